@@ -754,6 +754,7 @@ set(GUI_CMN_SRC
     src/common/dcbase.cpp
     src/common/dcbufcmn.cpp
     src/common/dcgraph.cpp
+    src/common/dcrecord.cpp
     src/common/dcsvg.cpp
     src/common/dirctrlcmn.cpp
     src/common/dlgcmn.cpp
@@ -841,6 +842,7 @@ set(GUI_CMN_SRC
     src/common/textcmn.cpp
     src/common/textentrycmn.cpp
     src/common/textmeasurecmn.cpp
+    src/common/tilecache.cpp
     src/common/toplvcmn.cpp
     src/common/treebase.cpp
     src/common/uiactioncmn.cpp
@@ -960,6 +962,7 @@ set(GUI_CMN_HDR
     wx/dcgraph.h
     wx/dcmemory.h
     wx/dcprint.h
+    wx/dcrecord.h
     wx/dcscreen.h
     wx/dcsvg.h
     wx/dialog.h
@@ -1153,6 +1156,7 @@ set(GUI_CMN_HDR
     wx/statline.h
     wx/tbarbase.h
     wx/tglbtn.h
+    wx/tilecache.h
     wx/tipwin.h
     wx/toolbook.h
     wx/tooltip.h
@@ -528,6 +528,15 @@ wx_check_funcs(fsync
                gettimeofday
                )
 
+# Check functions used by wxExecute() under Unix
+if(UNIX)
+    wx_check_funcs(posix_spawnp
+                   posix_spawn_file_actions_addclosefrom_np
+                   posix_spawn_file_actions_addchdir_np
+                   close_range
+                   )
+endif()
+
 if(MSVC)
     check_symbol_exists(vsscanf stdio.h HAVE_VSSCANF)
 endif()
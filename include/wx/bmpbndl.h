@@ -98,6 +98,35 @@ public:
     // On MacOS, name must be a file with an extension "svg" placed in the
     // "Resources" subdirectory of the application bundle.
     wxNODISCARD static wxBitmapBundle FromSVGResource(const wxString& name, const wxSize& sizeDef);
+
+    // Statistics of the global cache of bitmaps rasterized from SVG.
+    struct SVGCacheStats
+    {
+        // Number of bitmaps found in the cache and of those that had to be
+        // rasterized.
+        size_t hits = 0;
+        size_t misses = 0;
+
+        // Number and total size of the bitmaps currently in the cache.
+        size_t count = 0;
+        size_t bytes = 0;
+    };
+
+    wxNODISCARD static SVGCacheStats GetSVGCacheStats();
+
+    // Set the maximal size of the cache in bytes, 0 disables it.
+    static void SetSVGCacheLimit(size_t bytes);
+
+    // Remove all bitmaps from the cache and reset its statistics.
+    static void ClearSVGCache();
+
+    // Rasterize the bitmaps of all the given sizes for all SVG bundles in the
+    // given collection using the specified number of threads (0 means to use
+    // as many threads as there are CPUs). Returns the number of bitmaps which
+    // had to be rasterized.
+    static size_t PrerasterizeSVG(const wxVector<wxBitmapBundle>& bundles,
+                                  const wxVector<wxSize>& sizes,
+                                  int numThreads = 0);
 #endif // wxHAS_SVG
 
     // Create from the resources: all existing versions of the bitmap of the
@@ -18,8 +18,29 @@
 #include "wx/geometry.h"
 #include "wx/graphics.h"
 
+#include <memory>
+
 class WXDLLIMPEXP_FWD_CORE wxWindowDC;
 
+class wxGCDCGlyphAtlas;
+
+// Statistics of the glyph cache used by wxGCDC for drawing text.
+struct wxGCDCGlyphCacheStats
+{
+    // Number of glyphs found in the cache.
+    unsigned long hits = 0;
+
+    // Number of glyphs which had to be rasterized and added to the cache.
+    unsigned long misses = 0;
+
+    // Number of glyphs rasterized in advance, when creating the cache for a
+    // new font, without being used yet.
+    unsigned long prerasterized = 0;
+
+    // Number of strings drawn without using the cache, e.g. because they
+    // need complex shaping.
+    unsigned long fallbacks = 0;
+};
 
 class WXDLLIMPEXP_CORE wxGCDC: public wxDC
 {
@@ -44,6 +65,14 @@ public:
 
     virtual ~wxGCDC();
 
+    // Use the glyph cache for drawing simple text with this DC.
+    void EnableGlyphCache(bool enable = true);
+
+    // Functions working with the glyph cache shared by all wxGCDC objects.
+    static wxGCDCGlyphCacheStats GetGlyphCacheStats();
+    static void ResetGlyphCacheStats();
+    static void ClearGlyphCache();
+
 #ifdef __WXMSW__
     // override wxDC virtual functions to provide access to HDC associated with
     // underlying wxGraphicsContext
@@ -121,6 +150,8 @@ public:
 
     virtual void* GetHandle() const override;
 
+    void EnableGlyphCache(bool enable);
+
 #if wxUSE_DC_TRANSFORM_MATRIX
     virtual bool CanUseTransformMatrix() const override;
     virtual bool SetTransformMatrix(const wxAffineMatrix2D& matrix) override;
@@ -255,6 +286,15 @@ protected:
     bool m_isClipBoxValid;
 
 private:
+    // Draw the given single line string using the glyph cache if possible,
+    // return false if it can't be used for it.
+    bool DoDrawTextUsingGlyphCache(const wxString& str, wxCoord x, wxCoord y);
+
+    // Glyphs of the current font in the current text colour, only used if
+    // m_useGlyphCache is true and created on demand.
+    std::shared_ptr<wxGCDCGlyphAtlas> m_glyphAtlas;
+    bool m_useGlyphCache;
+
     // This method only initializes trivial fields.
     void CommonInit();
 
@@ -0,0 +1,156 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/dcrecord.h
+// Purpose:     wxRecordingDC and wxDisplayList classes
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_DCRECORD_H_
+#define _WX_DCRECORD_H_
+
+#include "wx/dc.h"
+
+#include <unordered_map>
+#include <vector>
+
+class WXDLLIMPEXP_FWD_BASE wxInputStream;
+class WXDLLIMPEXP_FWD_BASE wxOutputStream;
+
+class wxRecordingDCImpl;
+
+// ----------------------------------------------------------------------------
+// wxDisplayList: sequence of drawing operations recorded by wxRecordingDC
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_CORE wxDisplayList
+{
+public:
+    wxDisplayList() = default;
+
+    // The list can't be copied, as the pens created by Load() refer to the
+    // dashes stored in it, but it can be moved.
+    wxDisplayList(wxDisplayList&&) = default;
+    wxDisplayList& operator=(wxDisplayList&&) = default;
+
+    // Return true if nothing was recorded.
+    bool IsEmpty() const { return m_entries.empty(); }
+
+    // Return the number of recorded drawing operations.
+    size_t GetCount() const { return m_entries.size(); }
+
+    // Return the bounding box of all drawing operations in logical
+    // coordinates used when recording them.
+    wxRect GetBoundingBox() const;
+
+    // Remove all recorded operations.
+    void Clear();
+
+    // Draw all recorded operations on the given DC.
+    void Replay(wxDC& dc) const;
+
+    // Draw only the recorded operations intersecting the given rectangle.
+    void Replay(wxDC& dc, const wxRect& rect) const;
+
+#if wxUSE_STREAMS && wxUSE_IMAGE
+    // Save the list to a stream in binary format or load it from it.
+    bool Save(wxOutputStream& stream) const;
+    bool Load(wxInputStream& stream);
+#endif // wxUSE_STREAMS && wxUSE_IMAGE
+
+private:
+    // Attributes used for a drawing operation.
+    struct State
+    {
+        // Indices into m_pens, m_brushes and m_fonts, or -1 if not set.
+        int pen = -1,
+            brush = -1,
+            background = -1,
+            font = -1;
+
+        wxColour textForeground,
+                 textBackground;
+
+        int backgroundMode = wxBRUSHSTYLE_TRANSPARENT;
+
+        wxRasterOperationMode logicalFunction = wxCOPY;
+
+        // Effective clipping rectangle, only used if clipping is true.
+        bool clipping = false;
+        wxRect clipRect;
+    };
+
+    struct Entry
+    {
+        // Offset of the operation data in m_data.
+        size_t offset;
+
+        // Index of the state in m_states.
+        size_t state;
+
+        // Bounding box of the operation or an empty rectangle if it affects
+        // the entire DC, e.g. Clear().
+        wxRect bbox;
+    };
+
+    // Replay the entries with the given indices or all of them if indices is
+    // null.
+    void DoReplay(wxDC& dc, const wxUint32* indices, size_t count) const;
+
+    // Change the DC attributes which are different from the current ones, if
+    // any, to the given state.
+    void ApplyState(wxDC& dc, const State& state, const State* current,
+                    const wxRect* outerClip) const;
+
+    void ReplayEntry(wxDC& dc, const Entry& entry,
+                     std::vector<wxPoint>& points) const;
+
+    void BuildSpatialIndex() const;
+
+    int FindBitmap(const wxBitmap& bitmap) const;
+
+
+    // Recorded operations in binary format.
+    std::vector<unsigned char> m_data;
+
+    std::vector<Entry> m_entries;
+    std::vector<State> m_states;
+
+    // Objects used by the recorded operations.
+    std::vector<wxPen> m_pens;
+    std::vector<wxBrush> m_brushes;
+    std::vector<wxFont> m_fonts;
+    std::vector<wxBitmap> m_bitmaps;
+
+    // Dashes of the pens created by Load(), which must remain valid for as
+    // long as the pens using them are.
+    std::vector<std::vector<wxDash>> m_dashes;
+
+    // Spatial index used for culling the operations: the indices of entries
+    // intersecting each cell of a regular grid and the indices of the entries
+    // too big to be put in it. It's created on demand when it's needed.
+    mutable std::unordered_map<wxUint64, std::vector<wxUint32>> m_grid;
+    mutable std::vector<wxUint32> m_gridLarge;
+    mutable bool m_gridValid = false;
+
+    friend class wxRecordingDCImpl;
+};
+
+// ----------------------------------------------------------------------------
+// wxRecordingDC: records all drawing operations into a wxDisplayList
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_CORE wxRecordingDC : public wxDC
+{
+public:
+    // The display list must outlive this DC, the recorded operations are
+    // appended to its existing contents.
+    wxRecordingDC(wxDisplayList& list, const wxSize& size);
+
+private:
+    wxDECLARE_ABSTRACT_CLASS(wxRecordingDC);
+    wxDECLARE_NO_COPY_CLASS(wxRecordingDC);
+};
+
+#endif // _WX_DCRECORD_H_
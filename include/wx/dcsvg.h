@@ -19,6 +19,8 @@
 #include "wx/dc.h"
 
 #include <memory>
+#include <string>
+#include <unordered_map>
 
 #define wxSVGVersion wxT("v0101")
 
@@ -33,6 +35,7 @@ enum wxSVGShapeRenderingMode
 };
 
 class WXDLLIMPEXP_FWD_BASE wxFileOutputStream;
+class WXDLLIMPEXP_FWD_BASE wxOutputStream;
 
 class WXDLLIMPEXP_FWD_CORE wxSVGFileDC;
 
@@ -143,6 +146,8 @@ public:
 
     void SetShapeRenderingMode(wxSVGShapeRenderingMode renderingMode);
 
+    void EnableStyleClasses(bool enable);
+
 private:
     virtual bool DoGetPixel(wxCoord WXUNUSED(x), wxCoord WXUNUSED(y),
                             wxColour* WXUNUSED(col)) const override
@@ -257,9 +262,32 @@ private:
     void Init(const wxString& filename, int width, int height,
               double dpi, const wxString& title);
 
+    // Append the given string to the output buffer and write the buffer to
+    // the file if it's big enough.
     void write(const wxString& s);
 
 private:
+    // Functions appending to the output buffer without converting anything,
+    // WriteBufferIfNeeded() must be called after using them.
+    void Append(const char* s) { m_buffer += s; }
+    void Append(const std::string& s) { m_buffer += s; }
+    void AppendInt(long n);
+    void AppendNum(double f);
+
+    void WriteBufferIfNeeded();
+
+    // Write all the buffered output to the file.
+    void WriteBuffer();
+
+    // Return the stream to write the output to, may be null.
+    wxOutputStream* GetOutputStream() const;
+
+    // Update the cached values of the attributes depending on the current pen,
+    // brush and rendering mode.
+    void UpdatePenAttrs();
+    void UpdateBrushAttrs();
+    void UpdateRenderModeAttr();
+
     // If m_graphics_changed is true, close the current <g> element and start a
     // new one for the last pen/brush change.
     void NewGraphicsIfNeeded();
@@ -274,6 +302,8 @@ private:
     int                 m_width, m_height;
     double              m_dpi;
     std::unique_ptr<wxFileOutputStream> m_outfile;
+    std::unique_ptr<wxOutputStream> m_zoutfile; // used for SVGZ output only
+    std::string         m_buffer;
     std::unique_ptr<wxSVGBitmapHandler> m_bmp_handler; // class to handle bitmaps
     wxSVGShapeRenderingMode m_renderingMode;
 
@@ -288,6 +318,18 @@ private:
     // Unique ID for every gradient.
     size_t m_gradientUniqueId;
 
+    // Cached (UTF-8) attributes used for every primitive.
+    std::string m_penPatternAttr,
+                m_brushPatternAttr,
+                m_renderModeAttr;
+
+    // If true, graphics group styles are defined as CSS classes which are
+    // reused for all the groups with the same style.
+    bool m_useStyleClasses;
+
+    // Map of the group styles to the indices of the classes defining them.
+    std::unordered_map<std::string, size_t> m_styleClasses;
+
     wxDECLARE_ABSTRACT_CLASS(wxSVGFileDCImpl);
     wxDECLARE_NO_COPY_CLASS(wxSVGFileDCImpl);
 };
@@ -312,6 +354,9 @@ public:
 
     void SetShapeRenderingMode(wxSVGShapeRenderingMode renderingMode);
 
+    // Use CSS classes for the styles of the graphics groups.
+    void EnableStyleClasses(bool enable = true);
+
 private:
     wxDECLARE_ABSTRACT_CLASS(wxSVGFileDC);
 };
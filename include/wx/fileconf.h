@@ -20,6 +20,9 @@
 #include "wx/confbase.h"
 #include "wx/filename.h"
 
+#include <unordered_map>
+#include <vector>
+
 // ----------------------------------------------------------------------------
 // wxFileConfig
 // ----------------------------------------------------------------------------
@@ -202,6 +205,12 @@ public:
   void EnableAutoSave() { m_autosave = true; }
   void DisableAutoSave() { m_autosave = false; }
 
+  // in batch mode the lines of the file are not updated when writing values
+  // but only once, when the batch mode is turned off or the file is saved,
+  // which is faster when writing many values
+  void SetBatchMode(bool batch = true);
+  bool IsBatchMode() const { return m_batchMode; }
+
 public:
   // functions to work with this list
   wxFileConfigLineList *LineListAppend(const wxString& str);
@@ -245,6 +254,13 @@ private:
   // if path doesn't exist and createMissingComponents == false
   bool DoSetPath(const wxString& strPath, bool createMissingComponents);
 
+  // forget all the cached paths, must be called when deleting or renaming
+  // any groups
+  void ClearPathCache() { m_pathCache.clear(); }
+
+  // update the lines for the entries modified in batch mode
+  void UpdatePendingLines();
+
   // set/test the dirty flag
   void SetDirty() { m_isDirty = true; }
   void ResetDirty() { m_isDirty = false; }
@@ -269,8 +285,23 @@ private:
   int m_umask;                          // the umask to use for file creation
 #endif // __UNIX__
 
+  // the groups corresponding to the full paths recently used with SetPath()
+  // and the normalized paths themselves
+  struct CachedPath
+  {
+      wxFileConfigGroup *group;
+      wxString path;
+  };
+  std::unordered_map<wxString, CachedPath> m_pathCache;
+
+  // the entries modified in batch mode whose lines must still be updated
+  std::vector<wxFileConfigEntry *> m_pendingEntries;
+
   bool m_isDirty;                       // if true, we have unsaved changes
   bool m_autosave;                      // if true, save changes on destruction
+  bool m_batchMode;                     // if true, don't update lines at once
+
+  friend class wxFileConfigEntry;
 
   wxDECLARE_NO_COPY_CLASS(wxFileConfig);
   wxDECLARE_ABSTRACT_CLASS(wxFileConfig);
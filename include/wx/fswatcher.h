@@ -20,7 +20,9 @@
 #include "wx/filename.h"
 #include "wx/dir.h"
 
+#include <memory>
 #include <unordered_map>
+#include <vector>
 
 #define wxTRACE_FSWATCHER "fswatcher"
 
@@ -287,6 +289,9 @@ using wxFSWatchInfoMap = std::unordered_map<wxString, wxFSWatchInfo>;
  */
 class wxFSWatcherImpl;
 
+// Private helper used by AddTreeAsync()
+class wxFSWTreeAdder;
+
 /**
  * Main entry point for clients interested in file system events.
  * Defines interface that can be used to receive that kind of events.
@@ -316,6 +321,21 @@ public:
     virtual bool AddTree(const wxFileName& path, int events = wxFSW_EVENT_ALL,
                          const wxString& filespec = wxEmptyString);
 
+    /**
+     * Same as AddTree(), but only the path itself is watched immediately,
+     * while the rest of the tree is traversed in a background thread and its
+     * directories are watched progressively, without blocking the caller.
+     */
+    virtual bool AddTreeAsync(const wxFileName& path,
+                              int events = wxFSW_EVENT_ALL,
+                              const wxString& filespec = wxEmptyString);
+
+    /**
+     * Returns true if any trees passed to AddTreeAsync() are still being
+     * traversed.
+     */
+    bool IsAddingTree() const;
+
     /**
      * Removes path from the list of watched paths.
      */
@@ -359,6 +379,23 @@ public:
             m_owner = handler;
     }
 
+    /**
+     * Sets the time during which the repeated modification, access, attribute
+     * change and rename events for the same path are merged into a single
+     * event, 0 (default) means that all events are sent immediately.
+     *
+     * This is currently only implemented in inotify-based version.
+     */
+    void SetCoalescingInterval(int milliseconds)
+    {
+        m_coalescingInterval = milliseconds;
+    }
+
+    int GetCoalescingInterval() const
+    {
+        return m_coalescingInterval;
+    }
+
 
     // This is a semi-private function used by wxWidgets itself only.
     //
@@ -379,7 +416,22 @@ protected:
     wxFSWatcherImpl* m_service;     // file system events service
     wxEvtHandler* m_owner;             // handler for file system events
 
+private:
+    // Called in the main thread with the directories found by the tree adder
+    // with the given ID, done is true for the last call for this adder.
+    void OnTreeDirsFound(int id, const wxArrayString& dirs, bool done);
+
+    // Stop traversing the tree at the given path, or all of them if it's
+    // empty, in the background. Returns true if anything was cancelled.
+    bool CancelAddTreeAsync(const wxString& canonical = wxString());
+
+    // The trees being currently added by AddTreeAsync().
+    std::vector<std::unique_ptr<wxFSWTreeAdder>> m_treeAdders;
+
+    int m_coalescingInterval;          // in ms, 0 if not coalescing events
+
     friend class wxFSWatcherImpl;
+    friend class wxFSWTreeAdder;
 };
 
 // include the platform specific file defining wxFileSystemWatcher
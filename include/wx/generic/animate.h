@@ -107,6 +107,11 @@ protected:      // internal utilities
     bool RebuildBackingStoreUpToFrame(unsigned int);
     void DrawFrame(wxDC &dc, unsigned int);
 
+    // Save the area of the backing store covered by the given frame if its
+    // disposal method is wxANIM_TOPREVIOUS, so that it can be restored later
+    // without redrawing all the previous frames.
+    void SaveAreaUnderFrame(wxDC& dc, unsigned int frame);
+
     virtual void DisplayStaticImage() override;
     virtual wxSize DoGetBestSize() const override;
 
@@ -143,6 +148,10 @@ private:
     // True if we need to show the next frame after painting the current one.
     bool m_needToShowNextFrame = false;
 
+    // The contents of the backing store under the current frame before it
+    // was drawn, only valid if its disposal method is wxANIM_TOPREVIOUS.
+    wxBitmap m_bmpUnderFrame;
+
     typedef wxAnimationCtrlBase base_type;
     wxDECLARE_DYNAMIC_CLASS(wxGenericAnimationCtrl);
     wxDECLARE_EVENT_TABLE();
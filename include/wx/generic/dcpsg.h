@@ -20,6 +20,21 @@
 #include "wx/cmndata.h"
 #include "wx/strvararg.h"
 
+#include <string>
+
+// Encodings which can be used for the bitmaps in PostScript output.
+enum wxPostScriptImageEncoding
+{
+    // Uncompressed hexadecimal data, compatible with PostScript Level 1.
+    wxPS_IMAGE_ENCODING_HEX,
+
+    // ASCII85-encoded run-length compressed data, requires Level 2.
+    wxPS_IMAGE_ENCODING_RUNLENGTH,
+
+    // ASCII85-encoded Flate (zlib) compressed data, requires Level 3.
+    wxPS_IMAGE_ENCODING_FLATE
+};
+
 //-----------------------------------------------------------------------------
 // wxPostScriptDC
 //-----------------------------------------------------------------------------
@@ -33,6 +48,10 @@ public:
     // Recommended constructor
     wxPostScriptDC(const wxPrintData& printData);
 
+    // Choose how the bitmaps are stored in the output, must be called before
+    // StartDoc().
+    void SetImageEncoding(wxPostScriptImageEncoding encoding);
+
 private:
     wxDECLARE_DYNAMIC_CLASS(wxPostScriptDC);
 };
@@ -92,6 +111,10 @@ public:
     virtual int GetDepth() const override { return 24; }
 
     void PsPrint( const wxString& psdata );
+    void PsPrint( const char* psdata );
+
+    void SetImageEncoding(wxPostScriptImageEncoding encoding)
+        { m_imageEncoding = encoding; }
 
     // Overridden for wxPrinterDC Impl
 
@@ -149,6 +172,20 @@ protected:
     // Set PostScript color
     void SetPSColour(const wxColour& col);
 
+    // Functions appending to the output buffer without any conversions,
+    // PsFlushIfNeeded() must be called after using them.
+    void PsAppend(const char* psdata) { m_psBuffer += psdata; }
+    void PsAppendNumber(double value);
+    void PsAppendPoint(double x, double y, const char* op);
+
+    // Append the data of the given RGB image using the current encoding.
+    void PsAppendImageData(const unsigned char* data, int width, int height);
+
+    void PsFlushIfNeeded();
+
+    // Write all the buffered output to the file or stream.
+    void PsFlush();
+
     FILE*             m_pstream;    // PostScript output stream
     unsigned char     m_currentRed;
     unsigned char     m_currentGreen;
@@ -161,6 +198,8 @@ protected:
     double            m_pageHeight;
     wxArrayString     m_definedPSFonts;
     bool              m_isFontChanged;
+    std::string       m_psBuffer;   // Output not written to m_pstream yet
+    wxPostScriptImageEncoding m_imageEncoding;
 
 private:
     wxDECLARE_DYNAMIC_CLASS(wxPostScriptDCImpl);
@@ -0,0 +1,36 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/generic/private/dcpsg.h
+// Purpose:     Helpers used for generating PostScript output.
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_GENERIC_PRIVATE_DCPSG_H_
+#define _WX_GENERIC_PRIVATE_DCPSG_H_
+
+#include "wx/defs.h"
+
+#include <string>
+#include <vector>
+
+// These functions are only exported for testing them.
+namespace wxPrivate
+{
+
+// Append the number formatted as "%f" printf() format does in C locale.
+WXDLLIMPEXP_CORE void AppendPSNumber(std::string& s, double f);
+
+// Append the data compressed for RunLengthDecode filter to the vector.
+WXDLLIMPEXP_CORE void
+RunLengthEncode(const unsigned char* data, size_t len,
+                std::vector<unsigned char>& out);
+
+// Append the data encoded for ASCII85Decode filter, including "~>" marker.
+WXDLLIMPEXP_CORE void
+AppendASCII85(std::string& s, const unsigned char* data, size_t len);
+
+} // namespace wxPrivate
+
+#endif // _WX_GENERIC_PRIVATE_DCPSG_H_
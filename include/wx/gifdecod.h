@@ -19,6 +19,8 @@
 #include "wx/animdecod.h"
 #include "wx/dynarray.h"
 
+#include <vector>
+
 // internal utility used to store a frame in 8bit-per-pixel format
 class GIFImage;
 
@@ -71,6 +73,17 @@ public:
     // load function which returns more info than just Load():
     wxGIFErrorCode LoadGIF( wxInputStream& stream );
 
+    // enable decoding frames only when they're needed, keeping at most the
+    // given number of decoded frames in memory (must be called before loading)
+    void EnableLazyDecoding(bool enable = true, unsigned int maxCachedFrames = 4);
+    bool IsLazyDecodingEnabled() const
+        { return m_maxCachedFrames != 0; }
+
+    // in lazy decoding mode, decode all frames to detect any errors in them,
+    // without keeping more frames in memory than usual, decoding lastFrame,
+    // if specified, last to keep it in the cache
+    wxGIFErrorCode ValidateFrames(int lastFrame = -1);
+
     // free all internal frames
     void Destroy();
 
@@ -81,7 +94,11 @@ public:
     bool ConvertToImage(unsigned int frame, wxImage *image) const override;
 
     wxNODISCARD wxAnimationDecoder *Clone() const override
-        { return new wxGIFDecoder; }
+    {
+        wxGIFDecoder* const decoder = new wxGIFDecoder;
+        decoder->m_maxCachedFrames = m_maxCachedFrames;
+        return decoder;
+    }
     wxAnimationType GetType() const override
         { return wxANIMATION_TYPE_GIF; }
 
@@ -95,10 +112,27 @@ private:
     wxGIFErrorCode dgif(wxInputStream& stream,
                         GIFImage *img, int interl, int bits);
 
+    // store the compressed frame data for decoding it later in lazy mode
+    wxGIFErrorCode StoreFrameData(wxInputStream& stream,
+                                  GIFImage *img, int interl, int bits);
+
+    // decode the given frame if necessary in lazy mode and return it
+    GIFImage *GetDecodedFrame(unsigned int frame) const;
+
+    // decode the given frame if necessary in lazy mode
+    wxGIFErrorCode DecodeFrame(unsigned int frame) const;
+
 
     // array of all frames
     wxArrayPtrVoid m_frames;
 
+    // lazy decoding data: the maximal number of decoded frames to keep (0 if
+    // lazy decoding is not used), compressed data of all frames and indices
+    // of the currently decoded frames, from least to most recently used
+    unsigned int m_maxCachedFrames = 0;
+    std::vector<unsigned char> m_frameData;
+    mutable std::vector<unsigned int> m_cachedFrames;
+
     // decoder state vars
     int           m_restbits;       // remaining valid bits
     unsigned int  m_restbyte;       // remaining bytes in this block
@@ -23,6 +23,8 @@
 #include "wx/peninfobase.h"
 #include "wx/vector.h"
 
+#include <functional>
+
 enum wxAntialiasMode
 {
     wxANTIALIAS_NONE, // should be 0
@@ -947,6 +949,19 @@ public:
         DrawRectangle(rect.m_x, rect.m_y, rect.m_width, rect.m_height);
     }
 
+    // draws many rectangles at once, optionally filling each of them with its
+    // own colour instead of the current brush
+    virtual void DrawRectangles( size_t n, const wxRect2DDouble *rects, const wxColour *colours = nullptr );
+
+    // draws many points as 1x1 squares filled with the current brush or the
+    // given colours
+    virtual void DrawPoints( size_t n, const wxPoint2DDouble *points, const wxColour *colours = nullptr );
+
+    // strokes disconnected lines using the given pen, optionally with a
+    // different colour for each of them
+    virtual void StrokeSegments( size_t n, const wxPoint2DDouble *beginPoints, const wxPoint2DDouble *endPoints,
+                                 const wxGraphicsPenInfo& pen, const wxColour *colours = nullptr );
+
     // draws an ellipse
     virtual void DrawEllipse( wxDouble x, wxDouble y, wxDouble w, wxDouble h);
 
@@ -1110,6 +1125,13 @@ public:
 
 #if wxUSE_IMAGE
     virtual wxGraphicsContext * CreateContextFromImage(wxImage& image) = 0;
+
+    // Draw on the image by calling the given function for each of its
+    // horizontal bands, rendered in parallel by the given number of threads
+    // (all CPUs are used by default).
+    bool RenderImageInBands(wxImage& image,
+                            const std::function<void (wxGraphicsContext&)>& draw,
+                            int numThreads = 0);
 #endif // wxUSE_IMAGE
 
     // create a context that can be used for measuring texts only, no drawing allowed
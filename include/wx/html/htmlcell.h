@@ -270,6 +270,11 @@ public:
     //    members) = place items to fit window, according to the width w
     virtual void Layout(int w);
 
+    // Returns true if the result of Layout() may depend on the width passed
+    // to it. This is used by wxHtmlContainerCell to avoid laying out the
+    // cells again when only its width changes.
+    virtual bool IsLayoutWidthDependent() const { return true; }
+
     // renders the cell
     virtual void Draw(wxDC& WXUNUSED(dc),
                       int WXUNUSED(x), int WXUNUSED(y),
@@ -455,6 +460,7 @@ public:
     virtual wxCursor GetMouseCursor(wxHtmlWindowInterface *window) const override;
     virtual wxString ConvertToText(wxHtmlSelection *sel) const override;
     bool IsLinebreakAllowed() const override { return m_allowLinebreak; }
+    bool IsLayoutWidthDependent() const override { return false; }
 
     void SetPreviousWord(wxHtmlWordCell *cell);
 
@@ -551,7 +557,8 @@ public:
     void SetWidthFloat(int w, int units) {m_WidthFloat = w; m_WidthFloatUnits = units; m_LastLayout = -1;}
     void SetWidthFloat(const wxHtmlTag& tag, double pixel_scale = 1.0);
     // sets minimal height of this container.
-    void SetMinHeight(int h, int align = wxHTML_ALIGN_TOP) {m_MinHeight = h; m_MinHeightAlign = align; m_LastLayout = -1;}
+    // (changing it doesn't invalidate the layout, which is just adjusted)
+    void SetMinHeight(int h, int align = wxHTML_ALIGN_TOP) {m_MinHeight = h; m_MinHeightAlign = align;}
 
     void SetBackgroundColour(const wxColour& clr) {m_BkColour = clr;}
     // returns background colour (of wxNullColour if none set), so that widgets can
@@ -633,6 +640,54 @@ protected:
 private:
     void InitParent(wxHtmlContainerCell *parent);
 
+    // State of the layout at the beginning of a line.
+    struct LayoutLine
+    {
+        wxHtmlCell *cell = nullptr;
+        int ypos = 0;
+        int maxLineWidth = 0,
+            maxTotalWidth = 0,
+            curLineWidth = 0;
+        int lineWidthMin = 0,
+            lineWidthMax = 0;
+    };
+
+    // Try to reuse the result of the previous layout for the new width of
+    // the container, return false if it must be laid out again. If only
+    // the last lines must be laid out again, returns true and fills the
+    // line to resume the layout from.
+    bool ReuseLayout(int width, LayoutLine *resume);
+
+    // Move the cells to respect m_MinHeight and update m_Height.
+    void ApplyMinHeight();
+
+    // Let the parent containers know that this one must be laid out again.
+    void NotifyLayoutChange();
+
+    // Results of the last layout, used by ReuseLayout().
+    int m_LayoutWidth = -1;
+            // width of the container computed from the available width
+    int m_LayoutLineWidthMin = 0,
+        m_LayoutLineWidthMax = 0;
+            // range of line widths for which the lines are broken in the
+            // same way, the max value is exclusive
+    int m_LayoutUsedWidth = 0;
+            // width actually used by the contents
+    int m_LayoutHeight = 0,
+        m_LayoutMinHeightOffset = 0;
+            // height of the contents and their offset due to m_MinHeight
+    bool m_LayoutHasWidthDependentCells = false;
+            // true if any child cell IsLayoutWidthDependent()
+    LayoutLine m_LayoutLastLine,
+               m_LayoutPrevLine;
+            // state at the beginning of the last two lines
+    bool m_LayoutCellsAppended = false;
+            // true if InsertCell() was called after the last layout
+    int m_LayoutChangedChildren = 0;
+            // number of child containers which must be laid out again
+    bool m_LayoutNotifiedParent = false;
+            // true if this container was counted in the parent one
+
     wxDECLARE_ABSTRACT_CLASS(wxHtmlContainerCell);
     wxDECLARE_NO_COPY_CLASS(wxHtmlContainerCell);
 };
@@ -655,6 +710,8 @@ public:
 
     virtual wxString GetDescription() const override;
 
+    virtual bool IsLayoutWidthDependent() const override { return false; }
+
 protected:
     wxColour m_Colour;
     unsigned m_Flags;
@@ -683,6 +740,8 @@ public:
 
     virtual wxString GetDescription() const override;
 
+    virtual bool IsLayoutWidthDependent() const override { return false; }
+
 protected:
     wxFont m_Font;
 
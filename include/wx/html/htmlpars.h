@@ -69,6 +69,12 @@ public:
     // 4. call DoneParser();
     wxObject* Parse(const wxString& source);
 
+    // Parses the HTML fragment appended to the source previously parsed by
+    // Parse() or this method and appends it to the source returned by
+    // GetSource(). Only the fragment itself is parsed, so any tags left open
+    // in the previous source don't affect it.
+    wxObject* ParseAppended(const wxString& source);
+
     // Sets the source. This must be called before running Parse() method.
     virtual void InitParser(const wxString& source);
     // This must be called after Parse().
@@ -468,6 +468,9 @@ public:
     // implementation of SetPage()
     bool DoSetPage(const wxString& source);
 
+    // pass the HTML source through all the registered processors
+    wxString ApplyProcessors(const wxString& source) const;
+
 protected:
     // This is pointer to the first cell in parsed data.  (Note: the first cell
     // is usually top one = all other cells are sub-cells of this one)
@@ -530,6 +533,10 @@ private:
     wxPoint     m_tmpSelFromPos;
     wxHtmlCell *m_tmpSelFromCell;
 
+    // container to which the text passed to AppendToPage() is added, it is
+    // only found when AppendToPage() is called for the first time
+    wxHtmlContainerCell *m_tmpAppendCell;
+
     // if >0 contents of the window is not redrawn
     // (in order to avoid ugly blinking)
     int m_tmpCanDrawLocks;
@@ -164,6 +164,14 @@ private:
         { AddWord(new wxHtmlWordCell(word, *(GetDC()))); }
     void AddPreBlock(const wxString& text);
 
+    // Parses the fragment appended to the document in which the parsing
+    // ended in the given container, adding the cells created for it directly
+    // to this document, as if the fragment were parsed together with it.
+    // Returns the container in which the parsing of the fragment ended.
+    // This is used by wxHtmlWindow::AppendToPage().
+    wxHtmlContainerCell *ParseAppendedTo(wxHtmlContainerCell *container,
+                                         const wxString& source);
+
     bool m_tmpLastWasSpace;
     wxString m_tmpStrBuf;
         // temporary variables used by AddText
@@ -178,6 +186,10 @@ private:
 
     wxHtmlContainerCell *m_Container;
             // current container. See Open/CloseContainer for details.
+    wxHtmlContainerCell *m_appendContainer;
+            // container passed to ParseAppendedTo() while it's running
+    wxHtmlContainerCell *m_appendFormatting;
+            // cells to insert at the beginning of m_appendContainer
 
     int m_FontBold, m_FontItalic, m_FontUnderlined, m_FontFixed; // this is not true,false but 1,0, we need it for indexing
     int m_FontSize; // From 1 (smallest) to 7, default is 3.
@@ -101,6 +101,28 @@ const unsigned char wxIMAGE_ALPHA_OPAQUE = 0xff;
 class WXDLLIMPEXP_FWD_CORE wxImageHandler;
 class WXDLLIMPEXP_FWD_CORE wxImage;
 class WXDLLIMPEXP_FWD_CORE wxPalette;
+class wxImagePackedBuffer;
+
+//-----------------------------------------------------------------------------
+// wxImageRowsReceiver: gets the image rows as they are being loaded
+//-----------------------------------------------------------------------------
+
+#if wxUSE_STREAMS
+
+class WXDLLIMPEXP_CORE wxImageRowsReceiver
+{
+public:
+    wxImageRowsReceiver() = default;
+    virtual ~wxImageRowsReceiver() = default;
+
+    // Called when the rows in [firstRow, firstRow + numRows) range of the
+    // image being loaded have been decoded, return false to stop loading.
+    virtual bool OnRows(const wxImage& image, int firstRow, int numRows) = 0;
+
+    wxDECLARE_NO_COPY_CLASS(wxImageRowsReceiver);
+};
+
+#endif // wxUSE_STREAMS
 
 //-----------------------------------------------------------------------------
 // wxImageHandler
@@ -112,6 +134,7 @@ public:
     wxImageHandler()
         : m_name(wxEmptyString), m_extension(wxEmptyString), m_mime(), m_type(wxBITMAP_TYPE_INVALID)
         { }
+    virtual ~wxImageHandler();
 
 #if wxUSE_STREAMS
     // NOTE: LoadFile and SaveFile are not pure virtuals to allow derived classes
@@ -123,6 +146,13 @@ public:
                            bool WXUNUSED(verbose)=true )
         { return false; }
 
+    // Load the image passing its rows to the receiver as soon as they are
+    // decoded: the default implementation just passes all of them at once
+    // after calling LoadFile().
+    virtual bool LoadFileRows( wxImage *image, wxInputStream& stream,
+                               wxImageRowsReceiver& receiver,
+                               bool verbose=true, int index=-1 );
+
     int GetImageCount( wxInputStream& stream );
         // save the stream position, call DoGetImageCount() and restore the position
 
@@ -503,17 +533,33 @@ public:
 
     // these functions provide fastest access to wxImage data but should be
     // used carefully as no checks are done
+    unsigned char *GetData();
     unsigned char *GetData() const;
     void SetData( unsigned char *data, bool static_data=false );
     void SetData( unsigned char *data, int new_width, int new_height, bool static_data=false );
     void SetDataRGBA(const unsigned char* data);
 
-    unsigned char *GetAlpha() const;    // may return nullptr!
-    bool HasAlpha() const { return GetAlpha() != nullptr; }
+    unsigned char *GetAlpha();          // may return nullptr!
+    unsigned char *GetAlpha() const;
+    bool HasAlpha() const;
     void SetAlpha(unsigned char *alpha = nullptr, bool static_data=false);
     void InitAlpha();
     void ClearAlpha();
 
+    // Packed storage mode using a single premultiplied ARGB value per pixel:
+    // the image is converted to it by GetPackedData() and back to the default
+    // storage by any non-const function accessing the RGB data or alpha
+    // channel, while the const ones use a copy of the data in this storage.
+    bool CreatePacked( int width, int height, bool clear = true );
+    bool CreatePacked( const wxSize& sz, bool clear = true )
+        { return CreatePacked(sz.GetWidth(), sz.GetHeight(), clear); }
+    bool IsPacked() const;
+    wxUint32 *GetPackedData();
+
+    // implementation only: return the buffer used in packed mode, which can
+    // be shared with the native bitmaps, or nullptr if it's not used
+    wxImagePackedBuffer *GetPackedBuffer() const;
+
     // return true if this pixel is masked or has alpha less than specified
     // threshold
     bool IsTransparent(int x, int y,
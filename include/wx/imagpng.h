@@ -27,7 +27,9 @@
 #define wxIMAGE_OPTION_PNG_COMPRESSION_MEM_LEVEL   wxT("PngZM")
 #define wxIMAGE_OPTION_PNG_COMPRESSION_STRATEGY    wxT("PngZS")
 #define wxIMAGE_OPTION_PNG_COMPRESSION_BUFFER_SIZE wxT("PngZB")
+#define wxIMAGE_OPTION_PNG_COMPRESSION_THREADS     wxT("PngZT")
 #define wxIMAGE_OPTION_PNG_DESCRIPTION             wxT("PngDescription")
+#define wxIMAGE_OPTION_PNG_FAST                    wxT("PngFast")
 
 enum
 {
@@ -53,6 +55,9 @@ public:
 #if wxUSE_STREAMS
     virtual bool LoadFile( wxImage *image, wxInputStream& stream, bool verbose=true, int index=-1 ) override;
     virtual bool SaveFile( wxImage *image, wxOutputStream& stream, bool verbose=true ) override;
+    virtual bool LoadFileRows( wxImage *image, wxInputStream& stream,
+                               wxImageRowsReceiver& receiver,
+                               bool verbose=true, int index=-1 ) override;
 protected:
     virtual bool DoCanRead( wxInputStream& stream ) override;
 #endif
@@ -42,6 +42,9 @@ public:
 
 #if wxUSE_STREAMS
     virtual bool LoadFile( wxImage *image, wxInputStream& stream, bool verbose=true, int index=-1 ) override;
+    virtual bool LoadFileRows( wxImage *image, wxInputStream& stream,
+                               wxImageRowsReceiver& receiver,
+                               bool verbose=true, int index=-1 ) override;
     virtual bool SaveFile( wxImage *image, wxOutputStream& stream, bool verbose=true ) override;
 
 protected:
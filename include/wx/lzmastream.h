@@ -31,8 +31,13 @@ protected:
     wxLZMAData();
     ~wxLZMAData();
 
+    // Change the size of the buffer used for the compressed data, this can
+    // only be done before starting to use it.
+    void SetBufferSize(size_t size);
+
     wxLZMAStream* m_stream;
     wxUint8* m_streamBuf;
+    size_t m_streamBufSize;
     wxFileOffset m_pos;
 
     wxDECLARE_NO_COPY_CLASS(wxLZMAData);
@@ -60,6 +65,20 @@ public:
         Init();
     }
 
+    // Use multiple threads for decompression: threads == 0 means to use as
+    // many threads as there are CPUs and memlimit == 0 means no limit.
+    wxLZMAInputStream(wxInputStream& stream, int threads, wxUint64 memlimit = 0)
+        : wxFilterInputStream(stream)
+    {
+        Init(threads, memlimit);
+    }
+
+    wxLZMAInputStream(wxInputStream* stream, int threads, wxUint64 memlimit = 0)
+        : wxFilterInputStream(stream)
+    {
+        Init(threads, memlimit);
+    }
+
     char Peek() override { return wxInputStream::Peek(); }
     wxFileOffset GetLength() const override { return wxInputStream::GetLength(); }
 
@@ -68,7 +87,7 @@ protected:
     wxFileOffset OnSysTell() const override { return m_pos; }
 
 private:
-    void Init();
+    void Init(int threads = 1, wxUint64 memlimit = 0);
 };
 
 // ----------------------------------------------------------------------------
@@ -91,6 +110,22 @@ public:
         Init(level);
     }
 
+    // Use multiple threads for compression, the meaning of the extra
+    // parameters is the same as for wxLZMAInputStream.
+    wxLZMAOutputStream(wxOutputStream& stream, int level, int threads,
+                       wxUint64 memlimit = 0)
+        : wxFilterOutputStream(stream)
+    {
+        Init(level, threads, memlimit);
+    }
+
+    wxLZMAOutputStream(wxOutputStream* stream, int level, int threads,
+                       wxUint64 memlimit = 0)
+        : wxFilterOutputStream(stream)
+    {
+        Init(level, threads, memlimit);
+    }
+
     virtual ~wxLZMAOutputStream() { Close(); }
 
     void Sync() override { DoFlush(false); }
@@ -102,7 +137,7 @@ protected:
     wxFileOffset OnSysTell() const override { return m_pos; }
 
 private:
-    void Init(int level);
+    void Init(int level, int threads = 1, wxUint64 memlimit = 0);
 
     // Write the contents of the internal buffer to the output stream.
     bool UpdateOutput();
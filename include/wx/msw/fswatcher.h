@@ -28,6 +28,17 @@ public:
     virtual bool AddTree(const wxFileName& path, int events = wxFSW_EVENT_ALL,
                          const wxString& filter = wxEmptyString) override;
 
+    // There is no need to traverse the tree in the background when a single
+    // native watch can be used for all of it.
+    virtual bool AddTreeAsync(const wxFileName& path,
+                              int events = wxFSW_EVENT_ALL,
+                              const wxString& filter = wxEmptyString) override
+    {
+        return filter.empty()
+                ? AddTree(path, events, filter)
+                : wxFileSystemWatcherBase::AddTreeAsync(path, events, filter);
+    }
+
 protected:
     bool Init();
 };
@@ -49,6 +49,14 @@ public:
     bool AddTree(const wxFileName& path, int events = wxFSW_EVENT_ALL,
                 const wxString& filespec = wxEmptyString) override;
 
+    // adding a tree is cheap when using FSEvents, so there is no need to do
+    // it in the background
+    bool AddTreeAsync(const wxFileName& path, int events = wxFSW_EVENT_ALL,
+                const wxString& filespec = wxEmptyString) override
+    {
+        return AddTree(path, events, filespec);
+    }
+
     // reimplement removing a tree so that we
     // cleanup the opened fs streams
     bool RemoveTree(const wxFileName& path) override;
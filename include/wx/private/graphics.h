@@ -162,6 +162,27 @@ public :
     virtual bool Contains( wxDouble x, wxDouble y, wxPolygonFillMode fillStyle = wxODDEVEN_RULE) const=0;
 };
 
+// Return the rectangle covering the same area as the given one but with
+// non-negative width and height, so that all rectangles added to the same path
+// have the same orientation and overlapping ones are filled correctly when
+// using wxWINDING_RULE.
+inline wxRect2DDouble wxGetNormalizedRect2D(const wxRect2DDouble& rect)
+{
+    wxRect2DDouble r(rect);
+    if ( r.m_width < 0 )
+    {
+        r.m_x += r.m_width;
+        r.m_width = -r.m_width;
+    }
+    if ( r.m_height < 0 )
+    {
+        r.m_y += r.m_height;
+        r.m_height = -r.m_height;
+    }
+
+    return r;
+}
+
 #endif
 
 #endif // _WX_GRAPHICS_PRIVATE_H_
@@ -0,0 +1,61 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/private/image.h
+// Purpose:     Private wxImage helpers for sharing data with native bitmaps
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_PRIVATE_IMAGE_H_
+#define _WX_PRIVATE_IMAGE_H_
+
+#include "wx/image.h"
+
+#include <stdlib.h>
+
+// ----------------------------------------------------------------------------
+// wxImagePackedBuffer: pixel data of wxImage using packed storage mode
+// ----------------------------------------------------------------------------
+
+// Each pixel is stored as a native-endian 32-bit value with alpha in the upper
+// 8 bits followed by red, green and blue, which are premultiplied by alpha.
+// This is the same layout as used by CAIRO_FORMAT_ARGB32 and premultiplied
+// 32bpp DIBs under MSW.
+//
+// The buffer is reference-counted to allow the native bitmaps created from the
+// image to use it without copying: wxImage never modifies it if it's shared.
+class wxImagePackedBuffer : public wxRefCounter
+{
+public:
+    // Allocate the buffer for the given number of pixels, check IsOk() to
+    // verify if this succeeded.
+    explicit wxImagePackedBuffer(size_t count)
+        : m_data(static_cast<wxUint32*>(malloc(count*sizeof(wxUint32))))
+    {
+    }
+
+    bool IsOk() const { return m_data != nullptr; }
+
+    wxUint32* GetData() const { return m_data; }
+
+    // This function can be used as a destroy notification callback for the
+    // native objects using this buffer, after calling IncRef() on it.
+    static void Release(void* buffer)
+    {
+        static_cast<wxImagePackedBuffer*>(buffer)->DecRef();
+    }
+
+protected:
+    virtual ~wxImagePackedBuffer()
+    {
+        free(m_data);
+    }
+
+private:
+    wxUint32* const m_data;
+
+    wxDECLARE_NO_COPY_CLASS(wxImagePackedBuffer);
+};
+
+#endif // _WX_PRIVATE_IMAGE_H_
@@ -31,6 +31,8 @@ class WXDLLIMPEXP_FWD_CORE wxPalette;
 #define wxQUANTIZE_INCLUDE_WINDOWS_COLOURS      0x01
 #define wxQUANTIZE_RETURN_8BIT_DATA             0x02
 #define wxQUANTIZE_FILL_DESTINATION_IMAGE       0x04
+#define wxQUANTIZE_FAST                         0x08
+#define wxQUANTIZE_NO_DITHERING                 0x10
 
 class WXDLLIMPEXP_CORE wxQuantize: public wxObject
 {
@@ -68,6 +70,10 @@ public:
     // fills out_rows with indexes into palette (which is also stored into palette variable)
     static void DoQuantize(unsigned w, unsigned h, unsigned char **in_rows, unsigned char **out_rows, unsigned char *palette, int desiredNoColours);
 
+    // Same as above, but also takes wxQUANTIZE_FAST and
+    // wxQUANTIZE_NO_DITHERING flags into account.
+    static void DoQuantize(unsigned w, unsigned h, unsigned char **in_rows, unsigned char **out_rows, unsigned char *palette, int desiredNoColours, int flags);
+
 };
 
 #endif
@@ -16,6 +16,7 @@
 #include "wx/archive.h"
 
 #include <unordered_map>
+#include <vector>
 
 /////////////////////////////////////////////////////////////////////////////
 // Constants
@@ -141,6 +142,7 @@ private:
     int          m_DevMinor;
 
     friend class wxTarInputStream;
+    friend class wxTarIndex;
 
     wxDECLARE_DYNAMIC_CLASS(wxTarEntry);
 };
@@ -149,6 +151,8 @@ private:
 /////////////////////////////////////////////////////////////////////////////
 // wxTarInputStream
 
+class WXDLLIMPEXP_FWD_BASE wxTarIndex;
+
 class WXDLLIMPEXP_BASE wxTarInputStream : public wxArchiveInputStream
 {
 public:
@@ -159,6 +163,8 @@ public:
     virtual ~wxTarInputStream();
 
     bool OpenEntry(wxTarEntry& entry);
+    bool OpenEntry(const wxTarIndex& index, const wxString& name,
+                   wxPathFormat format = wxPATH_NATIVE);
     bool CloseEntry() override;
 
     wxTarEntry *GetNextEntry();
@@ -178,6 +184,7 @@ private:
 
     wxArchiveEntry *DoGetNextEntry() override    { return GetNextEntry(); }
     bool OpenEntry(wxArchiveEntry& entry) override;
+    bool DoOpenEntry(const wxTarEntry& entry);
     bool IsOpened() const               { return m_pos != wxInvalidOffset; }
 
     wxStreamError ReadHeaders();
@@ -203,6 +210,57 @@ private:
 };
 
 
+/////////////////////////////////////////////////////////////////////////////
+// wxTarIndex - the catalog of all entries of a tar allowing to open any of
+// them directly, without reading all the preceding headers
+
+class WXDLLIMPEXP_BASE wxTarIndex
+{
+public:
+    wxTarIndex() : m_archiveSize(wxInvalidOffset) { }
+
+    // build the index by reading all headers of the tar from the stream,
+    // which must be positioned at the start of the tar
+    bool Build(wxInputStream& stream, wxMBConv& conv = wxConvLocal);
+
+    // save the index to, or load it from, a sidecar file: if archiveSize is
+    // specified when loading, the index is only loaded if it corresponds to
+    // a tar of this size
+    bool Save(wxOutputStream& stream) const;
+    bool Load(wxInputStream& stream,
+              wxFileOffset archiveSize = wxInvalidOffset);
+
+    // check that the index was built for the tar in the given seekable
+    // stream, by comparing its size and the header of its last entry
+    bool IsUpToDate(wxInputStream& stream) const;
+
+    // the conventional name of the sidecar index file for the given tar
+    static wxString GetIndexName(const wxString& tarName)
+        { return tarName + wxS(".idx"); }
+
+    void Clear();
+
+    bool IsEmpty() const                { return m_entries.empty(); }
+    size_t GetCount() const             { return m_entries.size(); }
+    const wxTarEntry& GetEntry(size_t n) const { return m_entries[n]; }
+
+    // size of the tar the index was built for, if known
+    wxFileOffset GetArchiveSize() const { return m_archiveSize; }
+
+    // return the entry with the given name or null if there is none
+    const wxTarEntry *Find(const wxString& name,
+                           wxPathFormat format = wxPATH_NATIVE) const;
+
+private:
+    void Add(const wxTarEntry& entry);
+
+    std::vector<wxTarEntry> m_entries;
+    std::unordered_map<wxString, size_t> m_byName;
+    wxFileOffset m_archiveSize;
+    std::vector<char> m_lastHeader; // raw header block of the last entry
+};
+
+
 /////////////////////////////////////////////////////////////////////////////
 // wxTarOutputStream
 
@@ -0,0 +1,108 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/tilecache.h
+// Purpose:     wxTileCache class
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_TILECACHE_H_
+#define _WX_TILECACHE_H_
+
+#include "wx/bitmap.h"
+#include "wx/gdicmn.h"
+
+#include <unordered_map>
+
+class WXDLLIMPEXP_FWD_CORE wxDC;
+class WXDLLIMPEXP_FWD_CORE wxWindow;
+
+// ----------------------------------------------------------------------------
+// wxTileCache: keeps the rendered contents of a window in bitmap tiles
+// ----------------------------------------------------------------------------
+
+// Derive from this class and override DrawTile() to draw the given part of the
+// window and call Paint() from the paint event handler to blit the cached
+// tiles, redrawing only the ones invalidated by Invalidate() since the last
+// paint. All rectangles are in logical coordinates, so the tiles remain valid
+// when the window is scrolled.
+class WXDLLIMPEXP_CORE wxTileCache
+{
+public:
+    explicit wxTileCache(const wxSize& tileSize = wxSize(256, 256),
+                         size_t maxTiles = 256);
+    virtual ~wxTileCache();
+
+    // Changing the tile size discards all the currently cached tiles.
+    void SetTileSize(const wxSize& tileSize);
+    wxSize GetTileSize() const { return m_tileSize; }
+
+    // Set the maximal number of tiles to keep, the least recently used ones
+    // are discarded when there are more of them.
+    void SetMaxTiles(size_t maxTiles);
+    size_t GetMaxTiles() const { return m_maxTiles; }
+
+    // Mark the given part, or all, of the cached contents as needing to be
+    // redrawn.
+    void Invalidate(const wxRect& rect);
+    void InvalidateAll();
+
+    // Discard all the cached tiles.
+    void Clear();
+
+    // Draw the given rectangle on the DC using the cached tiles, updating
+    // them if necessary.
+    void Paint(wxDC& dc, const wxRect& rect);
+
+    // Draw all parts of the window update region, this should be called from
+    // the window paint event handler with a wxPaintDC already prepared for
+    // drawing in logical coordinates.
+    void PaintUpdateRegion(wxDC& dc, const wxWindow* window);
+
+protected:
+    // Must be overridden to draw the given rectangle, the DC is clipped to it.
+    // The tiles are not cleared before calling it, so it must paint the whole
+    // rectangle, including the background.
+    virtual void DrawTile(wxDC& dc, const wxRect& rect) = 0;
+
+private:
+    struct Tile
+    {
+        wxBitmap bitmap;
+
+        // The part of the tile which needs to be redrawn, may be empty.
+        wxRect dirty;
+
+        // The value of m_paintCounter when this tile was last painted.
+        unsigned long lastUsed;
+    };
+
+    // Tiles are indexed by their column and row combined in a single value.
+    typedef wxUint64 TileKey;
+
+    static TileKey MakeKey(int col, int row)
+    {
+        return (static_cast<TileKey>(static_cast<wxUint32>(col)) << 32) |
+                    static_cast<wxUint32>(row);
+    }
+
+    wxRect GetTileRect(TileKey key) const;
+
+    // Discard the least recently used tiles if we have too many of them.
+    void DiscardUnusedTiles();
+
+    wxSize m_tileSize;
+    size_t m_maxTiles;
+
+    // Content scale factor used for the existing tiles.
+    double m_scale;
+
+    unsigned long m_paintCounter;
+
+    std::unordered_map<TileKey, Tile> m_tiles;
+
+    wxDECLARE_NO_COPY_CLASS(wxTileCache);
+};
+
+#endif // _WX_TILECACHE_H_
@@ -49,6 +49,7 @@ class WXDLLIMPEXP_FWD_BASE wxArrayInt;
 #endif
 
 #include <unordered_map>
+#include <vector>
 
 // ----------------------------------------------------------------------------
 // Forward declaration
@@ -409,6 +410,13 @@ WXDLLIMPEXP_BASE long wxExecute(const wxString& command,
                                 int flags = 0,
                                 const wxExecuteEnv *env = nullptr);
 
+// execute all the given commands asynchronously using the same flags and
+// environment, return the PIDs of the launched processes (0 for the commands
+// which couldn't be launched)
+WXDLLIMPEXP_BASE std::vector<long> wxExecuteBatch(const wxArrayString& commands,
+                                                  int flags = wxEXEC_ASYNC,
+                                                  const wxExecuteEnv *env = nullptr);
+
 #if defined(__WINDOWS__) && wxUSE_IPC
 // ask a DDE server to execute the DDE request with given parameters
 WXDLLIMPEXP_BASE bool wxExecuteDDE(const wxString& ddeServer,
@@ -323,6 +323,118 @@ public:
      */
     static wxBitmapBundle FromSVGResource(const wxString& name, const wxSize& sizeDef);
 
+    /**
+        Statistics of the cache of bitmaps rasterized from SVG images.
+
+        @see GetSVGCacheStats()
+
+        @since 3.3.2
+     */
+    struct SVGCacheStats
+    {
+        /// Number of requested bitmaps that were found in the cache.
+        size_t hits;
+
+        /// Number of requested bitmaps that had to be rasterized.
+        size_t misses;
+
+        /// Number of bitmaps currently in the global cache.
+        size_t count;
+
+        /// Total size of the bitmaps in the global cache, in bytes.
+        size_t bytes;
+    };
+
+    /**
+        Returns the statistics of the SVG rasterization cache.
+
+        The bitmaps rasterized from SVG bundles are cached, both in each
+        bundle, which keeps the last few sizes used with it, and in a global
+        cache shared by all the bundles, which is indexed by the contents of
+        the SVG document and the bitmap size, meaning that bundles created
+        from the same SVG data share the bitmaps. The global cache uses a
+        least-recently-used eviction policy to keep its total size under the
+        limit set by SetSVGCacheLimit().
+
+        This function is mostly useful for checking how efficient this cache
+        is in the application.
+
+        Only available if @c wxHAS_SVG is defined.
+
+        @since 3.3.2
+     */
+    static SVGCacheStats GetSVGCacheStats();
+
+    /**
+        Sets the maximal size of the global SVG rasterization cache.
+
+        The default limit is 16MiB. If the cache already uses more memory than
+        the new limit, the least recently used bitmaps are removed from it.
+
+        Only available if @c wxHAS_SVG is defined.
+
+        @param bytes The maximal total size of the bitmaps in the cache, 0
+            disables the global cache entirely.
+
+        @since 3.3.2
+     */
+    static void SetSVGCacheLimit(size_t bytes);
+
+    /**
+        Removes all bitmaps from the global SVG rasterization cache and resets
+        its statistics.
+
+        Only available if @c wxHAS_SVG is defined.
+
+        @since 3.3.2
+     */
+    static void ClearSVGCache();
+
+    /**
+        Rasterizes the bitmaps of the given sizes for the SVG bundles in
+        advance using multiple threads.
+
+        Rasterizing SVG images is relatively slow and, by default, it is done
+        on demand, when GetBitmap() is called for a bundle for the first time,
+        which can noticeably slow down the creation of the windows using many
+        SVG icons. This function can be called to rasterize all the bitmaps
+        which are going to be needed in parallel, e.g. when starting the
+        application, so that the subsequent GetBitmap() calls for them don't
+        need to do it.
+
+        Only the pixel data is produced by the worker threads, each of which
+        uses its own rasterizer, while the bitmaps are created in the calling
+        thread, which must be the main one, after all of them terminate. The
+        resulting bitmaps are stored in the bundles themselves and in the
+        global cache (see GetSVGCacheStats()), and bundles created from the
+        same SVG data are rasterized only once.
+
+        Example of using this function:
+        @code
+        wxVector<wxBitmapBundle> icons;
+        for ( const wxString& path : iconPaths )
+            icons.push_back(wxBitmapBundle::FromSVGFile(path, wxSize(16, 16)));
+
+        // Rasterize all icons at 100% and 200% scale.
+        wxBitmapBundle::PrerasterizeSVG(icons, {wxSize(16, 16), wxSize(32, 32)});
+        @endcode
+
+        Only available if @c wxHAS_SVG is defined.
+
+        @param bundles The bundles to rasterize, non-SVG bundles are ignored.
+        @param sizes The sizes of the bitmaps to create for each bundle.
+        @param numThreads The number of threads to use, including the calling
+            one. If 0 (default), the number of CPUs is used. This parameter
+            is ignored if @c wxUSE_THREADS is 0.
+        @return The number of bitmaps which were rasterized, the bitmaps which
+            had been already available are not counted.
+
+        @since 3.3.2
+     */
+    static size_t PrerasterizeSVG(const wxVector<wxBitmapBundle>& bundles,
+                                  const wxVector<wxSize>& sizes,
+                                  int numThreads = 0);
+
     /**
         Clear the existing bundle contents.
 
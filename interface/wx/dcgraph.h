@@ -5,6 +5,39 @@
 // Licence:     wxWindows licence
 /////////////////////////////////////////////////////////////////////////////
 
+/**
+    Statistics of the glyph cache used by wxGCDC.
+
+    @see wxGCDC::EnableGlyphCache(), wxGCDC::GetGlyphCacheStats()
+
+    @since 3.3.2
+*/
+struct wxGCDCGlyphCacheStats
+{
+    /// Number of glyphs found in the cache.
+    unsigned long hits;
+
+    /// Number of glyphs which had to be rasterized and added to the cache.
+    unsigned long misses;
+
+    /**
+        Number of glyphs rasterized in advance.
+
+        All ASCII characters are rasterized when the cache is created for a new
+        font, colour and scale combination, before they're used, so they're
+        not counted as misses.
+     */
+    unsigned long prerasterized;
+
+    /**
+        Number of strings drawn without using the cache by a DC using it.
+
+        This happens for the strings requiring complex shaping, e.g. in Arabic
+        or Indic scripts, or when the text is scaled or rotated.
+     */
+    unsigned long fallbacks;
+};
+
 /**
     @class wxGCDC
 
@@ -108,5 +141,60 @@ public:
     */
     void SetGraphicsContext(wxGraphicsContext* context);
 
+    /**
+       Enable or disable the use of the glyph cache for drawing text.
+
+       When the glyph cache is enabled, DrawText() rasterizes each character
+       of the current font in the current text foreground colour only once and
+       then draws the text by copying the cached bitmaps of its characters,
+       positioned using their advance widths. This is much faster than normal
+       text drawing, which is especially noticeable when drawing many short
+       strings, as is typically done by grid-like controls.
+
+       However the text drawn in this way is not kerned and doesn't use
+       ligatures, so it may look slightly different from the normal text. This
+       is why the cache is not used by default and must be explicitly enabled.
+
+       Strings which require complex shaping or bidirectional layout, e.g.
+       containing Arabic, Hebrew or Indic characters or combining marks, are
+       always drawn normally, as is any text drawn with scaling or rotation
+       transformation or from a thread other than the main one.
+
+       The cache is shared by all wxGCDC objects using it, so the glyphs
+       rasterized when drawing on one DC are reused by the others.
+
+       @see GetGlyphCacheStats(), ClearGlyphCache()
+
+       @since 3.3.2
+    */
+    void EnableGlyphCache(bool enable = true);
+
+    /**
+       Return the statistics of the glyph cache.
+
+       The returned values are cumulative for all wxGCDC objects using the
+       cache since the program start or the last call to ResetGlyphCacheStats()
+       and can be used for checking the effectiveness of the cache.
+
+       @since 3.3.2
+    */
+    static wxGCDCGlyphCacheStats GetGlyphCacheStats();
+
+    /**
+       Reset all values returned by GetGlyphCacheStats() to 0.
+
+       @since 3.3.2
+    */
+    static void ResetGlyphCacheStats();
+
+    /**
+       Free all glyphs in the cache.
+
+       The cache size is limited, so calling this function is not necessary,
+       but it can be used to free memory when the cache won't be used any more.
+
+       @since 3.3.2
+    */
+    static void ClearGlyphCache();
 };
 
@@ -5,6 +5,41 @@
 // Licence:     wxWindows licence
 /////////////////////////////////////////////////////////////////////////////
 
+/**
+    Encodings which can be used for the bitmaps drawn on wxPostScriptDC.
+
+    @see wxPostScriptDC::SetImageEncoding()
+
+    @since 3.3.2
+*/
+enum wxPostScriptImageEncoding
+{
+    /**
+        Uncompressed hexadecimal data.
+
+        This encoding is compatible with PostScript Level 1 interpreters, but
+        results in output twice bigger than the bitmap data itself.
+    */
+    wxPS_IMAGE_ENCODING_HEX,
+
+    /**
+        Run-length compressed data in ASCII85 format.
+
+        This encoding requires PostScript Level 2 and is efficient for the
+        images with big areas of the same colour, e.g. charts or screenshots.
+    */
+    wxPS_IMAGE_ENCODING_RUNLENGTH,
+
+    /**
+        Flate (zlib) compressed data in ASCII85 format.
+
+        This encoding requires PostScript Level 3 and results in the smallest
+        output. If wxWidgets is built without zlib support, it is handled as
+        wxPS_IMAGE_ENCODING_RUNLENGTH.
+    */
+    wxPS_IMAGE_ENCODING_FLATE
+};
+
 /**
     @class wxPostScriptDC
 
@@ -32,5 +67,18 @@ public:
     */
     wxPostScriptDC(const wxPrintData& printData);
 
+    /**
+        Set the encoding used for the bitmaps drawn on this DC.
+
+        By default, wxPS_IMAGE_ENCODING_HEX is used for compatibility with
+        all PostScript interpreters. Use wxPS_IMAGE_ENCODING_FLATE to get much
+        smaller files if the output is only going to be used with PostScript
+        Level 3 devices, or wxPS_IMAGE_ENCODING_RUNLENGTH for Level 2 ones.
+
+        This function must be called before calling StartDoc().
+
+        @since 3.3.2
+    */
+    void SetImageEncoding(wxPostScriptImageEncoding encoding);
 };
 
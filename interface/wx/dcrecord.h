@@ -0,0 +1,184 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        dcrecord.h
+// Purpose:     interface of wxRecordingDC and wxDisplayList
+// Author:      wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+    @class wxDisplayList
+
+    Sequence of drawing operations recorded by wxRecordingDC.
+
+    A display list allows to perform the possibly expensive traversal of the
+    application data model only once and then draw its result as many times as
+    needed, e.g. on screen, in print preview, when printing and when exporting
+    it to SVG using wxSVGFileDC, by calling Replay().
+
+    The operations are stored in a compact binary format, with the pens,
+    brushes, fonts and bitmaps used by them stored only once. When only a part
+    of the drawing needs to be updated, e.g. when handling wxEVT_PAINT, the
+    overload of Replay() taking a rectangle can be used to skip all the
+    operations outside of it quickly using a spatial index built on demand.
+
+    Example of using the display list for painting a window:
+    @code
+    void MyCanvas::OnPaint(wxPaintEvent&)
+    {
+        wxPaintDC dc(this);
+
+        if ( m_displayList.IsEmpty() )
+        {
+            wxRecordingDC recDC(m_displayList, GetVirtualSize());
+            DrawModel(recDC);
+        }
+
+        wxRegionIterator upd(GetUpdateRegion());
+        for ( ; upd; ++upd )
+        {
+            wxDCClipper clip(dc, upd.GetRect());
+            m_displayList.Replay(dc, upd.GetRect());
+        }
+    }
+    @endcode
+
+    and the same list can then be reused for printing by replaying it from
+    wxPrintout::OnPrintPage(), after calling wxPrintout::FitThisSizeToPage()
+    or a similar function to set up the scaling of the printer DC.
+
+    Note that the list records the logical coordinates passed to the drawing
+    functions, so any scaling or origin change must be done by setting up the
+    DC passed to Replay() and not by calling the corresponding functions of
+    wxRecordingDC itself. To replay the list on wxGraphicsContext, wrap it in
+    wxGCDC.
+
+    Display lists can be moved, but not copied.
+
+    @library{wxcore}
+    @category{dc}
+
+    @see wxRecordingDC
+
+    @since 3.3.2
+*/
+class wxDisplayList
+{
+public:
+    /**
+        Default constructor creates an empty list.
+    */
+    wxDisplayList();
+
+    /**
+        Move constructor takes over the contents of another list.
+    */
+    wxDisplayList(wxDisplayList&& other);
+
+    /**
+        Move assignment operator replaces the contents of this list with that
+        of another one.
+    */
+    wxDisplayList& operator=(wxDisplayList&& other);
+
+    /**
+        Return @true if the list doesn't contain any operations.
+    */
+    bool IsEmpty() const;
+
+    /**
+        Return the number of drawing operations in the list.
+    */
+    size_t GetCount() const;
+
+    /**
+        Return the rectangle containing all the drawing operations.
+
+        Operations not limited to any area, such as wxDC::Clear(), are not
+        taken into account.
+    */
+    wxRect GetBoundingBox() const;
+
+    /**
+        Remove all operations from the list.
+    */
+    void Clear();
+
+    /**
+        Draw all operations in the list on the given DC.
+
+        The pen, brush, font and other attributes of the DC, as well as its
+        clipping region, are restored after drawing. Any attributes not set
+        when recording are inherited from the DC, while the clipping regions
+        used when recording are intersected with the one of the DC, if any.
+    */
+    void Replay(wxDC& dc) const;
+
+    /**
+        Draw the operations intersecting the given rectangle on the given DC.
+
+        This function is similar to Replay() but skips all operations which
+        don't affect the given rectangle, which makes it much faster when only
+        a small part of a complex drawing needs to be redrawn. Note that it
+        doesn't clip the output to this rectangle, wxDCClipper can be used to
+        do this if necessary.
+    */
+    void Replay(wxDC& dc, const wxRect& rect) const;
+
+    /**
+        Save the list in binary format to the given stream.
+
+        The bitmaps are saved in device-independent format, however fonts are
+        saved using their attributes and so may look different when the list is
+        loaded on another system.
+
+        @return @true if the list was saved successfully.
+    */
+    bool Save(wxOutputStream& stream) const;
+
+    /**
+        Load the list previously saved by Save() from the given stream.
+
+        The existing contents of the list are replaced by the loaded one if
+        this function succeeds and are left unchanged otherwise.
+
+        @return @true if the list was loaded successfully or @false if the data
+            in the stream is invalid.
+    */
+    bool Load(wxInputStream& stream);
+};
+
+/**
+    @class wxRecordingDC
+
+    wxRecordingDC records all drawing operations performed on it in a
+    wxDisplayList instead of actually drawing them.
+
+    The operations can be later drawn on any other DC using
+    wxDisplayList::Replay().
+
+    This DC doesn't support reading back the pixels drawn on it, i.e.
+    wxDC::GetPixel(), and using it as the source of wxDC::Blit(). When another
+    DC is blitted to this one, its current contents is recorded.
+
+    @library{wxcore}
+    @category{dc}
+
+    @see wxDisplayList
+
+    @since 3.3.2
+*/
+class wxRecordingDC : public wxDC
+{
+public:
+    /**
+        Create a DC recording to the given list.
+
+        The new operations are appended to the existing contents of the list,
+        which must outlive the DC.
+
+        @param list The display list to record the drawing operations to.
+        @param size The size returned by wxDC::GetSize() of this DC, which
+            should normally be the size of the drawing being recorded.
+    */
+    wxRecordingDC(wxDisplayList& list, const wxSize& size);
+};
@@ -45,6 +45,11 @@ enum wxSVGShapeRenderingMode
     as the SVG file, however it is possible to change this behaviour by
     replacing the built in bitmap handler using wxSVGFileDC::SetBitmapHandler().
 
+    The output is buffered and only completely written to the file when the
+    wxSVGFileDC object is destroyed. If the file name has @c .svgz extension,
+    the output is compressed using gzip, as expected for this format (this
+    requires @c wxUSE_ZLIB, which is enabled by default).
+
     More substantial SVG libraries (for reading and writing) are available at
     <a href="http://wxart2d.sourceforge.net/" target="_blank">wxArt2D</a> and
     <a href="http://wxsvg.sourceforge.net/" target="_blank">wxSVG</a>.
@@ -102,6 +107,23 @@ public:
     */
     void SetShapeRenderingMode(wxSVGShapeRenderingMode renderingMode);
 
+    /**
+        Use CSS classes for the styles of the generated graphics groups.
+
+        By default, the stroke and fill style corresponding to the current pen
+        and brush is repeated for every group of elements drawn with them.
+        When this option is enabled, each distinct style is defined only once
+        as a CSS class, which is then referenced by all the groups using it.
+        This makes the output significantly smaller if the same pens and
+        brushes are used many times.
+
+        This option is disabled by default because not all SVG renderers
+        support CSS, notably the one used by wxBitmapBundle::FromSVG() doesn't.
+
+        @since 3.3.2
+    */
+    void EnableStyleClasses(bool enable = true);
+
     /**
         Destroys the current clipping region so that none of the DC is clipped.
         Since intersections arising from sequential calls to SetClippingRegion are represented
@@ -203,6 +203,31 @@ public:
     */
     void DisableAutoSave();
 
+    /**
+        Enables or disables the batch mode.
+
+        In batch mode, writing a value only updates it in memory, while the
+        text of the configuration file is updated only once, when the batch
+        mode is turned off or the file is saved using Flush() or Save(). This
+        can be faster when writing many values.
+
+        The values written in batch mode can be read back immediately and the
+        resulting file contents is exactly the same as if the batch mode were
+        not used.
+
+        @since 3.3.2
+    */
+    void SetBatchMode(bool batch = true);
+
+    /**
+        Returns @true if the batch mode is on.
+
+        @see SetBatchMode()
+
+        @since 3.3.2
+    */
+    bool IsBatchMode() const;
+
     /**
         Allows setting the mode to be used for the config file creation. For example, to
         create a config file which is not readable by other users (useful if it stores
@@ -98,6 +98,41 @@ public:
     virtual bool AddTree(const wxFileName& path, int events = wxFSW_EVENT_ALL,
                          const wxString& filter = wxEmptyString);
 
+    /**
+        This is the same as AddTree(), but doesn't block until the entire tree
+        rooted at @a path is traversed.
+
+        Only @a path itself is watched when this function returns, while its
+        subdirectories are found in a background thread and added
+        progressively, from the main thread event loop, so that the
+        application remains responsive even when adding huge trees. Note that
+        the changes in the subdirectories which haven't been added yet are not
+        reported.
+
+        On the platforms where AddTree() is implemented efficiently, i.e. MSW
+        and macOS, this function just calls it. It also does the same if
+        wxUSE_THREADS is 0 or if the background thread couldn't be started.
+
+        Calling RemoveTree() for @a path or RemoveAll() stops adding the tree.
+
+        @return @true if @a path itself was successfully added.
+
+        @see IsAddingTree()
+
+        @since 3.3.2
+     */
+    virtual bool AddTreeAsync(const wxFileName& path,
+                              int events = wxFSW_EVENT_ALL,
+                              const wxString& filter = wxEmptyString);
+
+    /**
+        Returns @true if any trees passed to AddTreeAsync() are still being
+        added.
+
+        @since 3.3.2
+     */
+    bool IsAddingTree() const;
+
     /**
         Removes @a path from the list of watched paths.
 
@@ -141,6 +176,35 @@ public:
         owner.
      */
     void SetOwner(wxEvtHandler* handler);
+
+    /**
+        Sets the interval during which the repeated events are coalesced.
+
+        When a file is being written to, many modification events are
+        typically generated for it in quick succession. If this interval is
+        positive, wxFSW_EVENT_MODIFY, wxFSW_EVENT_ACCESS and wxFSW_EVENT_ATTRIB
+        events for the same path happening during it are merged into a single
+        event, as are identical consecutive wxFSW_EVENT_RENAME ones, and the
+        resulting events are sent when the interval ends. All the other events
+        are still sent immediately, after sending all the pending coalesced
+        events, so the relative order of the events is preserved.
+
+        This is currently only implemented in the inotify-based version used
+        under Linux and is ignored elsewhere.
+
+        @param milliseconds
+            The interval in milliseconds, 0 (default) disables coalescing.
+
+        @since 3.3.2
+     */
+    void SetCoalescingInterval(int milliseconds);
+
+    /**
+        Returns the interval set by SetCoalescingInterval().
+
+        @since 3.3.2
+     */
+    int GetCoalescingInterval() const;
 };
 
 
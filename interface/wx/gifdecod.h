@@ -7,10 +7,34 @@
 // Licence:     wxWindows licence
 /////////////////////////////////////////////////////////////////////////////
 
+/**
+    Error codes returned by wxGIFDecoder functions.
+*/
+enum wxGIFErrorCode
+{
+    wxGIF_OK = 0,                   ///< Everything was OK.
+    wxGIF_INVFORMAT,                ///< Error in GIF data.
+    wxGIF_MEMERR,                   ///< Error allocating memory.
+    wxGIF_TRUNCATED                 ///< File appears to be truncated.
+};
+
 /**
    @class wxGIFDecoder
 
    An animation decoder supporting animated GIF files.
+
+   By default, all frames are decoded when the animation is loaded, which
+   may require a lot of memory for long animations. EnableLazyDecoding() can
+   be used to only keep the compressed data in memory and decode the frames
+   when they are needed instead. To use this mode for all GIF animations
+   loaded by wxAnimation, enable it for its GIF handler:
+   @code
+   for ( wxAnimationDecoder* decoder : wxAnimation::GetHandlers() )
+   {
+       if ( decoder->GetType() == wxANIMATION_TYPE_GIF )
+           static_cast<wxGIFDecoder*>(decoder)->EnableLazyDecoding();
+   }
+   @endcode
 */
 class  wxGIFDecoder : public wxAnimationDecoder
 {
@@ -19,6 +43,58 @@ public:
     ~wxGIFDecoder();
 
     virtual bool Load( wxInputStream& stream );
+
+    /**
+        Enable or disable decoding the frames only when they are needed.
+
+        When lazy decoding is enabled, loading the animation only stores the
+        compressed data of its frames, which are then decoded when their data
+        is accessed for the first time. At most @a maxCachedFrames decoded
+        frames are kept in memory, with the least recently used ones being
+        discarded and decoded again if they are needed later.
+
+        Note that the errors in the frame data are not detected during
+        loading in this mode, and the frames are decoded as far as possible.
+        ValidateFrames() can be used to detect them.
+
+        This function must be called before loading the animation. Its
+        setting is preserved by Clone(), so it also applies to the animations
+        loaded by wxAnimation if this decoder is used as its handler.
+
+        @since 3.3.2
+    */
+    void EnableLazyDecoding(bool enable = true, unsigned int maxCachedFrames = 4);
+
+    /**
+        Returns @true if lazy decoding is enabled.
+
+        @see EnableLazyDecoding()
+
+        @since 3.3.2
+    */
+    bool IsLazyDecodingEnabled() const;
+
+    /**
+        Checks that the data of all frames is valid.
+
+        In lazy decoding mode, this function decodes all the frames to detect
+        any errors in their data, which are not detected by Load() in this
+        mode. Only the usual number of decoded frames is kept in memory, so
+        this doesn't require more memory than decoding a single frame.
+
+        If lazy decoding is not enabled, the frames are already checked when
+        loading them and this function just returns @c wxGIF_OK.
+
+        @param lastFrame If not -1, the index of the frame to decode after all
+            the other ones, so that it remains in memory and can be accessed
+            without decoding it again.
+        @return @c wxGIF_OK if all the frames are valid or the error code
+            corresponding to the first problem found otherwise.
+
+        @since 3.3.2
+    */
+    wxGIFErrorCode ValidateFrames(int lastFrame = -1);
+
     virtual wxAnimationDecoder *Clone() const;
     virtual wxAnimationType GetType() const;
     virtual bool ConvertToImage(unsigned int frame, wxImage *image) const;
@@ -949,6 +949,47 @@ public:
     */
     void DrawRectangle(const wxRect2DDouble& rect);
 
+    /**
+        Draws many rectangles at once.
+
+        This function is equivalent to calling DrawRectangle() for all the
+        given rectangles, but is much faster when drawing many of them, e.g.
+        for a heat map, as all of them are drawn as a single path if possible.
+
+        Note that all rectangles are filled before outlining any of them with
+        the current pen, so the result may differ from calling DrawRectangle()
+        in a loop if the rectangles overlap.
+
+        @param n
+            The number of rectangles.
+        @param rects
+            Array of @a n rectangles.
+        @param colours
+            If non-null, this array must contain @a n elements and each
+            rectangle is filled with the corresponding colour instead of the
+            current brush, which doesn't need to be set at all in this case.
+
+        @since 3.3.2
+    */
+    virtual void DrawRectangles(size_t n, const wxRect2DDouble* rects,
+                                const wxColour* colours = nullptr);
+
+    /**
+        Draws many points at once.
+
+        Each point is drawn as a 1 by 1 square, in user coordinates, with its
+        top left corner at the given position and filled with the current
+        brush or the corresponding element of @a colours array, if it is
+        non-null. The current pen is not used by this function.
+
+        This is useful for drawing scatter plots with many points, see
+        DrawRectangles() for drawing bigger markers.
+
+        @since 3.3.2
+    */
+    virtual void DrawPoints(size_t n, const wxPoint2DDouble* points,
+                            const wxColour* colours = nullptr);
+
     /**
         Draws a rounded rectangle.
     */
@@ -1063,6 +1104,38 @@ public:
 
     virtual void StrokeLines(size_t n, const wxPoint2DDouble* beginPoints,
                              const wxPoint2DDouble* endPoints);
+
+    /**
+        Stroke disconnected lines from begin to end points using the given
+        pen, optionally with a different colour for each of them.
+
+        This function doesn't use nor change the current pen. If @a colours
+        is null, it is equivalent to calling StrokeLines() after setting the
+        pen created from @a pen, otherwise each segment is stroked with the
+        specified pen using the corresponding colour instead of the pen one.
+
+        The consecutive segments of the same colour are drawn together, so it
+        is more efficient to sort them by colour if the drawing order doesn't
+        matter.
+
+        @param n
+            The number of segments.
+        @param beginPoints
+            Array of @a n starting points.
+        @param endPoints
+            Array of @a n ending points.
+        @param pen
+            The attributes of the pen to use for all segments.
+        @param colours
+            If non-null, array of @a n colours to use for the segments.
+
+        @since 3.3.2
+    */
+    virtual void StrokeSegments(size_t n,
+                                const wxPoint2DDouble* beginPoints,
+                                const wxPoint2DDouble* endPoints,
+                                const wxGraphicsPenInfo& pen,
+                                const wxColour* colours = nullptr);
     /**
         Stroke lines connecting all the points.
 
@@ -1642,6 +1715,47 @@ public:
      */
     wxGraphicsContext* CreateContextFromImage(wxImage& image);
 
+    /**
+        Draws on the image using multiple threads.
+
+        This function splits the image in horizontal bands and draws each of
+        them in parallel by calling the provided @a draw function with a
+        context created for this band only. This can be much faster than
+        drawing on a context returned by CreateContextFromImage() for big
+        images, e.g. when generating high resolution pages of a report, and
+        produces exactly the same result.
+
+        The drawing function is called once for each band and its context is
+        translated so that the function can draw using the same coordinates as
+        for the entire image, with anything outside of the current band being
+        clipped. This means that it must not use
+        wxGraphicsContext::SetTransform() to set an absolute transformation,
+        nor rely on wxGraphicsContext::GetSize() returning the size of the
+        image. Also note that the function is called from several threads
+        concurrently, so it must be thread-safe and, in particular, must not
+        use any pens, brushes, fonts or other objects shared with the other
+        calls, including the stock objects such as ::wxBLACK_PEN or ::wxWHITE:
+        all of them need to be created inside the function. The
+        contexts themselves are created in the calling thread, which should
+        be the main one, as creating them may need to use the GUI toolkit.
+
+        If the image is too small to be split in several bands or @a numThreads
+        is 1, this function simply calls @a draw with a context for the entire
+        image in the current thread.
+
+        @param image The image to draw on.
+        @param draw The function performing the drawing.
+        @param numThreads The maximal number of threads to use, including the
+            current one. By default, the number of CPUs is used.
+        @return @true if the image was drawn successfully, @false if creating
+            any of the contexts failed.
+
+        @since 3.3.2
+     */
+    bool RenderImageInBands(wxImage& image,
+                            const std::function<void (wxGraphicsContext&)>& draw,
+                            int numThreads = 0);
+
     /**
         Creates a native brush from a wxBrush.
     */
@@ -399,6 +399,25 @@ public:
     */
     virtual void Layout(int w);
 
+    /**
+        Returns @true if the result of Layout() may depend on the width passed
+        to it.
+
+        wxHtmlContainerCell remembers the result of its last layout and, when
+        it is laid out again with a different width, only lays out again the
+        cells for which this function returns @true. If their size doesn't
+        change and the lines of the container are broken at the same places,
+        the previous layout is reused, which makes resizing big documents much
+        faster.
+
+        The default implementation returns @true, which is always safe. It
+        should be overridden to return @false in the custom cells whose size
+        is fixed and which don't contain any other cells.
+
+        @since 3.3.2
+    */
+    virtual bool IsLayoutWidthDependent() const;
+
     /**
         This function is simple event handler.
         Each time the user clicks mouse button over a cell within wxHtmlWindow
@@ -530,6 +549,9 @@ public:
 
         Note that the container takes ownership of the cell and will delete it
         when it itself is destroyed.
+
+        If the container had been already laid out, only its last lines are
+        laid out again by the next call to Layout() with the same width.
     */
     void InsertCell(wxHtmlCell* cell);
 
@@ -623,6 +645,10 @@ public:
             This parameter is one of @c wxHTML_ALIGN_TOP, @c wxHTML_ALIGN_BOTTOM,
             @c wxHTML_ALIGN_CENTER. It refers to the contents, not to the
             empty place.
+
+        Since wxWidgets 3.3.2, changing the minimal height doesn't require
+        laying out the contents of the container again, they are just moved
+        vertically if necessary when Layout() is called.
     */
     void SetMinHeight(int h, int align = wxHTML_ALIGN_TOP);
 
@@ -248,6 +248,25 @@ public:
     */
     wxObject* Parse(const wxString& source);
 
+    /**
+        Parses HTML fragment appended to the previously parsed document.
+
+        This method works like Parse() but only parses the given fragment,
+        which is appended to the source of the document previously parsed by
+        Parse() or this method, i.e. GetSource() returns the entire document
+        after calling it. This allows to avoid parsing the entire document
+        again when adding more contents to it, which is what
+        wxHtmlWindow::AppendToPage() does.
+
+        Notice that the fragment is parsed independently of the previous
+        source, so the tags left open in it don't affect the fragment.
+
+        @return The product of parsing the fragment only.
+
+        @since 3.3.2
+    */
+    wxObject* ParseAppended(const wxString& source);
+
     /**
         Restores parser's state before last call to PushTagHandler().
     */
@@ -187,6 +187,15 @@ public:
     /**
         Appends HTML fragment to currently displayed text and refreshes the window.
 
+        Since wxWidgets 3.3.2, only the new fragment is parsed and laid out,
+        so calling this function repeatedly, e.g. to show log messages, takes
+        time proportional to the size of the appended text and not to the size
+        of the entire page.
+        The text at the beginning of the fragment continues the last
+        paragraph of the page, however note that the fragment is parsed
+        independently and so any tags left open in the existing page, e.g.
+        @c \<b\> or @c \<font\>, don't affect it.
+
         @param source
             HTML code fragment
 
@@ -148,7 +148,9 @@ enum wxImagePNGType
 #define wxIMAGE_OPTION_PNG_COMPRESSION_MEM_LEVEL        wxString("PngZM")
 #define wxIMAGE_OPTION_PNG_COMPRESSION_STRATEGY         wxString("PngZS")
 #define wxIMAGE_OPTION_PNG_COMPRESSION_BUFFER_SIZE      wxString("PngZB")
+#define wxIMAGE_OPTION_PNG_COMPRESSION_THREADS          wxString("PngZT")
 #define wxIMAGE_OPTION_PNG_DESCRIPTION                  wxString("PngDescription")
+#define wxIMAGE_OPTION_PNG_FAST                         wxString("PngFast")
 
 #define wxIMAGE_OPTION_TIFF_BITSPERSAMPLE               wxString("BitsPerSample")
 #define wxIMAGE_OPTION_TIFF_SAMPLESPERPIXEL             wxString("SamplesPerPixel")
@@ -175,6 +177,53 @@ enum
 };
 
 
+/**
+    @class wxImageRowsReceiver
+
+    Abstract base class for the objects receiving the rows of an image while
+    it is being loaded by wxImageHandler::LoadFileRows().
+
+    This allows displaying or processing the image progressively, as it is
+    being decoded, instead of waiting until it is fully loaded.
+
+    @library{wxcore}
+    @category{gdi}
+
+    @since 3.3.2
+*/
+class wxImageRowsReceiver
+{
+public:
+    /// Default constructor.
+    wxImageRowsReceiver();
+
+    /// Trivial but virtual destructor.
+    virtual ~wxImageRowsReceiver();
+
+    /**
+        Called when the given rows of the image have been decoded.
+
+        The rows are always passed in top to bottom order and each row is
+        passed exactly once. The @a image has its final size, but only the
+        rows up to @c firstRow+numRows are valid, the contents of the
+        remaining ones is undefined.
+
+        Note that the alpha channel may be added to the image only when the
+        first non-opaque pixel is decoded, in which case all the rows passed
+        to this function before were fully opaque. Also note that the image
+        options, such as its resolution, are only set after loading it
+        completely.
+
+        @param image The image being loaded.
+        @param firstRow The index of the first row which has been decoded.
+        @param numRows The number of decoded rows, always positive.
+        @return @true to continue loading the image or @false to cancel it,
+            in which case wxImageHandler::LoadFileRows() returns @false.
+    */
+    virtual bool OnRows(const wxImage& image, int firstRow, int numRows) = 0;
+};
+
+
 /**
     @class wxImageHandler
 
@@ -316,6 +365,44 @@ public:
     virtual bool LoadFile(wxImage* image, wxInputStream& stream,
                           bool verbose = true, int index = -1);
 
+    /**
+        Loads an image from a stream, passing its rows to the receiver as
+        they are decoded.
+
+        This function is similar to LoadFile(), but calls
+        wxImageRowsReceiver::OnRows() with the rows of the image decoded so
+        far while it is being loaded. Loading can be cancelled by returning
+        @false from it.
+
+        PNG, JPEG and TIFF handlers decode the images progressively, in
+        bands of rows, without allocating an intermediate buffer of the size
+        of the full image when possible, but interlaced PNG images and TIFF
+        images not stored in top to bottom order are still passed to the
+        receiver all at once. The default implementation of this function,
+        used by the other handlers, just calls LoadFile() and then passes all
+        the rows of the image to the receiver.
+
+        @param image
+            The image object which is to be affected by this operation.
+        @param stream
+            Opened input stream for reading image data.
+        @param receiver
+            The object receiving the decoded rows.
+        @param verbose
+            If set to @true, errors reported by the image handler will produce
+            wxLogMessages.
+        @param index
+            The index of the image in the file (starting from zero).
+
+        @return @true if the operation succeeded, @false if it failed or was
+            cancelled.
+
+        @since 3.3.2
+    */
+    virtual bool LoadFileRows(wxImage* image, wxInputStream& stream,
+                              wxImageRowsReceiver& receiver,
+                              bool verbose = true, int index = -1);
+
     /**
         Saves an image in the output stream.
 
@@ -793,6 +880,24 @@ public:
     */
     bool Create( const wxSize& sz, unsigned char* data, unsigned char* alpha, bool static_data = false );
 
+    /**
+        Creates a fresh image using packed storage mode.
+
+        The image is created with an alpha channel and, if @a clear is @true,
+        all its pixels are initialized to transparent black. Use
+        GetPackedData() to access them.
+
+        @return @true if the call succeeded, @false otherwise.
+
+        @since 3.3.2
+    */
+    bool CreatePacked(int width, int height, bool clear = true);
+
+    /**
+        @overload
+    */
+    bool CreatePacked(const wxSize& sz, bool clear = true);
+
     /**
         Initialize the image data with zeroes (the default) or with the
         byte value given as @a value.
@@ -1235,6 +1340,15 @@ public:
         This pointer is @NULL for the images without the alpha channel. If the image
         does have it, this pointer may be used to directly manipulate the alpha values
         which are stored as the RGB ones.
+
+        If the image uses packed storage mode, the non-const overload converts
+        it back to the default storage, while the const one only creates a
+        copy of its data in this storage, see GetPackedData().
+    */
+    unsigned char* GetAlpha();
+
+    /**
+        @overload
     */
     unsigned char* GetAlpha() const;
 
@@ -1249,9 +1363,77 @@ public:
         row, with second row following after it and so on.
 
         You should not delete the returned pointer nor pass it to SetData().
+
+        If the image uses packed storage mode, it is converted back to the
+        default storage by the non-const overload of this function, while the
+        const one only creates a copy of its data in this storage, see
+        GetPackedData().
+
+        @see GetPackedData()
+    */
+    unsigned char* GetData();
+
+    /**
+        @overload
     */
     unsigned char* GetData() const;
 
+    /**
+        Returns the image data in packed storage mode, converting the image to
+        it if necessary.
+
+        By default, wxImage stores RGB values and the alpha channel, if any, in
+        two separate arrays returned by GetData() and GetAlpha(). In packed
+        storage mode, each pixel is stored as a single native-endian 32-bit
+        value with alpha in the upper 8 bits followed by red, green and blue
+        components, which are premultiplied by alpha, in the same order as
+        described in GetData(). Opaque images have all alpha values set to
+        255.
+
+        This is the format used by Cairo and native bitmaps on several
+        platforms, so using it avoids converting the image data every time a
+        wxBitmap or wxGraphicsBitmap is created from the image, as its data
+        can be used directly instead. This is currently done by wxGTK 3 and
+        Cairo-based wxGraphicsContext for the images without a mask, and Cairo
+        wxGraphicsContext created for such image also draws directly on its
+        data.
+
+        All the other non-const functions accessing the pixels data, including
+        GetData() and GetAlpha(), convert the image back to the default
+        storage, which is lossy for partially transparent pixels, and the alpha
+        channel is created at that time if any pixel is not opaque. The const
+        functions, such as GetRed(), don't change the storage mode, as they
+        can be called from several threads at once, but create a copy of the
+        data in the default storage which is kept until the image is modified,
+        so the pointers returned by the const overloads of GetData() and
+        GetAlpha() must not be used for modifying it. Functions only
+        returning the image attributes, such as GetSize(), HasAlpha() or
+        HasMask(), don't change the storage mode. Note that, as the returned
+        data can be modified, HasAlpha() returns @true for the image after
+        calling this function, until it's converted back to the default
+        storage.
+
+        The returned pointer can be used to modify the image data until the
+        storage mode is changed and must not be deleted.
+
+        @return Pointer to the data of GetWidth() times GetHeight() pixels or
+            @NULL if the image is invalid or memory allocation failed.
+
+        @see IsPacked(), CreatePacked()
+
+        @since 3.3.2
+    */
+    wxUint32* GetPackedData();
+
+    /**
+        Returns @true if the image currently uses packed storage mode.
+
+        @see GetPackedData()
+
+        @since 3.3.2
+    */
+    bool IsPacked() const;
+
     /**
         Return alpha value at given pixel location.
     */
@@ -1361,8 +1543,11 @@ public:
             one right now) support rescaling the image during loading which is
             vastly more efficient than loading the entire huge image and
             rescaling it later (if these options are not supported by the
-            handler, this is still what happens however). These options must be
-            set before calling LoadFile() to have any effect.
+            handler, this is still what happens however). The JPEG handler
+            decodes the image directly at the biggest scale, in multiples of
+            1/8, at which it fits, if supported by the libjpeg version used.
+            These options must be set before calling LoadFile() to have any
+            effect.
 
         @li @c wxIMAGE_OPTION_ORIGINAL_WIDTH and @c wxIMAGE_OPTION_ORIGINAL_HEIGHT:
             These options will return the original size of the image if either
@@ -1412,6 +1597,21 @@ public:
             (in bytes) for saving a PNG file. Ideally this should be as big as
             the resulting PNG file. Use this option if your application produces
             images with small size variation.
+        @li @c wxIMAGE_OPTION_PNG_COMPRESSION_THREADS: Number of threads to
+            use for compressing the image data when saving a PNG file, 0 means
+            using as many threads as there are CPUs. The default is 1, i.e.
+            compression is not done in parallel. When using multiple threads,
+            the image is split into bands of rows compressed independently,
+            which results in slightly bigger files and ignores
+            @c wxIMAGE_OPTION_PNG_COMPRESSION_BUFFER_SIZE. It is also only used for
+            images with the bit depth of 8 (which is the default). This option
+            is available since wxWidgets 3.3.2.
+        @li @c wxIMAGE_OPTION_PNG_FAST: If non-zero, save the PNG file as fast
+            as possible instead of trying to make it as small as possible. This
+            changes the defaults of compression level, filter and strategy to
+            the fastest ones, but these options can still be specified
+            explicitly to override them. This option is available since
+            wxWidgets 3.3.2.
 
         Options specific to wxTIFFHandler:
         @li @c wxIMAGE_OPTION_TIFF_BITSPERSAMPLE: Number of bits per
@@ -1579,7 +1779,12 @@ public:
             @li wxBITMAP_TYPE_CUR: Load a Windows cursor file (CUR).
             @li wxBITMAP_TYPE_ANI: Load a Windows animated cursor file (ANI).
             @li wxBITMAP_TYPE_WEBP: Load a WebP file.
-            @li wxBITMAP_TYPE_ANY: Will try to autodetect the format.
+            @li wxBITMAP_TYPE_ANY: Will try to autodetect the format. Since
+                wxWidgets 3.3.2, the header of the image is read only once and,
+                if it contains the signature of one of the standard formats,
+                the handler for this format is tried first, before asking all
+                the other handlers, in their registration order, whether they
+                can read the image.
         @param index
             Index of the image to load in the case that the image file contains
             multiple images. This is only used by GIF, ICO, TIFF and WebP handlers.
@@ -2037,6 +2242,14 @@ public:
     /**
         Returns the static list of image format handlers.
 
+        Note that the list should only be modified using AddHandler(),
+        InsertHandler() and RemoveHandler(), as FindHandler() and
+        FindHandlerMime() use an index of the handlers by their type, extension
+        and MIME type which is only updated by these functions. If handlers are
+        added to the list directly, or removed from it and deleted, these
+        functions fall back to searching it linearly until the index is
+        updated by the next call to one of the functions above.
+
         @see wxImageHandler
     */
     static wxList& GetHandlers();
@@ -12,7 +12,9 @@
 #define wxIMAGE_OPTION_PNG_COMPRESSION_MEM_LEVEL    wxT("PngZM")
 #define wxIMAGE_OPTION_PNG_COMPRESSION_STRATEGY     wxT("PngZS")
 #define wxIMAGE_OPTION_PNG_COMPRESSION_BUFFER_SIZE  wxT("PngZB")
+#define wxIMAGE_OPTION_PNG_COMPRESSION_THREADS      wxT("PngZT")
 #define wxIMAGE_OPTION_PNG_DESCRIPTION              wxT("PngDescription")
+#define wxIMAGE_OPTION_PNG_FAST                     wxT("PngFast")
 
 /* These are already in interface/wx/image.h
     They were likely put there as a stopgap, but they've been there long enough
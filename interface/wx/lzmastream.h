@@ -60,6 +60,37 @@ public:
         delete it when it is itself destroyed.
      */
     wxLZMAInputStream(wxInputStream* stream);
+
+    /**
+        Create decompressing stream using multiple threads.
+
+        Using multiple threads can significantly speed up decompression of big
+        files, but only if they were compressed using multiple threads too, as
+        done by wxLZMAOutputStream when using this option, as this results in
+        splitting the data into several blocks which can then be decompressed
+        independently. For the files consisting of a single block, using this
+        constructor is equivalent to using the single-threaded version.
+
+        Multithreaded decompression requires liblzma 5.4.0 or later, when
+        using an older version, @a threads and @a memlimit are simply ignored.
+
+        @param stream
+            The underlying stream, the ownership of which is taken if it is
+            passed by pointer, as in the overloads above.
+        @param threads
+            The number of threads to use or 0 to use as many threads as there
+            are CPUs in the system.
+        @param memlimit
+            If non-zero, the memory limit in bytes after exceeding which the
+            number of threads is reduced (possibly to a single one). Notice
+            that decompression never fails because of exceeding this limit.
+
+        @since 3.3.2
+     */
+    wxLZMAInputStream(wxInputStream& stream, int threads, wxUint64 memlimit = 0);
+
+    /// @overload
+    wxLZMAInputStream(wxInputStream* stream, int threads, wxUint64 memlimit = 0);
 };
 
 /**
@@ -101,6 +132,39 @@ class wxLZMAOutputStream : public wxFilterOutputStream
         delete it when it is itself destroyed.
      */
     wxLZMAOutputStream(wxOutputStream* stream);
+
+    /**
+        Create compressing stream using multiple threads.
+
+        The data is split into blocks which are compressed in parallel, which
+        is much faster than single-threaded compression, but results in
+        slightly bigger output. As an additional benefit, the data compressed
+        in this way can be decompressed using multiple threads too, see
+        wxLZMAInputStream.
+
+        Multithreaded compression requires liblzma 5.2.0 or later and, if it
+        is not available, single-threaded compression is used instead.
+
+        @param stream
+            The underlying stream, the ownership of which is taken if it is
+            passed by pointer, as in the overloads above.
+        @param level
+            Compression level from 0 to 9 or -1 to use the default level.
+        @param threads
+            The number of threads to use or 0 to use as many threads as there
+            are CPUs in the system.
+        @param memlimit
+            If non-zero, the number of threads is reduced until the memory
+            needed for compression doesn't exceed this limit.
+
+        @since 3.3.2
+     */
+    wxLZMAOutputStream(wxOutputStream& stream, int level, int threads,
+                       wxUint64 memlimit = 0);
+
+    /// @overload
+    wxLZMAOutputStream(wxOutputStream* stream, int level, int threads,
+                       wxUint64 memlimit = 0);
 };
 
 /**
@@ -5,6 +5,40 @@
 // Licence:     wxWindows licence
 /////////////////////////////////////////////////////////////////////////////
 
+/// Reserve room for the 20 standard Windows colours in the palette.
+#define wxQUANTIZE_INCLUDE_WINDOWS_COLOURS      0x01
+
+/// Return the palette indices in the @c eightBitData parameter.
+#define wxQUANTIZE_RETURN_8BIT_DATA             0x02
+
+/// Fill the destination image with the quantized colours.
+#define wxQUANTIZE_FILL_DESTINATION_IMAGE       0x04
+
+/**
+    Use the faster quantization engine.
+
+    By default, the median cut algorithm from IJG JPEG library is used. With
+    this flag, an octree of the image colours is used for building the palette
+    instead and the nearest palette entries are looked up using a cache, which
+    is typically faster for big images and often gives better results.
+
+    @since 3.3.2
+*/
+#define wxQUANTIZE_FAST                         0x08
+
+/**
+    Don't use Floyd-Steinberg dithering when mapping the image colours to the
+    palette.
+
+    Dithering is used by default, as it significantly improves the appearance
+    of the images with smooth gradients, but disabling it makes quantization
+    faster and may be preferable for the images which will be compressed, as
+    dithered images compress much worse.
+
+    @since 3.3.2
+*/
+#define wxQUANTIZE_NO_DITHERING                 0x10
+
 /**
     @class wxQuantize
 
@@ -36,12 +70,28 @@ public:
                            unsigned char** in_rows, unsigned char** out_rows,
                            unsigned char* palette, int desiredNoColours);
 
+    /**
+        Same as the overload above, but allows specifying @c wxQUANTIZE_FAST
+        and @c wxQUANTIZE_NO_DITHERING flags to select the quantization engine
+        and disable dithering, all the other flags are ignored.
+
+        @since 3.3.2
+    */
+    static void DoQuantize(unsigned int w, unsigned int h,
+                           unsigned char** in_rows, unsigned char** out_rows,
+                           unsigned char* palette, int desiredNoColours,
+                           int flags);
+
     /**
         Reduce the colours in the source image and put the result into the destination image.
         Both images may be the same, to overwrite the source image.
 
         Specify an optional palette pointer to receive the resulting palette.
         This palette may be passed to ConvertImageToBitmap, for example.
+
+        @a flags is a combination of @c wxQUANTIZE_XXX constants, notably
+        @c wxQUANTIZE_FAST can be included in them to use the faster
+        quantization engine.
     */
     static bool Quantize(const wxImage& src, wxImage& dest,
                          wxPalette** pPalette, int desiredNoColours = 236,
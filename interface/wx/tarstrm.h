@@ -91,6 +91,166 @@ public:
         seekable stream.
     */
     bool OpenEntry(wxTarEntry& entry);
+
+    /**
+        Closes the current entry if one is open, then opens the entry with the
+        given @a name using the offsets stored in the @a index.
+
+        This allows to access any entry directly, without reading the headers
+        of all the preceding entries. The @a index must have been built for
+        this tar file, and the tar should be on a seekable stream.
+
+        Returns @false if there is no entry with this name in the index or if
+        it couldn't be opened.
+
+        @since 3.3.2
+    */
+    bool OpenEntry(const wxTarIndex& index, const wxString& name,
+                   wxPathFormat format = wxPATH_NATIVE);
+};
+
+
+
+/**
+    @class wxTarIndex
+
+    Catalog of all the entries of a tar file, allowing to open any of them
+    directly using wxTarInputStream::OpenEntry().
+
+    Reading an entry from a tar normally requires reading the headers of all
+    the entries preceding it, which can be slow for big archives. The index
+    can be built once, using Build(), and then saved to a sidecar file, using
+    Save(), so that it can be loaded much faster later, using Load(). By
+    convention, the sidecar file has the name returned by GetIndexName() and
+    wxArchiveFSHandler uses it, if it exists and IsUpToDate() returns @true
+    for the archive, instead of reading the archive headers.
+
+    Example of building the index:
+    @code
+        wxFFileInputStream in(tarName);
+        wxTarIndex index;
+        if ( index.Build(in) )
+        {
+            wxFFileOutputStream out(wxTarIndex::GetIndexName(tarName));
+            index.Save(out);
+        }
+    @endcode
+
+    And of using it:
+    @code
+        wxFFileInputStream in(tarName);
+        wxFFileInputStream indexIn(wxTarIndex::GetIndexName(tarName));
+        wxTarIndex index;
+        if ( index.Load(indexIn, in.GetLength()) && index.IsUpToDate(in) )
+        {
+            wxTarInputStream tar(in);
+            if ( tar.OpenEntry(index, "some/file.txt") )
+                ... read the entry data from tar ...
+        }
+    @endcode
+
+    @library{wxbase}
+    @category{archive,streams}
+
+    @see @ref overview_archive, wxTarEntry, wxTarInputStream
+
+    @since 3.3.2
+*/
+class wxTarIndex
+{
+public:
+    /**
+        Creates an empty index.
+    */
+    wxTarIndex();
+
+    /**
+        Builds the index by reading all the headers of the tar from the given
+        stream, which must be positioned at the start of the archive.
+
+        The stream should be seekable to avoid reading the data of the entries.
+
+        Returns @false if the tar couldn't be read, the index is empty then.
+    */
+    bool Build(wxInputStream& stream, wxMBConv& conv = wxConvLocal);
+
+    /**
+        Saves the index to the given stream.
+    */
+    bool Save(wxOutputStream& stream) const;
+
+    /**
+        Loads the index previously saved by Save().
+
+        If @a archiveSize is specified, the index is only loaded if it was
+        built for a tar of this size, which allows to detect stale indices.
+
+        Returns @false if the index couldn't be loaded, the index is empty
+        then.
+
+        @see IsUpToDate()
+    */
+    bool Load(wxInputStream& stream,
+              wxFileOffset archiveSize = wxInvalidOffset);
+
+    /**
+        Checks whether the index corresponds to the tar in the given stream.
+
+        The size of the archive must be the same as the size of the tar the
+        index was built for and the header of the last entry in the archive
+        must be unchanged. This detects the archives modified after building
+        the index, including the ones whose size didn't change.
+
+        The @a stream must be seekable and its length must be known, otherwise
+        @false is returned. Its current position is preserved.
+
+        Note that an index built by Build() from a non-seekable stream doesn't
+        contain the header of the last entry and so this function always
+        returns @false for it, unless the tar is empty.
+    */
+    bool IsUpToDate(wxInputStream& stream) const;
+
+    /**
+        Returns the name of the sidecar index file for the given tar file.
+
+        This is just @a tarName with the @c .idx extension appended to it.
+    */
+    static wxString GetIndexName(const wxString& tarName);
+
+    /**
+        Removes all entries from the index.
+    */
+    void Clear();
+
+    /**
+        Returns @true if the index has no entries.
+    */
+    bool IsEmpty() const;
+
+    /**
+        Returns the number of entries in the index.
+    */
+    size_t GetCount() const;
+
+    /**
+        Returns the entry with the given index, which must be less than
+        GetCount().
+
+        The entries are in the same order as in the tar.
+    */
+    const wxTarEntry& GetEntry(size_t n) const;
+
+    /**
+        Returns the size of the tar the index was built for or
+        ::wxInvalidOffset if it is unknown.
+    */
+    wxFileOffset GetArchiveSize() const;
+
+    /**
+        Returns the entry with the given name or @NULL if there is none.
+    */
+    const wxTarEntry* Find(const wxString& name,
+                           wxPathFormat format = wxPATH_NATIVE) const;
 };
 
 
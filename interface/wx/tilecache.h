@@ -0,0 +1,184 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tilecache.h
+// Purpose:     interface of wxTileCache
+// Author:      wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+    @class wxTileCache
+
+    This class caches the contents of a custom-drawn window in bitmap tiles,
+    allowing to repaint it without redrawing the parts which didn't change.
+
+    Unlike wxBufferedPaintDC, which only avoids flicker, this class keeps the
+    rendered contents between the paint events. The tiles are indexed by
+    their position in logical coordinates, so that the contents remains valid
+    when the window is scrolled and the newly exposed areas of the window can
+    often be painted by just blitting the already existing tiles.
+
+    To use this class, derive from it and override its DrawTile() function to
+    draw the given part of the window contents, then call PaintUpdateRegion()
+    from the window paint event handler:
+    @code
+    class MyCanvas : public wxScrolled<wxWindow>
+    {
+    public:
+        MyCanvas(wxWindow* parent)
+            : wxScrolled<wxWindow>(parent),
+              m_cache(this)
+        {
+            Bind(wxEVT_PAINT, [this](wxPaintEvent&) {
+                wxPaintDC dc(this);
+                DoPrepareDC(dc);
+                m_cache.PaintUpdateRegion(dc, this);
+            });
+        }
+
+        void UpdateItem(const wxRect& rect)
+        {
+            ... change the data shown in the given logical rectangle ...
+
+            m_cache.Invalidate(rect);
+            RefreshRect(wxRect(CalcScrolledPosition(rect.GetPosition()),
+                               rect.GetSize()));
+        }
+
+    private:
+        class Cache : public wxTileCache
+        {
+        public:
+            explicit Cache(MyCanvas* canvas) : m_canvas(canvas) { }
+
+        protected:
+            void DrawTile(wxDC& dc, const wxRect& rect) override
+            {
+                ... draw the contents of the given rectangle ...
+            }
+
+        private:
+            MyCanvas* const m_canvas;
+        };
+
+        Cache m_cache;
+    };
+    @endcode
+
+    Note that the DC passed to Paint() or PaintUpdateRegion() is supposed to
+    not use any user scale, i.e. one logical unit must correspond to one
+    device unit, otherwise the tiles are not drawn correctly.
+
+    @library{wxcore}
+    @category{dc}
+
+    @see wxBufferedPaintDC
+
+    @since 3.3.2
+*/
+class wxTileCache
+{
+public:
+    /**
+        Create the cache using tiles of the given size.
+
+        @param tileSize The size of each tile in logical coordinates, must be
+            strictly positive.
+        @param maxTiles The maximal number of tiles to keep, see SetMaxTiles().
+    */
+    explicit wxTileCache(const wxSize& tileSize = wxSize(256, 256),
+                         size_t maxTiles = 256);
+
+    /**
+        Destructor frees all the tiles.
+    */
+    virtual ~wxTileCache();
+
+    /**
+        Change the size of the tiles.
+
+        Calling this function discards all the currently cached tiles if the
+        size changes.
+    */
+    void SetTileSize(const wxSize& tileSize);
+
+    /**
+        Returns the size of the tiles.
+    */
+    wxSize GetTileSize() const;
+
+    /**
+        Set the maximal number of tiles kept in the cache.
+
+        When there are more tiles, the least recently painted ones are
+        discarded and will be drawn again if they become visible later. Note
+        that the tiles needed for the area being currently painted are never
+        discarded, so there may be temporarily more tiles than this number if
+        it is too small to cover the entire window.
+    */
+    void SetMaxTiles(size_t maxTiles);
+
+    /**
+        Returns the maximal number of tiles kept in the cache.
+    */
+    size_t GetMaxTiles() const;
+
+    /**
+        Mark the given part of the window as needing to be redrawn.
+
+        Only the specified rectangle, in logical coordinates, will be drawn
+        again when it is painted the next time. Note that this function does
+        not refresh the window itself, wxWindow::RefreshRect() still needs to
+        be called to repaint it.
+    */
+    void Invalidate(const wxRect& rect);
+
+    /**
+        Mark the entire contents of the window as needing to be redrawn.
+
+        This is similar to Clear() but keeps the tile bitmaps, allowing them
+        to be reused.
+    */
+    void InvalidateAll();
+
+    /**
+        Discard all the cached tiles.
+    */
+    void Clear();
+
+    /**
+        Draw the given rectangle on the provided DC.
+
+        The tiles intersecting the rectangle are drawn by calling DrawTile()
+        if they don't exist yet or were invalidated and then blitted to the
+        DC.
+
+        @param dc The DC to draw on, prepared for using logical coordinates.
+        @param rect The rectangle to draw, in logical coordinates.
+    */
+    void Paint(wxDC& dc, const wxRect& rect);
+
+    /**
+        Draw all rectangles of the update region of the given window.
+
+        This function is typically called from wxEVT_PAINT handler, with the
+        wxPaintDC for which wxScrolled::DoPrepareDC() had been already called
+        if the window is scrolled.
+    */
+    void PaintUpdateRegion(wxDC& dc, const wxWindow* window);
+
+protected:
+    /**
+        Draw the given part of the window contents.
+
+        This function must be overridden to draw everything inside the given
+        rectangle, including the background: the tiles are not cleared before
+        calling it, so any part of the rectangle not painted by it keeps the
+        previous contents of the tile, which may be garbage for a new tile.
+
+        @param dc The DC to draw on, which uses the same logical coordinates
+            as the DC passed to Paint() and is clipped to @a rect. It has the
+            same font and colours as that DC.
+        @param rect The rectangle to draw, in logical coordinates.
+    */
+    virtual void DrawTile(wxDC& dc, const wxRect& rect) = 0;
+};
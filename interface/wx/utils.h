@@ -1398,6 +1398,41 @@ long wxExecute(const wxString& command, wxArrayString& output,
                 wxArrayString& errors, int flags = 0,
                 const wxExecuteEnv *env = nullptr);
 
+/**
+    Executes several commands asynchronously using the same options.
+
+    This function is equivalent to calling wxExecute(const wxString&,int,wxProcess*)
+    for each of the elements of @a commands, but can be more efficient, as the
+    options common to all the commands are only processed once. Under Unix
+    systems supporting it, @c posix_spawnp() is used to launch the processes,
+    which is much faster than @c fork() used by default for the programs using
+    a lot of memory.
+
+    Notice that wxExecute() itself also uses @c posix_spawnp() when possible,
+    so there is no need to use this function for launching a single process.
+
+    @param commands
+        The commands to execute, each of them being a command and its
+        parameters as a single string.
+    @param flags
+        Same as for wxExecute(const wxString&,int,wxProcess*) overload, but
+        must not include ::wxEXEC_SYNC.
+    @param env
+        An optional pointer to additional parameters for all the child
+        processes, such as their initial working directory and environment
+        variables.
+    @return
+        Vector of the same size as @a commands containing the PIDs of the
+        launched processes or 0 for the commands that couldn't be launched.
+
+    @since 3.3.2
+
+    @header{wx/utils.h}
+*/
+std::vector<long> wxExecuteBatch(const wxArrayString& commands,
+                                 int flags = wxEXEC_ASYNC,
+                                 const wxExecuteEnv* env = nullptr);
+
 /**
     Returns the number uniquely identifying the current process in the system.
     If an error occurs, 0 is returned.
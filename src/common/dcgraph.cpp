@@ -21,10 +21,18 @@
     #include "wx/dcmemory.h"
     #include "wx/math.h"
     #include "wx/geometry.h"
+    #include "wx/module.h"
 #endif
 
 #include "wx/display.h"
+#include "wx/hashmap.h"
+#include "wx/image.h"
 #include "wx/scopedarray.h"
+#include "wx/thread.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
 
 //-----------------------------------------------------------------------------
 // Local functions
@@ -70,6 +78,326 @@ static wxCompositionMode TranslateRasterOp(wxRasterOperationMode function)
     return wxCOMPOSITION_INVALID;
 }
 
+//-----------------------------------------------------------------------------
+// Glyph cache
+//-----------------------------------------------------------------------------
+
+static wxGCDCGlyphCacheStats gs_glyphCacheStats;
+
+#if wxUSE_IMAGE
+
+// Return true if the character can be drawn on its own, independently of the
+// surrounding ones, i.e. doesn't require any complex shaping, such as joining
+// Arabic letters or combining marks, or bidirectional text handling.
+static bool IsSimpleGlyph(wxUniChar ch)
+{
+    const wxUint32 c = ch.GetValue();
+
+    return (c >= 0x20 && c < 0x7f) ||       // ASCII
+           (c >= 0xa0 && c < 0x300) ||      // Latin-1 and Latin Extended
+           (c >= 0x370 && c < 0x483) ||     // Greek and Cyrillic...
+           (c >= 0x48a && c < 0x530) ||     // ... without combining marks
+           (c >= 0x1e00 && c < 0x2000) ||   // Latin and Greek Extended
+           (c >= 0x2010 && c < 0x2028) ||   // General Punctuation...
+           (c >= 0x2030 && c < 0x205f) ||   // ... without bidi controls
+           (c >= 0x20a0 && c < 0x20c0) ||   // Currency Symbols
+           (c >= 0x2100 && c < 0x2c00) ||   // Various symbols
+           (c >= 0x3000 && c < 0x302a) ||   // CJK Punctuation and Kana...
+           (c >= 0x3030 && c < 0x3099) ||   // ... without combining tone...
+           (c >= 0x309b && c < 0x3100) ||   // ... and voicing marks
+           (c >= 0x4e00 && c < 0xa000) ||   // CJK Unified Ideographs
+           (c >= 0xff01 && c < 0xff61);     // Fullwidth Forms
+}
+
+// Rasterized glyphs of a single font in a single colour.
+//
+// The glyphs are rasterized in batches on a single image, which is then split
+// into the bitmaps used for the individual glyphs, and then drawn at the
+// positions determined by their advance widths, i.e. without kerning.
+class wxGCDCGlyphAtlas
+{
+public:
+    struct Glyph
+    {
+        // Null for the glyphs without any pixels, e.g. spaces.
+        wxGraphicsBitmap bitmap;
+
+        // Offset of the pen position after drawing this glyph.
+        double advance = 0;
+
+        // Size of the bitmap in logical coordinates.
+        double width = 0;
+    };
+
+    wxGCDCGlyphAtlas(wxGraphicsRenderer* renderer,
+                     const wxFont& font,
+                     const wxColour& colour,
+                     double scale);
+
+    bool IsOk() const { return m_measuringContext != nullptr; }
+
+    // Ensure that all the glyphs of the given string are in the atlas,
+    // return false if it is full.
+    bool AddGlyphs(const wxString& str);
+
+    // Can only be called for the characters passed to AddGlyphs() before.
+    const Glyph& GetGlyph(wxUniChar ch) const
+    {
+        return m_glyphs.find(ch.GetValue())->second;
+    }
+
+    double GetHeight() const { return m_height; }
+
+    // Offset of the glyph origin in its bitmap.
+    double GetPadding() const { return m_padding; }
+
+private:
+    // Rasterize the given characters, which must not be in the atlas yet.
+    bool Rasterize(const std::vector<wxUniChar>& chars);
+
+    // Maximal number of glyphs in a single atlas, to avoid using too much
+    // memory when drawing text with many different characters, e.g. CJK.
+    static const size_t MAX_GLYPHS = 4096;
+
+    wxGraphicsRenderer* const m_renderer;
+    const wxFont m_font;
+    const wxColour m_colour;
+    const double m_scale;
+
+    std::unique_ptr<wxGraphicsContext> m_measuringContext;
+
+    double m_height = 0;
+    double m_padding = 0;
+
+    std::unordered_map<wxUint32, Glyph> m_glyphs;
+
+    wxDECLARE_NO_COPY_CLASS(wxGCDCGlyphAtlas);
+};
+
+namespace
+{
+
+// All the glyph atlases, indexed by their renderer, font, colour and scale.
+std::unordered_map<wxString, std::shared_ptr<wxGCDCGlyphAtlas>,
+                   wxStringHash, wxStringEqual> gs_glyphAtlases;
+
+// Maximal number of the atlases: when it's exceeded, the cache is cleared.
+const size_t MAX_GLYPH_ATLASES = 64;
+
+std::shared_ptr<wxGCDCGlyphAtlas>
+GetGlyphAtlas(wxGraphicsRenderer* renderer,
+              const wxFont& font,
+              const wxColour& colour,
+              double scale)
+{
+    const wxString key = wxString::Format("%p %s %08x %g",
+                                          static_cast<void*>(renderer),
+                                          font.GetNativeFontInfoDesc(),
+                                          colour.GetRGBA(),
+                                          scale);
+
+    std::shared_ptr<wxGCDCGlyphAtlas>& atlas = gs_glyphAtlases[key];
+    if ( !atlas )
+    {
+        if ( gs_glyphAtlases.size() > MAX_GLYPH_ATLASES )
+        {
+            gs_glyphAtlases.clear();
+            return GetGlyphAtlas(renderer, font, colour, scale);
+        }
+
+        atlas.reset(new wxGCDCGlyphAtlas(renderer, font, colour, scale));
+        if ( !atlas->IsOk() )
+        {
+            gs_glyphAtlases.erase(key);
+            return nullptr;
+        }
+    }
+
+    return atlas;
+}
+
+// Module clearing the cache on shutdown, as the cached bitmaps must be
+// destroyed before the renderers used for creating them are unloaded.
+class wxGCDCGlyphCacheModule : public wxModule
+{
+public:
+    wxGCDCGlyphCacheModule()
+    {
+#ifdef __WXMSW__
+    #if wxUSE_GRAPHICS_GDIPLUS
+        AddDependency("wxGDIPlusRendererModule");
+    #endif
+    #if wxUSE_GRAPHICS_DIRECT2D
+        AddDependency("wxDirect2DModule");
+    #endif
+#endif // __WXMSW__
+#if wxUSE_CAIRO && !defined(__WXGTK__)
+        AddDependency("wxCairoModule");
+#endif
+    }
+
+    virtual bool OnInit() override { return true; }
+    virtual void OnExit() override { gs_glyphAtlases.clear(); }
+
+private:
+    wxDECLARE_DYNAMIC_CLASS(wxGCDCGlyphCacheModule);
+};
+
+} // anonymous namespace
+
+wxIMPLEMENT_DYNAMIC_CLASS(wxGCDCGlyphCacheModule, wxModule);
+
+wxGCDCGlyphAtlas::wxGCDCGlyphAtlas(wxGraphicsRenderer* renderer,
+                                   const wxFont& font,
+                                   const wxColour& colour,
+                                   double scale)
+    : m_renderer(renderer),
+      m_font(font),
+      m_colour(colour),
+      m_scale(scale),
+      m_measuringContext(renderer->CreateMeasuringContext())
+{
+    if ( !m_measuringContext )
+        return;
+
+    m_measuringContext->SetFont(m_font, m_colour);
+    m_measuringContext->GetTextExtent("Hg", nullptr, &m_height);
+
+    // Leave enough space around each glyph for the parts extending beyond its
+    // advance width, e.g. for italic fonts, rounding it to a whole number of
+    // pixels to ensure that the glyph bitmaps are not interpolated.
+    m_padding = ceil(m_height * m_scale / 4) / m_scale;
+
+    // Pre-rasterize all ASCII characters as they're used most often, but
+    // don't count them as misses, as they're not needed yet.
+    std::vector<wxUniChar> ascii;
+    for ( char ch = 0x20; ch < 0x7f; ch++ )
+        ascii.push_back(ch);
+    if ( Rasterize(ascii) )
+        gs_glyphCacheStats.prerasterized += ascii.size();
+}
+
+bool wxGCDCGlyphAtlas::AddGlyphs(const wxString& str)
+{
+    size_t hits = 0;
+    std::vector<wxUniChar> missing;
+    for ( wxString::const_iterator it = str.begin(); it != str.end(); ++it )
+    {
+        const wxUniChar ch = *it;
+        if ( m_glyphs.count(ch.GetValue()) )
+        {
+            hits++;
+            continue;
+        }
+
+        // Check that we don't rasterize the same character twice.
+        if ( std::find(missing.begin(), missing.end(), ch) == missing.end() )
+            missing.push_back(ch);
+    }
+
+    if ( !missing.empty() )
+    {
+        if ( m_glyphs.size() + missing.size() > MAX_GLYPHS )
+            return false;
+
+        if ( !Rasterize(missing) )
+            return false;
+    }
+
+    // Only count the cached glyphs as hits, and the new ones as misses, if
+    // they're going to be used, i.e. if we don't fall back to drawing the
+    // text without the cache.
+    gs_glyphCacheStats.hits += hits;
+    gs_glyphCacheStats.misses += missing.size();
+
+    return true;
+}
+
+bool wxGCDCGlyphAtlas::Rasterize(const std::vector<wxUniChar>& chars)
+{
+    // Determine the positions of all glyphs in the image, in pixels.
+    const int height = static_cast<int>(ceil(m_height * m_scale));
+    const int padding = wxRound(m_padding * m_scale);
+
+    std::vector<int> offsets;
+    offsets.reserve(chars.size() + 1);
+
+    int width = 0;
+    for ( const wxUniChar ch : chars )
+    {
+        Glyph& glyph = m_glyphs[ch.GetValue()];
+        m_measuringContext->GetTextExtent(wxString(ch), &glyph.advance, nullptr);
+
+        const int cellWidth = static_cast<int>(ceil(glyph.advance * m_scale)) + 2*padding;
+        glyph.width = cellWidth / m_scale;
+
+        offsets.push_back(width);
+        width += cellWidth;
+    }
+    offsets.push_back(width);
+
+    if ( !width || !height )
+        return true;
+
+    // Draw all glyphs on a transparent image.
+    wxImage image(width, height);
+    image.SetAlpha();
+    memset(image.GetAlpha(), wxIMAGE_ALPHA_TRANSPARENT, width*height);
+
+    {
+        std::unique_ptr<wxGraphicsContext>
+            gc(m_renderer->CreateContextFromImage(image));
+        if ( !gc )
+        {
+            for ( const wxUniChar ch : chars )
+                m_glyphs.erase(ch.GetValue());
+
+            return false;
+        }
+
+        gc->Scale(m_scale, m_scale);
+        gc->SetFont(m_font, m_colour);
+
+        for ( size_t n = 0; n < chars.size(); n++ )
+            gc->DrawText(wxString(chars[n]), offsets[n] / m_scale + m_padding, 0);
+    }
+
+    const wxGraphicsBitmap
+        bitmapAll = m_renderer->CreateBitmapFromImage(image);
+
+    // And create the bitmaps for the individual glyphs, skipping the empty
+    // ones, which is worth doing as spaces are very common.
+    const unsigned char* const alpha = image.GetAlpha();
+    for ( size_t n = 0; n < chars.size(); n++ )
+    {
+        bool empty = true;
+        for ( int y = 0; y < height && empty; y++ )
+        {
+            const unsigned char* p = alpha + y*width;
+            for ( int x = offsets[n]; x < offsets[n + 1]; x++ )
+            {
+                if ( p[x] != wxIMAGE_ALPHA_TRANSPARENT )
+                {
+                    empty = false;
+                    break;
+                }
+            }
+        }
+
+        if ( empty )
+            continue;
+
+        m_glyphs[chars[n].GetValue()].bitmap =
+            m_renderer->CreateSubBitmap(bitmapAll,
+                                        offsets[n], 0,
+                                        offsets[n + 1] - offsets[n], height);
+    }
+
+    return true;
+}
+
+#endif // wxUSE_IMAGE
+
 //-----------------------------------------------------------------------------
 // wxDC bridge class
 //-----------------------------------------------------------------------------
@@ -114,6 +442,31 @@ wxGCDC::~wxGCDC()
 {
 }
 
+void wxGCDC::EnableGlyphCache(bool enable)
+{
+    static_cast<wxGCDCImpl*>(GetImpl())->EnableGlyphCache(enable);
+}
+
+/* static */
+wxGCDCGlyphCacheStats wxGCDC::GetGlyphCacheStats()
+{
+    return gs_glyphCacheStats;
+}
+
+/* static */
+void wxGCDC::ResetGlyphCacheStats()
+{
+    gs_glyphCacheStats = wxGCDCGlyphCacheStats();
+}
+
+/* static */
+void wxGCDC::ClearGlyphCache()
+{
+#if wxUSE_IMAGE
+    gs_glyphAtlases.clear();
+#endif // wxUSE_IMAGE
+}
+
 #ifdef __WXMSW__
 WXHDC wxGCDC::AcquireHDC()
 {
@@ -160,6 +513,9 @@ void wxGCDCImpl::SetGraphicsContext( wxGraphicsContext* ctx )
 {
     delete m_graphicContext;
 
+    // The new context may use a different renderer.
+    m_glyphAtlas.reset();
+
     if ( DoInitContext(ctx) )
     {
         if (m_graphicContext->GetWindow())
@@ -214,6 +570,8 @@ void wxGCDCImpl::CommonInit()
 {
     m_isClipBoxValid = false;
 
+    m_useGlyphCache = false;
+
     m_logicalFunctionSupported = true;
 }
 
@@ -459,6 +817,7 @@ void wxGCDCImpl::SetTextForeground( const wxColour &col )
     {
         m_textForegroundColour = col;
         m_graphicContext->SetFont( m_font, m_textForegroundColour );
+        m_glyphAtlas.reset();
     }
 }
 
@@ -515,6 +874,13 @@ void wxGCDCImpl::ComputeScaleAndOrigin()
     }
 }
 
+void wxGCDCImpl::EnableGlyphCache(bool enable)
+{
+    m_useGlyphCache = enable;
+    if ( !enable )
+        m_glyphAtlas.reset();
+}
+
 void* wxGCDCImpl::GetHandle() const
 {
     void* cgctx = nullptr;
@@ -540,6 +906,7 @@ void wxGCDCImpl::SetBackgroundMode( int mode )
 void wxGCDCImpl::SetFont( const wxFont &font )
 {
     m_font = font;
+    m_glyphAtlas.reset();
     if ( m_graphicContext )
     {
         m_graphicContext->SetFont(font, m_textForegroundColour);
@@ -1227,6 +1594,14 @@ void wxGCDCImpl::DoDrawText(const wxString& str, wxCoord x, wxCoord y)
     wxCompositionMode curMode = m_graphicContext->GetCompositionMode();
     m_graphicContext->SetCompositionMode(wxCOMPOSITION_OVER);
 
+    if ( m_useGlyphCache && DoDrawTextUsingGlyphCache(str, x, y) )
+    {
+        m_graphicContext->SetCompositionMode(curMode);
+
+        // Bounding box already updated by DoDrawTextUsingGlyphCache().
+        return;
+    }
+
     if ( m_backgroundMode == wxBRUSHSTYLE_TRANSPARENT )
         m_graphicContext->DrawText( str, x ,y);
     else
@@ -1238,6 +1613,92 @@ void wxGCDCImpl::DoDrawText(const wxString& str, wxCoord x, wxCoord y)
         CalcBoundingBox(wxPoint(x, y), GetOwner()->GetTextExtent(str));
 }
 
+bool wxGCDCImpl::DoDrawTextUsingGlyphCache(const wxString& str,
+                                           wxCoord x, wxCoord y)
+{
+#if wxUSE_IMAGE
+    // The cache is not thread-safe and so is only used by the main thread.
+    bool ok = m_font.IsOk() && wxIsMainThread();
+
+    // The glyphs are rasterized at the font size, so they can't be used if
+    // the text would be scaled or rotated.
+    if ( ok )
+    {
+        wxDouble a, b, c, d;
+        m_graphicContext->GetTransform().Get(&a, &b, &c, &d);
+        ok = a == 1 && b == 0 && c == 0 && d == 1;
+    }
+
+    for ( wxString::const_iterator it = str.begin(); ok && it != str.end(); ++it )
+    {
+        if ( !IsSimpleGlyph(*it) )
+            ok = false;
+    }
+
+    if ( ok && !m_glyphAtlas )
+    {
+        m_glyphAtlas = GetGlyphAtlas(m_graphicContext->GetRenderer(),
+                                     m_font,
+                                     m_textForegroundColour,
+                                     m_graphicContext->GetContentScaleFactor());
+        ok = m_glyphAtlas != nullptr;
+    }
+
+    if ( !ok || !m_glyphAtlas->AddGlyphs(str) )
+    {
+        gs_glyphCacheStats.fallbacks++;
+        return false;
+    }
+
+    const double height = m_glyphAtlas->GetHeight();
+
+    if ( m_backgroundMode != wxBRUSHSTYLE_TRANSPARENT )
+    {
+        double width = 0;
+        for ( wxString::const_iterator it = str.begin(); it != str.end(); ++it )
+            width += m_glyphAtlas->GetGlyph(*it).advance;
+
+        m_graphicContext->SetBrush(m_graphicContext->CreateBrush(m_textBackgroundColour));
+        m_graphicContext->SetPen(wxNullGraphicsPen);
+        m_graphicContext->DrawRectangle(x, y, width, height);
+        m_graphicContext->SetBrush(m_brush);
+        m_graphicContext->SetPen(m_pen);
+    }
+
+    // Position the glyphs at whole pixels to avoid blurring them.
+    const double padding = m_glyphAtlas->GetPadding();
+    double pos = 0;
+    for ( wxString::const_iterator it = str.begin(); it != str.end(); ++it )
+    {
+        const wxGCDCGlyphAtlas::Glyph& glyph = m_glyphAtlas->GetGlyph(*it);
+        if ( !glyph.bitmap.IsNull() )
+        {
+            m_graphicContext->DrawBitmap(glyph.bitmap,
+                                         x + wxRound(pos) - padding, y,
+                                         glyph.width, height);
+        }
+
+        pos += glyph.advance;
+    }
+
+    if ( AreAutomaticBoundingBoxUpdatesEnabled() )
+    {
+        CalcBoundingBox(wxPoint(x, y),
+                        wxSize(static_cast<int>(ceil(pos)),
+                               static_cast<int>(ceil(height))));
+    }
+
+    return true;
+#else // !wxUSE_IMAGE
+    wxUnusedVar(str);
+    wxUnusedVar(x);
+    wxUnusedVar(y);
+
+    gs_glyphCacheStats.fallbacks++;
+    return false;
+#endif // wxUSE_IMAGE/!wxUSE_IMAGE
+}
+
 bool wxGCDCImpl::CanGetTextExtent() const
 {
     wxCHECK_MSG( IsOk(), false, wxT("wxGCDC(cg)::CanGetTextExtent - invalid DC") );
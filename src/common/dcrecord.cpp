@@ -0,0 +1,1843 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        src/common/dcrecord.cpp
+// Purpose:     wxRecordingDC and wxDisplayList implementation
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ============================================================================
+// declarations
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+// for compilers that support precompilation, includes "wx/wx.h".
+#include "wx/wxprec.h"
+
+#ifndef WX_PRECOMP
+    #include "wx/dcmemory.h"
+    #include "wx/dcscreen.h"
+    #include "wx/icon.h"
+    #include "wx/image.h"
+    #include "wx/math.h"
+#endif
+
+#include "wx/dcrecord.h"
+#include "wx/display.h"
+
+#if wxUSE_STREAMS
+    #include "wx/datstrm.h"
+    #include "wx/stream.h"
+#endif
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+// ----------------------------------------------------------------------------
+// private helpers
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// Drawing operations codes stored in the display list data.
+enum RecordOp
+{
+    RecordOp_Clear,
+    RecordOp_Point,
+    RecordOp_Line,
+    RecordOp_Lines,
+    RecordOp_Polygon,
+    RecordOp_Rectangle,
+    RecordOp_RoundedRectangle,
+    RecordOp_Ellipse,
+    RecordOp_Arc,
+    RecordOp_EllipticArc,
+    RecordOp_Text,
+    RecordOp_RotatedText,
+    RecordOp_Bitmap,
+    RecordOp_GradientLinear,
+    RecordOp_GradientConcentric,
+    RecordOp_CrossHair,
+    RecordOp_FloodFill,
+
+    // Must be the last one.
+    RecordOp_Max
+};
+
+// Size of the cells of the spatial index grid.
+const int GRID_CELL_SIZE = 256;
+
+// Operations covering more than this number of cells in either direction are
+// not put into the grid but are always checked individually.
+const int GRID_MAX_CELLS = 16;
+
+// Number of the most recently used objects checked when adding a new one to
+// the display list: this is enough to avoid duplicating them when the same
+// few pens or brushes are used repeatedly without making recording slow.
+const size_t MAX_INTERN_LOOKBACK = 32;
+
+// The recorded data uses variable length encoding for integers: this makes it
+// compact as the coordinates are usually small, especially when they're
+// stored as differences from the previous point.
+void PutUInt(std::vector<unsigned char>& data, wxUint64 value)
+{
+    while ( value >= 0x80 )
+    {
+        data.push_back(static_cast<unsigned char>(value | 0x80));
+        value >>= 7;
+    }
+
+    data.push_back(static_cast<unsigned char>(value));
+}
+
+void PutInt(std::vector<unsigned char>& data, wxInt64 value)
+{
+    // Use zigzag encoding to keep small negative numbers small too.
+    PutUInt(data, (static_cast<wxUint64>(value) << 1) ^
+                   static_cast<wxUint64>(value >> 63));
+}
+
+void PutDouble(std::vector<unsigned char>& data, double value)
+{
+    wxUint64 bits;
+    memcpy(&bits, &value, sizeof(bits));
+    for ( int n = 0; n < 8; n++ )
+    {
+        data.push_back(static_cast<unsigned char>(bits));
+        bits >>= 8;
+    }
+}
+
+void PutColour(std::vector<unsigned char>& data, const wxColour& colour)
+{
+    if ( !colour.IsOk() )
+    {
+        data.push_back(0);
+        return;
+    }
+
+    data.push_back(1);
+    data.push_back(colour.Red());
+    data.push_back(colour.Green());
+    data.push_back(colour.Blue());
+    data.push_back(colour.Alpha());
+}
+
+void PutString(std::vector<unsigned char>& data, const wxString& str)
+{
+    const wxScopedCharBuffer utf8 = str.utf8_str();
+    PutUInt(data, utf8.length());
+    data.insert(data.end(), utf8.data(), utf8.data() + utf8.length());
+}
+
+void PutPoints(std::vector<unsigned char>& data,
+               int n, const wxPoint points[],
+               wxCoord xoffset, wxCoord yoffset)
+{
+    PutUInt(data, n);
+
+    wxInt64 xPrev = 0,
+            yPrev = 0;
+    for ( int i = 0; i < n; i++ )
+    {
+        const wxInt64 x = points[i].x + xoffset;
+        const wxInt64 y = points[i].y + yoffset;
+        PutInt(data, x - xPrev);
+        PutInt(data, y - yPrev);
+        xPrev = x;
+        yPrev = y;
+    }
+}
+
+// Reader for the data written by the functions above: as the data may come
+// from an external file, it never reads beyond its end and sets the error flag
+// instead.
+class DataReader
+{
+public:
+    DataReader(const std::vector<unsigned char>& data, size_t offset)
+        : m_p(data.data() + offset),
+          m_end(data.data() + data.size()),
+          m_error(offset > data.size())
+    {
+    }
+
+    bool IsOk() const { return !m_error; }
+
+    size_t GetRemaining() const { return m_error ? 0 : m_end - m_p; }
+
+    unsigned char Byte()
+    {
+        if ( m_error || m_p == m_end )
+        {
+            m_error = true;
+            return 0;
+        }
+
+        return *m_p++;
+    }
+
+    wxUint64 UInt()
+    {
+        wxUint64 value = 0;
+        for ( int shift = 0; shift < 64; shift += 7 )
+        {
+            const unsigned char b = Byte();
+            value |= static_cast<wxUint64>(b & 0x7f) << shift;
+            if ( !(b & 0x80) )
+                return value;
+        }
+
+        m_error = true;
+        return 0;
+    }
+
+    wxInt64 Int64()
+    {
+        const wxUint64 value = UInt();
+        return static_cast<wxInt64>((value >> 1) ^ (~(value & 1) + 1));
+    }
+
+    int Int()
+    {
+        const wxInt64 value = Int64();
+        if ( value < INT_MIN || value > INT_MAX )
+        {
+            m_error = true;
+            return 0;
+        }
+
+        return static_cast<int>(value);
+    }
+
+    double Double()
+    {
+        wxUint64 bits = 0;
+        for ( int n = 0; n < 8; n++ )
+            bits |= static_cast<wxUint64>(Byte()) << (8*n);
+
+        double value;
+        memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    wxColour Colour()
+    {
+        if ( !Byte() )
+            return wxColour();
+
+        const unsigned char r = Byte();
+        const unsigned char g = Byte();
+        const unsigned char b = Byte();
+        const unsigned char a = Byte();
+        return wxColour(r, g, b, a);
+    }
+
+    wxString String()
+    {
+        const wxUint64 len = UInt();
+        if ( len > GetRemaining() )
+        {
+            m_error = true;
+            return wxString();
+        }
+
+        const char* const s = reinterpret_cast<const char*>(m_p);
+        m_p += len;
+        return wxString::FromUTF8(s, len);
+    }
+
+    wxPoint Point()
+    {
+        const int x = Int();
+        const int y = Int();
+        return wxPoint(x, y);
+    }
+
+    wxRect Rect()
+    {
+        const wxPoint pt = Point();
+        const int w = Int();
+        const int h = Int();
+        return wxRect(pt, wxSize(w, h));
+    }
+
+    bool Points(std::vector<wxPoint>& points)
+    {
+        const wxUint64 n = UInt();
+
+        // Each coordinate takes at least one byte.
+        if ( n > GetRemaining() / 2 )
+        {
+            m_error = true;
+            return false;
+        }
+
+        points.resize(n);
+
+        wxInt64 x = 0,
+                y = 0;
+        for ( wxPoint& pt : points )
+        {
+            x += Int();
+            y += Int();
+            pt = wxPoint(static_cast<int>(x), static_cast<int>(y));
+        }
+
+        return IsOk() && n > 0;
+    }
+
+private:
+    const unsigned char* m_p;
+    const unsigned char* const m_end;
+    bool m_error;
+};
+
+inline wxUint64 MakeGridKey(int col, int row)
+{
+    return (static_cast<wxUint64>(static_cast<wxUint32>(col)) << 32) |
+            static_cast<wxUint32>(row);
+}
+
+// Return the range of grid cells covered by the given rectangle.
+inline void GetGridCells(const wxRect& rect,
+                         int& col1, int& row1, int& col2, int& row2)
+{
+    // Use floor division to handle negative coordinates correctly.
+    col1 = static_cast<int>(floor(double(rect.x) / GRID_CELL_SIZE));
+    row1 = static_cast<int>(floor(double(rect.y) / GRID_CELL_SIZE));
+    col2 = static_cast<int>(floor(double(rect.GetRight()) / GRID_CELL_SIZE));
+    row2 = static_cast<int>(floor(double(rect.GetBottom()) / GRID_CELL_SIZE));
+}
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+// wxRecordingDCImpl
+// ----------------------------------------------------------------------------
+
+class wxRecordingDCImpl : public wxDCImpl
+{
+public:
+    wxRecordingDCImpl(wxRecordingDC* owner, wxDisplayList& list,
+                      const wxSize& size)
+        : wxDCImpl(owner),
+          m_list(list),
+          m_size(size)
+    {
+        m_ok = true;
+        m_textBackgroundColour = *wxWHITE;
+
+        m_state.textForeground = m_textForegroundColour;
+        m_state.textBackground = m_textBackgroundColour;
+        m_state.backgroundMode = m_backgroundMode;
+        m_state.logicalFunction = m_logicalFunction;
+    }
+
+    virtual bool CanDrawBitmap() const override { return true; }
+    virtual bool CanGetTextExtent() const override { return true; }
+
+    virtual int GetDepth() const override { return 32; }
+    virtual wxSize GetPPI() const override { return wxDisplay::GetStdPPI(); }
+
+    virtual void DoGetSize(int* width, int* height) const override
+    {
+        if ( width )
+            *width = m_size.x;
+        if ( height )
+            *height = m_size.y;
+    }
+
+    virtual void DoGetSizeMM(int* width, int* height) const override
+    {
+        const wxSize ppi = GetPPI();
+        if ( width )
+            *width = wxRound(m_size.x * 25.4 / ppi.x);
+        if ( height )
+            *height = wxRound(m_size.y * 25.4 / ppi.y);
+    }
+
+    virtual void* GetHandle() const override { return nullptr; }
+
+    // Attributes.
+    virtual void SetFont(const wxFont& font) override
+    {
+        m_font = font;
+        SetStateIndex(m_state.font, InternObject(m_list.m_fonts, font));
+    }
+
+    virtual void SetPen(const wxPen& pen) override
+    {
+        m_pen = pen;
+        SetStateIndex(m_state.pen, InternObject(m_list.m_pens, pen));
+    }
+
+    virtual void SetBrush(const wxBrush& brush) override
+    {
+        m_brush = brush;
+        SetStateIndex(m_state.brush, InternObject(m_list.m_brushes, brush));
+    }
+
+    virtual void SetBackground(const wxBrush& brush) override
+    {
+        m_backgroundBrush = brush;
+        SetStateIndex(m_state.background,
+                      InternObject(m_list.m_brushes, brush));
+    }
+
+    virtual void SetBackgroundMode(int mode) override
+    {
+        m_backgroundMode = mode;
+        if ( m_state.backgroundMode != mode )
+        {
+            m_state.backgroundMode = mode;
+            m_stateChanged = true;
+        }
+    }
+
+    virtual void SetTextForeground(const wxColour& colour) override
+    {
+        m_textForegroundColour = colour;
+        if ( m_state.textForeground != colour )
+        {
+            m_state.textForeground = colour;
+            m_stateChanged = true;
+        }
+    }
+
+    virtual void SetTextBackground(const wxColour& colour) override
+    {
+        m_textBackgroundColour = colour;
+        if ( m_state.textBackground != colour )
+        {
+            m_state.textBackground = colour;
+            m_stateChanged = true;
+        }
+    }
+
+    virtual void SetLogicalFunction(wxRasterOperationMode function) override
+    {
+        m_logicalFunction = function;
+        if ( m_state.logicalFunction != function )
+        {
+            m_state.logicalFunction = function;
+            m_stateChanged = true;
+        }
+    }
+
+    virtual void SetPalette(const wxPalette& WXUNUSED(palette)) override
+    {
+    }
+
+    // Text metrics.
+    virtual wxCoord GetCharHeight() const override
+    {
+        wxDC& dc = GetMeasuringDC(m_font);
+        return dc.GetCharHeight();
+    }
+
+    virtual wxCoord GetCharWidth() const override
+    {
+        wxDC& dc = GetMeasuringDC(m_font);
+        return dc.GetCharWidth();
+    }
+
+    virtual void DoGetTextExtent(const wxString& string,
+                                 wxCoord* x, wxCoord* y,
+                                 wxCoord* descent = nullptr,
+                                 wxCoord* externalLeading = nullptr,
+                                 const wxFont* theFont = nullptr) const override
+    {
+        wxDC& dc = GetMeasuringDC(theFont ? *theFont : m_font);
+        dc.GetTextExtent(string, x, y, descent, externalLeading);
+    }
+
+    virtual bool DoGetPartialTextExtents(const wxString& text,
+                                         wxArrayInt& widths) const override
+    {
+        wxDC& dc = GetMeasuringDC(m_font);
+        return dc.GetPartialTextExtents(text, widths);
+    }
+
+    // Clipping: it is stored in the state of the operations and applied when
+    // they're replayed.
+    virtual void DoSetClippingRegion(wxCoord x, wxCoord y,
+                                     wxCoord w, wxCoord h) override
+    {
+        SetClipRect(wxRect(x, y, w, h));
+    }
+
+    virtual void DoSetDeviceClippingRegion(const wxRegion& region) override
+    {
+        // Device and logical coordinates are the same for this DC.
+        SetClipRect(region.GetBox());
+    }
+
+    virtual bool DoGetClippingRect(wxRect& rect) const override
+    {
+        if ( !m_state.clipping )
+        {
+            rect = wxRect(m_size);
+            return false;
+        }
+
+        rect = m_state.clipRect;
+        return true;
+    }
+
+    virtual void DestroyClippingRegion() override
+    {
+        ResetClipping();
+
+        if ( m_state.clipping )
+        {
+            m_state.clipping = false;
+            m_state.clipRect = wxRect();
+            m_stateChanged = true;
+        }
+    }
+
+    // Drawing.
+    virtual void Clear() override
+    {
+        AddOp(RecordOp_Clear, wxRect());
+    }
+
+    virtual bool DoGetPixel(wxCoord WXUNUSED(x), wxCoord WXUNUSED(y),
+                            wxColour* WXUNUSED(col)) const override
+    {
+        wxFAIL_MSG(wxS("wxRecordingDC::GetPixel() is not supported"));
+        return false;
+    }
+
+    virtual bool DoFloodFill(wxCoord x, wxCoord y, const wxColour& col,
+                             wxFloodFillStyle style = wxFLOOD_SURFACE) override
+    {
+        // The area affected by the flood fill is unknown.
+        AddOp(RecordOp_FloodFill, wxRect());
+        PutInt(m_list.m_data, x);
+        PutInt(m_list.m_data, y);
+        PutColour(m_list.m_data, col);
+        m_list.m_data.push_back(static_cast<unsigned char>(style));
+        return true;
+    }
+
+    virtual void DoCrossHair(wxCoord x, wxCoord y) override
+    {
+        AddOp(RecordOp_CrossHair, wxRect());
+        PutInt(m_list.m_data, x);
+        PutInt(m_list.m_data, y);
+    }
+
+    virtual void DoDrawPoint(wxCoord x, wxCoord y) override
+    {
+        AddOp(RecordOp_Point, InflateForPen(wxRect(x, y, 1, 1)));
+        PutInt(m_list.m_data, x);
+        PutInt(m_list.m_data, y);
+    }
+
+    virtual void DoDrawLine(wxCoord x1, wxCoord y1,
+                            wxCoord x2, wxCoord y2) override
+    {
+        AddOp(RecordOp_Line,
+              InflateForPen(wxRect(wxPoint(x1, y1), wxPoint(x2, y2))));
+        PutInt(m_list.m_data, x1);
+        PutInt(m_list.m_data, y1);
+        PutInt(m_list.m_data, x2);
+        PutInt(m_list.m_data, y2);
+    }
+
+    virtual void DoDrawLines(int n, const wxPoint points[],
+                             wxCoord xoffset, wxCoord yoffset) override
+    {
+        if ( n <= 0 )
+            return;
+
+        AddOp(RecordOp_Lines,
+              InflateForPen(GetPointsBox(n, points, xoffset, yoffset)));
+        PutPoints(m_list.m_data, n, points, xoffset, yoffset);
+    }
+
+    virtual void DoDrawPolygon(int n, const wxPoint points[],
+                               wxCoord xoffset, wxCoord yoffset,
+                               wxPolygonFillMode fillStyle = wxODDEVEN_RULE) override
+    {
+        if ( n <= 0 )
+            return;
+
+        AddOp(RecordOp_Polygon,
+              InflateForPen(GetPointsBox(n, points, xoffset, yoffset)));
+        m_list.m_data.push_back(static_cast<unsigned char>(fillStyle));
+        PutPoints(m_list.m_data, n, points, xoffset, yoffset);
+    }
+
+    virtual void DoDrawRectangle(wxCoord x, wxCoord y,
+                                 wxCoord width, wxCoord height) override
+    {
+        AddRectOp(RecordOp_Rectangle, x, y, width, height);
+    }
+
+    virtual void DoDrawRoundedRectangle(wxCoord x, wxCoord y,
+                                        wxCoord width, wxCoord height,
+                                        double radius) override
+    {
+        AddRectOp(RecordOp_RoundedRectangle, x, y, width, height);
+        PutDouble(m_list.m_data, radius);
+    }
+
+    virtual void DoDrawEllipse(wxCoord x, wxCoord y,
+                               wxCoord width, wxCoord height) override
+    {
+        AddRectOp(RecordOp_Ellipse, x, y, width, height);
+    }
+
+    virtual void DoDrawArc(wxCoord x1, wxCoord y1,
+                           wxCoord x2, wxCoord y2,
+                           wxCoord xc, wxCoord yc) override
+    {
+        // Use the bounding box of the entire circle for simplicity.
+        const int r = wxRound(sqrt(double(x1 - xc)*(x1 - xc) +
+                                   double(y1 - yc)*(y1 - yc)));
+        AddOp(RecordOp_Arc,
+              InflateForPen(wxRect(xc - r, yc - r, 2*r + 1, 2*r + 1)));
+        PutInt(m_list.m_data, x1);
+        PutInt(m_list.m_data, y1);
+        PutInt(m_list.m_data, x2);
+        PutInt(m_list.m_data, y2);
+        PutInt(m_list.m_data, xc);
+        PutInt(m_list.m_data, yc);
+    }
+
+    virtual void DoDrawEllipticArc(wxCoord x, wxCoord y, wxCoord w, wxCoord h,
+                                   double sa, double ea) override
+    {
+        AddRectOp(RecordOp_EllipticArc, x, y, w, h);
+        PutDouble(m_list.m_data, sa);
+        PutDouble(m_list.m_data, ea);
+    }
+
+    virtual void DoDrawText(const wxString& text,
+                            wxCoord x, wxCoord y) override
+    {
+        wxCoord w, h;
+        GetOwner()->GetMultiLineTextExtent(text, &w, &h);
+
+        AddOp(RecordOp_Text, wxRect(x, y, w, h));
+        PutInt(m_list.m_data, x);
+        PutInt(m_list.m_data, y);
+        PutString(m_list.m_data, text);
+    }
+
+    virtual void DoDrawRotatedText(const wxString& text,
+                                   wxCoord x, wxCoord y,
+                                   double angle) override
+    {
+        wxCoord w, h;
+        GetOwner()->GetMultiLineTextExtent(text, &w, &h);
+
+        // The text is rotated counterclockwise around its top left corner,
+        // compute the bounding box of the resulting rectangle.
+        const double rad = wxDegToRad(angle);
+        const double c = cos(rad);
+        const double s = sin(rad);
+        const wxPoint corners[] =
+        {
+            wxPoint(x, y),
+            wxPoint(x + wxRound(w*c), y - wxRound(w*s)),
+            wxPoint(x + wxRound(h*s), y + wxRound(h*c)),
+            wxPoint(x + wxRound(w*c + h*s), y + wxRound(h*c - w*s)),
+        };
+
+        AddOp(RecordOp_RotatedText,
+              GetPointsBox(WXSIZEOF(corners), corners, 0, 0).Inflate(1));
+        PutInt(m_list.m_data, x);
+        PutInt(m_list.m_data, y);
+        PutDouble(m_list.m_data, angle);
+        PutString(m_list.m_data, text);
+    }
+
+    virtual void DoDrawBitmap(const wxBitmap& bmp, wxCoord x, wxCoord y,
+                              bool useMask = false) override
+    {
+        wxCHECK_RET( bmp.IsOk(), wxS("invalid bitmap") );
+
+        const wxSize size = bmp.GetLogicalSize();
+        AddBitmapOp(bmp, wxRect(wxPoint(x, y), size), useMask, wxCOPY);
+    }
+
+    virtual void DoDrawIcon(const wxIcon& icon, wxCoord x, wxCoord y) override
+    {
+        wxCHECK_RET( icon.IsOk(), wxS("invalid icon") );
+
+        wxBitmap bmp;
+        bmp.CopyFromIcon(icon);
+        DoDrawBitmap(bmp, x, y, true);
+    }
+
+    virtual bool DoBlit(wxCoord xdest, wxCoord ydest,
+                        wxCoord width, wxCoord height,
+                        wxDC* source,
+                        wxCoord xsrc, wxCoord ysrc,
+                        wxRasterOperationMode rop = wxCOPY,
+                        bool useMask = false,
+                        wxCoord xsrcMask = wxDefaultCoord,
+                        wxCoord ysrcMask = wxDefaultCoord) override
+    {
+        return DoStretchBlit(xdest, ydest, width, height,
+                             source, xsrc, ysrc, width, height,
+                             rop, useMask, xsrcMask, ysrcMask);
+    }
+
+    virtual bool DoStretchBlit(wxCoord xdest, wxCoord ydest,
+                               wxCoord dstWidth, wxCoord dstHeight,
+                               wxDC* source,
+                               wxCoord xsrc, wxCoord ysrc,
+                               wxCoord srcWidth, wxCoord srcHeight,
+                               wxRasterOperationMode rop = wxCOPY,
+                               bool useMask = false,
+                               wxCoord xsrcMask = wxDefaultCoord,
+                               wxCoord ysrcMask = wxDefaultCoord) override
+    {
+        wxCHECK_MSG( source, false, wxS("null source DC") );
+
+        if ( srcWidth <= 0 || srcHeight <= 0 )
+            return false;
+
+        // Take a snapshot of the source DC contents as they can't be accessed
+        // when the list is replayed later.
+        wxBitmap bmp(srcWidth, srcHeight);
+        {
+            wxMemoryDC memDC(bmp);
+            if ( !memDC.Blit(0, 0, srcWidth, srcHeight, source, xsrc, ysrc,
+                             wxCOPY, useMask, xsrcMask, ysrcMask) )
+                return false;
+        }
+
+        AddBitmapOp(bmp, wxRect(xdest, ydest, dstWidth, dstHeight),
+                    useMask, rop);
+        return true;
+    }
+
+    virtual void DoGradientFillLinear(const wxRect& rect,
+                                      const wxColour& initialColour,
+                                      const wxColour& destColour,
+                                      wxDirection nDirection = wxEAST) override
+    {
+        AddOp(RecordOp_GradientLinear, rect);
+        PutRect(rect);
+        PutColour(m_list.m_data, initialColour);
+        PutColour(m_list.m_data, destColour);
+        m_list.m_data.push_back(static_cast<unsigned char>(nDirection));
+    }
+
+    virtual void DoGradientFillConcentric(const wxRect& rect,
+                                          const wxColour& initialColour,
+                                          const wxColour& destColour,
+                                          const wxPoint& circleCenter) override
+    {
+        AddOp(RecordOp_GradientConcentric, rect);
+        PutRect(rect);
+        PutColour(m_list.m_data, initialColour);
+        PutColour(m_list.m_data, destColour);
+        PutInt(m_list.m_data, circleCenter.x);
+        PutInt(m_list.m_data, circleCenter.y);
+    }
+
+private:
+    // Return the index of an existing object equal to the given one or add
+    // it to the list and return the index of the new element.
+    template <typename T>
+    static int InternObject(std::vector<T>& objects, const T& obj)
+    {
+        if ( !obj.IsOk() )
+            return -1;
+
+        const size_t count = objects.size();
+        const size_t first = count > MAX_INTERN_LOOKBACK
+                                ? count - MAX_INTERN_LOOKBACK
+                                : 0;
+        for ( size_t n = count; n > first; n-- )
+        {
+            if ( objects[n - 1] == obj )
+                return static_cast<int>(n - 1);
+        }
+
+        objects.push_back(obj);
+        return static_cast<int>(count);
+    }
+
+    void SetStateIndex(int& index, int value)
+    {
+        if ( index != value )
+        {
+            index = value;
+            m_stateChanged = true;
+        }
+    }
+
+    void SetClipRect(const wxRect& rect)
+    {
+        wxRect clip = rect;
+        if ( m_state.clipping )
+            clip.Intersect(m_state.clipRect);
+
+        // Ensure that empty clipping regions are handled consistently.
+        if ( clip.IsEmpty() )
+            clip = wxRect();
+
+        m_state.clipping = true;
+        m_state.clipRect = clip;
+        m_stateChanged = true;
+
+        m_clipping = true;
+        m_clipX1 = clip.x;
+        m_clipY1 = clip.y;
+        m_clipX2 = clip.x + clip.width;
+        m_clipY2 = clip.y + clip.height;
+    }
+
+    static bool IsSameState(const wxDisplayList::State& s1,
+                            const wxDisplayList::State& s2)
+    {
+        return s1.pen == s2.pen &&
+               s1.brush == s2.brush &&
+               s1.background == s2.background &&
+               s1.font == s2.font &&
+               s1.textForeground == s2.textForeground &&
+               s1.textBackground == s2.textBackground &&
+               s1.backgroundMode == s2.backgroundMode &&
+               s1.logicalFunction == s2.logicalFunction &&
+               s1.clipping == s2.clipping &&
+               s1.clipRect == s2.clipRect;
+    }
+
+    // Start a new operation with the given bounding box, which may be empty
+    // if the operation is not limited to any part of the DC.
+    void AddOp(RecordOp op, const wxRect& bbox)
+    {
+        std::vector<wxDisplayList::State>& states = m_list.m_states;
+        if ( m_stateChanged || states.empty() )
+        {
+            if ( states.empty() || !IsSameState(states.back(), m_state) )
+                states.push_back(m_state);
+
+            m_stateChanged = false;
+        }
+
+        wxDisplayList::Entry entry;
+        entry.offset = m_list.m_data.size();
+        entry.state = states.size() - 1;
+        entry.bbox = bbox;
+        m_list.m_entries.push_back(entry);
+        m_list.m_gridValid = false;
+
+        m_list.m_data.push_back(static_cast<unsigned char>(op));
+
+        if ( !bbox.IsEmpty() )
+        {
+            CalcBoundingBox(bbox.x, bbox.y, bbox.GetRight(), bbox.GetBottom());
+        }
+    }
+
+    void PutRect(const wxRect& rect)
+    {
+        PutInt(m_list.m_data, rect.x);
+        PutInt(m_list.m_data, rect.y);
+        PutInt(m_list.m_data, rect.width);
+        PutInt(m_list.m_data, rect.height);
+    }
+
+    void AddRectOp(RecordOp op,
+                   wxCoord x, wxCoord y, wxCoord width, wxCoord height)
+    {
+        wxRect rect(x, y, width, height);
+
+        // Negative sizes are allowed for the rectangle-like operations.
+        if ( rect.width < 0 )
+        {
+            rect.x += rect.width;
+            rect.width = -rect.width;
+        }
+        if ( rect.height < 0 )
+        {
+            rect.y += rect.height;
+            rect.height = -rect.height;
+        }
+
+        AddOp(op, InflateForPen(rect));
+        PutRect(wxRect(x, y, width, height));
+    }
+
+    void AddBitmapOp(const wxBitmap& bmp, const wxRect& rect,
+                     bool useMask, wxRasterOperationMode rop)
+    {
+        int index = m_list.FindBitmap(bmp);
+        if ( index == -1 )
+        {
+            index = static_cast<int>(m_list.m_bitmaps.size());
+            m_list.m_bitmaps.push_back(bmp);
+        }
+
+        AddOp(RecordOp_Bitmap, rect);
+        PutUInt(m_list.m_data, index);
+        PutRect(rect);
+        m_list.m_data.push_back(useMask);
+        m_list.m_data.push_back(static_cast<unsigned char>(rop));
+    }
+
+    wxRect InflateForPen(wxRect rect) const
+    {
+        if ( m_pen.IsOk() && m_pen.GetStyle() != wxPENSTYLE_TRANSPARENT )
+            rect.Inflate(m_pen.GetWidth() / 2 + 1);
+
+        return rect;
+    }
+
+    static wxRect GetPointsBox(int n, const wxPoint points[],
+                               wxCoord xoffset, wxCoord yoffset)
+    {
+        wxPoint ptMin = points[0],
+                ptMax = points[0];
+        for ( int i = 1; i < n; i++ )
+        {
+            ptMin.x = wxMin(ptMin.x, points[i].x);
+            ptMin.y = wxMin(ptMin.y, points[i].y);
+            ptMax.x = wxMax(ptMax.x, points[i].x);
+            ptMax.y = wxMax(ptMax.y, points[i].y);
+        }
+
+        const wxPoint offset(xoffset, yoffset);
+        return wxRect(ptMin + offset, ptMax + offset);
+    }
+
+    wxDC& GetMeasuringDC(const wxFont& font) const
+    {
+        if ( !m_measuringDC )
+            m_measuringDC.reset(new wxScreenDC);
+
+        m_measuringDC->SetFont(font.IsOk() ? font : *wxNORMAL_FONT);
+        return *m_measuringDC;
+    }
+
+
+    wxDisplayList& m_list;
+    const wxSize m_size;
+
+    // The state used for the next drawing operation and whether it may be
+    // different from the last state added to the list.
+    wxDisplayList::State m_state;
+    bool m_stateChanged = true;
+
+    // DC used for measuring text, created on demand.
+    mutable std::unique_ptr<wxScreenDC> m_measuringDC;
+
+    wxDECLARE_NO_COPY_CLASS(wxRecordingDCImpl);
+};
+
+// ----------------------------------------------------------------------------
+// wxRecordingDC
+// ----------------------------------------------------------------------------
+
+wxIMPLEMENT_ABSTRACT_CLASS(wxRecordingDC, wxDC);
+
+wxRecordingDC::wxRecordingDC(wxDisplayList& list, const wxSize& size)
+    : wxDC(new wxRecordingDCImpl(this, list, size))
+{
+}
+
+// ============================================================================
+// wxDisplayList implementation
+// ============================================================================
+
+wxRect wxDisplayList::GetBoundingBox() const
+{
+    wxRect bbox;
+    for ( const Entry& entry : m_entries )
+    {
+        if ( !entry.bbox.IsEmpty() )
+            bbox.Union(entry.bbox);
+    }
+
+    return bbox;
+}
+
+void wxDisplayList::Clear()
+{
+    m_data.clear();
+    m_entries.clear();
+    m_states.clear();
+    m_pens.clear();
+    m_brushes.clear();
+    m_fonts.clear();
+    m_bitmaps.clear();
+    m_dashes.clear();
+
+    m_grid.clear();
+    m_gridLarge.clear();
+    m_gridValid = false;
+}
+
+int wxDisplayList::FindBitmap(const wxBitmap& bitmap) const
+{
+    const size_t count = m_bitmaps.size();
+    const size_t first = count > MAX_INTERN_LOOKBACK
+                            ? count - MAX_INTERN_LOOKBACK
+                            : 0;
+    for ( size_t n = count; n > first; n-- )
+    {
+        if ( m_bitmaps[n - 1].IsSameAs(bitmap) )
+            return static_cast<int>(n - 1);
+    }
+
+    return -1;
+}
+
+// ----------------------------------------------------------------------------
+// replaying
+// ----------------------------------------------------------------------------
+
+void wxDisplayList::Replay(wxDC& dc) const
+{
+    DoReplay(dc, nullptr, m_entries.size());
+}
+
+void wxDisplayList::Replay(wxDC& dc, const wxRect& rect) const
+{
+    if ( m_entries.empty() || rect.IsEmpty() )
+        return;
+
+    BuildSpatialIndex();
+
+    std::vector<wxUint32> candidates(m_gridLarge);
+
+    int col1, row1, col2, row2;
+    GetGridCells(rect, col1, row1, col2, row2);
+
+    // Don't iterate over a huge number of cells if the rectangle is much
+    // bigger than the area actually used by the drawing.
+    if ( wxInt64(col2 - col1 + 1)*(row2 - row1 + 1) > wxInt64(m_grid.size()) )
+    {
+        for ( const auto& cell : m_grid )
+        {
+            const int col = static_cast<wxInt32>(cell.first >> 32);
+            const int row = static_cast<wxInt32>(cell.first & 0xffffffff);
+            if ( col >= col1 && col <= col2 && row >= row1 && row <= row2 )
+            {
+                candidates.insert(candidates.end(),
+                                  cell.second.begin(), cell.second.end());
+            }
+        }
+    }
+    else
+    {
+        for ( int row = row1; row <= row2; row++ )
+        {
+            for ( int col = col1; col <= col2; col++ )
+            {
+                const auto it = m_grid.find(MakeGridKey(col, row));
+                if ( it != m_grid.end() )
+                {
+                    candidates.insert(candidates.end(),
+                                      it->second.begin(), it->second.end());
+                }
+            }
+        }
+    }
+
+    // Operations must be replayed in their original order and only once.
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()),
+                     candidates.end());
+
+    std::vector<wxUint32> indices;
+    indices.reserve(candidates.size());
+    for ( wxUint32 n : candidates )
+    {
+        const Entry& entry = m_entries[n];
+        if ( !entry.bbox.IsEmpty() && !entry.bbox.Intersects(rect) )
+            continue;
+
+        // Also skip the operations completely clipped out.
+        const State& state = m_states[entry.state];
+        if ( state.clipping && !state.clipRect.Intersects(rect) )
+            continue;
+
+        indices.push_back(n);
+    }
+
+    if ( !indices.empty() )
+        DoReplay(dc, indices.data(), indices.size());
+}
+
+void wxDisplayList::BuildSpatialIndex() const
+{
+    if ( m_gridValid )
+        return;
+
+    m_grid.clear();
+    m_gridLarge.clear();
+
+    const size_t count = m_entries.size();
+    for ( size_t n = 0; n < count; n++ )
+    {
+        const wxRect& bbox = m_entries[n].bbox;
+        const wxUint32 index = static_cast<wxUint32>(n);
+
+        if ( bbox.IsEmpty() )
+        {
+            m_gridLarge.push_back(index);
+            continue;
+        }
+
+        int col1, row1, col2, row2;
+        GetGridCells(bbox, col1, row1, col2, row2);
+
+        if ( col2 - col1 >= GRID_MAX_CELLS || row2 - row1 >= GRID_MAX_CELLS )
+        {
+            m_gridLarge.push_back(index);
+            continue;
+        }
+
+        for ( int row = row1; row <= row2; row++ )
+        {
+            for ( int col = col1; col <= col2; col++ )
+                m_grid[MakeGridKey(col, row)].push_back(index);
+        }
+    }
+
+    m_gridValid = true;
+}
+
+void wxDisplayList::DoReplay(wxDC& dc,
+                             const wxUint32* indices,
+                             size_t count) const
+{
+    if ( !count )
+        return;
+
+    // Save the DC attributes to restore them after replaying.
+    const wxPen penOrig = dc.GetPen();
+    const wxBrush brushOrig = dc.GetBrush();
+    const wxBrush backgroundOrig = dc.GetBackground();
+    const wxFont fontOrig = dc.GetFont();
+    const wxColour textForegroundOrig = dc.GetTextForeground();
+    const wxColour textBackgroundOrig = dc.GetTextBackground();
+    const int backgroundModeOrig = dc.GetBackgroundMode();
+    const wxRasterOperationMode logicalFunctionOrig = dc.GetLogicalFunction();
+
+    wxRect outerClip;
+    const bool hasOuterClip = dc.GetClippingBox(outerClip);
+
+    const State* current = nullptr;
+    size_t currentIndex = 0;
+
+    std::vector<wxPoint> points;
+    for ( size_t n = 0; n < count; n++ )
+    {
+        const Entry& entry = m_entries[indices ? indices[n] : n];
+        if ( !current || entry.state != currentIndex )
+        {
+            const State& state = m_states[entry.state];
+            ApplyState(dc, state, current, hasOuterClip ? &outerClip : nullptr);
+
+            current = &state;
+            currentIndex = entry.state;
+        }
+
+        if ( current->clipping && current->clipRect.IsEmpty() )
+            continue;
+
+        ReplayEntry(dc, entry, points);
+    }
+
+    if ( current && current->clipping )
+    {
+        dc.DestroyClippingRegion();
+        if ( hasOuterClip )
+            dc.SetClippingRegion(outerClip);
+    }
+
+    dc.SetPen(penOrig);
+    dc.SetBrush(brushOrig);
+    dc.SetBackground(backgroundOrig);
+    dc.SetFont(fontOrig);
+    dc.SetTextForeground(textForegroundOrig);
+    dc.SetTextBackground(textBackgroundOrig);
+    dc.SetBackgroundMode(backgroundModeOrig);
+    dc.SetLogicalFunction(logicalFunctionOrig);
+}
+
+void wxDisplayList::ApplyState(wxDC& dc,
+                               const State& state,
+                               const State* current,
+                               const wxRect* outerClip) const
+{
+    // Objects which were not set when recording are left unchanged.
+    if ( state.pen != -1 && (!current || current->pen != state.pen) )
+        dc.SetPen(m_pens[state.pen]);
+    if ( state.brush != -1 && (!current || current->brush != state.brush) )
+        dc.SetBrush(m_brushes[state.brush]);
+    if ( state.background != -1 &&
+            (!current || current->background != state.background) )
+        dc.SetBackground(m_brushes[state.background]);
+    if ( state.font != -1 && (!current || current->font != state.font) )
+        dc.SetFont(m_fonts[state.font]);
+
+    if ( !current || current->textForeground != state.textForeground )
+        dc.SetTextForeground(state.textForeground);
+    if ( !current || current->textBackground != state.textBackground )
+        dc.SetTextBackground(state.textBackground);
+    if ( !current || current->backgroundMode != state.backgroundMode )
+        dc.SetBackgroundMode(state.backgroundMode);
+    if ( !current || current->logicalFunction != state.logicalFunction )
+        dc.SetLogicalFunction(state.logicalFunction);
+
+    const bool wasClipping = current && current->clipping;
+    if ( wasClipping != state.clipping ||
+            (state.clipping && current->clipRect != state.clipRect) )
+    {
+        if ( wasClipping )
+        {
+            dc.DestroyClippingRegion();
+            if ( outerClip )
+                dc.SetClippingRegion(*outerClip);
+        }
+
+        // Setting the clipping region intersects it with the outer one.
+        if ( state.clipping && !state.clipRect.IsEmpty() )
+            dc.SetClippingRegion(state.clipRect);
+    }
+}
+
+void wxDisplayList::ReplayEntry(wxDC& dc,
+                                const Entry& entry,
+                                std::vector<wxPoint>& points) const
+{
+    DataReader r(m_data, entry.offset);
+
+    switch ( r.Byte() )
+    {
+        case RecordOp_Clear:
+            dc.Clear();
+            break;
+
+        case RecordOp_Point:
+            {
+                const wxPoint pt = r.Point();
+                if ( r.IsOk() )
+                    dc.DrawPoint(pt);
+            }
+            break;
+
+        case RecordOp_Line:
+            {
+                const wxPoint pt1 = r.Point();
+                const wxPoint pt2 = r.Point();
+                if ( r.IsOk() )
+                    dc.DrawLine(pt1, pt2);
+            }
+            break;
+
+        case RecordOp_Lines:
+            if ( r.Points(points) )
+                dc.DrawLines(points.size(), points.data());
+            break;
+
+        case RecordOp_Polygon:
+            {
+                const wxPolygonFillMode
+                    fillStyle = static_cast<wxPolygonFillMode>(r.Byte());
+                if ( r.Points(points) )
+                    dc.DrawPolygon(points.size(), points.data(), 0, 0, fillStyle);
+            }
+            break;
+
+        case RecordOp_Rectangle:
+            {
+                const wxRect rect = r.Rect();
+                if ( r.IsOk() )
+                    dc.DrawRectangle(rect);
+            }
+            break;
+
+        case RecordOp_RoundedRectangle:
+            {
+                const wxRect rect = r.Rect();
+                const double radius = r.Double();
+                if ( r.IsOk() )
+                    dc.DrawRoundedRectangle(rect, radius);
+            }
+            break;
+
+        case RecordOp_Ellipse:
+            {
+                const wxRect rect = r.Rect();
+                if ( r.IsOk() )
+                    dc.DrawEllipse(rect);
+            }
+            break;
+
+        case RecordOp_Arc:
+            {
+                const wxPoint pt1 = r.Point();
+                const wxPoint pt2 = r.Point();
+                const wxPoint centre = r.Point();
+                if ( r.IsOk() )
+                    dc.DrawArc(pt1, pt2, centre);
+            }
+            break;
+
+        case RecordOp_EllipticArc:
+            {
+                const wxRect rect = r.Rect();
+                const double sa = r.Double();
+                const double ea = r.Double();
+                if ( r.IsOk() )
+                    dc.DrawEllipticArc(rect.GetPosition(), rect.GetSize(), sa, ea);
+            }
+            break;
+
+        case RecordOp_Text:
+            {
+                const wxPoint pt = r.Point();
+                const wxString text = r.String();
+                if ( r.IsOk() )
+                    dc.DrawText(text, pt);
+            }
+            break;
+
+        case RecordOp_RotatedText:
+            {
+                const wxPoint pt = r.Point();
+                const double angle = r.Double();
+                const wxString text = r.String();
+                if ( r.IsOk() )
+                    dc.DrawRotatedText(text, pt, angle);
+            }
+            break;
+
+        case RecordOp_Bitmap:
+            {
+                const wxUint64 index = r.UInt();
+                const wxRect rect = r.Rect();
+                const bool useMask = r.Byte() != 0;
+                const wxRasterOperationMode
+                    rop = static_cast<wxRasterOperationMode>(r.Byte());
+                if ( !r.IsOk() || index >= m_bitmaps.size() )
+                    break;
+
+                const wxBitmap& bmp = m_bitmaps[index];
+                const wxSize size = bmp.GetLogicalSize();
+                if ( rect.GetSize() == size && rop == wxCOPY )
+                {
+                    dc.DrawBitmap(bmp, rect.GetPosition(), useMask);
+                }
+                else
+                {
+                    wxMemoryDC memDC;
+                    memDC.SelectObjectAsSource(bmp);
+                    dc.StretchBlit(rect.GetPosition(), rect.GetSize(),
+                                   &memDC, wxPoint(0, 0), size,
+                                   rop, useMask);
+                }
+            }
+            break;
+
+        case RecordOp_GradientLinear:
+            {
+                const wxRect rect = r.Rect();
+                const wxColour initial = r.Colour();
+                const wxColour dest = r.Colour();
+                const wxDirection dir = static_cast<wxDirection>(r.Byte());
+                if ( r.IsOk() )
+                    dc.GradientFillLinear(rect, initial, dest, dir);
+            }
+            break;
+
+        case RecordOp_GradientConcentric:
+            {
+                const wxRect rect = r.Rect();
+                const wxColour initial = r.Colour();
+                const wxColour dest = r.Colour();
+                const wxPoint centre = r.Point();
+                if ( r.IsOk() )
+                    dc.GradientFillConcentric(rect, initial, dest, centre);
+            }
+            break;
+
+        case RecordOp_CrossHair:
+            {
+                const wxPoint pt = r.Point();
+                if ( r.IsOk() )
+                    dc.CrossHair(pt);
+            }
+            break;
+
+        case RecordOp_FloodFill:
+            {
+                const wxPoint pt = r.Point();
+                const wxColour col = r.Colour();
+                const wxFloodFillStyle
+                    style = static_cast<wxFloodFillStyle>(r.Byte());
+                if ( r.IsOk() )
+                    dc.FloodFill(pt, col, style);
+            }
+            break;
+
+        case RecordOp_Max:
+            // Invalid operations are rejected by Load(), so this can't happen.
+            wxFAIL_MSG(wxS("unknown display list operation"));
+            break;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// serialization
+// ----------------------------------------------------------------------------
+
+#if wxUSE_STREAMS && wxUSE_IMAGE
+
+namespace
+{
+
+const char DISPLAY_LIST_MAGIC[] = "wxDL";
+const wxUint32 DISPLAY_LIST_VERSION = 2;
+
+// Limit on the number of elements of any kind in the file. Note that the
+// containers are still never allocated using the counts read from the file
+// but grow while reading their elements, so that a corrupted file can't make
+// us allocate much more memory than its size.
+const wxUint64 MAX_ELEMENTS = 0x10000000;
+
+// Read the given number of bytes, growing the buffer gradually for the reason
+// explained above.
+bool ReadData(wxInputStream& stream, wxUint64 size,
+              std::vector<unsigned char>& data)
+{
+    const size_t CHUNK_SIZE = 0x100000;
+
+    data.clear();
+    while ( data.size() < size )
+    {
+        const size_t offset = data.size();
+        const size_t len = static_cast<size_t>(wxMin(size - offset,
+                                                     wxUint64(CHUNK_SIZE)));
+        data.resize(offset + len);
+        if ( stream.Read(&data[offset], len).LastRead() != len )
+            return false;
+    }
+
+    return true;
+}
+
+bool ReadCount(wxDataInputStream& ds, size_t& count)
+{
+    const wxUint64 n = ds.Read64();
+    if ( !ds.IsOk() || n > MAX_ELEMENTS )
+        return false;
+
+    count = static_cast<size_t>(n);
+    return true;
+}
+
+void WriteColour(wxDataOutputStream& ds, const wxColour& colour)
+{
+    ds.Write8(colour.IsOk());
+    ds.Write8(colour.Red());
+    ds.Write8(colour.Green());
+    ds.Write8(colour.Blue());
+    ds.Write8(colour.Alpha());
+}
+
+wxColour ReadColour(wxDataInputStream& ds)
+{
+    const bool ok = ds.Read8() != 0;
+    const wxUint8 r = ds.Read8();
+    const wxUint8 g = ds.Read8();
+    const wxUint8 b = ds.Read8();
+    const wxUint8 a = ds.Read8();
+    return ok ? wxColour(r, g, b, a) : wxColour();
+}
+
+void WriteRect(wxDataOutputStream& ds, const wxRect& rect)
+{
+    ds.Write32(static_cast<wxUint32>(rect.x));
+    ds.Write32(static_cast<wxUint32>(rect.y));
+    ds.Write32(static_cast<wxUint32>(rect.width));
+    ds.Write32(static_cast<wxUint32>(rect.height));
+}
+
+wxRect ReadRect(wxDataInputStream& ds)
+{
+    const wxInt32 x = static_cast<wxInt32>(ds.Read32());
+    const wxInt32 y = static_cast<wxInt32>(ds.Read32());
+    const wxInt32 w = static_cast<wxInt32>(ds.Read32());
+    const wxInt32 h = static_cast<wxInt32>(ds.Read32());
+    return wxRect(x, y, w, h);
+}
+
+// Bitmaps are stored as their RGB(A) data, which is portable between
+// platforms, together with their mask colour, if any.
+void WriteBitmap(wxDataOutputStream& ds, wxOutputStream& stream,
+                 const wxBitmap& bitmap)
+{
+    ds.Write8(bitmap.IsOk());
+    if ( !bitmap.IsOk() )
+        return;
+
+    const wxImage image = bitmap.ConvertToImage();
+    const int w = image.GetWidth();
+    const int h = image.GetHeight();
+
+    ds.Write32(w);
+    ds.Write32(h);
+    ds.WriteDouble(bitmap.GetScaleFactor());
+
+    ds.Write8(image.HasMask());
+    ds.Write8(image.GetMaskRed());
+    ds.Write8(image.GetMaskGreen());
+    ds.Write8(image.GetMaskBlue());
+
+    const size_t numPixels = static_cast<size_t>(w)*h;
+    stream.Write(image.GetData(), 3*numPixels);
+
+    ds.Write8(image.HasAlpha());
+    if ( image.HasAlpha() )
+        stream.Write(image.GetAlpha(), numPixels);
+}
+
+bool ReadBitmap(wxDataInputStream& ds, wxInputStream& stream,
+                wxBitmap& bitmap)
+{
+    if ( !ds.Read8() )
+    {
+        bitmap = wxBitmap();
+        return ds.IsOk();
+    }
+
+    const wxUint32 w = ds.Read32();
+    const wxUint32 h = ds.Read32();
+    const double scale = ds.ReadDouble();
+
+    const bool hasMask = ds.Read8() != 0;
+    const wxUint8 maskRed = ds.Read8();
+    const wxUint8 maskGreen = ds.Read8();
+    const wxUint8 maskBlue = ds.Read8();
+
+    if ( !ds.IsOk() || !w || !h || wxUint64(w)*h > MAX_ELEMENTS )
+        return false;
+
+    // Don't create the image before reading its data, as its size may be
+    // wrong.
+    const size_t numPixels = static_cast<size_t>(w)*h;
+    std::vector<unsigned char> rgb;
+    if ( !ReadData(stream, 3*numPixels, rgb) )
+        return false;
+
+    std::vector<unsigned char> alpha;
+    const bool hasAlpha = ds.Read8() != 0;
+    if ( !ds.IsOk() || (hasAlpha && !ReadData(stream, numPixels, alpha)) )
+        return false;
+
+    wxImage image(w, h, false);
+    if ( !image.IsOk() )
+        return false;
+
+    memcpy(image.GetData(), rgb.data(), rgb.size());
+    if ( hasAlpha )
+    {
+        image.SetAlpha();
+        memcpy(image.GetAlpha(), alpha.data(), alpha.size());
+    }
+
+    if ( hasMask )
+        image.SetMaskColour(maskRed, maskGreen, maskBlue);
+
+    bitmap = wxBitmap(image, wxBITMAP_SCREEN_DEPTH, scale > 0 ? scale : 1.0);
+    return bitmap.IsOk();
+}
+
+} // anonymous namespace
+
+bool wxDisplayList::Save(wxOutputStream& stream) const
+{
+    wxDataOutputStream ds(stream);
+
+    stream.Write(DISPLAY_LIST_MAGIC, 4);
+    ds.Write32(DISPLAY_LIST_VERSION);
+
+    ds.Write64(static_cast<wxUint64>(m_bitmaps.size()));
+    for ( const wxBitmap& bitmap : m_bitmaps )
+        WriteBitmap(ds, stream, bitmap);
+
+    ds.Write64(static_cast<wxUint64>(m_pens.size()));
+    for ( const wxPen& pen : m_pens )
+    {
+        WriteColour(ds, pen.GetColour());
+        ds.Write32(pen.GetWidth());
+        ds.Write32(pen.GetStyle());
+        ds.Write32(pen.GetCap());
+        ds.Write32(pen.GetJoin());
+
+        wxDash* dashes = nullptr;
+        const int numDashes = pen.GetStyle() == wxPENSTYLE_USER_DASH
+                                ? pen.GetDashes(&dashes)
+                                : 0;
+        // Dashes are saved as 32-bit values as wxDash is not the same type
+        // in all ports.
+        ds.Write32(dashes ? numDashes : 0);
+        for ( int n = 0; dashes && n < numDashes; n++ )
+            ds.Write32(static_cast<wxUint32>(static_cast<wxInt32>(dashes[n])));
+
+        const wxBitmap* const stipple = pen.GetStyle() == wxPENSTYLE_STIPPLE
+                                            ? pen.GetStipple()
+                                            : nullptr;
+        WriteBitmap(ds, stream, stipple ? *stipple : wxNullBitmap);
+    }
+
+    ds.Write64(static_cast<wxUint64>(m_brushes.size()));
+    for ( const wxBrush& brush : m_brushes )
+    {
+        WriteColour(ds, brush.GetColour());
+        ds.Write32(brush.GetStyle());
+        const wxBitmap* stipple = nullptr;
+        switch ( brush.GetStyle() )
+        {
+            case wxBRUSHSTYLE_STIPPLE:
+            case wxBRUSHSTYLE_STIPPLE_MASK:
+            case wxBRUSHSTYLE_STIPPLE_MASK_OPAQUE:
+                stipple = brush.GetStipple();
+                break;
+
+            default:
+                break;
+        }
+        WriteBitmap(ds, stream, stipple ? *stipple : wxNullBitmap);
+    }
+
+    ds.Write64(static_cast<wxUint64>(m_fonts.size()));
+    for ( const wxFont& font : m_fonts )
+    {
+        ds.WriteDouble(font.GetFractionalPointSize());
+        ds.Write32(font.GetFamily());
+        ds.Write32(font.GetStyle());
+        ds.Write32(font.GetNumericWeight());
+        ds.Write8(font.GetUnderlined());
+        ds.Write8(font.GetStrikethrough());
+        ds.WriteString(font.GetFaceName());
+    }
+
+    ds.Write64(static_cast<wxUint64>(m_states.size()));
+    for ( const State& state : m_states )
+    {
+        ds.Write32(static_cast<wxUint32>(state.pen));
+        ds.Write32(static_cast<wxUint32>(state.brush));
+        ds.Write32(static_cast<wxUint32>(state.background));
+        ds.Write32(static_cast<wxUint32>(state.font));
+        WriteColour(ds, state.textForeground);
+        WriteColour(ds, state.textBackground);
+        ds.Write32(state.backgroundMode);
+        ds.Write32(state.logicalFunction);
+        ds.Write8(state.clipping);
+        WriteRect(ds, state.clipRect);
+    }
+
+    ds.Write64(static_cast<wxUint64>(m_entries.size()));
+    for ( const Entry& entry : m_entries )
+    {
+        ds.Write64(static_cast<wxUint64>(entry.offset));
+        ds.Write64(static_cast<wxUint64>(entry.state));
+        WriteRect(ds, entry.bbox);
+    }
+
+    ds.Write64(static_cast<wxUint64>(m_data.size()));
+    stream.Write(m_data.data(), m_data.size());
+
+    return ds.IsOk();
+}
+
+bool wxDisplayList::Load(wxInputStream& stream)
+{
+    char magic[4];
+    if ( stream.Read(magic, 4).LastRead() != 4 ||
+            memcmp(magic, DISPLAY_LIST_MAGIC, 4) != 0 )
+        return false;
+
+    wxDataInputStream ds(stream);
+    if ( ds.Read32() != DISPLAY_LIST_VERSION )
+        return false;
+
+    // Load everything into a temporary object to leave this one unchanged in
+    // case of an error.
+    wxDisplayList list;
+
+    size_t count;
+    if ( !ReadCount(ds, count) )
+        return false;
+
+    for ( size_t n = 0; n < count; n++ )
+    {
+        wxBitmap bitmap;
+        if ( !ReadBitmap(ds, stream, bitmap) )
+            return false;
+
+        list.m_bitmaps.push_back(bitmap);
+    }
+
+    if ( !ReadCount(ds, count) )
+        return false;
+
+    for ( size_t n = 0; n < count; n++ )
+    {
+        const wxColour colour = ReadColour(ds);
+        const int width = ds.Read32();
+        const wxPenStyle style = static_cast<wxPenStyle>(ds.Read32());
+        const wxPenCap cap = static_cast<wxPenCap>(ds.Read32());
+        const wxPenJoin join = static_cast<wxPenJoin>(ds.Read32());
+
+        const wxUint32 numDashes = ds.Read32();
+        if ( !ds.IsOk() || numDashes > 0xff )
+            return false;
+
+        std::vector<wxDash> dashes(numDashes);
+        for ( wxDash& dash : dashes )
+            dash = static_cast<wxDash>(static_cast<wxInt32>(ds.Read32()));
+
+        wxBitmap stipple;
+        if ( !ReadBitmap(ds, stream, stipple) )
+            return false;
+
+        wxPen pen(wxPenInfo(colour, width, style).Cap(cap).Join(join));
+        if ( !dashes.empty() )
+        {
+            list.m_dashes.push_back(std::move(dashes));
+            const std::vector<wxDash>& d = list.m_dashes.back();
+            pen.SetDashes(d.size(), d.data());
+        }
+        if ( stipple.IsOk() )
+            pen.SetStipple(stipple);
+
+        list.m_pens.push_back(pen);
+    }
+
+    if ( !ReadCount(ds, count) )
+        return false;
+
+    for ( size_t n = 0; n < count; n++ )
+    {
+        const wxColour colour = ReadColour(ds);
+        const wxBrushStyle style = static_cast<wxBrushStyle>(ds.Read32());
+
+        wxBitmap stipple;
+        if ( !ReadBitmap(ds, stream, stipple) )
+            return false;
+
+        if ( stipple.IsOk() )
+            list.m_brushes.push_back(wxBrush(stipple));
+        else
+            list.m_brushes.push_back(wxBrush(colour, style));
+    }
+
+    if ( !ReadCount(ds, count) )
+        return false;
+
+    for ( size_t n = 0; n < count; n++ )
+    {
+        const double pointSize = ds.ReadDouble();
+        const wxFontFamily family = static_cast<wxFontFamily>(ds.Read32());
+        const wxFontStyle style = static_cast<wxFontStyle>(ds.Read32());
+        const int weight = ds.Read32();
+        const bool underlined = ds.Read8() != 0;
+        const bool strikethrough = ds.Read8() != 0;
+        const wxString faceName = ds.ReadString();
+        if ( !ds.IsOk() )
+            return false;
+
+        list.m_fonts.push_back(wxFont(wxFontInfo(pointSize)
+                                        .Family(family)
+                                        .Style(style)
+                                        .Weight(weight)
+                                        .Underlined(underlined)
+                                        .Strikethrough(strikethrough)
+                                        .FaceName(faceName)));
+    }
+
+    if ( !ReadCount(ds, count) )
+        return false;
+
+    const auto isValidIndex = [](int index, size_t size)
+    {
+        return index == -1 || (index >= 0 && static_cast<size_t>(index) < size);
+    };
+
+    for ( size_t n = 0; n < count; n++ )
+    {
+        State state;
+        state.pen = static_cast<wxInt32>(ds.Read32());
+        state.brush = static_cast<wxInt32>(ds.Read32());
+        state.background = static_cast<wxInt32>(ds.Read32());
+        state.font = static_cast<wxInt32>(ds.Read32());
+        state.textForeground = ReadColour(ds);
+        state.textBackground = ReadColour(ds);
+        state.backgroundMode = ds.Read32();
+        state.logicalFunction = static_cast<wxRasterOperationMode>(ds.Read32());
+        state.clipping = ds.Read8() != 0;
+        state.clipRect = ReadRect(ds);
+
+        if ( !ds.IsOk() ||
+                !isValidIndex(state.pen, list.m_pens.size()) ||
+                !isValidIndex(state.brush, list.m_brushes.size()) ||
+                !isValidIndex(state.background, list.m_brushes.size()) ||
+                !isValidIndex(state.font, list.m_fonts.size()) )
+            return false;
+
+        list.m_states.push_back(state);
+    }
+
+    if ( !ReadCount(ds, count) )
+        return false;
+
+    for ( size_t n = 0; n < count; n++ )
+    {
+        Entry entry;
+        const wxUint64 offset = ds.Read64();
+        const wxUint64 state = ds.Read64();
+        entry.bbox = ReadRect(ds);
+
+        if ( !ds.IsOk() || state >= list.m_states.size() )
+            return false;
+
+        entry.offset = static_cast<size_t>(offset);
+        entry.state = static_cast<size_t>(state);
+
+        list.m_entries.push_back(entry);
+    }
+
+    const wxUint64 dataSize = ds.Read64();
+    if ( !ds.IsOk() || dataSize > 16*MAX_ELEMENTS )
+        return false;
+
+    if ( !ReadData(stream, dataSize, list.m_data) )
+        return false;
+
+    // The operation arguments are checked when replaying them, but check the
+    // operations themselves here.
+    for ( const Entry& entry : list.m_entries )
+    {
+        if ( entry.offset >= list.m_data.size() ||
+                list.m_data[entry.offset] >= RecordOp_Max )
+            return false;
+    }
+
+    *this = std::move(list);
+
+    return true;
+}
+
+#endif // wxUSE_STREAMS && wxUSE_IMAGE
@@ -28,6 +28,10 @@
 #include "wx/display.h"
 #include "wx/private/rescale.h"
 
+#if wxUSE_ZLIB
+    #include "wx/zstream.h"
+#endif
+
 #if wxUSE_MARKUP
     #include "wx/private/markupparser.h"
 #endif
@@ -61,6 +65,97 @@ inline wxString NumStr(float f)
     return NumStr(double(f));
 }
 
+// The functions below append to the output string directly. They are used
+// for the output of every primitive instead of wxString::Format() because
+// they are much faster and don't allocate any memory.
+void AppendIntStr(std::string& s, long n)
+{
+    char buf[32];
+    char* const end = buf + sizeof(buf);
+    char* p = end;
+
+    unsigned long u = n < 0 ? 0ul - static_cast<unsigned long>(n) : n;
+    do
+    {
+        *--p = static_cast<char>('0' + u % 10);
+        u /= 10;
+    } while ( u );
+
+    if ( n < 0 )
+        *--p = '-';
+
+    s.append(p, end - p);
+}
+
+// Append the same representation of the number as returned by NumStr().
+void AppendNumStr(std::string& s, double f)
+{
+    if ( f == 0 )
+    {
+        s += "0.00";
+        return;
+    }
+
+    // Use the slow but general version for the values which can't be handled
+    // below, including NaN.
+    const double a = fabs(f);
+    if ( !(a < 1e13) )
+    {
+        s += NumStr(f).utf8_string();
+        return;
+    }
+
+    // Round the number to 2 decimal digits in the same way as printf() does
+    // it, i.e. using its exact binary value and rounding the ties to even:
+    // compare the exact value of 200*a, computed as x + e, with the midpoint
+    // between the two candidates, which is an exactly representable integer.
+    const double lo = floor(a * 100);
+    const double mid = 2*lo + 1;
+    const double x = a * 200;
+    const double e = fma(a, 200, -x);
+    const bool roundUp = x > mid ||
+                         (x == mid && (e > 0 || (e == 0 && fmod(lo, 2) != 0)));
+
+    unsigned long long u = static_cast<unsigned long long>(lo) + roundUp;
+
+    char buf[32];
+    char* const end = buf + sizeof(buf);
+    char* p = end;
+
+    *--p = static_cast<char>('0' + u % 10);
+    u /= 10;
+    *--p = static_cast<char>('0' + u % 10);
+    u /= 10;
+    *--p = '.';
+    do
+    {
+        *--p = static_cast<char>('0' + u % 10);
+        u /= 10;
+    } while ( u );
+
+    if ( f < 0 )
+        *--p = '-';
+
+    s.append(p, end - p);
+}
+
+// Append the colour as "#RRGGBB" string, as Col2SVG() does.
+void AppendColour(std::string& s, const wxColour& c, float* opacity)
+{
+    static const char hexDigits[] = "0123456789ABCDEF";
+
+    const unsigned char rgb[] = { c.Red(), c.Green(), c.Blue() };
+
+    s += '#';
+    for ( unsigned char v : rgb )
+    {
+        s += hexDigits[v >> 4];
+        s += hexDigits[v & 0xf];
+    }
+
+    *opacity = c.Alpha() != wxALPHA_OPAQUE ? c.Alpha() / 255.0f : 1.0f;
+}
+
 // Return the colour representation as HTML-like "#rrggbb" string and also
 // returns its alpha as opacity number in 0..1 range.
 wxString Col2SVG(wxColour c, float* opacity = nullptr)
@@ -83,10 +178,12 @@ wxString Col2SVG(wxColour c, float* opacity = nullptr)
     return c.GetAsString(wxC2S_HTML_SYNTAX);
 }
 
-wxString GetPenStroke(const wxColour& c, int style = wxPENSTYLE_SOLID)
+void AppendPenStroke(std::string& s, const wxColour& c, int style = wxPENSTYLE_SOLID)
 {
     float opacity;
-    wxString s = wxS("stroke:") + Col2SVG(c, &opacity) + wxS(";");
+    s += "stroke:";
+    AppendColour(s, c, &opacity);
+    s += ';';
 
     switch ( style )
     {
@@ -96,23 +193,32 @@ wxString GetPenStroke(const wxColour& c, int style = wxPENSTYLE_SOLID)
         case wxPENSTYLE_LONG_DASH:
         case wxPENSTYLE_DOT_DASH:
         case wxPENSTYLE_USER_DASH:
-            s += wxString::Format(wxS(" stroke-opacity:%s;"), NumStr(opacity));
+            s += " stroke-opacity:";
+            AppendNumStr(s, opacity);
+            s += ';';
             break;
         case wxPENSTYLE_TRANSPARENT:
-            s += wxS(" stroke-opacity:0.0;");
+            s += " stroke-opacity:0.0;";
             break;
         default:
             wxASSERT_MSG(false, wxS("wxSVGFileDC::Requested Pen Style not available"));
             break;
     }
+}
 
-    return s;
+wxString GetPenStroke(const wxColour& c, int style = wxPENSTYLE_SOLID)
+{
+    std::string s;
+    AppendPenStroke(s, c, style);
+    return wxString::FromUTF8(s);
 }
 
-wxString GetBrushFill(const wxColour& c, int style = wxBRUSHSTYLE_SOLID)
+void AppendBrushFill(std::string& s, const wxColour& c, int style = wxBRUSHSTYLE_SOLID)
 {
     float opacity;
-    wxString s = wxS("fill:") + Col2SVG(c, &opacity) + wxS(";");
+    s += "fill:";
+    AppendColour(s, c, &opacity);
+    s += ';';
 
     switch ( style )
     {
@@ -123,17 +229,24 @@ wxString GetBrushFill(const wxColour& c, int style = wxBRUSHSTYLE_SOLID)
         case wxBRUSHSTYLE_CROSS_HATCH:
         case wxBRUSHSTYLE_VERTICAL_HATCH:
         case wxBRUSHSTYLE_HORIZONTAL_HATCH:
-            s += wxString::Format(wxS(" fill-opacity:%s;"), NumStr(opacity));
+            s += " fill-opacity:";
+            AppendNumStr(s, opacity);
+            s += ';';
             break;
         case wxBRUSHSTYLE_TRANSPARENT:
-            s += wxS(" fill-opacity:0.0;");
+            s += " fill-opacity:0.0;";
             break;
         default:
             wxASSERT_MSG(false, wxS("wxSVGFileDC::Requested Brush Style not available"));
             break;
     }
+}
 
-    return s;
+wxString GetBrushFill(const wxColour& c, int style = wxBRUSHSTYLE_SOLID)
+{
+    std::string s;
+    AppendBrushFill(s, c, style);
+    return wxString::FromUTF8(s);
 }
 
 wxString GetPenPattern(const wxPen& pen)
@@ -201,41 +314,39 @@ wxString GetPenPattern(const wxPen& pen)
     return s;
 }
 
-wxString GetPenStyle(const wxPen& pen)
+void AppendPenStyle(std::string& penStyle, const wxPen& pen)
 {
-    wxString penStyle;
-
-    penStyle += wxString::Format(wxS("stroke-width:%d;"), pen.GetWidth());
+    penStyle += "stroke-width:";
+    AppendIntStr(penStyle, pen.GetWidth());
+    penStyle += ';';
 
     switch (pen.GetCap())
     {
         case wxCAP_PROJECTING:
-            penStyle += wxS(" stroke-linecap:square;");
+            penStyle += " stroke-linecap:square;";
             break;
         case wxCAP_BUTT:
-            penStyle += wxS(" stroke-linecap:butt;");
+            penStyle += " stroke-linecap:butt;";
             break;
         case wxCAP_ROUND:
         default:
-            penStyle += wxS(" stroke-linecap:round;");
+            penStyle += " stroke-linecap:round;";
             break;
     }
 
     switch (pen.GetJoin())
     {
         case wxJOIN_BEVEL:
-            penStyle += wxS(" stroke-linejoin:bevel;");
+            penStyle += " stroke-linejoin:bevel;";
             break;
         case wxJOIN_MITER:
-            penStyle += wxS(" stroke-linejoin:miter;");
+            penStyle += " stroke-linejoin:miter;";
             break;
         case wxJOIN_ROUND:
         default:
-            penStyle += wxS(" stroke-linejoin:round;");
+            penStyle += " stroke-linejoin:round;";
             break;
     }
-
-    return penStyle;
 }
 
 wxString GetBrushStyleName(const wxBrush& brush)
@@ -506,6 +617,11 @@ void wxSVGFileDC::SetShapeRenderingMode(wxSVGShapeRenderingMode renderingMode)
     ((wxSVGFileDCImpl*)GetImpl())->SetShapeRenderingMode(renderingMode);
 }
 
+void wxSVGFileDC::EnableStyleClasses(bool enable)
+{
+    ((wxSVGFileDCImpl*)GetImpl())->EnableStyleClasses(enable);
+}
+
 // ----------------------------------------------------------
 // wxSVGFileDCImpl
 // ----------------------------------------------------------
@@ -527,8 +643,6 @@ void wxSVGFileDCImpl::Init(const wxString& filename, int width, int height,
 
     m_dpi = dpi;
 
-    m_OK = true;
-
     m_clipUniqueId = 0;
     m_clipNestingLevel = 0;
 
@@ -550,15 +664,35 @@ void wxSVGFileDCImpl::Init(const wxString& filename, int width, int height,
 
     m_renderingMode = wxSVG_SHAPE_RENDERING_AUTO;
 
+    m_useStyleClasses = false;
+    m_styleClasses.clear();
+
+    UpdatePenAttrs();
+    UpdateBrushAttrs();
+    UpdateRenderModeAttr();
+
     ////////////////////code here
 
     m_bmp_handler.reset();
 
+    m_zoutfile.reset();
     if ( m_filename.empty() )
         m_outfile.reset();
     else
         m_outfile.reset(new wxFileOutputStream(m_filename));
 
+#if wxUSE_ZLIB
+    // Compress the output if the file has the extension used for the
+    // compressed SVG files.
+    if ( m_outfile && wxFileName(m_filename).GetExt().IsSameAs("svgz", false) )
+        m_zoutfile.reset(new wxZlibOutputStream(*m_outfile, -1, wxZLIB_GZIP));
+#endif // wxUSE_ZLIB
+
+    m_buffer.clear();
+
+    const wxOutputStream* const stream = GetOutputStream();
+    m_OK = stream && stream->IsOk();
+
     const wxSize dpiSize = FromDIP(wxSize(m_width, m_height));
 
     wxString s;
@@ -583,6 +717,11 @@ wxSVGFileDCImpl::~wxSVGFileDCImpl()
 
     s += wxS("</g>\n</svg>\n");
     write(s);
+
+    WriteBuffer();
+
+    // Close the compressed stream before the file it writes to.
+    m_zoutfile.reset();
 }
 
 void wxSVGFileDCImpl::DoGetSizeMM(int* width, int* height) const
@@ -627,11 +766,21 @@ void wxSVGFileDCImpl::DoDrawLine(wxCoord x1, wxCoord y1, wxCoord x2, wxCoord y2)
 {
     NewGraphicsIfNeeded();
 
-    wxString s;
-    s = wxString::Format(wxS("  <path d=\"M%d %d L%d %d\" %s %s/>\n"),
-        x1, y1, x2, y2, GetRenderMode(m_renderingMode), GetPenPattern(m_pen));
-
-    write(s);
+    Append("  <path d=\"M");
+    AppendInt(x1);
+    Append(" ");
+    AppendInt(y1);
+    Append(" L");
+    AppendInt(x2);
+    Append(" ");
+    AppendInt(y2);
+    Append("\" ");
+    Append(m_renderModeAttr);
+    Append(" ");
+    Append(m_penPatternAttr);
+    Append("/>\n");
+
+    WriteBufferIfNeeded();
 
     if ( AreAutomaticBoundingBoxUpdatesEnabled() )
         CalcBoundingBox(x1, y1, x2, y2);
@@ -642,25 +791,32 @@ void wxSVGFileDCImpl::DoDrawLines(int n, const wxPoint points[], wxCoord xoffset
     if (n > 1)
     {
         NewGraphicsIfNeeded();
-        wxString s;
 
-        s = wxString::Format(wxS("  <path d=\"M%d %d"),
-            (points[0].x + xoffset), (points[0].y + yoffset));
+        Append("  <path d=\"M");
+        AppendInt(points[0].x + xoffset);
+        Append(" ");
+        AppendInt(points[0].y + yoffset);
 
         if ( AreAutomaticBoundingBoxUpdatesEnabled() )
             CalcBoundingBox(points[0].x + xoffset, points[0].y + yoffset);
 
         for (int i = 1; i < n; ++i)
         {
-            s += wxString::Format(wxS(" L%d %d"), (points[i].x + xoffset), (points[i].y + yoffset));
+            Append(" L");
+            AppendInt(points[i].x + xoffset);
+            Append(" ");
+            AppendInt(points[i].y + yoffset);
             if ( AreAutomaticBoundingBoxUpdatesEnabled() )
                 CalcBoundingBox(points[i].x + xoffset, points[i].y + yoffset);
         }
 
-        s += wxString::Format(wxS("\" style=\"fill:none\" %s %s/>\n"),
-            GetRenderMode(m_renderingMode), GetPenPattern(m_pen));
+        Append("\" style=\"fill:none\" ");
+        Append(m_renderModeAttr);
+        Append(" ");
+        Append(m_penPatternAttr);
+        Append("/>\n");
 
-        write(s);
+        WriteBufferIfNeeded();
     }
 }
 
@@ -717,7 +873,7 @@ void wxSVGFileDCImpl::DoDrawSpline(const wxPointList* points)
         CalcBoundingBox(wxRound(p2.m_x), wxRound(p2.m_y));
 
     s += wxString::Format("\" style=\"fill:none\" %s %s/>\n",
-                          GetRenderMode(m_renderingMode), GetPenPattern(m_pen));
+                          m_renderModeAttr, m_penPatternAttr);
     write(s);
 }
 #endif // wxUSE_SPLINES
@@ -726,15 +882,13 @@ void wxSVGFileDCImpl::DoDrawPoint(wxCoord x, wxCoord y)
 {
     NewGraphicsIfNeeded();
 
-    wxString s;
-
-    s = wxS("  <g style=\"stroke-width:1; stroke-linecap:round;\">\n  ");
-    write(s);
+    Append("  <g style=\"stroke-width:1; stroke-linecap:round;\">\n  ");
 
     DoDrawLine(x, y, x, y);
 
-    s = wxS("  </g>\n");
-    write(s);
+    Append("  </g>\n");
+
+    WriteBufferIfNeeded();
 }
 
 void wxSVGFileDCImpl::DoDrawText(const wxString& text, wxCoord x, wxCoord y)
@@ -837,7 +991,7 @@ void wxSVGFileDCImpl::DoDrawRotatedText(const wxString& sText, wxCoord x, wxCoor
             s = wxString::Format(
                 wxS("  <rect x=\"%s\" y=\"%s\" width=\"%d\" height=\"%d\" %s %s %s/>\n"),
                 NumStr(xRect), NumStr(yRect), ww, hh,
-                GetRenderMode(m_renderingMode), rectStyle, rectTransform);
+                m_renderModeAttr, rectStyle, rectTransform);
 
             write(s);
         }
@@ -868,13 +1022,26 @@ void wxSVGFileDCImpl::DoDrawRectangle(wxCoord x, wxCoord y, wxCoord width, wxCoo
 void wxSVGFileDCImpl::DoDrawRoundedRectangle(wxCoord x, wxCoord y, wxCoord width, wxCoord height, double radius)
 {
     NewGraphicsIfNeeded();
-    wxString s;
 
-    s = wxString::Format(wxS("  <rect x=\"%d\" y=\"%d\" width=\"%d\" height=\"%d\" rx=\"%s\" %s %s %s/>\n"),
-        x, y, width, height, NumStr(radius),
-        GetRenderMode(m_renderingMode), GetPenPattern(m_pen), GetBrushPattern(m_brush));
-
-    write(s);
+    Append("  <rect x=\"");
+    AppendInt(x);
+    Append("\" y=\"");
+    AppendInt(y);
+    Append("\" width=\"");
+    AppendInt(width);
+    Append("\" height=\"");
+    AppendInt(height);
+    Append("\" rx=\"");
+    AppendNum(radius);
+    Append("\" ");
+    Append(m_renderModeAttr);
+    Append(" ");
+    Append(m_penPatternAttr);
+    Append(" ");
+    Append(m_brushPatternAttr);
+    Append("/>\n");
+
+    WriteBufferIfNeeded();
 
     if ( AreAutomaticBoundingBoxUpdatesEnabled() )
         CalcBoundingBox(wxPoint(x, y), wxSize(width, height));
@@ -886,22 +1053,28 @@ void wxSVGFileDCImpl::DoDrawPolygon(int n, const wxPoint points[],
 {
     NewGraphicsIfNeeded();
 
-    wxString s;
-
-    s = wxS("  <polygon points=\"");
+    Append("  <polygon points=\"");
 
     for (int i = 0; i < n; i++)
     {
-        s += wxString::Format(wxS("%d %d "), points[i].x + xoffset, points[i].y + yoffset);
+        AppendInt(points[i].x + xoffset);
+        Append(" ");
+        AppendInt(points[i].y + yoffset);
+        Append(" ");
         if ( AreAutomaticBoundingBoxUpdatesEnabled() )
             CalcBoundingBox(points[i].x + xoffset, points[i].y + yoffset);
     }
 
-    s += wxString::Format(wxS("\" %s %s %s style=\"fill-rule:%s;\"/>\n"),
-        GetRenderMode(m_renderingMode), GetPenPattern(m_pen), GetBrushPattern(m_brush),
-        fillStyle == wxODDEVEN_RULE ? wxS("evenodd") : wxS("nonzero"));
+    Append("\" ");
+    Append(m_renderModeAttr);
+    Append(" ");
+    Append(m_penPatternAttr);
+    Append(" ");
+    Append(m_brushPatternAttr);
+    Append(fillStyle == wxODDEVEN_RULE ? " style=\"fill-rule:evenodd;\"/>\n"
+                                       : " style=\"fill-rule:nonzero;\"/>\n");
 
-    write(s);
+    WriteBufferIfNeeded();
 }
 
 void wxSVGFileDCImpl::DoDrawPolyPolygon(int n, const int count[], const wxPoint points[],
@@ -953,13 +1126,21 @@ void wxSVGFileDCImpl::DoDrawEllipse(wxCoord x, wxCoord y, wxCoord width, wxCoord
     const double rh = height / 2.0;
     const double rw = width / 2.0;
 
-    wxString s;
-    s = wxString::Format(wxS("  <ellipse cx=\"%s\" cy=\"%s\" rx=\"%s\" ry=\"%s\" %s %s"),
-        NumStr(x + rw), NumStr(y + rh), NumStr(rw), NumStr(rh),
-        GetRenderMode(m_renderingMode), GetPenPattern(m_pen));
-    s += wxS("/>\n");
-
-    write(s);
+    Append("  <ellipse cx=\"");
+    AppendNum(x + rw);
+    Append("\" cy=\"");
+    AppendNum(y + rh);
+    Append("\" rx=\"");
+    AppendNum(rw);
+    Append("\" ry=\"");
+    AppendNum(rh);
+    Append("\" ");
+    Append(m_renderModeAttr);
+    Append(" ");
+    Append(m_penPatternAttr);
+    Append("/>\n");
+
+    WriteBufferIfNeeded();
 
     if ( AreAutomaticBoundingBoxUpdatesEnabled() )
         CalcBoundingBox(wxPoint(x, y), wxSize(width, height));
@@ -1025,7 +1206,7 @@ void wxSVGFileDCImpl::DoDrawArc(wxCoord x1, wxCoord y1, wxCoord x2, wxCoord y2,
     }
 
     s += wxString::Format(wxS("\" %s %s/>\n"),
-        GetRenderMode(m_renderingMode), GetPenPattern(m_pen));
+        m_renderModeAttr, m_penPatternAttr);
 
     write(s);
 }
@@ -1112,7 +1293,7 @@ void wxSVGFileDCImpl::DoDrawEllipticArc(wxCoord x, wxCoord y, wxCoord w, wxCoord
         wxString arcFill = arcPath;
         arcFill += wxString::Format(wxS(" L%s %s z\" %s %s/>\n"),
             NumStr(xc), NumStr(yc),
-            GetRenderMode(m_renderingMode), GetPenPattern(m_pen));
+            m_renderModeAttr, m_penPatternAttr);
         write(arcFill);
     }
 
@@ -1120,7 +1301,7 @@ void wxSVGFileDCImpl::DoDrawEllipticArc(wxCoord x, wxCoord y, wxCoord w, wxCoord
     NewGraphicsIfNeeded();
 
     wxString arcLine = wxString::Format(wxS("%s\" %s %s/>\n"),
-        arcPath, GetRenderMode(m_renderingMode), GetPenPattern(m_pen));
+        arcPath, m_renderModeAttr, m_penPatternAttr);
     write(arcLine);
 }
 
@@ -1154,7 +1335,7 @@ void wxSVGFileDCImpl::DoGradientFillLinear(const wxRect& rect,
 
     s += wxString::Format(wxS("  <rect x=\"%d\" y=\"%d\" width=\"%d\" height=\"%d\" fill=\"url(#gradient%zu)\" %s %s %s/>\n"),
         rect.x, rect.y, rect.width, rect.height, m_gradientUniqueId,
-        GetRenderMode(m_renderingMode), GetPenPattern(m_pen), GetBrushPattern(m_brush));
+        m_renderModeAttr, m_penPatternAttr, m_brushPatternAttr);
 
     m_gradientUniqueId++;
 
@@ -1194,7 +1375,7 @@ void wxSVGFileDCImpl::DoGradientFillConcentric(const wxRect& rect,
 
     s += wxString::Format(wxS("  <rect x=\"%d\" y=\"%d\" width=\"%d\" height=\"%d\" fill=\"url(#gradient%zu)\" %s %s %s/>\n"),
         rect.x, rect.y, rect.width, rect.height, m_gradientUniqueId,
-        GetRenderMode(m_renderingMode), GetPenPattern(m_pen), GetBrushPattern(m_brush));
+        m_renderModeAttr, m_penPatternAttr, m_brushPatternAttr);
 
     m_gradientUniqueId++;
 
@@ -1344,12 +1525,26 @@ void wxSVGFileDCImpl::SetBitmapHandler(wxSVGBitmapHandler* handler)
 void wxSVGFileDCImpl::SetShapeRenderingMode(wxSVGShapeRenderingMode renderingMode)
 {
     m_renderingMode = renderingMode;
+
+    UpdateRenderModeAttr();
+}
+
+void wxSVGFileDCImpl::EnableStyleClasses(bool enable)
+{
+    if ( enable != m_useStyleClasses )
+    {
+        m_useStyleClasses = enable;
+
+        m_graphics_changed = true;
+    }
 }
 
 void wxSVGFileDCImpl::SetBrush(const wxBrush& brush)
 {
     m_brush = brush;
 
+    UpdateBrushAttrs();
+
     m_graphics_changed = true;
 
     wxString pattern = CreateBrushFill(m_brush, m_renderingMode);
@@ -1365,9 +1560,26 @@ void wxSVGFileDCImpl::SetPen(const wxPen& pen)
 {
     m_pen = pen;
 
+    UpdatePenAttrs();
+
     m_graphics_changed = true;
 }
 
+void wxSVGFileDCImpl::UpdatePenAttrs()
+{
+    m_penPatternAttr = GetPenPattern(m_pen).utf8_string();
+}
+
+void wxSVGFileDCImpl::UpdateBrushAttrs()
+{
+    m_brushPatternAttr = GetBrushPattern(m_brush).utf8_string();
+}
+
+void wxSVGFileDCImpl::UpdateRenderModeAttr()
+{
+    m_renderModeAttr = GetRenderMode(m_renderingMode).utf8_string();
+}
+
 void wxSVGFileDCImpl::NewGraphicsIfNeeded()
 {
     if ( !m_graphics_changed )
@@ -1375,25 +1587,62 @@ void wxSVGFileDCImpl::NewGraphicsIfNeeded()
 
     m_graphics_changed = false;
 
-    write(wxS("</g>\n"));
+    Append("</g>\n");
 
     DoStartNewGraphics();
 }
 
 void wxSVGFileDCImpl::DoStartNewGraphics()
 {
-    wxString s;
+    std::string style;
+    AppendPenStyle(style, m_pen);
+    style += ' ';
+    AppendBrushFill(style, m_brush.GetColour(), m_brush.GetStyle());
+    style += ' ';
+    AppendPenStroke(style, m_pen.GetColour(), m_pen.GetStyle());
+
+    if ( m_useStyleClasses )
+    {
+        // Define a new class when this style is used for the first time.
+        const auto it = m_styleClasses.find(style);
+        size_t index;
+        if ( it == m_styleClasses.end() )
+        {
+            index = m_styleClasses.size();
 
-    s = wxString::Format(wxS("<g style=\"%s %s %s\" transform=\"translate(%d %d) scale(%s %s)\">\n"),
-        GetPenStyle(m_pen),
-        GetBrushFill(m_brush.GetColour(), m_brush.GetStyle()),
-        GetPenStroke(m_pen.GetColour(), m_pen.GetStyle()),
-        (m_deviceOriginX - m_logicalOriginX) * m_signX,
-        (m_deviceOriginY - m_logicalOriginY) * m_signY,
-        NumStr(m_scaleX * m_signX),
-        NumStr(m_scaleY * m_signY));
+            Append("<style>.wxs");
+            AppendInt(index);
+            Append(" { ");
+            Append(style);
+            Append(" }</style>\n");
 
-    write(s);
+            m_styleClasses.emplace(std::move(style), index);
+        }
+        else
+        {
+            index = it->second;
+        }
+
+        Append("<g class=\"wxs");
+        AppendInt(index);
+    }
+    else
+    {
+        Append("<g style=\"");
+        Append(style);
+    }
+
+    Append("\" transform=\"translate(");
+    AppendInt((m_deviceOriginX - m_logicalOriginX) * m_signX);
+    Append(" ");
+    AppendInt((m_deviceOriginY - m_logicalOriginY) * m_signY);
+    Append(") scale(");
+    AppendNum(m_scaleX * m_signX);
+    Append(" ");
+    AppendNum(m_scaleY * m_signY);
+    Append(")\">\n");
+
+    WriteBufferIfNeeded();
 }
 
 void wxSVGFileDCImpl::SetFont(const wxFont& font)
@@ -1447,23 +1696,62 @@ void wxSVGFileDCImpl::DoDrawBitmap(const wxBitmap& bmp, wxCoord x, wxCoord y,
     if ( !m_bmp_handler )
         m_bmp_handler.reset(new wxSVGBitmapFileHandler(m_filename));
 
-    m_OK = m_outfile && m_outfile->IsOk();
+    // The handler writes to the stream directly, so flush everything written
+    // before it first.
+    WriteBuffer();
     if (!m_OK)
         return;
 
-    m_bmp_handler->ProcessBitmap(bmp, x, y, *m_outfile);
-    m_OK = m_outfile->IsOk();
+    wxOutputStream* const stream = GetOutputStream();
+    m_bmp_handler->ProcessBitmap(bmp, x, y, *stream);
+    m_OK = stream->IsOk();
 }
 
 void wxSVGFileDCImpl::write(const wxString& s)
 {
-    m_OK = m_outfile && m_outfile->IsOk();
-    if (!m_OK)
-        return;
+    const wxScopedCharBuffer buf = s.utf8_str();
+    m_buffer.append(buf.data(), buf.length());
 
-    const wxCharBuffer buf = s.utf8_str();
-    m_outfile->Write(buf, strlen((const char*)buf));
-    m_OK = m_outfile->IsOk();
+    WriteBufferIfNeeded();
+}
+
+void wxSVGFileDCImpl::AppendInt(long n)
+{
+    AppendIntStr(m_buffer, n);
+}
+
+void wxSVGFileDCImpl::AppendNum(double f)
+{
+    AppendNumStr(m_buffer, f);
+}
+
+void wxSVGFileDCImpl::WriteBufferIfNeeded()
+{
+    // Writing to the stream is relatively expensive, so only do it when we
+    // have accumulated enough output.
+    if ( m_buffer.size() >= 64*1024 )
+        WriteBuffer();
+}
+
+void wxSVGFileDCImpl::WriteBuffer()
+{
+    wxOutputStream* const stream = GetOutputStream();
+    m_OK = stream && stream->IsOk();
+    if ( m_OK && !m_buffer.empty() )
+    {
+        stream->Write(m_buffer.data(), m_buffer.size());
+        m_OK = stream->IsOk();
+    }
+
+    m_buffer.clear();
+}
+
+wxOutputStream* wxSVGFileDCImpl::GetOutputStream() const
+{
+    if ( m_zoutfile )
+        return m_zoutfile.get();
+
+    return m_outfile.get();
 }
 
 #endif // wxUSE_SVG
@@ -48,6 +48,8 @@
 #include  <stdlib.h>
 #include  <ctype.h>
 
+#include  <algorithm>
+
 // ----------------------------------------------------------------------------
 // constants
 // ----------------------------------------------------------------------------
@@ -59,8 +61,8 @@
 // ----------------------------------------------------------------------------
 
 // compare functions for sorting the arrays
-static int LINKAGEMODE CompareEntries(wxFileConfigEntry *p1, wxFileConfigEntry *p2);
-static int LINKAGEMODE CompareGroups(wxFileConfigGroup *p1, wxFileConfigGroup *p2);
+static bool CompareEntries(wxFileConfigEntry *p1, wxFileConfigEntry *p2);
+static bool CompareGroups(wxFileConfigGroup *p1, wxFileConfigGroup *p2);
 
 // filter strings
 static wxString FilterInValue(const wxString& str);
@@ -74,18 +76,55 @@ static wxString FilterOutEntryName(const wxString& str);
 // ============================================================================
 
 // ----------------------------------------------------------------------------
-// "template" array types
+// container types
 // ----------------------------------------------------------------------------
 
-#ifdef WXMAKINGDLL_BASE
-    WX_DEFINE_SORTED_USER_EXPORTED_ARRAY(wxFileConfigEntry *, ArrayEntries,
-                                         WXDLLIMPEXP_BASE);
-    WX_DEFINE_SORTED_USER_EXPORTED_ARRAY(wxFileConfigGroup *, ArrayGroups,
-                                         WXDLLIMPEXP_BASE);
+typedef std::vector<wxFileConfigEntry *> ArrayEntries;
+typedef std::vector<wxFileConfigGroup *> ArrayGroups;
+
+// hash and equality functors for the entry and group names, which are case-
+// insensitive unless wxCONFIG_CASE_SENSITIVE is set
+struct wxFileConfigNameHash
+{
+    size_t operator()(const wxString& name) const
+    {
+#if wxCONFIG_CASE_SENSITIVE
+        return wxStringHash()(name);
 #else
-    WX_DEFINE_SORTED_ARRAY(wxFileConfigEntry *, ArrayEntries);
-    WX_DEFINE_SORTED_ARRAY(wxFileConfigGroup *, ArrayGroups);
+        // FNV-1a hash of the lower case characters
+        size_t hash = 2166136261u;
+        for ( wxString::const_iterator i = name.begin(); i != name.end(); ++i )
+        {
+            hash ^= static_cast<size_t>(wxTolower(*i).GetValue());
+            hash *= 16777619u;
+        }
+
+        return hash;
 #endif
+    }
+};
+
+struct wxFileConfigNameEqual
+{
+    bool operator()(const wxString& name1, const wxString& name2) const
+    {
+#if wxCONFIG_CASE_SENSITIVE
+        return name1 == name2;
+#else
+        return name1.length() == name2.length() && name1.CmpNoCase(name2) == 0;
+#endif
+    }
+};
+
+typedef std::unordered_map<wxString, wxFileConfigEntry *,
+                           wxFileConfigNameHash,
+                           wxFileConfigNameEqual> HashEntries;
+typedef std::unordered_map<wxString, wxFileConfigGroup *,
+                           wxFileConfigNameHash,
+                           wxFileConfigNameEqual> HashGroups;
+
+// maximal number of paths cached by wxFileConfig::DoSetPath()
+static const size_t wxFILECONFIG_MAX_CACHED_PATHS = 1024;
 
 // ----------------------------------------------------------------------------
 // wxFileConfigLineList
@@ -131,7 +170,8 @@ private:
   wxString      m_strName,      // entry name
                 m_strValue;     //       value
   bool          m_bImmutable:1, // can be overridden locally?
-                m_bHasValue:1;  // set after first call to SetValue()
+                m_bHasValue:1,  // set after first call to SetValue()
+                m_bPendingLine:1; // line must be updated (in batch mode)
 
   int           m_nLine;        // used if m_pLine == nullptr only
 
@@ -157,6 +197,9 @@ public:
   void SetValue(const wxString& strValue, bool bUser = true);
   void SetLine(wxFileConfigLineList *pLine);
 
+  // update our line in the linked list to correspond to the current value
+  void UpdateLine();
+
     wxDECLARE_NO_COPY_CLASS(wxFileConfigEntry);
 };
 
@@ -171,6 +214,12 @@ private:
   wxFileConfigGroup  *m_pParent;    // parent group (nullptr for root group)
   ArrayEntries  m_aEntries;         // entries in this group
   ArrayGroups   m_aSubgroups;       // subgroups
+  HashEntries   m_hashEntries;      // the same entries and subgroups indexed
+  HashGroups    m_hashSubgroups;    // by name for fast lookup
+
+  // the arrays above are only sorted when they're accessed from outside
+  mutable bool  m_entriesSorted,
+                m_subgroupsSorted;
   wxString      m_strName;          // group's name
   wxFileConfigLineList *m_pLine;    // pointer to our line in the linked list
   wxFileConfigEntry *m_pLastEntry;  // last entry/subgroup of this group in the
@@ -194,9 +243,10 @@ public:
   wxFileConfigGroup    *Parent()  const { return m_pParent; }
   wxFileConfig   *Config()  const { return m_pConfig; }
 
-  const ArrayEntries& Entries() const { return m_aEntries;   }
-  const ArrayGroups&  Groups()  const { return m_aSubgroups; }
-  bool  IsEmpty() const { return Entries().IsEmpty() && Groups().IsEmpty(); }
+  // these accessors return the entries/subgroups sorted by name
+  const ArrayEntries& Entries() const;
+  const ArrayGroups&  Groups()  const;
+  bool  IsEmpty() const { return m_aEntries.empty() && m_aSubgroups.empty(); }
 
   // find entry/subgroup (nullptr if not found)
   wxFileConfigGroup *FindSubgroup(const wxString& name) const;
@@ -546,6 +596,8 @@ wxFileConfig::wxFileConfig(const wxString& appName, const wxString& vendorName,
 
     SetUmask(-1);
 
+    m_batchMode = false;
+
     Init();
 }
 
@@ -556,6 +608,7 @@ wxFileConfig::wxFileConfig(wxInputStream &inStream, const wxMBConv& conv)
 {
     m_isDirty = false;
     m_autosave = true;
+    m_batchMode = false;
 
     // always local_file when this constructor is called (?)
     SetStyle(GetStyle() | wxCONFIG_USE_LOCAL_FILE);
@@ -631,6 +684,9 @@ wxFileConfig::wxFileConfig(wxInputStream &inStream, const wxMBConv& conv)
 
 void wxFileConfig::CleanUp()
 {
+    ClearPathCache();
+    m_pendingEntries.clear();
+
     delete m_pRootGroup;
 
     wxFileConfigLineList *pCur = m_linesHead;
@@ -828,17 +884,28 @@ wxFileConfig::DoSetPath(const wxString& strPath, bool createMissingComponents)
         return true;
     }
 
+    wxString strFullPath;
     if ( strPath[0] == wxCONFIG_PATH_SEPARATOR ) {
         // absolute path
-        wxSplitPath(aParts, strPath);
+        strFullPath = strPath;
     }
     else {
         // relative path, combine with current one
-        wxString strFullPath = m_strPath;
+        strFullPath = m_strPath;
         strFullPath << wxCONFIG_PATH_SEPARATOR << strPath;
-        wxSplitPath(aParts, strFullPath);
     }
 
+    // the same paths are typically used again and again, so check if we had
+    // already resolved this one
+    const auto it = m_pathCache.find(strFullPath);
+    if ( it != m_pathCache.end() ) {
+        m_pCurrentGroup = it->second.group;
+        m_strPath = it->second.path;
+        return true;
+    }
+
+    wxSplitPath(aParts, strFullPath);
+
     // change current group
     size_t n;
     m_pCurrentGroup = m_pRootGroup;
@@ -861,6 +928,13 @@ wxFileConfig::DoSetPath(const wxString& strPath, bool createMissingComponents)
         m_strPath << wxCONFIG_PATH_SEPARATOR << aParts[n];
     }
 
+    if ( m_pathCache.size() >= wxFILECONFIG_MAX_CACHED_PATHS )
+        ClearPathCache();
+
+    CachedPath& cached = m_pathCache[strFullPath];
+    cached.group = m_pCurrentGroup;
+    cached.path = m_strPath;
+
     return true;
 }
 
@@ -886,7 +960,7 @@ bool wxFileConfig::GetFirstGroup(wxString& str, long& lIndex) const
 
 bool wxFileConfig::GetNextGroup (wxString& str, long& lIndex) const
 {
-    if ( size_t(lIndex) < m_pCurrentGroup->Groups().GetCount() ) {
+    if ( size_t(lIndex) < m_pCurrentGroup->Groups().size() ) {
         str = m_pCurrentGroup->Groups()[(size_t)lIndex++]->Name();
         return true;
     }
@@ -902,7 +976,7 @@ bool wxFileConfig::GetFirstEntry(wxString& str, long& lIndex) const
 
 bool wxFileConfig::GetNextEntry (wxString& str, long& lIndex) const
 {
-    if ( size_t(lIndex) < m_pCurrentGroup->Entries().GetCount() ) {
+    if ( size_t(lIndex) < m_pCurrentGroup->Entries().size() ) {
         str = m_pCurrentGroup->Entries()[(size_t)lIndex++]->Name();
         return true;
     }
@@ -912,12 +986,12 @@ bool wxFileConfig::GetNextEntry (wxString& str, long& lIndex) const
 
 size_t wxFileConfig::GetNumberOfEntries(bool bRecursive) const
 {
-    size_t n = m_pCurrentGroup->Entries().GetCount();
+    size_t n = m_pCurrentGroup->Entries().size();
     if ( bRecursive ) {
         wxFileConfig * const self = const_cast<wxFileConfig *>(this);
 
         wxFileConfigGroup *pOldCurrentGroup = m_pCurrentGroup;
-        size_t nSubgroups = m_pCurrentGroup->Groups().GetCount();
+        size_t nSubgroups = m_pCurrentGroup->Groups().size();
         for ( size_t nGroup = 0; nGroup < nSubgroups; nGroup++ ) {
             self->m_pCurrentGroup = m_pCurrentGroup->Groups()[nGroup];
             n += GetNumberOfEntries(true);
@@ -930,12 +1004,12 @@ size_t wxFileConfig::GetNumberOfEntries(bool bRecursive) const
 
 size_t wxFileConfig::GetNumberOfGroups(bool bRecursive) const
 {
-    size_t n = m_pCurrentGroup->Groups().GetCount();
+    size_t n = m_pCurrentGroup->Groups().size();
     if ( bRecursive ) {
         wxFileConfig * const self = const_cast<wxFileConfig *>(this);
 
         wxFileConfigGroup *pOldCurrentGroup = m_pCurrentGroup;
-        size_t nSubgroups = m_pCurrentGroup->Groups().GetCount();
+        size_t nSubgroups = m_pCurrentGroup->Groups().size();
         for ( size_t nGroup = 0; nGroup < nSubgroups; nGroup++ ) {
             self->m_pCurrentGroup = m_pCurrentGroup->Groups()[nGroup];
             n += GetNumberOfGroups(true);
@@ -1079,6 +1153,10 @@ bool wxFileConfig::DoWriteString(const wxString& key, const wxString& szValue)
 
         SetDirty();
 
+        // the new group line must come after the lines of the entries which
+        // were written before
+        UpdatePendingLines();
+
         // this will add a line for this group if it didn't have it before (or
         // do nothing for the root but it's ok as it always exists anyhow)
         (void)m_pCurrentGroup->GetGroupLine();
@@ -1133,6 +1211,8 @@ bool wxFileConfig::Flush(bool /* bCurrentOnly */)
   if ( !IsDirty() || m_fnLocalFile.GetFullPath().empty() )
     return true;
 
+  UpdatePendingLines();
+
   // Create the directory containing the file if it doesn't exist. Although we
   // don't always use XDG, it seems sensible to follow the XDG specification
   // and create it with permissions 700 if it doesn't exist.
@@ -1160,11 +1240,18 @@ bool wxFileConfig::Flush(bool /* bCurrentOnly */)
   }
 
   // write all strings to file
+  const wxString eol = wxTextFile::GetEOL();
+  size_t len = 0;
+  for ( wxFileConfigLineList *p = m_linesHead; p != nullptr; p = p->Next() )
+  {
+    len += p->Text().length() + eol.length();
+  }
+
   wxString filetext;
-  filetext.reserve(4096);
+  filetext.reserve(len);
   for ( wxFileConfigLineList *p = m_linesHead; p != nullptr; p = p->Next() )
   {
-    filetext << p->Text() << wxTextFile::GetEOL();
+    filetext << p->Text() << eol;
   }
 
   if ( !file.Write(filetext, *m_conv) )
@@ -1189,6 +1276,8 @@ bool wxFileConfig::Flush(bool /* bCurrentOnly */)
 
 bool wxFileConfig::Save(wxOutputStream& os, const wxMBConv& conv)
 {
+    UpdatePendingLines();
+
     // save unconditionally, even if not dirty
     for ( wxFileConfigLineList *p = m_linesHead; p != nullptr; p = p->Next() )
     {
@@ -1226,6 +1315,8 @@ bool wxFileConfig::RenameEntry(const wxString& oldName,
     if ( !oldEntry )
         return false;
 
+    UpdatePendingLines();
+
     // check that the new entry doesn't already exist
     if ( m_pCurrentGroup->FindEntry(newName) )
         return false;
@@ -1255,6 +1346,9 @@ bool wxFileConfig::RenameGroup(const wxString& oldName,
     if ( m_pCurrentGroup->FindSubgroup(newName) )
         return false;
 
+    UpdatePendingLines();
+    ClearPathCache();
+
     group->Rename(newName);
 
     SetDirty();
@@ -1268,6 +1362,8 @@ bool wxFileConfig::RenameGroup(const wxString& oldName,
 
 bool wxFileConfig::DeleteEntry(const wxString& key, bool bGroupIfEmptyAlso)
 {
+  UpdatePendingLines();
+
   wxConfigPathChanger path(this, key);
 
   if ( !m_pCurrentGroup->DeleteEntry(path.Name()) )
@@ -1279,6 +1375,7 @@ bool wxFileConfig::DeleteEntry(const wxString& key, bool bGroupIfEmptyAlso)
     if ( m_pCurrentGroup != m_pRootGroup ) {
       wxFileConfigGroup *pGroup = m_pCurrentGroup;
       SetPath(wxT(".."));  // changes m_pCurrentGroup!
+      ClearPathCache();
       m_pCurrentGroup->DeleteSubgroupByName(pGroup->Name());
     }
     //else: never delete the root group
@@ -1289,8 +1386,12 @@ bool wxFileConfig::DeleteEntry(const wxString& key, bool bGroupIfEmptyAlso)
 
 bool wxFileConfig::DeleteGroup(const wxString& key)
 {
+  UpdatePendingLines();
+
   wxConfigPathChanger path(this, RemoveTrailingSeparator(key));
 
+  ClearPathCache();
+
   if ( !m_pCurrentGroup->DeleteSubgroupByName(path.Name()) )
       return false;
 
@@ -1321,10 +1422,56 @@ bool wxFileConfig::DeleteAll()
   return true;
 }
 
+// ----------------------------------------------------------------------------
+// batch mode
+// ----------------------------------------------------------------------------
+
+void wxFileConfig::SetBatchMode(bool batch)
+{
+    m_batchMode = batch;
+
+    if ( !batch )
+        UpdatePendingLines();
+}
+
+void wxFileConfig::UpdatePendingLines()
+{
+    // this must be done in the same order as the entries were modified in, as
+    // this determines the order of the new lines in the file
+    for ( wxFileConfigEntry *pEntry : m_pendingEntries )
+        pEntry->UpdateLine();
+
+    m_pendingEntries.clear();
+}
+
 // ----------------------------------------------------------------------------
 // linked list functions
 // ----------------------------------------------------------------------------
 
+// This is called for every line modification, so avoid even evaluating the
+// arguments of wxLogTrace() unless tracing is really enabled.
+static void
+TraceLinesHeadAndTail(const wxFileConfigLineList *head,
+                      const wxFileConfigLineList *tail)
+{
+#if wxUSE_LOG_TRACE
+    if ( !wxLog::IsAllowedTraceMask(FILECONF_TRACE_MASK) )
+        return;
+
+    wxLogTrace( FILECONF_TRACE_MASK,
+                wxT("        head: %s"),
+                ((head) ? head->Text()
+                        : wxString()) );
+    wxLogTrace( FILECONF_TRACE_MASK,
+                wxT("        tail: %s"),
+                ((tail) ? tail->Text()
+                        : wxString()) );
+#else // !wxUSE_LOG_TRACE
+    wxUnusedVar(head);
+    wxUnusedVar(tail);
+#endif // wxUSE_LOG_TRACE/!wxUSE_LOG_TRACE
+}
+
     // append a new line to the end of the list
 
 wxFileConfigLineList *wxFileConfig::LineListAppend(const wxString& str)
@@ -1332,14 +1479,7 @@ wxFileConfigLineList *wxFileConfig::LineListAppend(const wxString& str)
     wxLogTrace( FILECONF_TRACE_MASK,
                 wxT("    ** Adding Line '%s'"),
                 str );
-    wxLogTrace( FILECONF_TRACE_MASK,
-                wxT("        head: %s"),
-                ((m_linesHead) ? m_linesHead->Text()
-                               : wxString()) );
-    wxLogTrace( FILECONF_TRACE_MASK,
-                wxT("        tail: %s"),
-                ((m_linesTail) ? m_linesTail->Text()
-                               : wxString()) );
+    TraceLinesHeadAndTail(m_linesHead, m_linesTail);
 
     wxFileConfigLineList *pLine = new wxFileConfigLineList(str);
 
@@ -1357,14 +1497,7 @@ wxFileConfigLineList *wxFileConfig::LineListAppend(const wxString& str)
 
     m_linesTail = pLine;
 
-    wxLogTrace( FILECONF_TRACE_MASK,
-                wxT("        head: %s"),
-                ((m_linesHead) ? m_linesHead->Text()
-                               : wxString()) );
-    wxLogTrace( FILECONF_TRACE_MASK,
-                wxT("        tail: %s"),
-                ((m_linesTail) ? m_linesTail->Text()
-                               : wxString()) );
+    TraceLinesHeadAndTail(m_linesHead, m_linesTail);
 
     return m_linesTail;
 }
@@ -1378,14 +1511,7 @@ wxFileConfigLineList *wxFileConfig::LineListInsert(const wxString& str,
                 str,
                 ((pLine) ? pLine->Text()
                          : wxString()) );
-    wxLogTrace( FILECONF_TRACE_MASK,
-                wxT("        head: %s"),
-                ((m_linesHead) ? m_linesHead->Text()
-                               : wxString()) );
-    wxLogTrace( FILECONF_TRACE_MASK,
-                wxT("        tail: %s"),
-                ((m_linesTail) ? m_linesTail->Text()
-                               : wxString()) );
+    TraceLinesHeadAndTail(m_linesHead, m_linesTail);
 
     if ( pLine == m_linesTail )
         return LineListAppend(str);
@@ -1408,14 +1534,7 @@ wxFileConfigLineList *wxFileConfig::LineListInsert(const wxString& str,
         pLine->SetNext(pNewLine);
     }
 
-    wxLogTrace( FILECONF_TRACE_MASK,
-                wxT("        head: %s"),
-                ((m_linesHead) ? m_linesHead->Text()
-                               : wxString()) );
-    wxLogTrace( FILECONF_TRACE_MASK,
-                wxT("        tail: %s"),
-                ((m_linesTail) ? m_linesTail->Text()
-                               : wxString()) );
+    TraceLinesHeadAndTail(m_linesHead, m_linesTail);
 
     return pNewLine;
 }
@@ -1425,14 +1544,7 @@ void wxFileConfig::LineListRemove(wxFileConfigLineList *pLine)
     wxLogTrace( FILECONF_TRACE_MASK,
                 wxT("    ** Removing Line '%s'"),
                 pLine->Text() );
-    wxLogTrace( FILECONF_TRACE_MASK,
-                wxT("        head: %s"),
-                ((m_linesHead) ? m_linesHead->Text()
-                               : wxString()) );
-    wxLogTrace( FILECONF_TRACE_MASK,
-                wxT("        tail: %s"),
-                ((m_linesTail) ? m_linesTail->Text()
-                               : wxString()) );
+    TraceLinesHeadAndTail(m_linesHead, m_linesTail);
 
     wxFileConfigLineList    *pPrev = pLine->Prev(),
                             *pNext = pLine->Next();
@@ -1451,14 +1563,7 @@ void wxFileConfig::LineListRemove(wxFileConfigLineList *pLine)
     else
         pNext->SetPrev(pPrev);
 
-    wxLogTrace( FILECONF_TRACE_MASK,
-                wxT("        head: %s"),
-                ((m_linesHead) ? m_linesHead->Text()
-                               : wxString()) );
-    wxLogTrace( FILECONF_TRACE_MASK,
-                wxT("        tail: %s"),
-                ((m_linesTail) ? m_linesTail->Text()
-                               : wxString()) );
+    TraceLinesHeadAndTail(m_linesHead, m_linesTail);
 
     delete pLine;
 }
@@ -1480,10 +1585,11 @@ bool wxFileConfig::LineListIsEmpty()
 wxFileConfigGroup::wxFileConfigGroup(wxFileConfigGroup *pParent,
                                        const wxString& strName,
                                        wxFileConfig *pConfig)
-                         : m_aEntries(CompareEntries),
-                           m_aSubgroups(CompareGroups),
-                           m_strName(strName)
+                         : m_strName(strName)
 {
+  m_entriesSorted =
+  m_subgroupsSorted = true;
+
   m_pConfig = pConfig;
   m_pParent = pParent;
   m_pLine   = nullptr;
@@ -1496,12 +1602,12 @@ wxFileConfigGroup::wxFileConfigGroup(wxFileConfigGroup *pParent,
 wxFileConfigGroup::~wxFileConfigGroup()
 {
   // entries
-  size_t n, nCount = m_aEntries.GetCount();
+  size_t n, nCount = m_aEntries.size();
   for ( n = 0; n < nCount; n++ )
     delete m_aEntries[n];
 
   // subgroups
-  nCount = m_aSubgroups.GetCount();
+  nCount = m_aSubgroups.size();
   for ( n = 0; n < nCount; n++ )
     delete m_aSubgroups[n];
 }
@@ -1664,7 +1770,7 @@ void wxFileConfigGroup::UpdateGroupAndSubgroupsLines()
 
 
     // also update all subgroups as they have this groups name in their lines
-    const size_t nCount = m_aSubgroups.GetCount();
+    const size_t nCount = m_aSubgroups.size();
     for ( size_t n = 0; n < nCount; n++ )
     {
         m_aSubgroups[n]->UpdateGroupAndSubgroupsLines();
@@ -1678,13 +1784,14 @@ void wxFileConfigGroup::Rename(const wxString& newName)
     if ( newName == m_strName )
         return;
 
-    // we need to remove the group from the parent and it back under the new
-    // name to keep the parents array of subgroups alphabetically sorted
-    m_pParent->m_aSubgroups.Remove(this);
+    // we need to update the key of this group in the parent hash map and the
+    // parents array of subgroups needs to be sorted again
+    m_pParent->m_hashSubgroups.erase(m_strName);
 
     m_strName = newName;
 
-    m_pParent->m_aSubgroups.Add(this);
+    m_pParent->m_hashSubgroups[m_strName] = this;
+    m_pParent->m_subgroupsSorted = false;
 
     // update the group lines recursively
     UpdateGroupAndSubgroupsLines();
@@ -1703,67 +1810,42 @@ wxString wxFileConfigGroup::GetFullName() const
 // find an item
 // ----------------------------------------------------------------------------
 
-// use binary search because the array is sorted
 wxFileConfigEntry *
 wxFileConfigGroup::FindEntry(const wxString& name) const
 {
-  size_t
-       lo = 0,
-       hi = m_aEntries.GetCount();
-  wxFileConfigEntry *pEntry;
-
-  while ( lo < hi ) {
-    size_t i;
-    i = (lo + hi)/2;
-    pEntry = m_aEntries[i];
-
-    int res;
-    #if wxCONFIG_CASE_SENSITIVE
-      res = pEntry->Name().compare(name);
-    #else
-      res = pEntry->Name().CmpNoCase(name);
-    #endif
-
-    if ( res > 0 )
-      hi = i;
-    else if ( res < 0 )
-      lo = i + 1;
-    else
-      return pEntry;
-  }
+  const auto it = m_hashEntries.find(name);
 
-  return nullptr;
+  return it == m_hashEntries.end() ? nullptr : it->second;
 }
 
 wxFileConfigGroup *
 wxFileConfigGroup::FindSubgroup(const wxString& name) const
 {
-  size_t
-       lo = 0,
-       hi = m_aSubgroups.GetCount();
-  wxFileConfigGroup *pGroup;
-
-  while ( lo < hi ) {
-    size_t i;
-    i = (lo + hi)/2;
-    pGroup = m_aSubgroups[i];
-
-    int res;
-    #if wxCONFIG_CASE_SENSITIVE
-      res = pGroup->Name().compare(name);
-    #else
-      res = pGroup->Name().CmpNoCase(name);
-    #endif
-
-    if ( res > 0 )
-      hi = i;
-    else if ( res < 0 )
-      lo = i + 1;
-    else
-      return pGroup;
+  const auto it = m_hashSubgroups.find(name);
+
+  return it == m_hashSubgroups.end() ? nullptr : it->second;
+}
+
+const ArrayEntries& wxFileConfigGroup::Entries() const
+{
+  if ( !m_entriesSorted ) {
+    ArrayEntries& entries = const_cast<ArrayEntries&>(m_aEntries);
+    std::sort(entries.begin(), entries.end(), CompareEntries);
+    m_entriesSorted = true;
   }
 
-  return nullptr;
+  return m_aEntries;
+}
+
+const ArrayGroups& wxFileConfigGroup::Groups() const
+{
+  if ( !m_subgroupsSorted ) {
+    ArrayGroups& groups = const_cast<ArrayGroups&>(m_aSubgroups);
+    std::sort(groups.begin(), groups.end(), CompareGroups);
+    m_subgroupsSorted = true;
+  }
+
+  return m_aSubgroups;
 }
 
 // ----------------------------------------------------------------------------
@@ -1777,7 +1859,9 @@ wxFileConfigEntry *wxFileConfigGroup::AddEntry(const wxString& strName, int nLin
 
     wxFileConfigEntry   *pEntry = new wxFileConfigEntry(this, strName, nLine);
 
-    m_aEntries.Add(pEntry);
+    m_aEntries.push_back(pEntry);
+    m_hashEntries[pEntry->Name()] = pEntry;
+    m_entriesSorted = false;
     return pEntry;
 }
 
@@ -1788,7 +1872,9 @@ wxFileConfigGroup *wxFileConfigGroup::AddSubgroup(const wxString& strName)
 
     wxFileConfigGroup   *pGroup = new wxFileConfigGroup(this, strName, m_pConfig);
 
-    m_aSubgroups.Add(pGroup);
+    m_aSubgroups.push_back(pGroup);
+    m_hashSubgroups[pGroup->Name()] = pGroup;
+    m_subgroupsSorted = false;
     return pGroup;
 }
 
@@ -1832,7 +1918,7 @@ bool wxFileConfigGroup::DeleteSubgroup(wxFileConfigGroup *pGroup)
                         : wxString() );
 
     // delete all entries...
-    size_t nCount = pGroup->m_aEntries.GetCount();
+    size_t nCount = pGroup->m_aEntries.size();
 
     wxLogTrace(FILECONF_TRACE_MASK,
                wxT("Removing %lu entries"), (unsigned long)nCount );
@@ -1851,7 +1937,7 @@ bool wxFileConfigGroup::DeleteSubgroup(wxFileConfigGroup *pGroup)
     }
 
     // ...and subgroups of this subgroup
-    nCount = pGroup->m_aSubgroups.GetCount();
+    nCount = pGroup->m_aSubgroups.size();
 
     wxLogTrace( FILECONF_TRACE_MASK,
                 wxT("Removing %lu subgroups"), (unsigned long)nCount );
@@ -1885,7 +1971,7 @@ bool wxFileConfigGroup::DeleteSubgroup(wxFileConfigGroup *pGroup)
             // our last entry is being deleted, so find the last one which
             // stays by going back until we find a subgroup or reach the
             // group line
-            const size_t nSubgroups = m_aSubgroups.GetCount();
+            const size_t nSubgroups = m_aSubgroups.size();
 
             m_pLastGroup = nullptr;
             for ( wxFileConfigLineList *pl = pLine->Prev();
@@ -1918,7 +2004,9 @@ bool wxFileConfigGroup::DeleteSubgroup(wxFileConfigGroup *pGroup)
                     pGroup->Name() );
     }
 
-    m_aSubgroups.Remove(pGroup);
+    m_aSubgroups.erase(std::find(m_aSubgroups.begin(), m_aSubgroups.end(),
+                                 pGroup));
+    m_hashSubgroups.erase(pGroup->Name());
     delete pGroup;
 
     return true;
@@ -1945,7 +2033,7 @@ bool wxFileConfigGroup::DeleteEntry(const wxString& name)
       wxFileConfigEntry *pNewLast = nullptr;
       const wxFileConfigLineList * const
         pNewLastLine = m_pLastEntry->GetLine()->Prev();
-      const size_t nEntries = m_aEntries.GetCount();
+      const size_t nEntries = m_aEntries.size();
       for ( size_t n = 0; n < nEntries; n++ ) {
         if ( m_aEntries[n]->GetLine() == pNewLastLine ) {
           pNewLast = m_aEntries[n];
@@ -1966,7 +2054,8 @@ bool wxFileConfigGroup::DeleteEntry(const wxString& name)
     m_pConfig->LineListRemove(pLine);
   }
 
-  m_aEntries.Remove(pEntry);
+  m_aEntries.erase(std::find(m_aEntries.begin(), m_aEntries.end(), pEntry));
+  m_hashEntries.erase(pEntry->Name());
   delete pEntry;
 
   return true;
@@ -1991,6 +2080,7 @@ wxFileConfigEntry::wxFileConfigEntry(wxFileConfigGroup *pParent,
   m_pLine   = nullptr;
 
   m_bHasValue = false;
+  m_bPendingLine = false;
 
   m_bImmutable = strName[0] == wxCONFIG_IMMUTABLE_PREFIX;
   if ( m_bImmutable )
@@ -2033,35 +2123,55 @@ void wxFileConfigEntry::SetValue(const wxString& strValue, bool bUser)
 
     if ( bUser )
     {
-        wxString strValFiltered;
-
-        if ( Group()->Config()->GetStyle() & wxCONFIG_USE_NO_ESCAPE_CHARACTERS )
+        wxFileConfig * const config = Group()->Config();
+        if ( config->IsBatchMode() )
         {
-            strValFiltered = strValue;
+            // just remember to update the line later
+            if ( !m_bPendingLine )
+            {
+                m_bPendingLine = true;
+                config->m_pendingEntries.push_back(this);
+            }
         }
-        else {
-            strValFiltered = FilterOutValue(strValue);
+        else
+        {
+            UpdateLine();
         }
+    }
+}
 
-        wxString    strLine;
-        strLine << FilterOutEntryName(m_strName) << wxT('=') << strValFiltered;
+void wxFileConfigEntry::UpdateLine()
+{
+    m_bPendingLine = false;
 
-        if ( m_pLine )
-        {
-            // entry was read from the local config file, just modify the line
-            m_pLine->SetText(strLine);
-        }
-        else // this entry didn't exist in the local file
-        {
-            // add a new line to the file: note that line returned by
-            // GetLastEntryLine() may be null if we're in the root group and it
-            // doesn't have any entries yet, but this is ok as passing null
-            // line to LineListInsert() means to prepend new line to the list
-            wxFileConfigLineList *line = Group()->GetLastEntryLine();
-            m_pLine = Group()->Config()->LineListInsert(strLine, line);
-
-            Group()->SetLastEntry(this);
-        }
+    wxString strValFiltered;
+
+    if ( Group()->Config()->GetStyle() & wxCONFIG_USE_NO_ESCAPE_CHARACTERS )
+    {
+        strValFiltered = m_strValue;
+    }
+    else {
+        strValFiltered = FilterOutValue(m_strValue);
+    }
+
+    wxString    strLine;
+    strLine << FilterOutEntryName(m_strName) << wxT('=') << strValFiltered;
+
+    if ( m_pLine )
+    {
+        // entry was read from the local config file, just modify the line
+        m_pLine->SetText(strLine);
+    }
+    else // this entry didn't exist in the local file
+    {
+        // add a new line to the file: note that line returned by
+        // GetLastEntryLine() may be null if we're in the root group and it
+        // doesn't have any entries yet, but this is ok as passing null
+        // line to LineListInsert() means to prepend new line to the list
+        wxFileConfigLineList *line = Group()->GetLastEntryLine();
+        m_pLine = Group()->Config()->LineListInsert(strLine, line);
+
+        Group()->SetLastEntry(this);
     }
 }
 
@@ -2073,21 +2183,21 @@ void wxFileConfigEntry::SetValue(const wxString& strValue, bool bUser)
 // compare functions for array sorting
 // ----------------------------------------------------------------------------
 
-int CompareEntries(wxFileConfigEntry *p1, wxFileConfigEntry *p2)
+bool CompareEntries(wxFileConfigEntry *p1, wxFileConfigEntry *p2)
 {
 #if wxCONFIG_CASE_SENSITIVE
-    return p1->Name().compare(p2->Name());
+    return p1->Name().compare(p2->Name()) < 0;
 #else
-    return p1->Name().CmpNoCase(p2->Name());
+    return p1->Name().CmpNoCase(p2->Name()) < 0;
 #endif
 }
 
-int CompareGroups(wxFileConfigGroup *p1, wxFileConfigGroup *p2)
+bool CompareGroups(wxFileConfigGroup *p1, wxFileConfigGroup *p2)
 {
 #if wxCONFIG_CASE_SENSITIVE
-    return p1->Name().compare(p2->Name());
+    return p1->Name().compare(p2->Name()) < 0;
 #else
-    return p1->Name().CmpNoCase(p2->Name());
+    return p1->Name().CmpNoCase(p2->Name()) < 0;
 #endif
 }
 
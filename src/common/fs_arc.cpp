@@ -22,6 +22,10 @@
 #include "wx/archive.h"
 #include "wx/private/fileback.h"
 
+#if wxUSE_TARSTREAM
+    #include "wx/tarstrm.h"
+#endif
+
 //---------------------------------------------------------------------------
 // wxArchiveFSCacheDataImpl
 //
@@ -61,6 +65,11 @@ public:
 
     wxArchiveFSEntry *GetNext(wxArchiveFSEntry *fse);
 
+#if wxUSE_TARSTREAM
+    // Fill the catalog from the index, avoiding reading the archive headers.
+    void UseIndex(const wxTarIndex& index);
+#endif // wxUSE_TARSTREAM
+
 private:
     // Takes ownership of "entry".
     wxArchiveFSEntry *AddToCache(wxArchiveEntry *entry);
@@ -156,6 +165,20 @@ wxArchiveEntry *wxArchiveFSCacheDataImpl::Get(const wxString& name)
     return nullptr;
 }
 
+#if wxUSE_TARSTREAM
+
+void wxArchiveFSCacheDataImpl::UseIndex(const wxTarIndex& index)
+{
+    for (size_t n = 0; n < index.GetCount(); n++)
+        AddToCache(index.GetEntry(n).Clone());
+
+    // The index contains all the entries, so we don't need to read anything
+    // from the archive itself any more.
+    CloseStreams();
+}
+
+#endif // wxUSE_TARSTREAM
+
 wxInputStream* wxArchiveFSCacheDataImpl::NewStream() const
 {
     if (m_backer)
@@ -207,6 +230,9 @@ public:
     wxInputStream *NewStream() const { return m_impl->NewStream(); }
     wxArchiveFSEntry *GetNext(wxArchiveFSEntry *fse)
         { return m_impl->GetNext(fse); }
+#if wxUSE_TARSTREAM
+    void UseIndex(const wxTarIndex& index) { m_impl->UseIndex(index); }
+#endif // wxUSE_TARSTREAM
 
 private:
     wxArchiveFSCacheDataImpl *m_impl;
@@ -269,6 +295,12 @@ public:
                               const wxArchiveClassFactory& factory,
                               wxInputStream *stream);
 
+    // Open the archive at the given location and add it to the cache.
+    wxArchiveFSCacheData* Open(wxFileSystem& fs,
+                               const wxString& key,
+                               const wxString& location,
+                               const wxArchiveClassFactory& factory);
+
     wxArchiveFSCacheData *Get(const wxString& name);
 
 private:
@@ -290,6 +322,50 @@ wxArchiveFSCacheData* wxArchiveFSCache::Add(
     return &data;
 }
 
+wxArchiveFSCacheData* wxArchiveFSCache::Open(
+        wxFileSystem& fs,
+        const wxString& key,
+        const wxString& location,
+        const wxArchiveClassFactory& factory)
+{
+    wxFSFile *file = fs.OpenFile(location);
+    if (!file)
+        return nullptr;
+
+    wxInputStream *stream = file->DetachStream();
+    delete file;
+
+#if wxUSE_TARSTREAM
+    // Use the sidecar index for tar archives if there is one and it matches
+    // the archive, as reading the catalog from it is much faster than reading
+    // all the headers from a big tar. If the archive size is unknown, we
+    // can't check whether the index is stale, so don't use it at all then.
+    wxTarIndex index;
+    if (factory.IsKindOf(wxCLASSINFO(wxTarClassFactory)) &&
+            stream->GetLength() != wxInvalidOffset)
+    {
+        std::unique_ptr<wxFSFile>
+            indexFile(fs.OpenFile(wxTarIndex::GetIndexName(location)));
+        if (indexFile && indexFile->GetStream())
+        {
+            wxLogNull noLog;
+            if (!index.Load(*indexFile->GetStream(), stream->GetLength()) ||
+                    !index.IsUpToDate(*stream))
+                index.Clear();
+        }
+    }
+#endif // wxUSE_TARSTREAM
+
+    wxArchiveFSCacheData* const data = Add(key, factory, stream);
+
+#if wxUSE_TARSTREAM
+    if (!index.IsEmpty())
+        data->UseIndex(index);
+#endif // wxUSE_TARSTREAM
+
+    return data;
+}
+
 wxArchiveFSCacheData *wxArchiveFSCache::Get(const wxString& name)
 {
     const auto it = m_hash.find(name);
@@ -363,11 +439,9 @@ wxFSFile* wxArchiveFSHandler::OpenFile(
     wxArchiveFSCacheData *cached = m_cache->Get(key);
     if (!cached)
     {
-        wxFSFile *leftFile = m_fs.OpenFile(left);
-        if (!leftFile)
+        cached = m_cache->Open(m_fs, key, left, *factory);
+        if (!cached)
             return nullptr;
-        cached = m_cache->Add(key, *factory, leftFile->DetachStream());
-        delete leftFile;
     }
 
     wxArchiveEntry *entry = cached->Get(right);
@@ -426,11 +500,9 @@ wxString wxArchiveFSHandler::FindFirst(const wxString& spec, int flags)
     m_Archive = m_cache->Get(key);
     if (!m_Archive)
     {
-        wxFSFile *leftFile = m_fs.OpenFile(left);
-        if (!leftFile)
+        m_Archive = m_cache->Open(m_fs, key, left, *factory);
+        if (!m_Archive)
             return wxEmptyString;
-        m_Archive = m_cache->Add(key, *factory, leftFile->DetachStream());
-        delete leftFile;
     }
 
     m_FindEntry = nullptr;
@@ -16,6 +16,12 @@
 #include "wx/fswatcher.h"
 #include "wx/private/fswatcher.h"
 
+#if wxUSE_THREADS
+    #include "wx/thread.h"
+#endif
+
+#include <algorithm>
+
 // ============================================================================
 // helpers
 // ============================================================================
@@ -72,17 +78,128 @@ wxString wxFileSystemWatcherEvent::ToString() const
 }
 
 
+// ============================================================================
+// wxFSWTreeAdder: traverses a directory tree in a background thread
+// ============================================================================
+
+#if wxUSE_THREADS
+
+class wxFSWTreeAdder : public wxThread
+{
+public:
+    wxFSWTreeAdder(wxFileSystemWatcherBase* watcher,
+                   int id,
+                   const wxString& canonical,
+                   int events,
+                   const wxString& filespec,
+                   int dirFlags)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_watcher(watcher),
+          m_id(id),
+          m_canonical(canonical),
+          m_events(events),
+          m_filespec(filespec),
+          m_dirFlags(dirFlags)
+    {
+    }
+
+    int GetId() const { return m_id; }
+    const wxString& GetCanonicalPath() const { return m_canonical; }
+    int GetEvents() const { return m_events; }
+    const wxString& GetFilespec() const { return m_filespec; }
+
+protected:
+    virtual ExitCode Entry() override
+    {
+        class Traverser : public wxDirTraverser
+        {
+        public:
+            explicit Traverser(wxFSWTreeAdder& adder) : m_adder(adder) { }
+
+            virtual wxDirTraverseResult OnFile(const wxString& WXUNUSED(filename)) override
+            {
+                // We only watch the directories, as in AddTree().
+                return wxDIR_CONTINUE;
+            }
+
+            virtual wxDirTraverseResult OnDir(const wxString& dirname) override
+            {
+                if ( m_adder.TestDestroy() )
+                    return wxDIR_STOP;
+
+                m_adder.m_dirs.push_back(dirname);
+
+                // Don't wait until the end to start watching the directories
+                // found so far, the tree can be really big.
+                if ( m_adder.m_dirs.size() == BATCH_SIZE )
+                    m_adder.SendDirs(false);
+
+                return wxDIR_CONTINUE;
+            }
+
+        private:
+            wxFSWTreeAdder& m_adder;
+        };
+
+        wxDir dir(m_canonical);
+        Traverser traverser(*this);
+        dir.Traverse(traverser, m_filespec, m_dirFlags);
+
+        SendDirs(true);
+
+        return nullptr;
+    }
+
+private:
+    // Number of directories sent to the main thread at once.
+    static const size_t BATCH_SIZE = 256;
+
+    void SendDirs(bool done)
+    {
+        wxFileSystemWatcherBase* const watcher = m_watcher;
+        const int id = m_id;
+        const wxArrayString dirs = m_dirs;
+
+        watcher->CallAfter([watcher, id, dirs, done]()
+            {
+                watcher->OnTreeDirsFound(id, dirs, done);
+            });
+
+        m_dirs.clear();
+    }
+
+    wxFileSystemWatcherBase* const m_watcher;
+    const int m_id;
+    const wxString m_canonical;
+    const int m_events;
+    const wxString m_filespec;
+    const int m_dirFlags;
+
+    // Directories found but not sent to the main thread yet.
+    wxArrayString m_dirs;
+};
+
+#else // !wxUSE_THREADS
+
+// Just define the class to allow deleting the pointers to it.
+class wxFSWTreeAdder
+{
+};
+
+#endif // wxUSE_THREADS/!wxUSE_THREADS
+
 // ============================================================================
 // wxFileSystemWatcherEvent implementation
 // ============================================================================
 
 wxFileSystemWatcherBase::wxFileSystemWatcherBase() :
-    m_service(nullptr), m_owner(this)
+    m_service(nullptr), m_owner(this), m_coalescingInterval(0)
 {
 }
 
 wxFileSystemWatcherBase::~wxFileSystemWatcherBase()
 {
+    CancelAddTreeAsync();
     RemoveAll();
     delete m_service;
 }
@@ -227,19 +344,147 @@ bool wxFileSystemWatcherBase::AddTree(const wxFileName& path, int events,
     return true;
 }
 
+bool wxFileSystemWatcherBase::AddTreeAsync(const wxFileName& path, int events,
+                                           const wxString& filespec)
+{
+#if wxUSE_THREADS
+    if (!path.DirExists())
+        return false;
+
+    const wxString canonical = GetCanonicalPath(path);
+    if (canonical.empty())
+        return false;
+
+    // Start watching the path itself immediately.
+    if ( !AddAny(path.GetPathWithSep(), events, wxFSWPath_Tree, filespec) )
+        return false;
+
+    // Prevent asserts or infinite loops in trees containing symlinks
+    int flags = wxDIR_DIRS | wxDIR_HIDDEN;
+    if ( !path.ShouldFollowLink() )
+    {
+        flags |= wxDIR_NO_FOLLOW;
+    }
+
+    static int s_lastId = 0;
+
+    std::unique_ptr<wxFSWTreeAdder>
+        adder(new wxFSWTreeAdder(this, ++s_lastId, canonical,
+                                 events, filespec, flags));
+    if ( adder->Run() != wxTHREAD_NO_ERROR )
+    {
+        wxLogTrace(wxTRACE_FSWATCHER,
+                   "Failed to start thread, adding tree '%s' synchronously",
+                   canonical);
+
+        // AddTree() adds the root itself too, so stop watching it here to
+        // avoid leaving an extra reference to it which RemoveTree() wouldn't
+        // remove.
+        Remove(path.GetPathWithSep());
+
+        return AddTree(path, events, filespec);
+    }
+
+    m_treeAdders.push_back(std::move(adder));
+
+    return true;
+#else // !wxUSE_THREADS
+    return AddTree(path, events, filespec);
+#endif // wxUSE_THREADS/!wxUSE_THREADS
+}
+
+bool wxFileSystemWatcherBase::IsAddingTree() const
+{
+    return !m_treeAdders.empty();
+}
+
+void
+wxFileSystemWatcherBase::OnTreeDirsFound(int id,
+                                         const wxArrayString& dirs,
+                                         bool done)
+{
+#if wxUSE_THREADS
+    const auto it = std::find_if(m_treeAdders.begin(), m_treeAdders.end(),
+                                 [id](const std::unique_ptr<wxFSWTreeAdder>& a)
+                                 {
+                                     return a->GetId() == id;
+                                 });
+    if ( it == m_treeAdders.end() )
+    {
+        // This adder must have been cancelled, ignore the remaining
+        // directories found by it.
+        return;
+    }
+
+    wxFSWTreeAdder& adder = **it;
+    for ( const wxString& dirname : dirs )
+    {
+        if ( AddAny(wxFileName::DirName(dirname),
+                    adder.GetEvents(), wxFSWPath_Tree, adder.GetFilespec()) )
+        {
+            wxLogTrace(wxTRACE_FSWATCHER,
+               "--- AddTreeAsync adding directory '%s' ---", dirname);
+        }
+    }
+
+    if ( done )
+    {
+        // The thread is exiting or has already exited.
+        adder.Wait();
+        m_treeAdders.erase(it);
+    }
+#else // !wxUSE_THREADS
+    wxUnusedVar(id);
+    wxUnusedVar(dirs);
+    wxUnusedVar(done);
+#endif // wxUSE_THREADS/!wxUSE_THREADS
+}
+
+bool wxFileSystemWatcherBase::CancelAddTreeAsync(const wxString& canonical)
+{
+    bool cancelled = false;
+
+#if wxUSE_THREADS
+    for ( auto it = m_treeAdders.begin(); it != m_treeAdders.end(); )
+    {
+        wxFSWTreeAdder& adder = **it;
+        if ( canonical.empty() || adder.GetCanonicalPath() == canonical )
+        {
+            // This waits until the thread terminates.
+            adder.Delete();
+            it = m_treeAdders.erase(it);
+            cancelled = true;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+#else // !wxUSE_THREADS
+    wxUnusedVar(canonical);
+#endif // wxUSE_THREADS/!wxUSE_THREADS
+
+    return cancelled;
+}
+
 bool wxFileSystemWatcherBase::RemoveTree(const wxFileName& path)
 {
     if (!path.DirExists())
         return false;
 
+    // Stop adding the watches for this tree if it's still being traversed,
+    // in which case some of its directories are not watched yet.
+    const bool partial = CancelAddTreeAsync(GetCanonicalPath(path));
+
     // OPT could be optimised if we stored information about relationships
     // between paths
     class RemoveTraverser : public wxDirTraverser
     {
     public:
         RemoveTraverser(wxFileSystemWatcherBase* watcher,
-                        const wxString& filespec) :
-            m_watcher(watcher), m_filespec(filespec)
+                        const wxString& filespec,
+                        bool partial) :
+            m_watcher(watcher), m_filespec(filespec), m_partial(partial)
         {
         }
 
@@ -252,13 +497,21 @@ bool wxFileSystemWatcherBase::RemoveTree(const wxFileName& path)
 
         virtual wxDirTraverseResult OnDir(const wxString& dirname) override
         {
-            m_watcher->Remove(wxFileName::DirName(dirname));
+            const wxFileName dir = wxFileName::DirName(dirname);
+
+            // Don't try removing the directories which were never added.
+            if ( m_partial &&
+                    !m_watcher->m_watches.count(m_watcher->GetCanonicalPath(dir)) )
+                return wxDIR_CONTINUE;
+
+            m_watcher->Remove(dir);
             return wxDIR_CONTINUE;
         }
 
     private:
         wxFileSystemWatcherBase* m_watcher;
         wxString m_filespec;
+        const bool m_partial;
     };
 
     // If AddTree() used a filespec, we must use the same one
@@ -289,7 +542,7 @@ bool wxFileSystemWatcherBase::RemoveTree(const wxFileName& path)
     {
         flags |= wxDIR_NO_FOLLOW;
     }
-    RemoveTraverser traverser(this, filespec);
+    RemoveTraverser traverser(this, filespec, partial);
     dir.Traverse(traverser, filespec, flags);
 
     // As in AddTree() above, handle the path itself explicitly.
@@ -300,6 +553,8 @@ bool wxFileSystemWatcherBase::RemoveTree(const wxFileName& path)
 
 bool wxFileSystemWatcherBase::RemoveAll()
 {
+    CancelAddTreeAsync();
+
     const bool ret = m_service->RemoveAll();
     m_watches.clear();
     return ret;
@@ -17,14 +17,17 @@
     #include "wx/palette.h"
     #include "wx/intl.h"
     #include "wx/log.h"
+    #include "wx/utils.h"
 #endif
 
 #include <stdlib.h>
 #include <string.h>
 #include "wx/gifdecod.h"
+#include "wx/mstream.h"
 #include "wx/scopedarray.h"
 #include "wx/scopeguard.h"
 
+#include <algorithm>
 #include <memory>
 
 enum
@@ -63,6 +66,13 @@ public:
     unsigned int ncolours;          // number of colours
     wxString comment;
 
+    // only used in lazy decoding mode, when p is null until the frame is
+    // decoded: the offset of the compressed data in wxGIFDecoder::m_frameData
+    // and the parameters needed for decoding it
+    size_t dataOffset;
+    int interl;
+    int bits;
+
     wxDECLARE_NO_COPY_CLASS(GIFImage);
 };
 
@@ -81,6 +91,9 @@ GIFImage::GIFImage()
     p = (unsigned char *) nullptr;
     pal = (unsigned char *) nullptr;
     ncolours = 0;
+    dataOffset = 0;
+    interl = 0;
+    bits = 0;
 }
 
 //---------------------------------------------------------------------------
@@ -109,6 +122,16 @@ void wxGIFDecoder::Destroy()
 
     m_frames.Clear();
     m_nFrames = 0;
+
+    m_frameData.clear();
+    m_cachedFrames.clear();
+}
+
+void wxGIFDecoder::EnableLazyDecoding(bool enable, unsigned int maxCachedFrames)
+{
+    wxASSERT_MSG( !m_nFrames, "must be called before loading the animation" );
+
+    m_maxCachedFrames = enable ? wxMax(maxCachedFrames, 1u) : 0;
 }
 
 
@@ -140,6 +163,9 @@ bool wxGIFDecoder::ConvertToImage(unsigned int frame, wxImage *image) const
     pal = GetPalette(frame);
     src = GetData(frame);
     dst = image->GetData();
+
+    if (!src)
+        return false;
     transparent = GetTransparentColourIndex(frame);
 
     // set transparent colour mask
@@ -270,13 +296,144 @@ wxColour wxGIFDecoder::GetTransparentColour(unsigned int frame) const
                     pal[n*3 + 2]);
 }
 
-unsigned char* wxGIFDecoder::GetData(unsigned int frame) const    { return (GetFrame(frame)->p); }
+unsigned char* wxGIFDecoder::GetData(unsigned int frame) const    { return (GetDecodedFrame(frame)->p); }
 unsigned char* wxGIFDecoder::GetPalette(unsigned int frame) const { return (GetFrame(frame)->pal); }
 unsigned int wxGIFDecoder::GetNcolours(unsigned int frame) const  { return (GetFrame(frame)->ncolours); }
 int wxGIFDecoder::GetTransparentColourIndex(unsigned int frame) const  { return (GetFrame(frame)->transparent); }
 
 
 
+//---------------------------------------------------------------------------
+// Lazy decoding
+//---------------------------------------------------------------------------
+
+GIFImage *wxGIFDecoder::GetDecodedFrame(unsigned int frame) const
+{
+    // any errors are ignored here, there is nothing to do about them any
+    // more, and the partially decoded frame is used, just as when the file
+    // is truncated
+    DecodeFrame(frame);
+
+    return GetFrame(frame);
+}
+
+wxGIFErrorCode wxGIFDecoder::DecodeFrame(unsigned int frame) const
+{
+    if ( !IsLazyDecodingEnabled() )
+        return wxGIF_OK;
+
+    GIFImage* const img = GetFrame(frame);
+
+    std::vector<unsigned int>::iterator it =
+        std::find(m_cachedFrames.begin(), m_cachedFrames.end(), frame);
+    if ( it != m_cachedFrames.end() )
+    {
+        // just mark it as the most recently used one
+        m_cachedFrames.erase(it);
+        m_cachedFrames.push_back(frame);
+        return wxGIF_OK;
+    }
+
+    // free the least recently used frame if there are too many of them, but
+    // reuse its buffer if possible
+    unsigned char* p = nullptr;
+    if ( m_cachedFrames.size() >= m_maxCachedFrames )
+    {
+        GIFImage* const old = GetFrame(m_cachedFrames.front());
+        if ( old->w * old->h == img->w * img->h )
+            p = old->p;
+        else
+            free(old->p);
+        old->p = nullptr;
+
+        m_cachedFrames.erase(m_cachedFrames.begin());
+    }
+
+    if ( !p )
+    {
+        p = (unsigned char *) malloc(wxMax(img->w * img->h, 1u));
+        if ( !p )
+            return wxGIF_MEMERR;
+    }
+
+    // the data may be incomplete, so initialize the entire frame
+    memset(p, 0, img->w * img->h);
+    img->p = p;
+
+    // this is the only thing modifying the decoder state in this function,
+    // which is logically const as it doesn't change the decoded frames
+    wxGIFDecoder* const self = const_cast<wxGIFDecoder*>(this);
+
+    wxMemoryInputStream stream(&m_frameData[img->dataOffset],
+                               m_frameData.size() - img->dataOffset);
+
+    // the frame is kept even if an error occurs, as it's partially decoded
+    const wxGIFErrorCode result = self->dgif(stream, img, img->interl, img->bits);
+
+    m_cachedFrames.push_back(frame);
+
+    return result;
+}
+
+wxGIFErrorCode wxGIFDecoder::ValidateFrames(int lastFrame)
+{
+    for ( unsigned int frame = 0; frame < m_nFrames; frame++ )
+    {
+        if ( static_cast<int>(frame) == lastFrame )
+            continue;
+
+        const wxGIFErrorCode result = DecodeFrame(frame);
+        if ( result != wxGIF_OK )
+            return result;
+    }
+
+    if ( lastFrame >= 0 && static_cast<unsigned int>(lastFrame) < m_nFrames )
+        return DecodeFrame(lastFrame);
+
+    return wxGIF_OK;
+}
+
+wxGIFErrorCode
+wxGIFDecoder::StoreFrameData(wxInputStream& stream,
+                             GIFImage *img, int interl, int bits)
+{
+    img->dataOffset = m_frameData.size();
+    img->interl = interl;
+    img->bits = bits;
+
+    // copy all data sub-blocks, including the terminating empty one
+    for ( ;; )
+    {
+        const int len = stream.GetC();
+        if ( len == wxEOF )
+        {
+            // the data is truncated, but the frame can still be partially
+            // decoded, as in non-lazy mode, so just terminate it
+            m_frameData.push_back(0);
+            break;
+        }
+
+        const size_t offset = m_frameData.size();
+        m_frameData.resize(offset + 1 + len);
+        m_frameData[offset] = static_cast<unsigned char>(len);
+
+        if ( !len )
+            break;
+
+        if ( !stream.Read(&m_frameData[offset + 1], len) ||
+                stream.LastRead() != static_cast<size_t>(len) )
+        {
+            // partially read sub-block is ignored by getcode() anyhow
+            m_frameData.resize(offset);
+            m_frameData.push_back(0);
+            break;
+        }
+    }
+
+    return wxGIF_OK;
+}
+
+
 //---------------------------------------------------------------------------
 // GIF reading and decoding
 //---------------------------------------------------------------------------
@@ -834,11 +991,17 @@ wxGIFErrorCode wxGIFDecoder::LoadGIF(wxInputStream& stream)
                 pimg->disposal = disposal;
                 pimg->delay = delay;
 
-                // allocate memory for image and palette
-                pimg->p   = (unsigned char *) malloc((unsigned int)size);
-                pimg->pal = (unsigned char *) malloc(768);
+                // allocate memory for image (unless it will be decoded
+                // later) and palette
+                if ( !IsLazyDecodingEnabled() )
+                {
+                    pimg->p = (unsigned char *) malloc((unsigned int)size);
+                    if (!pimg->p)
+                        return wxGIF_MEMERR;
+                }
 
-                if ((!pimg->p) || (!pimg->pal))
+                pimg->pal = (unsigned char *) malloc(768);
+                if (!pimg->pal)
                     return wxGIF_MEMERR;
 
                 // load local color map if available, else use global map
@@ -862,8 +1025,10 @@ wxGIFErrorCode wxGIFDecoder::LoadGIF(wxInputStream& stream)
                 if (stream.Eof() || bits <= 0)
                     return wxGIF_INVFORMAT;
 
-                // decode image
-                wxGIFErrorCode result = dgif(stream, pimg.get(), interl, bits);
+                // decode image or just store its data to decode it later
+                wxGIFErrorCode result = IsLazyDecodingEnabled()
+                    ? StoreFrameData(stream, pimg.get(), interl, bits)
+                    : dgif(stream, pimg.get(), interl, bits);
                 if (result != wxGIF_OK)
                     return result;
 
@@ -36,6 +36,15 @@
 #include "wx/private/rescale.h"
 #include "wx/display.h"
 
+#if wxUSE_THREADS
+    #include "wx/thread.h"
+
+    #include <atomic>
+    #include <vector>
+#endif // wxUSE_THREADS
+
+#include <memory>
+
 //-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
@@ -849,6 +858,87 @@ void wxGraphicsContext::StrokeLines( size_t n, const wxPoint2DDouble *beginPoint
     StrokePath( path );
 }
 
+void wxGraphicsContext::DrawRectangles( size_t n, const wxRect2DDouble *rects, const wxColour *colours)
+{
+    if ( !colours )
+    {
+        wxGraphicsPath path = CreatePath();
+        for ( size_t i = 0; i < n; ++i )
+        {
+            const wxRect2DDouble r = wxGetNormalizedRect2D(rects[i]);
+            path.AddRectangle( r.m_x, r.m_y, r.m_width, r.m_height );
+        }
+        DrawPath( path, wxWINDING_RULE );
+        return;
+    }
+
+    // Fill all consecutive rectangles of the same colour at once.
+    const wxGraphicsBrush formerBrush = m_brush;
+    for ( size_t i = 0; i < n; )
+    {
+        const wxColour& colour = colours[i];
+
+        wxGraphicsPath path = CreatePath();
+        for ( ; i < n && colours[i] == colour; ++i )
+        {
+            const wxRect2DDouble r = wxGetNormalizedRect2D(rects[i]);
+            path.AddRectangle( r.m_x, r.m_y, r.m_width, r.m_height );
+        }
+
+        SetBrush( CreateBrush(wxBrush(colour)) );
+        FillPath( path, wxWINDING_RULE );
+    }
+    SetBrush( formerBrush );
+
+    // And then outline all of them using the current pen.
+    if ( !m_pen.IsNull() )
+    {
+        wxGraphicsPath path = CreatePath();
+        for ( size_t i = 0; i < n; ++i )
+            path.AddRectangle( rects[i].m_x, rects[i].m_y, rects[i].m_width, rects[i].m_height );
+        StrokePath( path );
+    }
+}
+
+void wxGraphicsContext::DrawPoints( size_t n, const wxPoint2DDouble *points, const wxColour *colours)
+{
+    wxVector<wxRect2DDouble> rects(n);
+    for ( size_t i = 0; i < n; ++i )
+        rects[i] = wxRect2DDouble(points[i].m_x, points[i].m_y, 1, 1);
+
+    const wxGraphicsPen formerPen = m_pen;
+    SetPen( wxNullGraphicsPen );
+    DrawRectangles( n, rects.empty() ? nullptr : &rects[0], colours );
+    SetPen( formerPen );
+}
+
+void wxGraphicsContext::StrokeSegments( size_t n, const wxPoint2DDouble *beginPoints, const wxPoint2DDouble *endPoints,
+                                        const wxGraphicsPenInfo& pen, const wxColour *colours)
+{
+    const wxGraphicsPen formerPen = m_pen;
+
+    // Stroke all consecutive segments of the same colour at once.
+    wxGraphicsPenInfo info(pen);
+    for ( size_t i = 0; i < n; )
+    {
+        const size_t first = i;
+
+        wxGraphicsPath path = CreatePath();
+        for ( ; i < n && (!colours || colours[i] == colours[first]); ++i )
+        {
+            path.MoveToPoint( beginPoints[i].m_x, beginPoints[i].m_y );
+            path.AddLineToPoint( endPoints[i].m_x, endPoints[i].m_y );
+        }
+
+        if ( colours )
+            info.Colour( colours[first] );
+        SetPen( CreatePen(info) );
+        StrokePath( path );
+    }
+
+    SetPen( formerPen );
+}
+
 // create a 'native' matrix corresponding to these values
 wxGraphicsMatrix wxGraphicsContext::CreateMatrix( wxDouble a, wxDouble b, wxDouble c, wxDouble d,
     wxDouble tx, wxDouble ty) const
@@ -1091,4 +1181,237 @@ wxGraphicsContext* wxGraphicsRenderer::CreateContextFromUnknownDC(const wxDC& dc
     return nullptr;
 }
 
+#if wxUSE_IMAGE
+
+#if wxUSE_THREADS
+
+// To render the image using multiple threads, it is split in horizontal bands
+// and each of them is drawn on its own image by calling the drawing function
+// with the context translated so that the band rows are at the same position
+// as in the full image. As the translation is by an integer number of pixels,
+// the result is exactly the same as when drawing on the entire image.
+
+// The minimal number of rows in a band, it's not worth using threads for
+// drawing the bands smaller than this.
+static const int wxGC_MIN_BAND_ROWS = 64;
+
+namespace
+{
+
+// A band of rows drawn by one of the threads.
+struct wxGCImageBand
+{
+    int firstRow = 0;
+
+    // Initially contains the band rows of the original image, replaced with
+    // the drawing result when the context is destroyed.
+    wxImage image;
+
+    // The context used for drawing on the image. It is created and destroyed
+    // in the main thread, as creating it may require using the GUI toolkit
+    // functions (e.g. wxGTK gets the default screen font options from GDK),
+    // and is used only for drawing in the other threads.
+    std::unique_ptr<wxGraphicsContext> gc;
+};
+
+struct wxGCImageBandsParams
+{
+    wxGCImageBandsParams(const std::function<void (wxGraphicsContext&)>& draw_,
+                         std::vector<wxGCImageBand>& bands_)
+        : draw(draw_),
+          bands(bands_),
+          next(0)
+    {
+    }
+
+    const std::function<void (wxGraphicsContext&)>& draw;
+    std::vector<wxGCImageBand>& bands;
+
+    // Index of the next band to draw.
+    std::atomic<size_t> next;
+};
+
+// Draw the bands until there are no more of them left, this is called from
+// several threads concurrently.
+void wxGCDrawImageBands(wxGCImageBandsParams& params)
+{
+    for ( ;; )
+    {
+        const size_t n = params.next++;
+        if ( n >= params.bands.size() )
+            break;
+
+        params.draw(*params.bands[n].gc);
+    }
+}
+
+class wxGCDrawImageBandsThread : public wxThread
+{
+public:
+    explicit wxGCDrawImageBandsThread(wxGCImageBandsParams& params)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_params(params)
+    {
+    }
+
+protected:
+    virtual void* Entry() override
+    {
+        wxGCDrawImageBands(m_params);
+
+        return nullptr;
+    }
+
+private:
+    wxGCImageBandsParams& m_params;
+};
+
+} // anonymous namespace
+
+#endif // wxUSE_THREADS
+
+bool
+wxGraphicsRenderer::RenderImageInBands(wxImage& image,
+                                       const std::function<void (wxGraphicsContext&)>& draw,
+                                       int numThreads)
+{
+    wxCHECK_MSG( image.IsOk(), false, "invalid image" );
+    wxCHECK_MSG( draw, false, "no drawing function" );
+
+#if wxUSE_THREADS
+    if ( numThreads <= 0 )
+        numThreads = wxThread::GetCPUCount();
+
+    const int width = image.GetWidth();
+    const int height = image.GetHeight();
+    const int numBands = wxMin(numThreads, height / wxGC_MIN_BAND_ROWS);
+    if ( numBands > 1 )
+    {
+        // Packed images are drawn on directly, without converting them, so
+        // keep using the packed data for the bands too to ensure that the
+        // result is the same.
+        const bool packed = image.IsPacked() && !image.HasMask();
+        wxUint32* const packedData = packed ? image.GetPackedData() : nullptr;
+        wxCHECK_MSG( !packed || packedData, false, "failed to get image data" );
+
+        std::vector<wxGCImageBand> bands(numBands);
+        for ( int n = 0; n < numBands; n++ )
+        {
+            wxGCImageBand& band = bands[n];
+            band.firstRow = static_cast<int>(static_cast<wxInt64>(height) * n / numBands);
+
+            const int numRows = static_cast<int>(static_cast<wxInt64>(height) * (n + 1) / numBands)
+                                    - band.firstRow;
+
+            if ( packed )
+            {
+                if ( !band.image.CreatePacked(width, numRows, false) )
+                    return false;
+
+                memcpy(band.image.GetPackedData(),
+                       packedData + static_cast<size_t>(band.firstRow)*width,
+                       static_cast<size_t>(numRows)*width*sizeof(wxUint32));
+            }
+            else
+            {
+                band.image = image.GetSubImage(wxRect(0, band.firstRow, width, numRows));
+                if ( !band.image.IsOk() )
+                    return false;
+            }
+
+            band.gc.reset(CreateContextFromImage(band.image));
+            if ( !band.gc )
+                return false;
+
+            band.gc->Translate(0, -band.firstRow);
+        }
+
+        wxGCImageBandsParams params(draw, bands);
+
+        std::vector<std::unique_ptr<wxGCDrawImageBandsThread>> threads;
+        for ( int n = 1; n < numBands; n++ )
+        {
+            std::unique_ptr<wxGCDrawImageBandsThread>
+                thread(new wxGCDrawImageBandsThread(params));
+            if ( thread->Run() != wxTHREAD_NO_ERROR )
+            {
+                // Not fatal, we'll just use fewer threads.
+                break;
+            }
+
+            threads.push_back(std::move(thread));
+        }
+
+        // Do some of the work in this thread too.
+        wxGCDrawImageBands(params);
+
+        for ( const auto& thread : threads )
+            thread->Wait();
+
+        // Destroying the contexts stores the drawing results in the images.
+        for ( auto& band : bands )
+            band.gc.reset();
+
+        // Combine the bands into the final image.
+        if ( packed )
+        {
+            for ( auto& band : bands )
+            {
+                memcpy(packedData + static_cast<size_t>(band.firstRow)*width,
+                       band.image.GetPackedData(),
+                       static_cast<size_t>(band.image.GetHeight())*width*sizeof(wxUint32));
+            }
+
+            return true;
+        }
+
+        // As when drawing on the entire image, the result is a new image
+        // having the same format as the images produced for the bands.
+        wxImage result(width, height, false /* don't clear */);
+        if ( !result.IsOk() )
+            return false;
+
+        const bool hasAlpha = bands[0].image.HasAlpha();
+        if ( hasAlpha )
+            result.SetAlpha();
+
+        unsigned char* const data = result.GetData();
+        unsigned char* const alpha = result.GetAlpha();
+        for ( auto& band : bands )
+        {
+            const size_t offset = static_cast<size_t>(band.firstRow)*width;
+            const size_t count = static_cast<size_t>(band.image.GetHeight())*width;
+
+            memcpy(data + 3*offset, band.image.GetData(), 3*count);
+
+            if ( hasAlpha )
+            {
+                const unsigned char* const bandAlpha = band.image.GetAlpha();
+                if ( bandAlpha )
+                    memcpy(alpha + offset, bandAlpha, count);
+                else
+                    memset(alpha + offset, wxALPHA_OPAQUE, count);
+            }
+        }
+
+        image = result;
+
+        return true;
+    }
+#else // !wxUSE_THREADS
+    wxUnusedVar(numThreads);
+#endif // wxUSE_THREADS/!wxUSE_THREADS
+
+    // Just draw on the entire image directly.
+    std::unique_ptr<wxGraphicsContext> gc(CreateContextFromImage(image));
+    if ( !gc )
+        return false;
+
+    draw(*gc);
+
+    return true;
+}
+
+#endif // wxUSE_IMAGE
+
 #endif // wxUSE_GRAPHICS_CONTEXT
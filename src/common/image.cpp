@@ -24,13 +24,19 @@
     #include "wx/colour.h"
 #endif
 
+#include "wx/thread.h"
 #include "wx/wfstream.h"
 #include "wx/xpmdecod.h"
 
+#include "wx/private/image.h"
+
 // For memcpy
 #include <string.h>
 
+#include <atomic>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 // make the code compile with either wxFile*Stream or wxFFile*Stream:
 #define HAS_FILE_STREAMS (wxUSE_STREAMS && (wxUSE_FILE || wxUSE_FFILE))
@@ -56,6 +62,129 @@ IMPLEMENT_VARIANT_OBJECT_EXPORTED_SHALLOWCMP(wxImage,WXDLLEXPORT)
 wxList wxImage::sm_handlers;
 wxImage wxNullImage;
 
+//-----------------------------------------------------------------------------
+// image handlers index
+//-----------------------------------------------------------------------------
+
+namespace
+{
+
+// Index of the handlers in wxImage::sm_handlers by their type, extension and
+// MIME type, allowing to find them without calling the functions of all the
+// handlers in the list.
+//
+// It is rebuilt whenever a handler is added or removed, so it is never
+// modified during the lookups, which may happen in several threads at once.
+// Each rebuild increments the generation of the handlers list, and so does
+// deleting any handler, which is used to check that the index is up to date
+// and never returns a deleted handler.
+class wxImageHandlersIndex
+{
+public:
+    // All the handlers using the same key, in the same order as in the list.
+    typedef std::vector<wxImageHandler*> Handlers;
+
+    void Update(const wxList& list)
+    {
+        m_byType.clear();
+        m_byExt.clear();
+        m_byMime.clear();
+
+        m_generation = ++ms_listGeneration;
+        m_count = list.GetCount();
+
+        for ( wxList::compatibility_iterator node = list.GetFirst();
+              node;
+              node = node->GetNext() )
+        {
+            wxImageHandler* const handler = (wxImageHandler*)node->GetData();
+
+            // Only the first handler of each type can be found.
+            m_byType.insert(std::make_pair(handler->GetType(), handler));
+
+            AddToBucket(m_byExt, handler->GetExtension(), handler);
+            for ( const wxString& ext : handler->GetAltExtensions() )
+                AddToBucket(m_byExt, ext, handler);
+
+            AddToBucket(m_byMime, handler->GetMimeType(), handler);
+        }
+    }
+
+    // Called when a handler is deleted.
+    static void Invalidate() { ++ms_listGeneration; }
+
+    // The index can't be used if the list returned by wxImage::GetHandlers()
+    // was modified directly instead of using AddHandler() and RemoveHandler().
+    //
+    // This can only be detected if a handler was deleted or the number of
+    // handlers changed, but these checks are cheap, unlike comparing all the
+    // handlers.
+    bool IsValidFor(const wxList& list) const
+    {
+        return m_generation == ms_listGeneration && m_count == list.GetCount();
+    }
+
+    wxImageHandler* GetByType(wxBitmapType type) const
+    {
+        const auto it = m_byType.find(type);
+        if ( it == m_byType.end() )
+            return nullptr;
+
+        // The handler type could have been changed since the index was built.
+        wxImageHandler* const handler = it->second;
+        return handler->GetType() == type ? handler : nullptr;
+    }
+
+    // The caller must still check the handlers returned by these functions,
+    // as the keys are case-insensitive but not all comparisons are.
+    const Handlers* GetByExtension(const wxString& ext) const
+    {
+        return GetBucket(m_byExt, ext);
+    }
+
+    const Handlers* GetByMimeType(const wxString& mime) const
+    {
+        return GetBucket(m_byMime, mime);
+    }
+
+private:
+    typedef std::unordered_map<wxString, Handlers> Buckets;
+
+    static void
+    AddToBucket(Buckets& buckets, const wxString& key, wxImageHandler* handler)
+    {
+        Handlers& handlers = buckets[key.Lower()];
+
+        // Don't add the same handler twice if its main and alternative
+        // extensions differ only in case.
+        if ( handlers.empty() || handlers.back() != handler )
+            handlers.push_back(handler);
+    }
+
+    static const Handlers* GetBucket(const Buckets& buckets, const wxString& key)
+    {
+        const auto it = buckets.find(key.Lower());
+        return it == buckets.end() ? nullptr : &it->second;
+    }
+
+    std::unordered_map<int, wxImageHandler*> m_byType;
+    Buckets m_byExt;
+    Buckets m_byMime;
+
+    // The generation of the list incremented by Update() and Invalidate().
+    static unsigned ms_listGeneration;
+
+    // The generation and the number of handlers the index was built for.
+    unsigned m_generation = 0;
+    size_t m_count = 0;
+};
+
+unsigned wxImageHandlersIndex::ms_listGeneration = 0;
+
+wxImageHandlersIndex gs_handlersIndex;
+
+} // anonymous namespace
+
 //-----------------------------------------------------------------------------
 // wxImageRefData
 //-----------------------------------------------------------------------------
@@ -85,6 +214,24 @@ public:
     // same as m_static but for m_alpha
     bool            m_staticAlpha;
 
+    // pixel data in packed storage mode: if this is non-null, m_data and
+    // m_alpha are not used (but are still allocated if they're static)
+    wxImagePackedBuffer *m_packed;
+
+    // true if the alpha channel is used in packed storage mode and must be
+    // kept when converting the image back to the default storage
+    bool            m_packedHasAlpha;
+
+    // true if the packed data could have been modified since it was created,
+    // in which case it may contain non-opaque pixels
+    bool            m_packedModified;
+
+    // true if m_data and m_alpha contain the same pixels as m_packed: this is
+    // the case after accessing the data of a packed image in a const function,
+    // as the packed buffer can't be released then, because other threads may
+    // be using it
+    std::atomic<bool> m_unpacked;
+
     // global and per-object flags determining LoadFile() behaviour
     int             m_loadFlags;
     static int      sm_defaultLoadFlags;
@@ -96,12 +243,75 @@ public:
     wxArrayString   m_optionNames;
     wxArrayString   m_optionValues;
 
+    // Switch to the packed storage mode, converting the data to it.
+    bool Pack();
+
+    // Convert the data from the packed buffer, which is kept, to m_data and
+    // m_alpha. Returns false, without changing anything, if allocating memory
+    // for them failed.
+    //
+    // If keepAlpha is true, the alpha channel is kept if HasAlpha() returns
+    // true for the packed image, even if all pixels turn out to be opaque.
+    bool ConvertFromPacked(bool keepAlpha);
+
+    // Switch back to the default storage, converting the data from the packed
+    // buffer which is released. Returns false if there is not enough memory,
+    // in which case the image remains in the packed mode.
+    bool Unpack();
+
+    // Release the data in the default storage if the packed buffer is going to
+    // be modified.
+    void DiscardUnpacked();
+
+    // Return the image data ensuring that it uses the default storage or null
+    // if converting the data to it failed.
+    //
+    // The second parameter is only used to select the overload depending on
+    // whether the image is const or not: non-const images switch to the
+    // default storage, while for the const ones it's only created, in a
+    // thread-safe way, while keeping the packed data.
+    static wxImageRefData*
+    GetUnpacked(wxObjectRefData* refData, wxImage* WXUNUSED(image))
+    {
+        wxImageRefData* const data = static_cast<wxImageRefData*>(refData);
+        if ( data && data->m_packed && !data->Unpack() )
+            return nullptr;
+
+        return data;
+    }
+
+    static wxImageRefData*
+    GetUnpacked(wxObjectRefData* refData, const wxImage* WXUNUSED(image))
+    {
+        wxImageRefData* const data = static_cast<wxImageRefData*>(refData);
+        if ( data && data->m_packed && !data->m_unpacked.load(std::memory_order_acquire) )
+        {
+            wxCriticalSectionLocker lock(ms_csUnpack);
+
+            if ( !data->m_unpacked.load(std::memory_order_relaxed) )
+            {
+                // Don't change the result of HasAlpha() for the image.
+                if ( !data->ConvertFromPacked(true /* keep alpha */) )
+                    return nullptr;
+
+                data->m_unpacked.store(true, std::memory_order_release);
+            }
+        }
+
+        return data;
+    }
+
+    // Used to serialize the conversions in the const overload above.
+    static wxCriticalSection ms_csUnpack;
+
     wxDECLARE_NO_COPY_CLASS(wxImageRefData);
 };
 
 // For compatibility, if nothing else, loading is verbose by default.
 int wxImageRefData::sm_defaultLoadFlags = wxImage::Load_Verbose;
 
+wxCriticalSection wxImageRefData::ms_csUnpack;
+
 wxImageRefData::wxImageRefData()
 {
     m_width = 0;
@@ -119,6 +329,11 @@ wxImageRefData::wxImageRefData()
     m_static =
     m_staticAlpha = false;
 
+    m_packed = nullptr;
+    m_packedHasAlpha = false;
+    m_packedModified = false;
+    m_unpacked = false;
+
     m_loadFlags = sm_defaultLoadFlags;
 }
 
@@ -128,6 +343,178 @@ wxImageRefData::~wxImageRefData()
         free( m_data );
     if ( !m_staticAlpha )
         free( m_alpha );
+    if ( m_packed )
+        m_packed->DecRef();
+}
+
+bool wxImageRefData::Pack()
+{
+    const size_t count = size_t(m_width)*m_height;
+
+    wxImagePackedBuffer* const packed = new wxImagePackedBuffer(count);
+    if ( !packed->IsOk() )
+    {
+        packed->DecRef();
+        return false;
+    }
+
+    wxUint32* dst = packed->GetData();
+    const unsigned char* src = m_data;
+    const unsigned char* alpha = m_alpha;
+    if ( alpha )
+    {
+        for ( size_t n = 0; n < count; n++, src += 3 )
+        {
+            const unsigned a = *alpha++;
+            *dst++ = a                  << 24 |
+                     ((a * src[0]) / 255) << 16 |
+                     ((a * src[1]) / 255) <<  8 |
+                     ((a * src[2]) / 255);
+        }
+    }
+    else
+    {
+        for ( size_t n = 0; n < count; n++, src += 3 )
+        {
+            *dst++ = 0xff000000u | src[0] << 16 | src[1] << 8 | src[2];
+        }
+    }
+
+    m_packedHasAlpha = m_alpha != nullptr;
+
+    // The planes are not used any more, but we can't free them if they don't
+    // belong to us, so just keep them to convert the data back into them.
+    if ( !m_static )
+    {
+        free(m_data);
+        m_data = nullptr;
+    }
+
+    if ( !m_staticAlpha )
+    {
+        free(m_alpha);
+        m_alpha = nullptr;
+    }
+
+    m_packed = packed;
+
+    return true;
+}
+
+bool wxImageRefData::ConvertFromPacked(bool keepAlpha)
+{
+    const size_t count = size_t(m_width)*m_height;
+
+    // The planes may have been kept when packing the data if they're static.
+    unsigned char* const data = m_data
+                                    ? m_data
+                                    : static_cast<unsigned char*>(malloc(3*count));
+
+    // We don't know if alpha is needed before converting all pixels, unless it
+    // was already used before, so allocate it in any case and free it if all
+    // pixels turn out to be opaque.
+    unsigned char* alpha = m_alpha
+                                ? m_alpha
+                                : static_cast<unsigned char*>(malloc(count));
+
+    if ( !data || !alpha )
+    {
+        if ( data != m_data )
+            free(data);
+        if ( alpha != m_alpha )
+            free(alpha);
+
+        return false;
+    }
+
+    const wxUint32* src = m_packed->GetData();
+    unsigned char* dst = data;
+    unsigned char* dstAlpha = alpha;
+    bool hasAlpha = m_packedHasAlpha || (keepAlpha && m_packedModified);
+    for ( size_t n = 0; n < count; n++ )
+    {
+        const wxUint32 argb = *src++;
+        const unsigned a = argb >> 24;
+        *dstAlpha++ = static_cast<unsigned char>(a);
+
+        if ( a == 0xff )
+        {
+            *dst++ = static_cast<unsigned char>(argb >> 16);
+            *dst++ = static_cast<unsigned char>(argb >> 8);
+            *dst++ = static_cast<unsigned char>(argb);
+        }
+        else
+        {
+            hasAlpha = true;
+
+            if ( a )
+            {
+                // Clamp the values to deal with invalid premultiplied data
+                // in which a colour component is greater than alpha.
+                *dst++ = static_cast<unsigned char>(
+                            wxMin(((argb >> 16) & 0xff) * 255 / a, 255u));
+                *dst++ = static_cast<unsigned char>(
+                            wxMin(((argb >> 8) & 0xff) * 255 / a, 255u));
+                *dst++ = static_cast<unsigned char>(
+                            wxMin((argb & 0xff) * 255 / a, 255u));
+            }
+            else
+            {
+                *dst++ = 0;
+                *dst++ = 0;
+                *dst++ = 0;
+            }
+        }
+    }
+
+    if ( !hasAlpha && !m_staticAlpha )
+    {
+        free(alpha);
+        alpha = nullptr;
+    }
+
+    m_data = data;
+    m_alpha = alpha;
+
+    return true;
+}
+
+bool wxImageRefData::Unpack()
+{
+    // If the data was already converted by a const function, it must be kept
+    // as is, because pointers to it could have been returned, even if the
+    // alpha channel could turn out to be unnecessary.
+    if ( !m_unpacked && !ConvertFromPacked(false /* don't keep unused alpha */) )
+        return false;
+
+    m_packed->DecRef();
+    m_packed = nullptr;
+    m_packedHasAlpha = false;
+    m_packedModified = false;
+    m_unpacked = false;
+
+    return true;
+}
+
+void wxImageRefData::DiscardUnpacked()
+{
+    if ( !m_unpacked )
+        return;
+
+    // As in Pack(), keep the static planes to convert the data back into them.
+    if ( !m_static )
+    {
+        free(m_data);
+        m_data = nullptr;
+    }
+
+    if ( !m_staticAlpha )
+    {
+        free(m_alpha);
+        m_alpha = nullptr;
+    }
+
+    m_unpacked = false;
 }
 
 
@@ -135,7 +522,20 @@ wxImageRefData::~wxImageRefData()
 // wxImage
 //-----------------------------------------------------------------------------
 
-#define M_IMGDATA static_cast<wxImageRefData*>(m_refData)
+// This macro must be used to access the image RGB data or alpha channel, as it
+// switches the image from the packed storage mode if necessary. This can fail
+// if there is not enough memory, so the functions using it must check for it
+// first, using the macros below.
+#define M_IMGDATA wxImageRefData::GetUnpacked(m_refData, this)
+
+#define wxCHECK_IMGDATA(rc) \
+    wxCHECK_MSG( M_IMGDATA, rc, wxS("failed to unpack image data") )
+#define wxCHECK_IMGDATA_RET() \
+    wxCHECK_RET( M_IMGDATA, wxS("failed to unpack image data") )
+
+// This one can be used to access the other image attributes, such as its size,
+// without changing the storage mode.
+#define M_IMGINFO static_cast<wxImageRefData*>(m_refData)
 
 wxIMPLEMENT_DYNAMIC_CLASS(wxImage, wxObject);
 
@@ -231,6 +631,7 @@ void wxImage::Clear(unsigned char value)
     wxCHECK_RET( IsOk(), wxT("invalid image") );
 
     AllocExclusive();
+    wxCHECK_IMGDATA_RET();
 
     memset(M_IMGDATA->m_data, value, M_IMGDATA->m_width*M_IMGDATA->m_height*3);
 }
@@ -254,14 +655,35 @@ wxObjectRefData* wxImage::CloneRefData(const wxObjectRefData* that) const
     refData_new->m_hasMask = refData->m_hasMask;
     refData_new->m_ok = true;
     unsigned size = unsigned(refData->m_width) * unsigned(refData->m_height);
-    if (refData->m_alpha != nullptr)
+    if (refData->m_packed != nullptr)
     {
-        refData_new->m_alpha = (unsigned char*)malloc(size);
-        memcpy(refData_new->m_alpha, refData->m_alpha, size);
+        // Don't switch the original image from the packed mode, just copy the
+        // data in this mode.
+        wxImagePackedBuffer* const packed = new wxImagePackedBuffer(size);
+        if ( !packed->IsOk() )
+        {
+            packed->DecRef();
+            refData_new->DecRef();
+            return nullptr;
+        }
+
+        memcpy(packed->GetData(), refData->m_packed->GetData(),
+               size*sizeof(wxUint32));
+        refData_new->m_packed = packed;
+        refData_new->m_packedHasAlpha = refData->m_packedHasAlpha;
+        refData_new->m_packedModified = refData->m_packedModified;
+    }
+    else
+    {
+        if (refData->m_alpha != nullptr)
+        {
+            refData_new->m_alpha = (unsigned char*)malloc(size);
+            memcpy(refData_new->m_alpha, refData->m_alpha, size);
+        }
+        size *= 3;
+        refData_new->m_data = (unsigned char*)malloc(size);
+        memcpy(refData_new->m_data, refData->m_data, size);
     }
-    size *= 3;
-    refData_new->m_data = (unsigned char*)malloc(size);
-    memcpy(refData_new->m_data, refData->m_data, size);
 #if wxUSE_PALETTE
     refData_new->m_palette = refData->m_palette;
 #endif
@@ -277,6 +699,7 @@ wxImage wxImage::MakeEmptyClone(int flags) const
     wxImage image;
 
     wxCHECK_MSG( IsOk(), image, wxS("invalid image") );
+    wxCHECK_IMGDATA(image);
 
     long height = M_IMGDATA->m_height;
     long width  = M_IMGDATA->m_width;
@@ -326,6 +749,7 @@ wxImage wxImage::ShrinkBy( int xFactor , int yFactor ) const
     wxImage image;
 
     wxCHECK_MSG( IsOk(), image, wxT("invalid image") );
+    wxCHECK_IMGDATA(image);
 
     // can't scale to/from 0 size
     wxCHECK_MSG( (xFactor > 0) && (yFactor > 0), image,
@@ -445,6 +869,7 @@ wxImage::Scale( int width, int height, wxImageResizeQuality quality ) const
     wxImage image;
 
     wxCHECK_MSG( IsOk(), image, wxT("invalid image") );
+    wxCHECK_IMGDATA(image);
 
     // can't scale to/from 0 size
     wxCHECK_MSG( (width > 0) && (height > 0), image,
@@ -538,6 +963,7 @@ wxImage wxImage::ResampleNearest(int width, int height) const
     wxImage image;
 
     wxCHECK_MSG( IsOk(), image, "invalid image" );
+    wxCHECK_IMGDATA(image);
 
     // We use wxUIntPtr to rescale images of larger size in 64-bit builds:
     // using long wouldn't allow using images larger than 2^16 in either
@@ -662,6 +1088,7 @@ void ResampleBoxPrecalc(wxVector<BoxPrecalc>& boxes, int oldDim)
 wxImage wxImage::ResampleBox(int width, int height) const
 {
     wxCHECK_MSG( IsOk(), {}, "invalid image" );
+    wxCHECK_IMGDATA({});
 
     // This function implements a simple pre-blur/box averaging method for
     // downsampling that gives reasonably smooth results To scale the image
@@ -824,6 +1251,7 @@ void ResampleBilinearPrecalc(wxVector<BilinearPrecalc>& precalcs, int oldDim)
 wxImage wxImage::ResampleBilinear(int width, int height) const
 {
     wxCHECK_MSG( IsOk(), {}, "invalid image" );
+    wxCHECK_IMGDATA({});
 
     // This function implements a Bilinear algorithm for resampling.
     wxImage ret_image(width, height, false);
@@ -979,6 +1407,7 @@ void ResampleBicubicPrecalc(wxVector<BicubicPrecalc> &aWeight, int oldDim)
 wxImage wxImage::ResampleBicubic(int width, int height) const
 {
     wxCHECK_MSG( IsOk(), {}, "invalid image" );
+    wxCHECK_IMGDATA({});
 
     // This function implements a Bicubic B-Spline algorithm for resampling.
     // This method is certainly a little slower than wxImage's default pixel
@@ -1325,7 +1754,7 @@ wxImage wxImage::BlurVertical(int blurRadius) const
 wxImage wxImage::Blur(int blurRadius) const
 {
     wxImage ret_image;
-    ret_image.Create(M_IMGDATA->m_width, M_IMGDATA->m_height, false);
+    ret_image.Create(M_IMGINFO->m_width, M_IMGINFO->m_height, false);
 
     // Blur the image in each direction
     ret_image = BlurHorizontal(blurRadius);
@@ -1563,6 +1992,7 @@ wxImage wxImage::GetSubImage( const wxRect &rect ) const
     wxImage image;
 
     wxCHECK_MSG( IsOk(), image, wxT("invalid image") );
+    wxCHECK_IMGDATA(image);
 
     wxCHECK_MSG( (rect.GetLeft()>=0) && (rect.GetTop()>=0) &&
                  (rect.GetRight()<=GetWidth()) && (rect.GetBottom()<=GetHeight()),
@@ -1669,6 +2099,8 @@ wxImage::Paste(const wxImage & image, int x, int y,
     wxCHECK_RET( image.IsOk(), wxT("invalid image") );
 
     AllocExclusive();
+    wxCHECK_IMGDATA_RET();
+    wxCHECK_RET( image.GetData(), wxT("failed to unpack image data") );
 
     int xx = 0;
     int yy = 0;
@@ -1866,6 +2298,7 @@ void wxImage::Replace( unsigned char r1, unsigned char g1, unsigned char b1,
     wxCHECK_RET( IsOk(), wxT("invalid image") );
 
     AllocExclusive();
+    wxCHECK_IMGDATA_RET();
 
     unsigned char *data = GetData();
 
@@ -1951,21 +2384,21 @@ int wxImage::GetWidth() const
 {
     wxCHECK_MSG( IsOk(), 0, wxT("invalid image") );
 
-    return M_IMGDATA->m_width;
+    return M_IMGINFO->m_width;
 }
 
 int wxImage::GetHeight() const
 {
     wxCHECK_MSG( IsOk(), 0, wxT("invalid image") );
 
-    return M_IMGDATA->m_height;
+    return M_IMGINFO->m_height;
 }
 
 wxBitmapType wxImage::GetType() const
 {
     wxCHECK_MSG( IsOk(), wxBITMAP_TYPE_INVALID, wxT("invalid image") );
 
-    return M_IMGDATA->m_type;
+    return M_IMGINFO->m_type;
 }
 
 void wxImage::SetType(wxBitmapType type)
@@ -1975,16 +2408,16 @@ void wxImage::SetType(wxBitmapType type)
     // type can be wxBITMAP_TYPE_INVALID to reset the image type to default
     wxASSERT_MSG( type != wxBITMAP_TYPE_MAX, "invalid bitmap type" );
 
-    M_IMGDATA->m_type = type;
+    M_IMGINFO->m_type = type;
 }
 
 long wxImage::XYToIndex(int x, int y) const
 {
     if ( IsOk() &&
             x >= 0 && y >= 0 &&
-                x < M_IMGDATA->m_width && y < M_IMGDATA->m_height )
+                x < M_IMGINFO->m_width && y < M_IMGINFO->m_height )
     {
-        return y*M_IMGDATA->m_width + x;
+        return y*M_IMGINFO->m_width + x;
     }
 
     return -1;
@@ -1996,6 +2429,7 @@ void wxImage::SetRGB( int x, int y, unsigned char r, unsigned char g, unsigned c
     wxCHECK_RET( pos != -1, wxT("invalid image coordinates") );
 
     AllocExclusive();
+    wxCHECK_IMGDATA_RET();
 
     pos *= 3;
 
@@ -2009,6 +2443,7 @@ void wxImage::SetRGB( const wxRect& rect_, unsigned char r, unsigned char g, uns
     wxCHECK_RET( IsOk(), wxT("invalid image") );
 
     AllocExclusive();
+    wxCHECK_IMGDATA_RET();
 
     wxRect rect(rect_);
     wxRect imageRect(0, 0, GetWidth(), GetHeight());
@@ -2046,6 +2481,7 @@ unsigned char wxImage::GetRed( int x, int y ) const
 {
     long pos = XYToIndex(x, y);
     wxCHECK_MSG( pos != -1, 0, wxT("invalid image coordinates") );
+    wxCHECK_IMGDATA(0);
 
     pos *= 3;
 
@@ -2056,6 +2492,7 @@ unsigned char wxImage::GetGreen( int x, int y ) const
 {
     long pos = XYToIndex(x, y);
     wxCHECK_MSG( pos != -1, 0, wxT("invalid image coordinates") );
+    wxCHECK_IMGDATA(0);
 
     pos *= 3;
 
@@ -2066,6 +2503,7 @@ unsigned char wxImage::GetBlue( int x, int y ) const
 {
     long pos = XYToIndex(x, y);
     wxCHECK_MSG( pos != -1, 0, wxT("invalid image coordinates") );
+    wxCHECK_IMGDATA(0);
 
     pos *= 3;
 
@@ -2076,15 +2514,24 @@ bool wxImage::IsOk() const
 {
     // image of 0 width or height can't be considered ok - at least because it
     // causes crashes in ConvertToBitmap() if we don't catch it in time
-    wxImageRefData *data = M_IMGDATA;
+    wxImageRefData *data = M_IMGINFO;
     return data && data->m_ok && data->m_width && data->m_height;
 }
 
+unsigned char *wxImage::GetData()
+{
+    wxCHECK_MSG( IsOk(), (unsigned char *)nullptr, wxT("invalid image") );
+
+    const wxImageRefData* const data = M_IMGDATA;
+    return data ? data->m_data : nullptr;
+}
+
 unsigned char *wxImage::GetData() const
 {
     wxCHECK_MSG( IsOk(), (unsigned char *)nullptr, wxT("invalid image") );
 
-    return M_IMGDATA->m_data;
+    const wxImageRefData* const data = M_IMGDATA;
+    return data ? data->m_data : nullptr;
 }
 
 void wxImage::SetData( unsigned char *data, bool static_data  )
@@ -2093,14 +2540,14 @@ void wxImage::SetData( unsigned char *data, bool static_data  )
 
     wxImageRefData *newRefData = new wxImageRefData();
 
-    newRefData->m_width = M_IMGDATA->m_width;
-    newRefData->m_height = M_IMGDATA->m_height;
+    newRefData->m_width = M_IMGINFO->m_width;
+    newRefData->m_height = M_IMGINFO->m_height;
     newRefData->m_data = data;
     newRefData->m_ok = true;
-    newRefData->m_maskRed = M_IMGDATA->m_maskRed;
-    newRefData->m_maskGreen = M_IMGDATA->m_maskGreen;
-    newRefData->m_maskBlue = M_IMGDATA->m_maskBlue;
-    newRefData->m_hasMask = M_IMGDATA->m_hasMask;
+    newRefData->m_maskRed = M_IMGINFO->m_maskRed;
+    newRefData->m_maskGreen = M_IMGINFO->m_maskGreen;
+    newRefData->m_maskBlue = M_IMGINFO->m_maskBlue;
+    newRefData->m_hasMask = M_IMGINFO->m_hasMask;
     newRefData->m_static = static_data;
 
     UnRef();
@@ -2118,10 +2565,10 @@ void wxImage::SetData( unsigned char *data, int new_width, int new_height, bool
         newRefData->m_height = new_height;
         newRefData->m_data = data;
         newRefData->m_ok = true;
-        newRefData->m_maskRed = M_IMGDATA->m_maskRed;
-        newRefData->m_maskGreen = M_IMGDATA->m_maskGreen;
-        newRefData->m_maskBlue = M_IMGDATA->m_maskBlue;
-        newRefData->m_hasMask = M_IMGDATA->m_hasMask;
+        newRefData->m_maskRed = M_IMGINFO->m_maskRed;
+        newRefData->m_maskGreen = M_IMGINFO->m_maskGreen;
+        newRefData->m_maskBlue = M_IMGINFO->m_maskBlue;
+        newRefData->m_hasMask = M_IMGINFO->m_hasMask;
     }
     else
     {
@@ -2143,8 +2590,8 @@ void wxImage::SetDataRGBA(const unsigned char* data)
 
     wxImageRefData* newRefData = new wxImageRefData();
 
-    newRefData->m_width = M_IMGDATA->m_width;
-    newRefData->m_height = M_IMGDATA->m_height;
+    newRefData->m_width = M_IMGINFO->m_width;
+    newRefData->m_height = M_IMGINFO->m_height;
 
     size_t pixel_count = (size_t)newRefData->m_width * (size_t)newRefData->m_height;
     newRefData->m_data = (unsigned char*)malloc(3 * pixel_count);
@@ -2160,10 +2607,10 @@ void wxImage::SetDataRGBA(const unsigned char* data)
     }
 
     newRefData->m_ok = true;
-    newRefData->m_maskRed = M_IMGDATA->m_maskRed;
-    newRefData->m_maskGreen = M_IMGDATA->m_maskGreen;
-    newRefData->m_maskBlue = M_IMGDATA->m_maskBlue;
-    newRefData->m_hasMask = M_IMGDATA->m_hasMask;
+    newRefData->m_maskRed = M_IMGINFO->m_maskRed;
+    newRefData->m_maskGreen = M_IMGINFO->m_maskGreen;
+    newRefData->m_maskBlue = M_IMGINFO->m_maskBlue;
+    newRefData->m_hasMask = M_IMGINFO->m_hasMask;
     newRefData->m_static = false;
     newRefData->m_staticAlpha = false;
 
@@ -2184,6 +2631,7 @@ void wxImage::SetAlpha(int x, int y, unsigned char alpha)
     wxCHECK_RET( pos != -1, wxT("invalid image coordinates") );
 
     AllocExclusive();
+    wxCHECK_IMGDATA_RET();
 
     M_IMGDATA->m_alpha[pos] = alpha;
 }
@@ -2194,6 +2642,7 @@ unsigned char wxImage::GetAlpha(int x, int y) const
 
     long pos = XYToIndex(x, y);
     wxCHECK_MSG( pos != -1, 0, wxT("invalid image coordinates") );
+    wxCHECK_IMGDATA(0);
 
     return M_IMGDATA->m_alpha[pos];
 }
@@ -2202,6 +2651,7 @@ bool
 wxImage::ConvertColourToAlpha(unsigned char r, unsigned char g, unsigned char b)
 {
     SetAlpha(nullptr);
+    wxCHECK_IMGDATA(false);
 
     const int w = M_IMGDATA->m_width;
     const int h = M_IMGDATA->m_height;
@@ -2228,6 +2678,7 @@ void wxImage::SetAlpha( unsigned char *alpha, bool static_data )
     wxCHECK_RET( IsOk(), wxT("invalid image") );
 
     AllocExclusive();
+    wxCHECK_IMGDATA_RET();
 
     if ( !alpha )
     {
@@ -2241,11 +2692,20 @@ void wxImage::SetAlpha( unsigned char *alpha, bool static_data )
     M_IMGDATA->m_staticAlpha = static_data;
 }
 
+unsigned char *wxImage::GetAlpha()
+{
+    wxCHECK_MSG( IsOk(), (unsigned char *)nullptr, wxT("invalid image") );
+
+    const wxImageRefData* const data = M_IMGDATA;
+    return data ? data->m_alpha : nullptr;
+}
+
 unsigned char *wxImage::GetAlpha() const
 {
     wxCHECK_MSG( IsOk(), (unsigned char *)nullptr, wxT("invalid image") );
 
-    return M_IMGDATA->m_alpha;
+    const wxImageRefData* const data = M_IMGDATA;
+    return data ? data->m_alpha : nullptr;
 }
 
 void wxImage::InitAlpha()
@@ -2256,6 +2716,7 @@ void wxImage::InitAlpha()
 
     // initialize memory for alpha channel
     SetAlpha();
+    wxCHECK_IMGDATA_RET();
 
     unsigned char *alpha = M_IMGDATA->m_alpha;
     const size_t lenAlpha = M_IMGDATA->m_width * M_IMGDATA->m_height;
@@ -2291,6 +2752,7 @@ void wxImage::ClearAlpha()
     wxCHECK_RET( HasAlpha(), wxT("image already doesn't have an alpha channel") );
 
     AllocExclusive();
+    wxCHECK_IMGDATA_RET();
 
     if ( !M_IMGDATA->m_staticAlpha )
         free( M_IMGDATA->m_alpha );
@@ -2298,6 +2760,109 @@ void wxImage::ClearAlpha()
     M_IMGDATA->m_alpha = nullptr;
 }
 
+bool wxImage::HasAlpha() const
+{
+    wxCHECK_MSG( IsOk(), false, wxT("invalid image") );
+
+    const wxImageRefData* const data = M_IMGINFO;
+    if ( data->m_packed )
+        return data->m_packedHasAlpha || data->m_packedModified;
+
+    return data->m_alpha != nullptr;
+}
+
+// ----------------------------------------------------------------------------
+// packed storage mode
+// ----------------------------------------------------------------------------
+
+bool wxImage::CreatePacked( int width, int height, bool clear )
+{
+    UnRef();
+
+    if (width <= 0 || height <= 0)
+        return false;
+
+    const unsigned long long size = (unsigned long long)width * height * 4;
+    if (size > INT_MAX)
+        return false;
+
+    wxImagePackedBuffer* const packed = new wxImagePackedBuffer(size_t(width) * height);
+    if ( !packed->IsOk() )
+    {
+        packed->DecRef();
+        return false;
+    }
+
+    if ( clear )
+        memset(packed->GetData(), 0, size_t(size));
+
+    m_refData = new wxImageRefData;
+    M_IMGINFO->m_packed = packed;
+    M_IMGINFO->m_packedHasAlpha = true;
+    M_IMGINFO->m_width = width;
+    M_IMGINFO->m_height = height;
+    M_IMGINFO->m_ok = true;
+
+    return true;
+}
+
+bool wxImage::IsPacked() const
+{
+    return IsOk() && M_IMGINFO->m_packed != nullptr;
+}
+
+wxUint32 *wxImage::GetPackedData()
+{
+    wxCHECK_MSG( IsOk(), nullptr, wxT("invalid image") );
+
+    AllocExclusive();
+
+    // Copying the data could have failed.
+    if ( !IsOk() )
+        return nullptr;
+
+    wxImageRefData* const data = M_IMGINFO;
+    if ( !data->m_packed )
+    {
+        if ( !data->Pack() )
+            return nullptr;
+    }
+    else if ( data->m_packed->GetRefCount() > 1 )
+    {
+        // The buffer is still used by a native bitmap created from this image
+        // which must not be affected by any changes to it, so make a copy.
+        const size_t count = size_t(data->m_width) * data->m_height;
+        wxImagePackedBuffer* const packed = new wxImagePackedBuffer(count);
+        if ( !packed->IsOk() )
+        {
+            packed->DecRef();
+            return nullptr;
+        }
+
+        memcpy(packed->GetData(), data->m_packed->GetData(),
+               count*sizeof(wxUint32));
+
+        data->m_packed->DecRef();
+        data->m_packed = packed;
+    }
+
+    // The unpacked data, if any, won't correspond to the packed one any more.
+    data->DiscardUnpacked();
+
+    // We don't know what is going to be written to the data, so we have to
+    // assume that it can have non-opaque pixels, but the alpha channel is
+    // still not created when converting it back to the default storage if
+    // this is not the case.
+    data->m_packedModified = true;
+
+    return data->m_packed->GetData();
+}
+
+wxImagePackedBuffer *wxImage::GetPackedBuffer() const
+{
+    return IsOk() ? M_IMGINFO->m_packed : nullptr;
+}
+
 
 // ----------------------------------------------------------------------------
 // mask support
@@ -2308,6 +2873,7 @@ void wxImage::SetMaskColour( unsigned char r, unsigned char g, unsigned char b )
     wxCHECK_RET( IsOk(), wxT("invalid image") );
 
     AllocExclusive();
+    wxCHECK_IMGDATA_RET();
 
     M_IMGDATA->m_maskRed = r;
     M_IMGDATA->m_maskGreen = g;
@@ -2319,11 +2885,11 @@ bool wxImage::GetOrFindMaskColour( unsigned char *r, unsigned char *g, unsigned
 {
     wxCHECK_MSG( IsOk(), false, wxT("invalid image") );
 
-    if (M_IMGDATA->m_hasMask)
+    if (M_IMGINFO->m_hasMask)
     {
-        if (r) *r = M_IMGDATA->m_maskRed;
-        if (g) *g = M_IMGDATA->m_maskGreen;
-        if (b) *b = M_IMGDATA->m_maskBlue;
+        if (r) *r = M_IMGINFO->m_maskRed;
+        if (g) *g = M_IMGINFO->m_maskGreen;
+        if (b) *b = M_IMGINFO->m_maskBlue;
         return true;
     }
     else
@@ -2337,21 +2903,21 @@ unsigned char wxImage::GetMaskRed() const
 {
     wxCHECK_MSG( IsOk(), 0, wxT("invalid image") );
 
-    return M_IMGDATA->m_maskRed;
+    return M_IMGINFO->m_maskRed;
 }
 
 unsigned char wxImage::GetMaskGreen() const
 {
     wxCHECK_MSG( IsOk(), 0, wxT("invalid image") );
 
-    return M_IMGDATA->m_maskGreen;
+    return M_IMGINFO->m_maskGreen;
 }
 
 unsigned char wxImage::GetMaskBlue() const
 {
     wxCHECK_MSG( IsOk(), 0, wxT("invalid image") );
 
-    return M_IMGDATA->m_maskBlue;
+    return M_IMGINFO->m_maskBlue;
 }
 
 void wxImage::SetMask( bool mask )
@@ -2359,6 +2925,7 @@ void wxImage::SetMask( bool mask )
     wxCHECK_RET( IsOk(), wxT("invalid image") );
 
     AllocExclusive();
+    wxCHECK_IMGDATA_RET();
 
     M_IMGDATA->m_hasMask = mask;
 }
@@ -2367,13 +2934,14 @@ bool wxImage::HasMask() const
 {
     wxCHECK_MSG( IsOk(), false, wxT("invalid image") );
 
-    return M_IMGDATA->m_hasMask;
+    return M_IMGINFO->m_hasMask;
 }
 
 bool wxImage::IsTransparent(int x, int y, unsigned char threshold) const
 {
     long pos = XYToIndex(x, y);
     wxCHECK_MSG( pos != -1, false, wxT("invalid image coordinates") );
+    wxCHECK_IMGDATA(false);
 
     // check mask
     if ( M_IMGDATA->m_hasMask )
@@ -2405,7 +2973,7 @@ bool wxImage::SetMaskFromImage(const wxImage& mask,
                                unsigned char mr, unsigned char mg, unsigned char mb)
 {
     // check that the images are the same size
-    if ( (M_IMGDATA->m_height != mask.GetHeight() ) || (M_IMGDATA->m_width != mask.GetWidth () ) )
+    if ( (M_IMGINFO->m_height != mask.GetHeight() ) || (M_IMGINFO->m_width != mask.GetWidth () ) )
     {
         wxLogError( _("Image and mask have different sizes.") );
         return false;
@@ -2420,6 +2988,8 @@ bool wxImage::SetMaskFromImage(const wxImage& mask,
     }
 
     AllocExclusive();
+    wxCHECK_IMGDATA(false);
+    wxCHECK_MSG( mask.GetData(), false, wxT("failed to unpack image data") );
 
     unsigned char *imgdata = GetData();
     unsigned char *maskdata = mask.GetData();
@@ -2472,6 +3042,7 @@ bool wxImage::ConvertAlphaToMask(unsigned char mr,
         return false;
 
     AllocExclusive();
+    wxCHECK_IMGDATA(false);
 
     SetMask(true);
     SetMaskColour(mr, mg, mb);
@@ -2515,14 +3086,14 @@ bool wxImage::HasPalette() const
     if (!IsOk())
         return false;
 
-    return M_IMGDATA->m_palette.IsOk();
+    return M_IMGINFO->m_palette.IsOk();
 }
 
 const wxPalette& wxImage::GetPalette() const
 {
     wxCHECK_MSG( IsOk(), wxNullPalette, wxT("invalid image") );
 
-    return M_IMGDATA->m_palette;
+    return M_IMGINFO->m_palette;
 }
 
 void wxImage::SetPalette(const wxPalette& palette)
@@ -2530,6 +3101,7 @@ void wxImage::SetPalette(const wxPalette& palette)
     wxCHECK_RET( IsOk(), wxT("invalid image") );
 
     AllocExclusive();
+    wxCHECK_IMGDATA_RET();
 
     M_IMGDATA->m_palette = palette;
 }
@@ -2544,16 +3116,16 @@ void wxImage::SetOption(const wxString& name, const wxString& value)
 {
     AllocExclusive();
 
-    int idx = M_IMGDATA->m_optionNames.Index(name, false);
+    int idx = M_IMGINFO->m_optionNames.Index(name, false);
     if ( idx == wxNOT_FOUND )
     {
-        M_IMGDATA->m_optionNames.Add(name);
-        M_IMGDATA->m_optionValues.Add(value);
+        M_IMGINFO->m_optionNames.Add(name);
+        M_IMGINFO->m_optionValues.Add(value);
     }
     else
     {
-        M_IMGDATA->m_optionNames[idx] = name;
-        M_IMGDATA->m_optionValues[idx] = value;
+        M_IMGINFO->m_optionNames[idx] = name;
+        M_IMGINFO->m_optionValues[idx] = value;
     }
 }
 
@@ -2566,14 +3138,14 @@ void wxImage::SetOption(const wxString& name, int value)
 
 wxString wxImage::GetOption(const wxString& name) const
 {
-    if ( !M_IMGDATA )
+    if ( !M_IMGINFO )
         return wxEmptyString;
 
-    int idx = M_IMGDATA->m_optionNames.Index(name, false);
+    int idx = M_IMGINFO->m_optionNames.Index(name, false);
     if ( idx == wxNOT_FOUND )
         return wxEmptyString;
     else
-        return M_IMGDATA->m_optionValues[idx];
+        return M_IMGINFO->m_optionValues[idx];
 }
 
 int wxImage::GetOptionInt(const wxString& name) const
@@ -2583,7 +3155,7 @@ int wxImage::GetOptionInt(const wxString& name) const
 
 bool wxImage::HasOption(const wxString& name) const
 {
-    return M_IMGDATA ? M_IMGDATA->m_optionNames.Index(name, false) != wxNOT_FOUND
+    return M_IMGINFO ? M_IMGINFO->m_optionNames.Index(name, false) != wxNOT_FOUND
                      : false;
 }
 
@@ -2607,12 +3179,12 @@ void wxImage::SetLoadFlags(int flags)
 {
     AllocExclusive();
 
-    M_IMGDATA->m_loadFlags = flags;
+    M_IMGINFO->m_loadFlags = flags;
 }
 
 int wxImage::GetLoadFlags() const
 {
-    return M_IMGDATA ? M_IMGDATA->m_loadFlags : wxImageRefData::sm_defaultLoadFlags;
+    return M_IMGINFO ? M_IMGINFO->m_loadFlags : wxImageRefData::sm_defaultLoadFlags;
 }
 
 // Under Windows we can load wxImage not only from files but also from
@@ -2830,14 +3402,84 @@ int wxImage::GetImageCount( const wxString& WXUNUSED_UNLESS_STREAMS(name),
 
 #if wxUSE_STREAMS
 
+namespace
+{
+
+// Signatures of the image formats which can be recognized by looking at their
+// first few bytes. Note that matching the signature is not sufficient for the
+// handler to be able to read the image, so its CanRead() still needs to be
+// called, but this allows to avoid calling it for all the other handlers.
+struct wxImageSignature
+{
+    wxBitmapType type;
+    unsigned offset;
+    const char* bytes;
+    unsigned len;
+};
+
+const wxImageSignature gs_imageSignatures[] =
+{
+    { wxBITMAP_TYPE_PNG,  0, "\x89PNG\r\n\x1a\n",  8 },
+    { wxBITMAP_TYPE_JPEG, 0, "\xff\xd8",           2 },
+    { wxBITMAP_TYPE_GIF,  0, "GIF8",               4 },
+    { wxBITMAP_TYPE_BMP,  0, "BM",                 2 },
+    { wxBITMAP_TYPE_TIFF, 0, "II*\0",              4 },
+    { wxBITMAP_TYPE_TIFF, 0, "MM\0*",              4 },
+    { wxBITMAP_TYPE_WEBP, 8, "WEBP",               4 }, // after "RIFF"
+    { wxBITMAP_TYPE_ANI,  8, "ACON",               4 }, // after "RIFF"
+    { wxBITMAP_TYPE_IFF,  0, "FORM",               4 },
+    { wxBITMAP_TYPE_ICO,  0, "\0\0\1\0",           4 },
+    { wxBITMAP_TYPE_CUR,  0, "\0\0\2\0",           4 },
+    { wxBITMAP_TYPE_XPM,  0, "/* XPM */",          9 },
+    { wxBITMAP_TYPE_PNM,  0, "P2",                 2 },
+    { wxBITMAP_TYPE_PNM,  0, "P3",                 2 },
+    { wxBITMAP_TYPE_PNM,  0, "P5",                 2 },
+    { wxBITMAP_TYPE_PNM,  0, "P6",                 2 },
+    { wxBITMAP_TYPE_PCX,  0, "\x0a",               1 },
+};
+
+// Return the handler for the format of the image in the stream, determined by
+// reading its header only once, or nullptr if it couldn't be determined. The
+// stream position is not changed.
+wxImageHandler* FindHandlerBySignature(wxInputStream& stream)
+{
+    const wxFileOffset pos = stream.TellI();
+    if ( pos == wxInvalidOffset )
+        return nullptr;
+
+    unsigned char hdr[16];
+    const size_t len = stream.Read(hdr, WXSIZEOF(hdr)).LastRead();
+    if ( stream.SeekI(pos) == wxInvalidOffset )
+        return nullptr;
+
+    for ( const wxImageSignature& sig : gs_imageSignatures )
+    {
+        if ( sig.offset + sig.len <= len &&
+                memcmp(hdr + sig.offset, sig.bytes, sig.len) == 0 )
+        {
+            wxImageHandler* const handler = wxImage::FindHandler(sig.type);
+            if ( handler )
+                return handler;
+        }
+    }
+
+    return nullptr;
+}
+
+} // anonymous namespace
+
 bool wxImage::CanRead( wxInputStream &stream )
 {
+    wxImageHandler* const handlerSig = FindHandlerBySignature(stream);
+    if ( handlerSig && handlerSig->CanRead(stream) )
+        return true;
+
     const wxList& list = GetHandlers();
 
     for ( wxList::compatibility_iterator node = list.GetFirst(); node; node = node->GetNext() )
     {
         wxImageHandler *handler=(wxImageHandler*)node->GetData();
-        if (handler->CanRead( stream ))
+        if (handler != handlerSig && handler->CanRead( stream ))
             return true;
     }
 
@@ -2850,6 +3492,14 @@ int wxImage::GetImageCount( wxInputStream &stream, wxBitmapType type )
 
     if ( type == wxBITMAP_TYPE_ANY )
     {
+        wxImageHandler* const handlerSig = FindHandlerBySignature(stream);
+        if ( handlerSig && handlerSig->CanRead(stream) )
+        {
+            const int count = handlerSig->GetImageCount(stream);
+            if ( count >= 0 )
+                return count;
+        }
+
         const wxList& list = GetHandlers();
 
         for ( wxList::compatibility_iterator node = list.GetFirst();
@@ -2857,7 +3507,7 @@ int wxImage::GetImageCount( wxInputStream &stream, wxBitmapType type )
               node = node->GetNext() )
         {
              handler = (wxImageHandler*)node->GetData();
-             if ( handler->CanRead(stream) )
+             if ( handler != handlerSig && handler->CanRead(stream) )
              {
                  const int count = handler->GetImageCount(stream);
                  if ( count >= 0 )
@@ -2904,7 +3554,7 @@ bool wxImage::DoLoad(wxImageHandler& handler, wxInputStream& stream, int index)
         posOld = stream.TellI();
 
     if ( !handler.LoadFile(this, stream,
-                           (M_IMGDATA->m_loadFlags & Load_Verbose) != 0, index) )
+                           (M_IMGINFO->m_loadFlags & Load_Verbose) != 0, index) )
     {
         if ( posOld != wxInvalidOffset )
             stream.SeekI(posOld);
@@ -2943,7 +3593,7 @@ bool wxImage::DoLoad(wxImageHandler& handler, wxInputStream& stream, int index)
     }
 
     // Set this after Rescale, which currently does not preserve it
-    M_IMGDATA->m_type = handler.GetType();
+    M_IMGINFO->m_type = handler.GetType();
 
     return true;
 }
@@ -2955,7 +3605,7 @@ bool wxImage::LoadFile( wxInputStream& stream, wxBitmapType type, int index )
     wxImageHandler *handler;
 
     // do we issue warning/error messages?
-    const bool verbose = M_IMGDATA->m_loadFlags & Load_Verbose;
+    const bool verbose = M_IMGINFO->m_loadFlags & Load_Verbose;
 
     if ( type == wxBITMAP_TYPE_ANY )
     {
@@ -2973,13 +3623,21 @@ bool wxImage::LoadFile( wxInputStream& stream, wxBitmapType type, int index )
             return false;
         }
 
+        // Try the handler for the format identified by the image signature
+        // first, this is much faster than asking all handlers in turn.
+        wxImageHandler* const handlerSig = FindHandlerBySignature(stream);
+        if ( handlerSig && handlerSig->CanRead(stream) &&
+                DoLoad(*handlerSig, stream, index) )
+            return true;
+
         const wxList& list = GetHandlers();
         for ( wxList::compatibility_iterator node = list.GetFirst();
               node;
               node = node->GetNext() )
         {
              handler = (wxImageHandler*)node->GetData();
-             if ( handler->CanRead(stream) && DoLoad(*handler, stream, index) )
+             if ( handler != handlerSig &&
+                    handler->CanRead(stream) && DoLoad(*handler, stream, index) )
                  return true;
         }
 
@@ -3023,7 +3681,7 @@ bool wxImage::LoadFile( wxInputStream& stream, const wxString& mimetype, int ind
     wxImageHandler *handler = FindHandlerMime(mimetype);
 
     // do we issue warning/error messages?
-    const bool verbose = M_IMGDATA->m_loadFlags & Load_Verbose;
+    const bool verbose = M_IMGINFO->m_loadFlags & Load_Verbose;
 
     if ( !handler )
     {
@@ -3052,7 +3710,7 @@ bool wxImage::DoSave(wxImageHandler& handler, wxOutputStream& stream) const
     if ( !handler.SaveFile(self, stream) )
         return false;
 
-    M_IMGDATA->m_type = handler.GetType();
+    M_IMGINFO->m_type = handler.GetType();
     return true;
 }
 
@@ -3096,6 +3754,7 @@ void wxImage::AddHandler( wxImageHandler *handler )
     if (FindHandler( handler->GetType() ) == nullptr)
     {
         sm_handlers.Append( handler );
+        gs_handlersIndex.Update( sm_handlers );
     }
     else
     {
@@ -3108,6 +3767,9 @@ void wxImage::AddHandler( wxImageHandler *handler )
         wxLogDebug( wxT("Adding duplicate image handler for '%s'"),
                     handler->GetName().c_str() );
         delete handler;
+
+        // Deleting the handler invalidated the index.
+        gs_handlersIndex.Update( sm_handlers );
     }
 }
 
@@ -3117,6 +3779,7 @@ void wxImage::InsertHandler( wxImageHandler *handler )
     if (FindHandler( handler->GetType() ) == nullptr)
     {
         sm_handlers.Insert( handler );
+        gs_handlersIndex.Update( sm_handlers );
     }
     else
     {
@@ -3124,6 +3787,7 @@ void wxImage::InsertHandler( wxImageHandler *handler )
         wxLogDebug( wxT("Inserting duplicate image handler for '%s'"),
                     handler->GetName().c_str() );
         delete handler;
+        gs_handlersIndex.Update( sm_handlers );
     }
 }
 
@@ -3134,6 +3798,7 @@ bool wxImage::RemoveHandler( const wxString& name )
     {
         sm_handlers.DeleteObject(handler);
         delete handler;
+        gs_handlersIndex.Update(sm_handlers);
         return true;
     }
     else
@@ -3153,19 +3818,44 @@ wxImageHandler *wxImage::FindHandler( const wxString& name )
     return nullptr;
 }
 
+// Check if the handler matches the given extension and type: this is used by
+// FindHandler() both with and without the index.
+static bool
+HandlerMatchesExtension(const wxImageHandler* handler,
+                        const wxString& extension,
+                        wxBitmapType bitmapType)
+{
+    if ((bitmapType != wxBITMAP_TYPE_ANY) && (handler->GetType() != bitmapType))
+        return false;
+
+    return handler->GetExtension() == extension ||
+            handler->GetAltExtensions().Index(extension, false) != wxNOT_FOUND;
+}
+
 wxImageHandler *wxImage::FindHandler( const wxString& extension, wxBitmapType bitmapType )
 {
+    if ( gs_handlersIndex.IsValidFor(sm_handlers) )
+    {
+        const wxImageHandlersIndex::Handlers*
+            handlers = gs_handlersIndex.GetByExtension(extension);
+        if ( handlers )
+        {
+            for ( wxImageHandler* handler : *handlers )
+            {
+                if ( HandlerMatchesExtension(handler, extension, bitmapType) )
+                    return handler;
+            }
+        }
+
+        return nullptr;
+    }
+
     wxList::compatibility_iterator node = sm_handlers.GetFirst();
     while (node)
     {
         wxImageHandler *handler = (wxImageHandler*)node->GetData();
-        if ((bitmapType == wxBITMAP_TYPE_ANY) || (handler->GetType() == bitmapType))
-        {
-            if (handler->GetExtension() == extension)
-                return handler;
-            if (handler->GetAltExtensions().Index(extension, false) != wxNOT_FOUND)
-                return handler;
-        }
+        if ( HandlerMatchesExtension(handler, extension, bitmapType) )
+            return handler;
         node = node->GetNext();
     }
     return nullptr;
@@ -3173,6 +3863,9 @@ wxImageHandler *wxImage::FindHandler( const wxString& extension, wxBitmapType bi
 
 wxImageHandler *wxImage::FindHandler(wxBitmapType bitmapType )
 {
+    if ( gs_handlersIndex.IsValidFor(sm_handlers) )
+        return gs_handlersIndex.GetByType(bitmapType);
+
     wxList::compatibility_iterator node = sm_handlers.GetFirst();
     while (node)
     {
@@ -3185,6 +3878,22 @@ wxImageHandler *wxImage::FindHandler(wxBitmapType bitmapType )
 
 wxImageHandler *wxImage::FindHandlerMime( const wxString& mimetype )
 {
+    if ( gs_handlersIndex.IsValidFor(sm_handlers) )
+    {
+        const wxImageHandlersIndex::Handlers*
+            handlers = gs_handlersIndex.GetByMimeType(mimetype);
+        if ( handlers )
+        {
+            for ( wxImageHandler* handler : *handlers )
+            {
+                if ( handler->GetMimeType().IsSameAs(mimetype, false) )
+                    return handler;
+            }
+        }
+
+        return nullptr;
+    }
+
     wxList::compatibility_iterator node = sm_handlers.GetFirst();
     while (node)
     {
@@ -3214,6 +3923,7 @@ void wxImage::CleanUpHandlers()
     }
 
     sm_handlers.Clear();
+    gs_handlersIndex.Update(sm_handlers);
 }
 
 wxString wxImage::GetImageExtWildcard()
@@ -3494,6 +4204,13 @@ void wxImage::ChangeHSV(double angleH, double factorS, double factorV)
 
 wxIMPLEMENT_ABSTRACT_CLASS(wxImageHandler, wxObject);
 
+wxImageHandler::~wxImageHandler()
+{
+    // The handlers index can't be used any more if this handler is deleted
+    // without using RemoveHandler().
+    wxImageHandlersIndex::Invalidate();
+}
+
 #if wxUSE_STREAMS
 int wxImageHandler::GetImageCount( wxInputStream& stream )
 {
@@ -3501,6 +4218,24 @@ int wxImageHandler::GetImageCount( wxInputStream& stream )
             CallIfCanSeek(&wxImageHandler::DoGetImageCount, this);
 }
 
+bool wxImageHandler::LoadFileRows( wxImage *image,
+                                   wxInputStream& stream,
+                                   wxImageRowsReceiver& receiver,
+                                   bool verbose,
+                                   int index )
+{
+    if ( !LoadFile(image, stream, verbose, index) )
+        return false;
+
+    if ( !receiver.OnRows(*image, 0, image->GetHeight()) )
+    {
+        image->Destroy();
+        return false;
+    }
+
+    return true;
+}
+
 bool wxImageHandler::CanRead( const wxString& name )
 {
     wxImageFileInputStream stream(name);
@@ -3594,6 +4329,8 @@ unsigned long wxImage::CountColours( unsigned long stopafter ) const
     unsigned long size, nentries;
 
     p = GetData();
+    wxCHECK_MSG( p, 0, wxS("no image data") );
+
     size = static_cast<unsigned long>(GetWidth()) * GetHeight();
     nentries = 0;
 
@@ -3619,6 +4356,8 @@ unsigned long wxImage::CountColours( unsigned long stopafter ) const
 unsigned long wxImage::ComputeHistogram( wxImageHistogram &h ) const
 {
     unsigned char *p = GetData();
+    wxCHECK_MSG( p, 0, wxS("no image data") );
+
     unsigned long nentries = 0;
 
     h.clear();
@@ -3673,6 +4412,8 @@ wxImage wxImage::Rotate(double angle,
                         bool interpolating,
                         wxPoint *offset_after_rotation) const
 {
+    wxCHECK_MSG( GetData(), wxImage(), wxS("no image data") );
+
     // screen coordinates are a mirror image of "real" coordinates
     angle = -angle;
 
@@ -3951,6 +4692,7 @@ template <typename F>
 void wxImage::ApplyToAllPixels(const F& func)
 {
     AllocExclusive();
+    wxCHECK_IMGDATA_RET();
 
     const size_t size = GetWidth() * GetHeight();
     unsigned char *data = GetData();
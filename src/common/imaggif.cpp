@@ -113,8 +113,24 @@ static bool wxGIFHandler_BufferedOutput(wxOutputStream *, wxUint8 *buf, int c);
 bool wxGIFHandler::LoadFile(wxImage *image, wxInputStream& stream,
     bool verbose, int index)
 {
+    if ( index == -1 )
+        index = 0;
+
+    // Only a single frame is needed, so don't keep all the other ones in
+    // memory, but still check that they are valid, as a file with corrupted
+    // frames is not a valid GIF file. The needed frame is checked last, so
+    // that it doesn't have to be decoded again below.
     wxGIFDecoder decod;
-    switch ( decod.LoadGIF(stream) )
+    decod.EnableLazyDecoding(true, 1);
+    wxGIFErrorCode error = decod.LoadGIF(stream);
+    if ( error == wxGIF_OK || error == wxGIF_TRUNCATED )
+    {
+        const wxGIFErrorCode errorFrames = decod.ValidateFrames(index);
+        if ( errorFrames != wxGIF_OK )
+            error = errorFrames;
+    }
+
+    switch ( error )
     {
         case wxGIF_OK:
             break;
@@ -137,7 +153,7 @@ bool wxGIFHandler::LoadFile(wxImage *image, wxInputStream& stream,
             break;
     }
 
-    return decod.ConvertToImage(index != -1 ? (size_t)index : 0, image);
+    return decod.ConvertToImage(index, image);
 }
 
 bool wxGIFHandler::SaveFile(wxImage *image,
@@ -169,8 +185,13 @@ bool wxGIFHandler::DoCanRead( wxInputStream& stream )
 
 int wxGIFHandler::DoGetImageCount( wxInputStream& stream )
 {
+    // Lazy decoding avoids keeping all the frames in memory, but they still
+    // need to be decoded to check that they are valid.
     wxGIFDecoder decod;
+    decod.EnableLazyDecoding(true, 1);
     wxGIFErrorCode error = decod.LoadGIF(stream);
+    if ( error == wxGIF_OK || error == wxGIF_TRUNCATED )
+        error = decod.ValidateFrames();
     if ( (error != wxGIF_OK) && (error != wxGIF_TRUNCATED) )
         return -1;
 
@@ -21,6 +21,7 @@
     #include "wx/intl.h"
     #include "wx/bitmap.h"
     #include "wx/module.h"
+    #include "wx/utils.h"
 #endif
 
 // A hack based on one from tif_jpeg.c to overcome the problem on Windows
@@ -230,7 +231,10 @@ static inline void wx_cmyk_to_rgb(unsigned char* rgb, const unsigned char* cmyk)
     #pragma warning(disable:4611)
 #endif /* VC++ */
 
-bool wxJPEGHandler::LoadFile( wxImage *image, wxInputStream& stream, bool verbose, int WXUNUSED(index) )
+// common part of LoadFile() and LoadFileRows(), receiver may be null
+static bool
+wxLoadJPEG( wxImage *image, wxInputStream& stream, bool verbose,
+            wxImageRowsReceiver* receiver )
 {
     wxCHECK_MSG( image, false, "null image pointer" );
 
@@ -280,15 +284,31 @@ bool wxJPEGHandler::LoadFile( wxImage *image, wxInputStream& stream, bool verbos
         bytesPerPixel = 3;
     }
 
-    // scale the picture to fit in the specified max size if necessary
+    // scale the picture to fit in the specified max size if necessary: this
+    // is done by libjpeg using the reduced size IDCT, which is much faster
+    // than decoding the full image and scaling it down later
     if ( maxWidth > 0 || maxHeight > 0 )
     {
-        unsigned& scale = cinfo.scale_denom;
-        while ( (maxWidth && (cinfo.image_width / scale > maxWidth)) ||
-                    (maxHeight && (cinfo.image_height / scale > maxHeight)) )
+        // use the biggest scale, in 1/8 increments, for which the image still
+        // fits: the recent libjpeg versions and libjpeg-turbo support all of
+        // them, while the older ones use the biggest supported scale, i.e.
+        // 1/2, 1/4 or 1/8, less than the requested one and the image is then
+        // scaled down further by wxImage itself if necessary
+        const auto scaled = [](unsigned size, unsigned num)
+        {
+            return (size * num + 7) / 8;
+        };
+
+        unsigned num = 8;
+        while ( num > 1 &&
+                    ((maxWidth && scaled(cinfo.image_width, num) > maxWidth) ||
+                     (maxHeight && scaled(cinfo.image_height, num) > maxHeight)) )
         {
-            scale *= 2;
+            num--;
         }
+
+        cinfo.scale_num = num;
+        cinfo.scale_denom = 8;
     }
 
     jpeg_start_decompress( &cinfo );
@@ -302,30 +322,67 @@ bool wxJPEGHandler::LoadFile( wxImage *image, wxInputStream& stream, bool verbos
     image->SetMask( false );
     ptr = image->GetData();
 
-    unsigned stride = cinfo.output_width * bytesPerPixel;
-    JSAMPARRAY tempbuf = (*cinfo.mem->alloc_sarray)
-                            ((j_common_ptr) &cinfo, JPOOL_IMAGE, stride, 1 );
+    const unsigned stride = cinfo.output_width * bytesPerPixel;
+
+    // read as many scanlines as libjpeg can return at once, which is
+    // typically the height of an MCU row
+    const unsigned maxLines = wxMax(cinfo.rec_outbuf_height, 16);
 
-    while ( cinfo.output_scanline < cinfo.output_height )
+    if (cinfo.out_color_space == JCS_RGB)
     {
-        jpeg_read_scanlines( &cinfo, tempbuf, 1 );
-        if (cinfo.out_color_space == JCS_RGB)
+        // the image data has exactly the same layout as libjpeg output, so
+        // decode directly into it without any intermediate copies
+        JSAMPARRAY rows = (JSAMPARRAY)(*cinfo.mem->alloc_small)
+                            ((j_common_ptr) &cinfo, JPOOL_IMAGE,
+                             cinfo.output_height * sizeof(JSAMPROW));
+        for (unsigned y = 0; y < cinfo.output_height; y++)
+            rows[y] = ptr + y * stride;
+
+        while ( cinfo.output_scanline < cinfo.output_height )
         {
-            memcpy( ptr, tempbuf[0], stride );
-            ptr += stride;
+            const unsigned firstLine = cinfo.output_scanline;
+            const unsigned linesLeft = cinfo.output_height - firstLine;
+            const JDIMENSION lines = jpeg_read_scanlines( &cinfo, rows + firstLine,
+                                                          wxMin(linesLeft, maxLines) );
+
+            if ( receiver && lines && !receiver->OnRows(*image, firstLine, lines) )
+                break;
         }
-        else // CMYK
+    }
+    else // CMYK
+    {
+        JSAMPARRAY tempbuf = (*cinfo.mem->alloc_sarray)
+                                ((j_common_ptr) &cinfo, JPOOL_IMAGE, stride, maxLines );
+
+        while ( cinfo.output_scanline < cinfo.output_height )
         {
-            const unsigned char* inptr = (const unsigned char*) tempbuf[0];
-            for (size_t i = 0; i < cinfo.output_width; i++)
+            const unsigned firstLine = cinfo.output_scanline;
+            const JDIMENSION lines = jpeg_read_scanlines( &cinfo, tempbuf, maxLines );
+            for (JDIMENSION line = 0; line < lines; line++)
             {
-                wx_cmyk_to_rgb(ptr, inptr);
-                ptr += 3;
-                inptr += 4;
+                const unsigned char* inptr = (const unsigned char*) tempbuf[line];
+                for (size_t i = 0; i < cinfo.output_width; i++)
+                {
+                    wx_cmyk_to_rgb(ptr, inptr);
+                    ptr += 3;
+                    inptr += 4;
+                }
             }
+
+            if ( receiver && lines && !receiver->OnRows(*image, firstLine, lines) )
+                break;
         }
     }
 
+    if ( cinfo.output_scanline < cinfo.output_height )
+    {
+        // loading was cancelled by the receiver
+        (cinfo.src->term_source)(&cinfo);
+        jpeg_destroy_decompress( &cinfo );
+        image->Destroy();
+        return false;
+    }
+
     // set up resolution if available: it's part of optional JFIF APP0 chunk
     if ( cinfo.saw_JFIF_marker )
     {
@@ -349,6 +406,18 @@ bool wxJPEGHandler::LoadFile( wxImage *image, wxInputStream& stream, bool verbos
     return true;
 }
 
+bool wxJPEGHandler::LoadFile( wxImage *image, wxInputStream& stream, bool verbose, int WXUNUSED(index) )
+{
+    return wxLoadJPEG(image, stream, verbose, nullptr);
+}
+
+bool wxJPEGHandler::LoadFileRows( wxImage *image, wxInputStream& stream,
+                                  wxImageRowsReceiver& receiver,
+                                  bool verbose, int WXUNUSED(index) )
+{
+    return wxLoadJPEG(image, stream, verbose, &receiver);
+}
+
 typedef struct {
     struct jpeg_destination_mgr pub;
 
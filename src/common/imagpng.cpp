@@ -28,14 +28,25 @@
     #include "wx/intl.h"
     #include "wx/palette.h"
     #include "wx/stream.h"
+    #include "wx/utils.h"
 #endif
 
 #include "png.h"
 
+#if wxUSE_THREADS && wxUSE_ZLIB
+    #include "wx/thread.h"
+
+    #include "zlib.h"
+
+    #include <atomic>
+    #include <memory>
+#endif
+
 // For memcpy
 #include <string.h>
 
 #include <unordered_map>
+#include <vector>
 
 #define wxIMAGE_OPTION_PNG_DESCRIPTION_KEY "Description"
 
@@ -105,13 +116,15 @@ struct wxPNGInfoStruct
 // C++ destructors.
 struct wxPNGImageData
 {
-    wxPNGImageData()
+    explicit wxPNGImageData(wxImageRowsReceiver* receiver_ = nullptr)
     {
         lines = nullptr;
         m_buf = nullptr;
         info_ptr = (png_infop) nullptr;
         png_ptr = (png_structp) nullptr;
+        receiver = receiver_;
         ok = false;
+        cancelled = false;
     }
 
     bool Alloc(png_uint_32 width, png_uint_32 height, unsigned char* buf)
@@ -157,13 +170,25 @@ struct wxPNGImageData
 
     void DoLoadPNGFile(wxImage* image, wxPNGInfoStruct& wxinfo);
 
+    // Read the rows of a non-interlaced image one by one, return false on
+    // error or if loading was cancelled.
+    bool ReadRows(wxImage* image,
+                  png_uint_32 width,
+                  png_uint_32 height,
+                  bool needCopy);
+
     unsigned char** lines;
     unsigned char* m_buf;
     png_infop info_ptr;
     png_structp png_ptr;
+    wxImageRowsReceiver* receiver;
     bool ok;
+    bool cancelled;
 };
 
+// Number of rows passed to wxImageRowsReceiver at once.
+const png_uint_32 wxPNG_ROWS_BAND = 16;
+
 } // anonymous namespace
 
 // ----------------------------------------------------------------------------
@@ -245,7 +270,38 @@ bool wxPNGHandler::DoCanRead( wxInputStream& stream )
     return memcmp(hdr, "\211PNG", WXSIZEOF(hdr)) == 0;
 }
 
-// convert data from RGB to wxImage format
+// convert a single row from RGBA to wxImage format, alpha is allocated on
+// demand if we have any non-opaque pixels and advanced to the next row
+static
+void CopyRowFromPNG(wxImage *image,
+                    const unsigned char *ptrSrc,
+                    png_uint_32 width,
+                    png_uint_32 y,
+                    unsigned char *&alpha)
+{
+    unsigned char *ptrDst = image->GetData() + (size_t)y * width * 3;
+    for ( png_uint_32 x = 0; x < width; x++ )
+    {
+        unsigned char r = *ptrSrc++;
+        unsigned char g = *ptrSrc++;
+        unsigned char b = *ptrSrc++;
+        unsigned char a = *ptrSrc++;
+
+        // the first time we encounter a transparent pixel we must
+        // allocate alpha channel for the image
+        if ( !IsOpaque(a) && !alpha )
+            alpha = InitAlpha(image, x, y);
+
+        if ( alpha )
+            *alpha++ = a;
+
+        *ptrDst++ = r;
+        *ptrDst++ = g;
+        *ptrDst++ = b;
+    }
+}
+
+// convert data from RGBA to wxImage format
 static
 void CopyDataFromPNG(wxImage *image,
                      unsigned char **lines,
@@ -255,32 +311,8 @@ void CopyDataFromPNG(wxImage *image,
     // allocated on demand if we have any non-opaque pixels
     unsigned char *alpha = nullptr;
 
-    unsigned char *ptrDst = image->GetData();
-    {
-        for ( png_uint_32 y = 0; y < height; y++ )
-        {
-            const unsigned char *ptrSrc = lines[y];
-            for ( png_uint_32 x = 0; x < width; x++ )
-            {
-                unsigned char r = *ptrSrc++;
-                unsigned char g = *ptrSrc++;
-                unsigned char b = *ptrSrc++;
-                unsigned char a = *ptrSrc++;
-
-                // the first time we encounter a transparent pixel we must
-                // allocate alpha channel for the image
-                if ( !IsOpaque(a) && !alpha )
-                    alpha = InitAlpha(image, x, y);
-
-                if ( alpha )
-                    *alpha++ = a;
-
-                *ptrDst++ = r;
-                *ptrDst++ = g;
-                *ptrDst++ = b;
-            }
-        }
-    }
+    for ( png_uint_32 y = 0; y < height; y++ )
+        CopyRowFromPNG(image, lines[y], width, y, alpha);
 }
 
 // temporarily disable the warning C4611 (interaction between '_setjmp' and
@@ -340,10 +372,31 @@ wxPNGImageData::DoLoadPNGFile(wxImage* image, wxPNGInfoStruct& wxinfo)
         (color_type & PNG_COLOR_MASK_ALPHA) ||
         png_get_valid(png_ptr, info_ptr, PNG_INFO_tRNS);
 
-    if (!Alloc(width, height, needCopy ? nullptr : image->GetData()))
-        return;
+    // Interlaced images can only be read entirely, but the others are read
+    // row by row, which avoids allocating a full-size intermediate buffer
+    // when we need to copy the data and allows passing the rows to the
+    // receiver as soon as they're decoded.
+    if ( png_set_interlace_handling(png_ptr) == 1 )
+    {
+        if ( !ReadRows(image, width, height, needCopy) )
+            return;
+    }
+    else
+    {
+        if (!Alloc(width, height, needCopy ? nullptr : image->GetData()))
+            return;
+
+        png_read_image( png_ptr, lines );
 
-    png_read_image( png_ptr, lines );
+        if (needCopy)
+            CopyDataFromPNG(image, lines, width, height);
+
+        if ( receiver && !receiver->OnRows(*image, 0, height) )
+        {
+            cancelled = true;
+            return;
+        }
+    }
 
     // load "Description" text chunk
     png_textp text_ptr;
@@ -447,30 +500,75 @@ wxPNGImageData::DoLoadPNGFile(wxImage* image, wxPNGInfoStruct& wxinfo)
     }
 
 
-    // loaded successfully, now init wxImage with this data
-    if (needCopy)
-        CopyDataFromPNG(image, lines, width, height);
-
     // This will indicate to the caller that loading succeeded.
     ok = true;
 }
 
 bool
-wxPNGHandler::LoadFile(wxImage *image,
-                       wxInputStream& stream,
-                       bool verbose,
-                       int WXUNUSED(index))
+wxPNGImageData::ReadRows(wxImage* image,
+                         png_uint_32 width,
+                         png_uint_32 height,
+                         bool needCopy)
+{
+    unsigned char* const data = image->GetData();
+
+    // with alpha, we need a buffer for a single RGBA row
+    if ( needCopy )
+    {
+        m_buf = static_cast<unsigned char*>(malloc((size_t)width * 4));
+        if ( !m_buf )
+            return false;
+    }
+
+    // allocated on demand if we have any non-opaque pixels
+    unsigned char *alpha = nullptr;
+
+    png_uint_32 firstRow = 0;
+    for ( png_uint_32 y = 0; y < height; y++ )
+    {
+        if ( needCopy )
+        {
+            png_read_row( png_ptr, m_buf, nullptr );
+            CopyRowFromPNG(image, m_buf, width, y, alpha);
+        }
+        else
+        {
+            png_read_row( png_ptr, data + (size_t)y * width * 3, nullptr );
+        }
+
+        const png_uint_32 numRows = y + 1 - firstRow;
+        if ( receiver && (numRows == wxPNG_ROWS_BAND || y + 1 == height) )
+        {
+            if ( !receiver->OnRows(*image, firstRow, numRows) )
+            {
+                cancelled = true;
+                return false;
+            }
+
+            firstRow = y + 1;
+        }
+    }
+
+    return true;
+}
+
+// common part of LoadFile() and LoadFileRows(), receiver may be null
+static bool
+wxLoadPNG(wxImage *image,
+          wxInputStream& stream,
+          bool verbose,
+          wxImageRowsReceiver* receiver)
 {
     wxPNGInfoStruct wxinfo;
     wxinfo.verbose = verbose;
     wxinfo.stream.in = &stream;
 
-    wxPNGImageData data;
+    wxPNGImageData data(receiver);
     data.DoLoadPNGFile(image, wxinfo);
 
     if ( !data.ok )
     {
-        if (verbose)
+        if (verbose && !data.cancelled)
         {
            wxLogError(_("Couldn't load a PNG image - file is corrupted or not enough memory."));
         }
@@ -486,6 +584,25 @@ wxPNGHandler::LoadFile(wxImage *image,
     return true;
 }
 
+bool
+wxPNGHandler::LoadFile(wxImage *image,
+                       wxInputStream& stream,
+                       bool verbose,
+                       int WXUNUSED(index))
+{
+    return wxLoadPNG(image, stream, verbose, nullptr);
+}
+
+bool
+wxPNGHandler::LoadFileRows(wxImage *image,
+                           wxInputStream& stream,
+                           wxImageRowsReceiver& receiver,
+                           bool verbose,
+                           int WXUNUSED(index))
+{
+    return wxLoadPNG(image, stream, verbose, &receiver);
+}
+
 // ----------------------------------------------------------------------------
 // SaveFile() palette helpers
 // ----------------------------------------------------------------------------
@@ -524,6 +641,567 @@ static long PaletteAdd(PaletteMap *palette, const png_color_8& clr)
     return index;
 }
 
+// ----------------------------------------------------------------------------
+// SaveFile() rows conversion
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// Converts the rows of wxImage to the format used in the PNG file.
+class wxPNGRowConverter
+{
+public:
+    wxPNGRowConverter(const wxImage& image,
+                      const PaletteMap& palette,
+                      const png_color_8& mask,
+                      int colorType,
+                      int bitDepth,
+                      bool useAlpha,
+                      bool usePalette)
+        : m_palette(palette),
+          m_mask(mask),
+          m_data(image.GetData()),
+          m_alpha(image.HasAlpha() ? image.GetAlpha() : nullptr),
+          m_width(image.GetWidth()),
+          m_colorType(colorType),
+          m_bitDepth(bitDepth),
+          m_useAlpha(useAlpha),
+          m_usePalette(usePalette),
+          m_hasMask(image.HasMask())
+    {
+    }
+
+    // Return true if the image data can be passed to libpng as is.
+    bool IsDirect() const
+    {
+        return m_colorType == wxPNG_TYPE_COLOUR && m_bitDepth == 8 && !m_useAlpha;
+    }
+
+    // Return the pointer to the start of the given row in the image data,
+    // can only be used if IsDirect() returns true.
+    unsigned char* GetDirectRow(int y) const
+    {
+        return m_data + 3*static_cast<size_t>(y)*m_width;
+    }
+
+    // Convert the given row to the output buffer. This function is called
+    // from multiple threads when compressing the image in parallel, so it
+    // must not modify anything.
+    void Convert(int y, unsigned char* pData) const
+    {
+        const size_t offset = static_cast<size_t>(y)*m_width;
+        const unsigned char* pColors = m_data + 3*offset;
+        const unsigned char* pAlpha = m_alpha ? m_alpha + offset : nullptr;
+
+        // Handle the common case of RGBA output separately, as it's much
+        // faster without all the checks below.
+        if ( m_colorType == wxPNG_TYPE_COLOUR && m_bitDepth == 8 &&
+                m_useAlpha && pAlpha && !m_hasMask )
+        {
+            for ( int x = 0; x != m_width; x++ )
+            {
+                *pData++ = *pColors++;
+                *pData++ = *pColors++;
+                *pData++ = *pColors++;
+                *pData++ = *pAlpha++;
+            }
+
+            return;
+        }
+
+        for (int x = 0; x != m_width; x++)
+        {
+            png_color_8 clr;
+            clr.red   = *pColors++;
+            clr.green = *pColors++;
+            clr.blue  = *pColors++;
+            clr.gray  = 0;
+            clr.alpha = (m_usePalette && pAlpha) ? *pAlpha++ : 0; // use with wxPNG_TYPE_PALETTE only
+
+            switch ( m_colorType )
+            {
+                default:
+                    wxFAIL_MSG( wxT("unknown wxPNG_TYPE_XXX") );
+                    wxFALLTHROUGH;
+
+                case wxPNG_TYPE_COLOUR:
+                    *pData++ = clr.red;
+                    if ( m_bitDepth == 16 )
+                        *pData++ = 0;
+                    *pData++ = clr.green;
+                    if ( m_bitDepth == 16 )
+                        *pData++ = 0;
+                    *pData++ = clr.blue;
+                    if ( m_bitDepth == 16 )
+                        *pData++ = 0;
+                    break;
+
+                case wxPNG_TYPE_GREY:
+                    {
+                        // where do these coefficients come from? maybe we
+                        // should have image options for them as well?
+                        unsigned uiColor =
+                            (unsigned) (76.544*(unsigned)clr.red +
+                                        150.272*(unsigned)clr.green +
+                                        36.864*(unsigned)clr.blue);
+
+                        *pData++ = (unsigned char)((uiColor >> 8) & 0xFF);
+                        if ( m_bitDepth == 16 )
+                            *pData++ = (unsigned char)(uiColor & 0xFF);
+                    }
+                    break;
+
+                case wxPNG_TYPE_GREY_RED:
+                    *pData++ = clr.red;
+                    if ( m_bitDepth == 16 )
+                        *pData++ = 0;
+                    break;
+
+                case wxPNG_TYPE_PALETTE:
+                    *pData++ = (unsigned char) PaletteFind(m_palette, clr);
+                    break;
+            }
+
+            if ( m_useAlpha )
+            {
+                unsigned char uchAlpha = 255;
+                if ( pAlpha )
+                    uchAlpha = *pAlpha++;
+
+                if ( m_hasMask )
+                {
+                    if ( (clr.red == m_mask.red)
+                            && (clr.green == m_mask.green)
+                                && (clr.blue == m_mask.blue) )
+                        uchAlpha = 0;
+                }
+
+                *pData++ = uchAlpha;
+                if ( m_bitDepth == 16 )
+                    *pData++ = 0;
+            }
+        }
+    }
+
+private:
+    const PaletteMap& m_palette;
+    const png_color_8 m_mask;
+    unsigned char* const m_data;
+    const unsigned char* const m_alpha;
+    const int m_width;
+    const int m_colorType;
+    const int m_bitDepth;
+    const bool m_useAlpha;
+    const bool m_usePalette;
+    const bool m_hasMask;
+
+    wxDECLARE_NO_COPY_CLASS(wxPNGRowConverter);
+};
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+// Parallel IDAT compression
+// ----------------------------------------------------------------------------
+
+#if wxUSE_THREADS && wxUSE_ZLIB
+
+// To compress the image data using multiple threads, the image is split in
+// bands of rows which are filtered and compressed independently into raw
+// deflate streams. All of them except the last one are terminated by a sync
+// flush, which aligns them on a byte boundary without marking the end of the
+// stream, so that they can be simply concatenated together and wrapped in
+// zlib header and checksum to form the IDAT data.
+
+// The minimal number of rows in a band, it's not worth using threads for
+// fewer rows than this.
+static const int wxPNG_MIN_BAND_ROWS = 64;
+
+// Paeth predictor as defined by the PNG specification.
+static inline unsigned char wxPNGPaeth(int a, int b, int c)
+{
+    const int p = a + b - c;
+    const int pa = abs(p - a);
+    const int pb = abs(p - b);
+    const int pc = abs(p - c);
+
+    if ( pa <= pb && pa <= pc )
+        return static_cast<unsigned char>(a);
+
+    return static_cast<unsigned char>(pb <= pc ? b : c);
+}
+
+// Apply the given PNG_FILTER_VALUE_XXX filter to the row and return the sum
+// of absolute values of the filtered bytes, used to select the best filter.
+static unsigned long
+wxPNGFilterRow(int filter,
+               const unsigned char* row,
+               const unsigned char* prev,
+               size_t len,
+               size_t bpp,
+               unsigned char* out)
+{
+    unsigned long sum = 0;
+    for ( size_t i = 0; i < len; i++ )
+    {
+        const int a = i >= bpp ? row[i - bpp] : 0;
+        const int b = prev[i];
+        const int c = i >= bpp ? prev[i - bpp] : 0;
+
+        int pred;
+        switch ( filter )
+        {
+            default:
+            case PNG_FILTER_VALUE_NONE:  pred = 0;                   break;
+            case PNG_FILTER_VALUE_SUB:   pred = a;                   break;
+            case PNG_FILTER_VALUE_UP:    pred = b;                   break;
+            case PNG_FILTER_VALUE_AVG:   pred = (a + b) / 2;         break;
+            case PNG_FILTER_VALUE_PAETH: pred = wxPNGPaeth(a, b, c); break;
+        }
+
+        const unsigned char v = static_cast<unsigned char>(row[i] - pred);
+        out[i] = v;
+        sum += v < 128 ? v : 256 - v;
+    }
+
+    return sum;
+}
+
+namespace
+{
+
+// A band of rows compressed by one of the threads.
+struct wxPNGDeflateBand
+{
+    int firstRow = 0;
+    int numRows = 0;
+    bool last = false;
+
+    // Filled in by the thread compressing this band.
+    std::vector<unsigned char> data;
+    wxUint32 adler = 1;
+    wxUint64 length = 0;
+    bool ok = false;
+};
+
+// Parameters common to all bands.
+struct wxPNGDeflateParams
+{
+    const wxPNGRowConverter* converter;
+    size_t rowBytes;
+    size_t bpp;
+    int filters;
+
+    // zlib parameters, -1 means that the default value is used.
+    int level;
+    int memLevel;
+    int strategy;
+};
+
+} // anonymous namespace
+
+// Compress the data using the given deflate stream, appending the output to
+// the provided buffer, which is extended as necessary.
+static bool wxPNGDeflateData(z_stream& zs,
+                             const unsigned char* data,
+                             size_t len,
+                             int flush,
+                             std::vector<unsigned char>& out)
+{
+    zs.next_in = const_cast<Bytef*>(data);
+    zs.avail_in = static_cast<uInt>(len);
+
+    for ( ;; )
+    {
+        if ( out.size() == zs.total_out )
+            out.resize(wxMax(2*out.size(), size_t(0x10000)));
+
+        zs.next_out = &out[zs.total_out];
+        zs.avail_out = static_cast<uInt>(out.size() - zs.total_out);
+
+        const int rc = deflate(&zs, flush);
+        if ( rc == Z_STREAM_END )
+            return true;
+
+        if ( rc != Z_OK && rc != Z_BUF_ERROR )
+            return false;
+
+        // Unless we're finishing the stream, we're done when all the input
+        // was consumed and there is still space in the output buffer, as
+        // this means that everything was flushed into it.
+        if ( flush != Z_FINISH && zs.avail_out != 0 )
+            return true;
+    }
+}
+
+// Convert the image rows in the given band, filter and compress them.
+static bool wxPNGDeflateOneBand(const wxPNGDeflateParams& params,
+                                wxPNGDeflateBand& band)
+{
+    const size_t rowBytes = params.rowBytes;
+
+    // We need the current and the previous rows (initially all zeroes, as
+    // the first row of the image is filtered as if it were preceded by
+    // them) and the output row with the filter type byte and its candidate.
+    std::vector<unsigned char> buf(4*rowBytes + 2);
+    unsigned char* row = &buf[0];
+    unsigned char* prev = row + rowBytes;
+    unsigned char* out = prev + rowBytes;
+    unsigned char* candidate = out + rowBytes + 1;
+
+    if ( band.firstRow > 0 )
+        params.converter->Convert(band.firstRow - 1, prev);
+
+    // Don't use wxZlibOutputStream, as it doesn't allow specifying the memory
+    // level and the strategy, and use the same default memory level as zlib.
+    z_stream zs;
+    memset(&zs, 0, sizeof(zs));
+    if ( deflateInit2(&zs,
+                      params.level,
+                      Z_DEFLATED,
+                      -MAX_WBITS, // raw deflate stream, without zlib header
+                      params.memLevel != -1 ? params.memLevel : 8,
+                      params.strategy != -1 ? params.strategy
+                                            : Z_DEFAULT_STRATEGY) != Z_OK )
+    {
+        return false;
+    }
+
+    bool ok = true;
+    for ( int y = band.firstRow; y < band.firstRow + band.numRows; y++ )
+    {
+        params.converter->Convert(y, row);
+
+        unsigned long best = (unsigned long)-1;
+        for ( int filter = PNG_FILTER_VALUE_NONE;
+              filter < PNG_FILTER_VALUE_LAST;
+              filter++ )
+        {
+            if ( !(params.filters & (PNG_FILTER_NONE << filter)) )
+                continue;
+
+            const unsigned long sum = wxPNGFilterRow(filter, row, prev,
+                                                     rowBytes, params.bpp,
+                                                     candidate + 1);
+            if ( sum < best )
+            {
+                best = sum;
+                candidate[0] = static_cast<unsigned char>(filter);
+                std::swap(out, candidate);
+            }
+        }
+
+        if ( !wxPNGDeflateData(zs, out, rowBytes + 1, Z_NO_FLUSH, band.data) )
+        {
+            ok = false;
+            break;
+        }
+
+        band.adler = adler32(band.adler, out, static_cast<uInt>(rowBytes + 1));
+        band.length += rowBytes + 1;
+
+        std::swap(row, prev);
+    }
+
+    // Only the last band terminates the stream, the other ones just flush
+    // all their data to a byte boundary without adding the final block.
+    if ( ok )
+    {
+        ok = wxPNGDeflateData(zs, nullptr, 0,
+                              band.last ? Z_FINISH : Z_SYNC_FLUSH,
+                              band.data);
+    }
+
+    band.data.resize(zs.total_out);
+
+    deflateEnd(&zs);
+
+    return ok;
+}
+
+static void wxPNGDeflateBands(const wxPNGDeflateParams& params,
+                              std::vector<wxPNGDeflateBand>& bands,
+                              std::atomic<size_t>& next)
+{
+    for ( ;; )
+    {
+        const size_t n = next++;
+        if ( n >= bands.size() )
+            break;
+
+        bands[n].ok = wxPNGDeflateOneBand(params, bands[n]);
+    }
+}
+
+namespace
+{
+
+class wxPNGDeflateThread : public wxThread
+{
+public:
+    wxPNGDeflateThread(const wxPNGDeflateParams& params,
+                       std::vector<wxPNGDeflateBand>& bands,
+                       std::atomic<size_t>& next)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_params(params),
+          m_bands(bands),
+          m_next(next)
+    {
+    }
+
+protected:
+    virtual void* Entry() override
+    {
+        wxPNGDeflateBands(m_params, m_bands, m_next);
+
+        return nullptr;
+    }
+
+private:
+    const wxPNGDeflateParams& m_params;
+    std::vector<wxPNGDeflateBand>& m_bands;
+    std::atomic<size_t>& m_next;
+};
+
+} // anonymous namespace
+
+// Compress the image data using the given number of threads and return the
+// bands containing the IDAT data, without zlib header and checksum, or false
+// if it couldn't be done.
+static bool
+wxPNGCompressParallel(const wxPNGDeflateParams& params,
+                      int height,
+                      int numThreads,
+                      std::vector<wxPNGDeflateBand>& bands,
+                      wxUint32& adler)
+{
+    const int numBands = wxMin(numThreads, height / wxPNG_MIN_BAND_ROWS);
+    if ( numBands < 2 )
+        return false;
+
+    bands.resize(numBands);
+    for ( int n = 0; n < numBands; n++ )
+    {
+        wxPNGDeflateBand& band = bands[n];
+        band.firstRow = static_cast<int>(static_cast<wxInt64>(height) * n / numBands);
+        band.numRows = static_cast<int>(static_cast<wxInt64>(height) * (n + 1) / numBands)
+                        - band.firstRow;
+        band.last = n == numBands - 1;
+    }
+
+    std::atomic<size_t> next(0);
+
+    std::vector<std::unique_ptr<wxPNGDeflateThread>> threads;
+    for ( int n = 1; n < numBands; n++ )
+    {
+        std::unique_ptr<wxPNGDeflateThread>
+            thread(new wxPNGDeflateThread(params, bands, next));
+        if ( thread->Run() != wxTHREAD_NO_ERROR )
+        {
+            // Not fatal, we'll just use fewer threads.
+            break;
+        }
+
+        threads.push_back(std::move(thread));
+    }
+
+    // Do some of the work in this thread too.
+    wxPNGDeflateBands(params, bands, next);
+
+    for ( const auto& thread : threads )
+        thread->Wait();
+
+    adler = 1;
+    for ( const auto& band : bands )
+    {
+        if ( !band.ok )
+            return false;
+
+        adler = adler32_combine(adler, band.adler,
+                                static_cast<z_off_t>(band.length));
+    }
+
+    return true;
+}
+
+// Return the mask of PNG_FILTER_XXX values corresponding to the filters
+// specified by wxIMAGE_OPTION_PNG_FILTER, interpreting it as libpng does, or
+// to the default filters if it is -1.
+static int wxPNGGetFiltersMask(int filters, bool usePalette)
+{
+    if ( filters == -1 )
+        return usePalette ? PNG_FILTER_NONE : PNG_ALL_FILTERS;
+
+    filters &= PNG_ALL_FILTERS | 7;
+    if ( filters < PNG_FILTER_NONE )
+    {
+        // A single PNG_FILTER_VALUE_XXX value.
+        return filters < PNG_FILTER_VALUE_LAST ? PNG_FILTER_NONE << filters
+                                                : PNG_FILTER_NONE;
+    }
+
+    return filters & PNG_ALL_FILTERS;
+}
+
+// Write IDAT chunks with the image data compressed using multiple threads,
+// return false if nothing was written and the data needs to be written by
+// libpng as usual.
+static bool
+wxPNGWriteParallel(png_structp png_ptr,
+                   const wxPNGDeflateParams& params,
+                   int height,
+                   int numThreads)
+{
+    std::vector<wxPNGDeflateBand> bands;
+    wxUint32 adler;
+    if ( !wxPNGCompressParallel(params, height, numThreads, bands, adler) )
+        return false;
+
+    // zlib header for deflate with 32KiB window: the second byte indicates
+    // the compression level used and is chosen to make the header checksum
+    // valid.
+    static const unsigned char levelFlags[] = { 0x01, 0x5e, 0x9c, 0xda };
+    const int level = params.level;
+    const unsigned char header[] =
+    {
+        0x78,
+        levelFlags[level < 0 || level == 6 ? 2 : level < 2 ? 0 : level < 6 ? 1 : 3]
+    };
+
+    const unsigned char trailer[] =
+    {
+        static_cast<unsigned char>(adler >> 24),
+        static_cast<unsigned char>(adler >> 16),
+        static_cast<unsigned char>(adler >> 8),
+        static_cast<unsigned char>(adler)
+    };
+
+    // Write each band as a separate chunk, with the header in the first one
+    // and the checksum in the last one.
+    const png_const_bytep IDAT = reinterpret_cast<png_const_bytep>("IDAT");
+    for ( const auto& band : bands )
+    {
+        const bool first = &band == &bands.front();
+        const size_t size = band.data.size() +
+                                (first ? sizeof(header) : 0) +
+                                    (band.last ? sizeof(trailer) : 0);
+
+        png_write_chunk_start(png_ptr, IDAT, static_cast<png_uint_32>(size));
+        if ( first )
+            png_write_chunk_data(png_ptr, header, sizeof(header));
+        if ( !band.data.empty() )
+            png_write_chunk_data(png_ptr, &band.data[0], band.data.size());
+        if ( band.last )
+            png_write_chunk_data(png_ptr, trailer, sizeof(trailer));
+        png_write_chunk_end(png_ptr);
+    }
+
+    return true;
+}
+
+#endif // wxUSE_THREADS && wxUSE_ZLIB
+
 // ----------------------------------------------------------------------------
 // writing PNGs
 // ----------------------------------------------------------------------------
@@ -696,17 +1374,45 @@ bool wxPNGHandler::SaveFile( wxImage *image, wxOutputStream& stream, bool verbos
                                   : PNG_COLOR_TYPE_GRAY;
     }
 
+    // In fast mode, use the fastest compression level, the simplest filter
+    // and RLE compression strategy unless specified otherwise: this is much
+    // faster than the defaults and still compresses typical screenshots and
+    // other synthetic images reasonably well.
+    const bool fast = image->GetOptionInt(wxIMAGE_OPTION_PNG_FAST) != 0;
+
+    int filters = -1;
     if (image->HasOption(wxIMAGE_OPTION_PNG_FILTER))
-        png_set_filter( png_ptr, PNG_FILTER_TYPE_BASE, image->GetOptionInt(wxIMAGE_OPTION_PNG_FILTER) );
+        filters = image->GetOptionInt(wxIMAGE_OPTION_PNG_FILTER);
+    else if (fast)
+        filters = PNG_FILTER_SUB;
+
+    if (filters != -1)
+        png_set_filter( png_ptr, PNG_FILTER_TYPE_BASE, filters );
 
+    int level = -1;
     if (image->HasOption(wxIMAGE_OPTION_PNG_COMPRESSION_LEVEL))
-        png_set_compression_level( png_ptr, image->GetOptionInt(wxIMAGE_OPTION_PNG_COMPRESSION_LEVEL) );
+        level = image->GetOptionInt(wxIMAGE_OPTION_PNG_COMPRESSION_LEVEL);
+    else if (fast)
+        level = 1; // Z_BEST_SPEED
+
+    if (level != -1)
+        png_set_compression_level( png_ptr, level );
 
+    int memLevel = -1;
     if (image->HasOption(wxIMAGE_OPTION_PNG_COMPRESSION_MEM_LEVEL))
-        png_set_compression_mem_level( png_ptr, image->GetOptionInt(wxIMAGE_OPTION_PNG_COMPRESSION_MEM_LEVEL) );
+        memLevel = image->GetOptionInt(wxIMAGE_OPTION_PNG_COMPRESSION_MEM_LEVEL);
 
+    if (memLevel != -1)
+        png_set_compression_mem_level( png_ptr, memLevel );
+
+    int strategy = -1;
     if (image->HasOption(wxIMAGE_OPTION_PNG_COMPRESSION_STRATEGY))
-        png_set_compression_strategy( png_ptr, image->GetOptionInt(wxIMAGE_OPTION_PNG_COMPRESSION_STRATEGY) );
+        strategy = image->GetOptionInt(wxIMAGE_OPTION_PNG_COMPRESSION_STRATEGY);
+    else if (fast)
+        strategy = 3; // Z_RLE
+
+    if (strategy != -1)
+        png_set_compression_strategy( png_ptr, strategy );
 
     if (image->HasOption(wxIMAGE_OPTION_PNG_COMPRESSION_BUFFER_SIZE))
         png_set_compression_buffer_size( png_ptr, image->GetOptionInt(wxIMAGE_OPTION_PNG_COMPRESSION_BUFFER_SIZE) );
@@ -795,6 +1501,58 @@ bool wxPNGHandler::SaveFile( wxImage *image, wxOutputStream& stream, bool verbos
     png_set_shift( png_ptr, &sig_bit );
     png_set_packing( png_ptr );
 
+    const wxPNGRowConverter converter(*image, palette, mask, iColorType,
+                                      iBitDepth, bUseAlpha, bUsePalette);
+
+#if wxUSE_THREADS && wxUSE_ZLIB
+    int numThreads = image->HasOption(wxIMAGE_OPTION_PNG_COMPRESSION_THREADS)
+                        ? image->GetOptionInt(wxIMAGE_OPTION_PNG_COMPRESSION_THREADS)
+                        : 1;
+    if ( numThreads <= 0 )
+        numThreads = wxThread::GetCPUCount();
+
+    // Only 8 bit images can be compressed in parallel, as we don't perform
+    // packing and shifting done by libpng for the other bit depths.
+    if ( numThreads > 1 && iBitDepth == 8 )
+    {
+        wxPNGDeflateParams params;
+        params.converter = &converter;
+        params.rowBytes = static_cast<size_t>(iWidth) * iElements;
+        params.bpp = iElements;
+        params.filters = wxPNGGetFiltersMask(filters, bUsePalette);
+        params.level = level;
+        params.memLevel = memLevel;
+        params.strategy = strategy;
+
+        if ( wxPNGWriteParallel(png_ptr, params, iHeight, numThreads) )
+        {
+            // We can't use png_write_end() as libpng doesn't know that we
+            // had written the image data, but we don't have anything else
+            // to write after it anyhow.
+            png_write_chunk(png_ptr, reinterpret_cast<png_const_bytep>("IEND"),
+                            nullptr, 0);
+            png_destroy_write_struct( &png_ptr, (png_infopp)&info_ptr );
+
+            return true;
+        }
+    }
+#endif // wxUSE_THREADS && wxUSE_ZLIB
+
+    // When no conversion is needed, pass the image rows to libpng directly.
+    if ( converter.IsDirect() )
+    {
+        for (int y = 0; y != iHeight; ++y)
+        {
+            png_bytep row_ptr = converter.GetDirectRow(y);
+            png_write_rows( png_ptr, &row_ptr, 1 );
+        }
+
+        png_write_end( png_ptr, info_ptr );
+        png_destroy_write_struct( &png_ptr, (png_infopp)&info_ptr );
+
+        return true;
+    }
+
     unsigned char *
         data = (unsigned char *)malloc( image->GetWidth() * iElements );
     if ( !data )
@@ -803,86 +1561,9 @@ bool wxPNGHandler::SaveFile( wxImage *image, wxOutputStream& stream, bool verbos
         return false;
     }
 
-    const unsigned char *
-        pAlpha = (const unsigned char *)(bHasAlpha ? image->GetAlpha() : nullptr);
-
-    const unsigned char *pColors = image->GetData();
-
     for (int y = 0; y != iHeight; ++y)
     {
-        unsigned char *pData = data;
-        for (int x = 0; x != iWidth; x++)
-        {
-            png_color_8 clr;
-            clr.red   = *pColors++;
-            clr.green = *pColors++;
-            clr.blue  = *pColors++;
-            clr.gray  = 0;
-            clr.alpha = (bUsePalette && pAlpha) ? *pAlpha++ : 0; // use with wxPNG_TYPE_PALETTE only
-
-            switch ( iColorType )
-            {
-                default:
-                    wxFAIL_MSG( wxT("unknown wxPNG_TYPE_XXX") );
-                    wxFALLTHROUGH;
-
-                case wxPNG_TYPE_COLOUR:
-                    *pData++ = clr.red;
-                    if ( iBitDepth == 16 )
-                        *pData++ = 0;
-                    *pData++ = clr.green;
-                    if ( iBitDepth == 16 )
-                        *pData++ = 0;
-                    *pData++ = clr.blue;
-                    if ( iBitDepth == 16 )
-                        *pData++ = 0;
-                    break;
-
-                case wxPNG_TYPE_GREY:
-                    {
-                        // where do these coefficients come from? maybe we
-                        // should have image options for them as well?
-                        unsigned uiColor =
-                            (unsigned) (76.544*(unsigned)clr.red +
-                                        150.272*(unsigned)clr.green +
-                                        36.864*(unsigned)clr.blue);
-
-                        *pData++ = (unsigned char)((uiColor >> 8) & 0xFF);
-                        if ( iBitDepth == 16 )
-                            *pData++ = (unsigned char)(uiColor & 0xFF);
-                    }
-                    break;
-
-                case wxPNG_TYPE_GREY_RED:
-                    *pData++ = clr.red;
-                    if ( iBitDepth == 16 )
-                        *pData++ = 0;
-                    break;
-
-                case wxPNG_TYPE_PALETTE:
-                    *pData++ = (unsigned char) PaletteFind(palette, clr);
-                    break;
-            }
-
-            if ( bUseAlpha )
-            {
-                unsigned char uchAlpha = 255;
-                if ( bHasAlpha )
-                    uchAlpha = *pAlpha++;
-
-                if ( bHasMask )
-                {
-                    if ( (clr.red == mask.red)
-                            && (clr.green == mask.green)
-                                && (clr.blue == mask.blue) )
-                        uchAlpha = 0;
-                }
-
-                *pData++ = uchAlpha;
-                if ( iBitDepth == 16 )
-                    *pData++ = 0;
-            }
-        }
+        converter.Convert(y, data);
 
         png_bytep row_ptr = data;
         png_write_rows( png_ptr, &row_ptr, 1 );
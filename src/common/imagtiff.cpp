@@ -30,6 +30,7 @@
     #include "wx/bitmap.h"
     #include "wx/module.h"
     #include "wx/wxcrtvararg.h"
+    #include "wx/utils.h"
 #endif
 
 extern "C"
@@ -288,7 +289,71 @@ TIFFwxOpen(wxOutputStream &stream, const char* name, const char* mode)
     return tif;
 }
 
-bool wxTIFFHandler::LoadFile( wxImage *image, wxInputStream& stream, bool verbose, int index )
+// Minimal number of rows decoded at once, the actual number is a multiple of
+// the strip or tile height.
+static const wxUint32 wxTIFF_MIN_BAND_HEIGHT = 64;
+
+// Read the given rows of a 2 samples per pixel image (grey or black and white
+// with alpha), which is not supported by TIFFRGBAImageGet(), into the raster.
+static bool
+wxReadTIFFScanlines(TIFF *tif,
+                    unsigned char *buf,
+                    wxUint32 *raster,
+                    wxUint32 w,
+                    wxUint32 firstRow,
+                    wxUint32 numRows,
+                    bool isGreyScale,
+                    bool minIsWhite)
+{
+    const int minValue =  minIsWhite ? 255 : 0;
+    const int maxValue = 255 - minValue;
+
+    /*
+    Decode to ABGR format as that is what the code, that converts to
+    wxImage, later on expects (normally TIFFRGBAImageGet is used to
+    decode which uses an ABGR layout).
+    */
+    wxUint32 pos = 0;
+    for (wxUint32 y = firstRow; y < firstRow + numRows; ++y)
+    {
+        if (TIFFReadScanline(tif, buf, y, 0) != 1)
+            return false;
+
+        if (isGreyScale)
+        {
+            for (wxUint32 x = 0; x < w; ++x)
+            {
+                wxUint8 val = minIsWhite ? 255 - buf[x*2] : buf[x*2];
+                wxUint8 alpha = minIsWhite ? 255 - buf[x*2+1] : buf[x*2+1];
+                raster[pos] = val + (val << 8) + (val << 16)
+                    + (alpha << 24);
+                pos++;
+            }
+        }
+        else
+        {
+            for (wxUint32 x = 0; x < w; ++x)
+            {
+                int mask = buf[x*2/8] << ((x*2)%8);
+
+                wxUint8 val = mask & 128 ? maxValue : minValue;
+                raster[pos] = val + (val << 8) + (val << 16)
+                    + ((mask & 64 ? maxValue : minValue) << 24);
+                pos++;
+            }
+        }
+    }
+
+    return true;
+}
+
+// Common part of LoadFile() and LoadFileRows(), receiver may be null.
+static bool
+wxLoadTIFF(wxImage *image,
+           wxInputStream& stream,
+           bool verbose,
+           int index,
+           wxImageRowsReceiver* receiver)
 {
     if (index == -1)
         index = 0;
@@ -363,7 +428,34 @@ bool wxTIFFHandler::LoadFile( wxImage *image, wxInputStream& stream, bool verbos
         return false;
     }
 
-    raster = (wxUint32*) _TIFFmalloc( (wxUint32)bytesNeeded );
+    // The image is decoded in bands of rows, so that we don't need a raster
+    // for the entire image in addition to the image itself. This is only
+    // done for the images stored from top to bottom, as libtiff flips the
+    // rows of the other ones and so would return the bands in wrong order.
+    wxUint16 orientation = ORIENTATION_TOPLEFT;
+    (void) TIFFGetFieldDefaulted(tif, TIFFTAG_ORIENTATION, &orientation);
+
+    wxUint32 bandHeight = h;
+    if ( orientation == ORIENTATION_TOPLEFT )
+    {
+        // Make the bands contain whole strips or tiles to avoid decoding
+        // them more than once.
+        wxUint32 rowsPerBlock = 0;
+        if ( TIFFIsTiled(tif) )
+            (void) TIFFGetField(tif, TIFFTAG_TILELENGTH, &rowsPerBlock);
+        else
+            (void) TIFFGetFieldDefaulted(tif, TIFFTAG_ROWSPERSTRIP, &rowsPerBlock);
+
+        if ( rowsPerBlock > 0 && rowsPerBlock < h )
+        {
+            bandHeight = (wxTIFF_MIN_BAND_HEIGHT + rowsPerBlock - 1)
+                            / rowsPerBlock * rowsPerBlock;
+            if ( bandHeight > h )
+                bandHeight = h;
+        }
+    }
+
+    raster = (wxUint32*) _TIFFmalloc( (tsize_t)w * bandHeight * sizeof(wxUint32) );
 
     if (!raster)
     {
@@ -399,105 +491,93 @@ bool wxTIFFHandler::LoadFile( wxImage *image, wxInputStream& stream, bool verbos
 
     bool ok = true;
     char msg[1024] = "";
-    if
-    (
+    const bool useScanlines =
         (planarConfig == PLANARCONFIG_CONTIG && samplesPerPixel == 2
             && extraSamples == 1)
         &&
         (
             ( !TIFFRGBAImageOK(tif, msg) )
             || (bitsPerSample == 8)
-        )
-    )
-    {
-        const bool isGreyScale = (bitsPerSample == 8);
-        unsigned char *buf = (unsigned char *)_TIFFmalloc(TIFFScanlineSize(tif));
-        wxUint32 pos = 0;
-        const bool minIsWhite = (photometric == PHOTOMETRIC_MINISWHITE);
-        const int minValue =  minIsWhite ? 255 : 0;
-        const int maxValue = 255 - minValue;
-
-        /*
-        Decode to ABGR format as that is what the code, that converts to
-        wxImage, later on expects (normally TIFFReadRGBAImageOriented is
-        used to decode which uses an ABGR layout).
-        */
-        for (wxUint32 y = 0; y < h; ++y)
-        {
-            if (TIFFReadScanline(tif, buf, y, 0) != 1)
-            {
-                ok = false;
-                break;
-            }
-
-            if (isGreyScale)
-            {
-                for (wxUint32 x = 0; x < w; ++x)
-                {
-                    wxUint8 val = minIsWhite ? 255 - buf[x*2] : buf[x*2];
-                    wxUint8 alpha = minIsWhite ? 255 - buf[x*2+1] : buf[x*2+1];
-                    raster[pos] = val + (val << 8) + (val << 16)
-                        + (alpha << 24);
-                    pos++;
-                }
-            }
-            else
-            {
-                for (wxUint32 x = 0; x < w; ++x)
-                {
-                    int mask = buf[x*2/8] << ((x*2)%8);
-
-                    wxUint8 val = mask & 128 ? maxValue : minValue;
-                    raster[pos] = val + (val << 8) + (val << 16)
-                        + ((mask & 64 ? maxValue : minValue) << 24);
-                    pos++;
-                }
-            }
-        }
+        );
 
-        _TIFFfree(buf);
+    unsigned char *buf = nullptr;
+    TIFFRGBAImage img;
+    bool imgBegun = false;
+    if ( useScanlines )
+    {
+        buf = (unsigned char *)_TIFFmalloc(TIFFScanlineSize(tif));
+        ok = buf != nullptr;
     }
     else
     {
-        ok = TIFFReadRGBAImageOriented( tif, w, h, raster,
-            ORIENTATION_TOPLEFT, 0 ) != 0;
+        imgBegun = TIFFRGBAImageOK(tif, msg) &&
+                    TIFFRGBAImageBegin(&img, tif, 0, msg);
+        if ( imgBegun )
+            img.req_orientation = ORIENTATION_TOPLEFT;
+        ok = imgBegun;
     }
 
+    unsigned char *ptr = image->GetData();
 
-    if (!ok)
+    unsigned char *alpha = image->GetAlpha();
+
+    bool cancelled = false;
+    for ( wxUint32 firstRow = 0; ok && firstRow < h; firstRow += bandHeight )
     {
-        if (verbose)
+        const wxUint32 numRows = wxMin(bandHeight, h - firstRow);
+
+        if ( useScanlines )
         {
-            wxLogError( _("TIFF: Error reading image.") );
+            ok = wxReadTIFFScanlines(tif, buf, raster, w, firstRow, numRows,
+                                     bitsPerSample == 8,
+                                     photometric == PHOTOMETRIC_MINISWHITE);
+        }
+        else
+        {
+            img.row_offset = firstRow;
+            img.col_offset = 0;
+            ok = TIFFRGBAImageGet(&img, raster, w, numRows) != 0;
         }
 
-        _TIFFfree( raster );
-        image->Destroy();
-        TIFFClose( tif );
-
-        return false;
-    }
-
-    unsigned char *ptr = image->GetData();
-
-    unsigned char *alpha = image->GetAlpha();
-
-    wxUint32 pos = 0;
+        if ( !ok )
+            break;
 
-    for (wxUint32 i = 0; i < h; i++)
-    {
-        for (wxUint32 j = 0; j < w; j++)
+        const wxUint32 numPixels = w * numRows;
+        for (wxUint32 pos = 0; pos < numPixels; pos++)
         {
             *(ptr++) = (unsigned char)TIFFGetR(raster[pos]);
             *(ptr++) = (unsigned char)TIFFGetG(raster[pos]);
             *(ptr++) = (unsigned char)TIFFGetB(raster[pos]);
             if ( hasAlpha )
                 *(alpha++) = (unsigned char)TIFFGetA(raster[pos]);
+        }
 
-            pos++;
+        if ( receiver && !receiver->OnRows(*image, firstRow, numRows) )
+        {
+            cancelled = true;
+            ok = false;
         }
     }
 
+    if ( buf )
+        _TIFFfree(buf);
+
+    if ( imgBegun )
+        TIFFRGBAImageEnd(&img);
+
+    if (!ok)
+    {
+        if (verbose && !cancelled)
+        {
+            wxLogError( _("TIFF: Error reading image.") );
+        }
+
+        _TIFFfree( raster );
+        image->Destroy();
+        TIFFClose( tif );
+
+        return false;
+    }
 
     image->SetOption(wxIMAGE_OPTION_TIFF_PHOTOMETRIC, photometric);
 
@@ -580,6 +660,18 @@ bool wxTIFFHandler::LoadFile( wxImage *image, wxInputStream& stream, bool verbos
     return true;
 }
 
+bool wxTIFFHandler::LoadFile( wxImage *image, wxInputStream& stream, bool verbose, int index )
+{
+    return wxLoadTIFF(image, stream, verbose, index, nullptr);
+}
+
+bool wxTIFFHandler::LoadFileRows( wxImage *image, wxInputStream& stream,
+                                  wxImageRowsReceiver& receiver,
+                                  bool verbose, int index )
+{
+    return wxLoadTIFF(image, stream, verbose, index, &receiver);
+}
+
 int wxTIFFHandler::DoGetImageCount( wxInputStream& stream )
 {
     TIFF *tif = TIFFwxOpen( stream, "image", "r" );
@@ -39,6 +39,20 @@ namespace wxPrivate
 
 const size_t wxLZMA_BUF_SIZE = 4096;
 
+// Multithreaded (de)compression works with much bigger blocks of data, so use
+// a bigger buffer to avoid calling lzma_code() too often in this case.
+const size_t wxLZMA_MT_BUF_SIZE = 1024*1024;
+
+// liblzma versions in which multithreaded compression and decompression were
+// declared stable.
+#if LZMA_VERSION >= 50020002
+    #define wxHAS_LZMA_ENCODER_MT
+#endif
+
+#if LZMA_VERSION >= 50040002
+    #define wxHAS_LZMA_DECODER_MT
+#endif
+
 // ----------------------------------------------------------------------------
 // Private helpers
 // ----------------------------------------------------------------------------
@@ -58,6 +72,21 @@ struct wxLZMAStream : lzma_stream
     }
 };
 
+#ifdef wxHAS_LZMA_ENCODER_MT
+
+// Return the number of threads to use for the value passed to the stream ctor.
+uint32_t wxGetLZMAThreads(int threads)
+{
+    if ( threads > 0 )
+        return threads;
+
+    // This returns 0 if the number of CPUs can't be determined.
+    const uint32_t numCPUs = lzma_cputhreads();
+    return numCPUs ? numCPUs : 1;
+}
+
+#endif // wxHAS_LZMA_ENCODER_MT
+
 } // namespace wxPrivate
 
 using namespace wxPrivate;
@@ -92,6 +121,7 @@ wxLZMAData::wxLZMAData()
 {
     m_stream = new wxLZMAStream;
     m_streamBuf = new wxUint8[wxLZMA_BUF_SIZE];
+    m_streamBufSize = wxLZMA_BUF_SIZE;
     m_pos = 0;
 }
 
@@ -101,16 +131,55 @@ wxLZMAData::~wxLZMAData()
     delete m_stream;
 }
 
+void wxLZMAData::SetBufferSize(size_t size)
+{
+    delete [] m_streamBuf;
+    m_streamBuf = new wxUint8[size];
+    m_streamBufSize = size;
+}
+
 // ----------------------------------------------------------------------------
 // wxLZMAInputStream: decompression
 // ----------------------------------------------------------------------------
 
-void wxLZMAInputStream::Init()
+void wxLZMAInputStream::Init(int threads, wxUint64 memlimit)
 {
-    // We don't specify any memory usage limit nor any flags, not even
-    // LZMA_CONCATENATED recommended by liblzma documentation, because we don't
-    // foresee the need to support concatenated compressed files for now.
-    const lzma_ret rc = lzma_stream_decoder(m_stream, UINT64_MAX, 0);
+    lzma_ret rc = LZMA_PROG_ERROR;
+
+#ifdef wxHAS_LZMA_DECODER_MT
+    if ( threads != 1 )
+    {
+        lzma_mt mt;
+        memset(&mt, 0, sizeof(mt));
+        mt.threads = wxGetLZMAThreads(threads);
+
+        // Exceeding the limit just makes the decoder use fewer threads, but
+        // we still don't impose any limit on the total memory usage, as in
+        // the single-threaded case below.
+        mt.memlimit_threading = memlimit ? memlimit : UINT64_MAX;
+        mt.memlimit_stop = UINT64_MAX;
+
+        rc = lzma_stream_decoder_mt(m_stream, &mt);
+        if ( rc == LZMA_OK )
+            SetBufferSize(wxLZMA_MT_BUF_SIZE);
+    }
+#else // !wxHAS_LZMA_DECODER_MT
+    wxUnusedVar(threads);
+    wxUnusedVar(memlimit);
+#endif // wxHAS_LZMA_DECODER_MT/!wxHAS_LZMA_DECODER_MT
+
+    // Note that blocks can only be decompressed in parallel if the data was
+    // compressed by a multithreaded encoder, otherwise multithreaded decoder
+    // works as the single-threaded one.
+    if ( rc != LZMA_OK && rc != LZMA_MEM_ERROR )
+    {
+        // We don't specify any memory usage limit nor any flags, not even
+        // LZMA_CONCATENATED recommended by liblzma documentation, because we
+        // don't foresee the need to support concatenated compressed files for
+        // now.
+        rc = lzma_stream_decoder(m_stream, UINT64_MAX, 0);
+    }
+
     switch ( rc )
     {
         case LZMA_OK:
@@ -144,7 +213,7 @@ size_t wxLZMAInputStream::OnSysRead(void* outbuf, size_t size)
         // Get more input data if needed.
         if ( !m_stream->avail_in )
         {
-            m_parent_i_stream->Read(m_streamBuf, wxLZMA_BUF_SIZE);
+            m_parent_i_stream->Read(m_streamBuf, m_streamBufSize);
             m_stream->next_in = m_streamBuf;
             m_stream->avail_in = m_parent_i_stream->LastRead();
 
@@ -210,19 +279,60 @@ size_t wxLZMAInputStream::OnSysRead(void* outbuf, size_t size)
 // wxLZMAOutputStream: compression
 // ----------------------------------------------------------------------------
 
-void wxLZMAOutputStream::Init(int level)
+void wxLZMAOutputStream::Init(int level, int threads, wxUint64 memlimit)
 {
     if ( level == -1 )
         level = LZMA_PRESET_DEFAULT;
 
-    // Use the check type recommended by liblzma documentation.
-    const lzma_ret rc = lzma_easy_encoder(m_stream, level, LZMA_CHECK_CRC64);
+    lzma_ret rc = LZMA_PROG_ERROR;
+
+#ifdef wxHAS_LZMA_ENCODER_MT
+    if ( threads != 1 )
+    {
+        lzma_mt mt;
+        memset(&mt, 0, sizeof(mt));
+        mt.threads = wxGetLZMAThreads(threads);
+        mt.preset = level;
+        mt.check = LZMA_CHECK_CRC64;
+
+        // Encoder doesn't support memory limit directly, so reduce the number
+        // of threads until its memory usage fits into it.
+        if ( memlimit )
+        {
+            while ( mt.threads > 1 &&
+                        lzma_stream_encoder_mt_memusage(&mt) > memlimit )
+            {
+                mt.threads--;
+            }
+        }
+
+        if ( mt.threads > 1 )
+        {
+            rc = lzma_stream_encoder_mt(m_stream, &mt);
+            if ( rc == LZMA_OK )
+                SetBufferSize(wxLZMA_MT_BUF_SIZE);
+        }
+    }
+#else // !wxHAS_LZMA_ENCODER_MT
+    wxUnusedVar(threads);
+    wxUnusedVar(memlimit);
+#endif // wxHAS_LZMA_ENCODER_MT/!wxHAS_LZMA_ENCODER_MT
+
+    // Fall back to the single-threaded encoder if we don't need to, or can't,
+    // use multiple threads, e.g. because liblzma was built without support
+    // for them.
+    if ( rc != LZMA_OK && rc != LZMA_MEM_ERROR )
+    {
+        // Use the check type recommended by liblzma documentation.
+        rc = lzma_easy_encoder(m_stream, level, LZMA_CHECK_CRC64);
+    }
+
     switch ( rc )
     {
         case LZMA_OK:
             // Prepare for the first call to OnSysWrite().
             m_stream->next_out = m_streamBuf;
-            m_stream->avail_out = wxLZMA_BUF_SIZE;
+            m_stream->avail_out = m_streamBufSize;
 
             // Skip setting m_lasterror below.
             return;
@@ -292,7 +402,7 @@ bool wxLZMAOutputStream::UpdateOutput()
     // Write the buffer contents to the real output, taking care only to write
     // as much of it as we actually have, as the buffer can (and very likely
     // will) be incomplete.
-    const size_t numOut = wxLZMA_BUF_SIZE - m_stream->avail_out;
+    const size_t numOut = m_streamBufSize - m_stream->avail_out;
     m_parent_o_stream->Write(m_streamBuf, numOut);
     if ( m_parent_o_stream->LastWrite() != numOut )
     {
@@ -311,7 +421,7 @@ bool wxLZMAOutputStream::UpdateOutputIfNecessary()
             return false;
 
         m_stream->next_out = m_streamBuf;
-        m_stream->avail_out = wxLZMA_BUF_SIZE;
+        m_stream->avail_out = m_streamBufSize;
     }
 
     return true;
@@ -362,7 +472,7 @@ bool wxLZMAOutputStream::Close()
         return false;
 
     m_stream->next_out = m_streamBuf;
-    m_stream->avail_out = wxLZMA_BUF_SIZE;
+    m_stream->avail_out = m_streamBufSize;
 
     return wxFilterOutputStream::Close() && IsOk();
 }
@@ -38,15 +38,20 @@
 #ifndef WX_PRECOMP
     #include "wx/palette.h"
     #include "wx/image.h"
+    #include "wx/utils.h"
 #endif
 
 #ifdef __WXMSW__
     #include "wx/msw/private.h"
 #endif
 
+#include <limits.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include <algorithm>
+#include <vector>
+
 namespace
 {
 
@@ -280,6 +285,7 @@ typedef struct {
   bool needs_zeroed;        /* true if next pass must zero histogram */
 
   /* Variables for Floyd-Steinberg dithering */
+  bool dither;          /* false to use pass2_no_dither */
   FSERRPTR fserrors;        /* accumulated errors */
   bool on_odd_row;      /* flag to remember which row we are on */
   int * error_limiter;      /* table for clamping the applied error */
@@ -992,7 +998,6 @@ fill_inverse_cmap (j_decompress_ptr cinfo, int c0, int c1, int c2)
  * Map some rows of pixels to the output colormapped representation.
  */
 
-#if 0
 void
 pass2_no_dither (j_decompress_ptr cinfo,
          JSAMPARRAY input_buf, JSAMPARRAY output_buf, int num_rows)
@@ -1025,7 +1030,6 @@ pass2_no_dither (j_decompress_ptr cinfo,
     }
   }
 }
-#endif
 
 void
 pass2_fs_dither (j_decompress_ptr cinfo,
@@ -1277,7 +1281,8 @@ start_pass_2_quant (j_decompress_ptr cinfo, bool is_pre_scan)
     cquantize->needs_zeroed = true; /* Always zero histogram */
   } else {
     /* Set up method pointers */
-    cquantize->pub.color_quantize = pass2_fs_dither;
+    cquantize->pub.color_quantize = cquantize->dither ? pass2_fs_dither
+                                                      : pass2_no_dither;
     cquantize->pub.finish_pass = finish_pass2;
 
     {
@@ -1334,6 +1339,7 @@ jinit_2pass_quantizer (j_decompress_ptr cinfo)
   cinfo->cquantize = (jpeg_color_quantizer *) cquantize;
   cquantize->pub.start_pass = start_pass_2_quant;
   cquantize->pub.new_color_map = new_color_map_2_quant;
+  cquantize->dither = true;
   cquantize->fserrors = nullptr;   /* flag optional arrays not allocated */
   cquantize->error_limiter = nullptr;
 
@@ -1413,6 +1419,508 @@ prepare_range_limit_table (j_decompress_ptr cinfo)
 } // anonymous namespace
 
 
+// ----------------------------------------------------------------------------
+// Fast quantizer
+// ----------------------------------------------------------------------------
+
+/*
+ * This quantizer is used when wxQUANTIZE_FAST is specified. It builds an
+ * octree of the colours used in the image, limited to 5 levels (i.e. 5 bits
+ * of precision per channel), but keeping the sums of the exact colours
+ * values in its leaves. The tree is then reduced to the desired number of
+ * colours by merging the nodes with the least number of pixels, starting with
+ * the deepest level, and the averages of the colours in the remaining leaves
+ * form the palette.
+ *
+ * Mapping the colours to the palette uses a cache of the nearest palette
+ * entries for each cell of 5-6-5 bits colour space, which is filled lazily
+ * for the blocks of 4*4*4 cells at once: only the palette entries which can
+ * possibly be the nearest ones for some colour in the block are checked for
+ * each of its cells, as in fill_inverse_cmap() above.
+ */
+
+namespace
+{
+
+class wxFastQuantizer
+{
+public:
+    explicit wxFastQuantizer(int desiredColours)
+        : m_desiredColours(wxMax(1, wxMin(desiredColours, 256))),
+          m_leaves(1 << (3*MAX_DEPTH), -1),
+          m_cache(1 << 16, -1)
+    {
+        // Create the root node.
+        m_nodes.push_back(Node());
+    }
+
+    void AddRows(unsigned w, unsigned h, unsigned char **in_rows);
+
+    // Fill the palette with desiredColours entries, any unused ones are set
+    // to black.
+    void BuildPalette(unsigned char *palette);
+
+    void MapRows(unsigned w, unsigned h,
+                 unsigned char **in_rows, unsigned char **out_rows,
+                 bool dither);
+
+private:
+    // Number of levels in the tree, excluding the root.
+    static const int MAX_DEPTH = 5;
+
+    // Maximal number of pixels used for building the palette.
+    static const wxUint64 MAX_SAMPLES = 128*1024;
+
+    struct Node
+    {
+        Node()
+        {
+            for ( int i = 0; i < 8; i++ )
+                children[i] = -1;
+        }
+
+        bool IsLeaf() const
+        {
+            for ( int i = 0; i < 8; i++ )
+            {
+                if ( children[i] != -1 )
+                    return false;
+            }
+
+            return true;
+        }
+
+        int children[8];
+        int level = 0;
+        bool merged = false;
+
+        // The number of pixels in this node and all its children.
+        wxUint64 count = 0;
+
+        // The sums of the components of all the pixels, only valid in the
+        // leaves.
+        wxUint64 sumR = 0,
+                 sumG = 0,
+                 sumB = 0;
+    };
+
+    // Return the index of the leaf containing the pixels of this colour,
+    // creating it if necessary.
+    int FindOrAddLeaf(unsigned char r, unsigned char g, unsigned char b);
+
+    // Merge all children of this node, which must all be leaves, into it.
+    void MergeChildren(Node& node);
+
+    // Return the index of the palette entry closest to the given colour.
+    unsigned char FindNearest(int r, int g, int b);
+
+    // Fill the cache for the block of cells containing the given one.
+    void FillCacheBlock(int c0, int c1, int c2);
+
+
+    const int m_desiredColours;
+
+    std::vector<Node> m_nodes;
+    int m_numLeaves = 0;
+
+    // Indices of the leaves for all possible colours with MAX_DEPTH bits
+    // per channel, allowing to find the leaf without walking down the tree.
+    std::vector<int> m_leaves;
+
+    int m_numColours = 0;
+    unsigned char m_palette[3*256];
+
+    // Cached results of FindNearest() for 5-6-5 cells.
+    std::vector<wxInt16> m_cache;
+};
+
+int wxFastQuantizer::FindOrAddLeaf(unsigned char r, unsigned char g, unsigned char b)
+{
+    int n = 0;
+
+    for ( int level = 0; level < MAX_DEPTH; level++ )
+    {
+        const int shift = 7 - level;
+        const int child = (((r >> shift) & 1) << 2) |
+                          (((g >> shift) & 1) << 1) |
+                           ((b >> shift) & 1);
+
+        int next = m_nodes[n].children[child];
+        if ( next == -1 )
+        {
+            next = static_cast<int>(m_nodes.size());
+            m_nodes[n].children[child] = next;
+
+            m_nodes.push_back(Node());
+            m_nodes.back().level = level + 1;
+
+            if ( level + 1 == MAX_DEPTH )
+                m_numLeaves++;
+        }
+
+        n = next;
+    }
+
+    return n;
+}
+
+void wxFastQuantizer::AddRows(unsigned w, unsigned h, unsigned char **in_rows)
+{
+    const int shift = 8 - MAX_DEPTH;
+
+    // For big images, building the palette from a subset of pixels is much
+    // faster and gives almost the same result, so use only every step-th
+    // pixel of every step-th row.
+    unsigned step = 1;
+    while ( (wxUint64(w)/(step + 1))*(h/(step + 1)) >= MAX_SAMPLES )
+        step++;
+
+    for ( unsigned y = 0; y < h; y += step )
+    {
+        const unsigned char *p = in_rows[y];
+        for ( unsigned x = 0; x < w; x += step, p += 3*step )
+        {
+            const unsigned char r = p[0],
+                                g = p[1],
+                                b = p[2];
+
+            int& leafIndex = m_leaves[((r >> shift) << (2*MAX_DEPTH)) |
+                                      ((g >> shift) << MAX_DEPTH) |
+                                       (b >> shift)];
+            if ( leafIndex == -1 )
+                leafIndex = FindOrAddLeaf(r, g, b);
+
+            Node& leaf = m_nodes[leafIndex];
+            leaf.count++;
+            leaf.sumR += r;
+            leaf.sumG += g;
+            leaf.sumB += b;
+        }
+    }
+
+    // Compute the counts of the internal nodes from their leaves: as the
+    // children are always added after their parents, iterating in reverse
+    // order processes all children before their parent.
+    for ( size_t n = m_nodes.size(); n-- > 0; )
+    {
+        Node& node = m_nodes[n];
+        if ( node.level == MAX_DEPTH )
+            continue;
+
+        node.count = 0;
+        for ( int i = 0; i < 8; i++ )
+        {
+            if ( node.children[i] != -1 )
+                node.count += m_nodes[node.children[i]].count;
+        }
+    }
+}
+
+void wxFastQuantizer::MergeChildren(Node& node)
+{
+    int numChildren = 0;
+    for ( int i = 0; i < 8; i++ )
+    {
+        const int c = node.children[i];
+        if ( c == -1 )
+            continue;
+
+        Node& child = m_nodes[c];
+        node.sumR += child.sumR;
+        node.sumG += child.sumG;
+        node.sumB += child.sumB;
+        child.merged = true;
+
+        node.children[i] = -1;
+        numChildren++;
+    }
+
+    // The node itself becomes a leaf.
+    m_numLeaves -= numChildren - 1;
+}
+
+void wxFastQuantizer::BuildPalette(unsigned char *palette)
+{
+    // Reduce the tree by merging the nodes with the least number of pixels,
+    // starting from the deepest level: all their children are leaves as
+    // all the nodes at the deeper levels have already been merged.
+    for ( int level = MAX_DEPTH - 1;
+          level >= 0 && m_numLeaves > m_desiredColours;
+          level-- )
+    {
+        std::vector<int> candidates;
+        for ( size_t n = 0; n < m_nodes.size(); n++ )
+        {
+            const Node& node = m_nodes[n];
+            if ( node.level == level && !node.merged && !node.IsLeaf() )
+                candidates.push_back(static_cast<int>(n));
+        }
+
+        std::stable_sort(candidates.begin(), candidates.end(),
+                         [this](int n1, int n2)
+                         {
+                            return m_nodes[n1].count < m_nodes[n2].count;
+                         });
+
+        for ( size_t n = 0;
+              n < candidates.size() && m_numLeaves > m_desiredColours;
+              n++ )
+        {
+            MergeChildren(m_nodes[candidates[n]]);
+        }
+    }
+
+    // Use the average colours of the remaining leaves as the palette.
+    m_numColours = 0;
+    for ( const Node& node : m_nodes )
+    {
+        if ( node.merged || !node.count || !node.IsLeaf() )
+            continue;
+
+        wxCHECK_RET( m_numColours < m_desiredColours, "too many colours" );
+
+        unsigned char* const entry = m_palette + 3*m_numColours;
+        entry[0] = static_cast<unsigned char>((node.sumR + node.count/2) / node.count);
+        entry[1] = static_cast<unsigned char>((node.sumG + node.count/2) / node.count);
+        entry[2] = static_cast<unsigned char>((node.sumB + node.count/2) / node.count);
+
+        m_numColours++;
+    }
+
+    // This can only happen for an empty image.
+    if ( !m_numColours )
+    {
+        m_palette[0] = m_palette[1] = m_palette[2] = 0;
+        m_numColours = 1;
+    }
+
+    memcpy(palette, m_palette, 3*m_numColours);
+    memset(palette + 3*m_numColours, 0, 3*(m_desiredColours - m_numColours));
+
+    // The nodes are not needed any more.
+    std::vector<Node>().swap(m_nodes);
+    std::vector<int>().swap(m_leaves);
+}
+
+inline int ClampSample(int v)
+{
+    return v < 0 ? 0 : v > MAXJSAMPLE ? MAXJSAMPLE : v;
+}
+
+// Add the squares of the minimal and maximal distances from the value to the
+// given range to the provided variables.
+static inline void
+AddBoxDistances(int v, int vmin, int vmax, int& dmin, int& dmax)
+{
+    int d;
+    if ( v < vmin )
+    {
+        d = vmin - v;
+        dmin += d*d;
+        d = vmax - v;
+    }
+    else if ( v > vmax )
+    {
+        d = v - vmax;
+        dmin += d*d;
+        d = v - vmin;
+    }
+    else
+    {
+        d = wxMax(v - vmin, vmax - v);
+    }
+
+    dmax += d*d;
+}
+
+void wxFastQuantizer::FillCacheBlock(int c0, int c1, int c2)
+{
+    // Cells are 8*4*8 and blocks are 4*4*4 cells, i.e. 32*16*32.
+    const int minR = (c0 & ~3) << 3,
+              minG = (c1 & ~3) << 2,
+              minB = (c2 & ~3) << 3;
+    const int maxR = minR + 31,
+              maxG = minG + 15,
+              maxB = minB + 31;
+
+    // Compute the minimal and maximal distances from each palette entry to
+    // the block: only the entries whose minimal distance is not greater than
+    // the smallest maximal distance can be the nearest to some of its cells.
+    int minDist[256];
+    int minMaxDist = INT_MAX;
+    for ( int i = 0; i < m_numColours; i++ )
+    {
+        const unsigned char* const p = m_palette + 3*i;
+
+        int dmin = 0,
+            dmax = 0;
+        AddBoxDistances(p[0], minR, maxR, dmin, dmax);
+        AddBoxDistances(p[1], minG, maxG, dmin, dmax);
+        AddBoxDistances(p[2], minB, maxB, dmin, dmax);
+
+        minDist[i] = dmin;
+        if ( dmax < minMaxDist )
+            minMaxDist = dmax;
+    }
+
+    unsigned char candidates[256];
+    int numCandidates = 0;
+    for ( int i = 0; i < m_numColours; i++ )
+    {
+        if ( minDist[i] <= minMaxDist )
+            candidates[numCandidates++] = static_cast<unsigned char>(i);
+    }
+
+    // Now find the nearest candidate for the centre of each cell.
+    for ( int i0 = 0; i0 < 4; i0++ )
+    {
+        const int r = minR + 8*i0 + 4;
+        for ( int i1 = 0; i1 < 4; i1++ )
+        {
+            const int g = minG + 4*i1 + 2;
+            for ( int i2 = 0; i2 < 4; i2++ )
+            {
+                const int b = minB + 8*i2 + 4;
+
+                int best = candidates[0];
+                int bestDist = INT_MAX;
+                for ( int n = 0; n < numCandidates; n++ )
+                {
+                    const unsigned char* const p = m_palette + 3*candidates[n];
+                    const int dr = p[0] - r,
+                              dg = p[1] - g,
+                              db = p[2] - b;
+                    const int dist = dr*dr + dg*dg + db*db;
+                    if ( dist < bestDist )
+                    {
+                        bestDist = dist;
+                        best = candidates[n];
+                    }
+                }
+
+                const int key = (((c0 & ~3) + i0) << 11) |
+                                (((c1 & ~3) + i1) << 5) |
+                                 ((c2 & ~3) + i2);
+                m_cache[key] = static_cast<wxInt16>(best);
+            }
+        }
+    }
+}
+
+inline unsigned char wxFastQuantizer::FindNearest(int r, int g, int b)
+{
+    const int c0 = r >> 3,
+              c1 = g >> 2,
+              c2 = b >> 3;
+    const int key = (c0 << 11) | (c1 << 5) | c2;
+
+    int index = m_cache[key];
+    if ( index == -1 )
+    {
+        FillCacheBlock(c0, c1, c2);
+        index = m_cache[key];
+    }
+
+    return static_cast<unsigned char>(index);
+}
+
+void wxFastQuantizer::MapRows(unsigned w, unsigned h,
+                              unsigned char **in_rows, unsigned char **out_rows,
+                              bool dither)
+{
+    if ( !dither )
+    {
+        for ( unsigned y = 0; y < h; y++ )
+        {
+            const unsigned char *in = in_rows[y];
+            unsigned char *out = out_rows[y];
+            for ( unsigned x = 0; x < w; x++, in += 3 )
+                out[x] = FindNearest(in[0], in[1], in[2]);
+        }
+
+        return;
+    }
+
+    // Floyd-Steinberg dithering with serpentine scanning, done in the same
+    // way as in pass2_fs_dither() above: the errors for the next row are
+    // stored multiplied by 16 in an array with an extra pixel on both sides,
+    // while the errors propagated along the current row are kept in local
+    // variables.
+    std::vector<int> errors(3*(w + 2), 0);
+
+    // Use a local pointer to allow the compiler to keep it in a register, as
+    // it can't know that writing to the output doesn't modify m_palette.
+    const unsigned char* const palette = m_palette;
+
+    for ( unsigned y = 0; y < h; y++ )
+    {
+        const unsigned char *in;
+        unsigned char *out;
+        int *errorptr;
+        int dir;
+        if ( y % 2 == 0 )
+        {
+            in = in_rows[y];
+            out = out_rows[y];
+            errorptr = &errors[0];
+            dir = 1;
+        }
+        else
+        {
+            in = in_rows[y] + 3*(w - 1);
+            out = out_rows[y] + w - 1;
+            errorptr = &errors[3*(w + 1)];
+            dir = -1;
+        }
+
+        const int dir3 = 3*dir;
+
+        int cur0 = 0, cur1 = 0, cur2 = 0;
+        int belowerr0 = 0, belowerr1 = 0, belowerr2 = 0;
+        int bpreverr0 = 0, bpreverr1 = 0, bpreverr2 = 0;
+
+        for ( unsigned n = 0; n < w; n++ )
+        {
+            cur0 = ClampSample(RIGHT_SHIFT(cur0 + errorptr[dir3 + 0] + 8, 4) + in[0]);
+            cur1 = ClampSample(RIGHT_SHIFT(cur1 + errorptr[dir3 + 1] + 8, 4) + in[1]);
+            cur2 = ClampSample(RIGHT_SHIFT(cur2 + errorptr[dir3 + 2] + 8, 4) + in[2]);
+
+            const unsigned char index = FindNearest(cur0, cur1, cur2);
+            *out = index;
+
+            // Distribute the error: 7/16 to the next pixel in this row and
+            // 3/16, 5/16 and 1/16 to the pixels below.
+            const unsigned char* const p = palette + 3*index;
+            const int err0 = cur0 - p[0],
+                      err1 = cur1 - p[1],
+                      err2 = cur2 - p[2];
+
+            errorptr[0] = bpreverr0 + 3*err0;
+            errorptr[1] = bpreverr1 + 3*err1;
+            errorptr[2] = bpreverr2 + 3*err2;
+            bpreverr0 = belowerr0 + 5*err0;
+            bpreverr1 = belowerr1 + 5*err1;
+            bpreverr2 = belowerr2 + 5*err2;
+            belowerr0 = err0;
+            belowerr1 = err1;
+            belowerr2 = err2;
+            cur0 = 7*err0;
+            cur1 = 7*err1;
+            cur2 = 7*err2;
+
+            in += dir3;
+            out += dir;
+            errorptr += dir3;
+        }
+
+        errorptr[0] = bpreverr0;
+        errorptr[1] = bpreverr1;
+        errorptr[2] = bpreverr2;
+    }
+}
+
+} // anonymous namespace
+
 /*
  * wxQuantize
  */
@@ -1422,6 +1930,23 @@ wxIMPLEMENT_DYNAMIC_CLASS(wxQuantize, wxObject);
 void wxQuantize::DoQuantize(unsigned w, unsigned h, unsigned char **in_rows, unsigned char **out_rows,
     unsigned char *palette, int desiredNoColours)
 {
+    DoQuantize(w, h, in_rows, out_rows, palette, desiredNoColours, 0);
+}
+
+void wxQuantize::DoQuantize(unsigned w, unsigned h, unsigned char **in_rows, unsigned char **out_rows,
+    unsigned char *palette, int desiredNoColours, int flags)
+{
+    const bool dither = !(flags & wxQUANTIZE_NO_DITHERING);
+
+    if (flags & wxQUANTIZE_FAST)
+    {
+        wxFastQuantizer quantizer(desiredNoColours);
+        quantizer.AddRows(w, h, in_rows);
+        quantizer.BuildPalette(palette);
+        quantizer.MapRows(w, h, in_rows, out_rows, dither);
+        return;
+    }
+
     j_decompress dec;
     my_cquantize_ptr cquantize;
 
@@ -1431,6 +1956,7 @@ void wxQuantize::DoQuantize(unsigned w, unsigned h, unsigned char **in_rows, uns
     prepare_range_limit_table(&dec);
     jinit_2pass_quantizer(&dec);
     cquantize = (my_cquantize_ptr) dec.cquantize;
+    cquantize->dither = dither;
 
 
     cquantize->pub.start_pass(&dec, true);
@@ -1507,7 +2033,7 @@ bool wxQuantize::Quantize(const wxImage& src, wxImage& dest,
         outrows[i] = data8bit + w * i;
 
     //RGB->palette
-    DoQuantize(w, h, rows, outrows, palette, desiredNoColours);
+    DoQuantize(w, h, rows, outrows, palette, desiredNoColours, flags);
 
     delete[] rows;
     delete[] outrows;
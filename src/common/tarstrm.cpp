@@ -22,6 +22,7 @@
 
 #include "wx/buffer.h"
 #include "wx/datetime.h"
+#include "wx/datstrm.h"
 #include "wx/filename.h"
 #include "wx/thread.h"
 
@@ -703,6 +704,25 @@ wxTarEntry *wxTarInputStream::GetNextEntry()
 }
 
 bool wxTarInputStream::OpenEntry(wxTarEntry& entry)
+{
+    return DoOpenEntry(entry);
+}
+
+bool wxTarInputStream::OpenEntry(const wxTarIndex& index,
+                                 const wxString& name,
+                                 wxPathFormat format /*=wxPATH_NATIVE*/)
+{
+    const wxTarEntry *entry = index.Find(name, format);
+
+    if (!entry) {
+        m_lasterror = wxSTREAM_READ_ERROR;
+        return false;
+    }
+
+    return DoOpenEntry(*entry);
+}
+
+bool wxTarInputStream::DoOpenEntry(const wxTarEntry& entry)
 {
     wxFileOffset offset = entry.GetOffset();
 
@@ -1029,6 +1049,232 @@ size_t wxTarInputStream::OnSysRead(void *buffer, size_t size)
 }
 
 
+/////////////////////////////////////////////////////////////////////////////
+// Index
+
+// The index file starts with this signature followed by the format version
+// and ends with it too, to detect truncated files
+static const char TARINDEX_MAGIC[] = "wxTARIDX";
+static const wxUint32 TARINDEX_VERSION = 2;
+
+static void WriteIndexDate(wxDataOutputStream& ds, const wxDateTime& dt)
+{
+    ds.Write8(dt.IsValid());
+    ds.Write64(dt.IsValid() ? wxUint64(dt.GetValue().GetValue()) : 0);
+}
+
+static wxDateTime ReadIndexDate(wxDataInputStream& ds)
+{
+    bool valid = ds.Read8() != 0;
+    wxLongLong value = static_cast<wxLongLong_t>(ds.Read64());
+    return valid ? wxDateTime(value) : wxDateTime();
+}
+
+// Read the header block of the given entry, which immediately precedes its
+// data, from a seekable stream, restoring the stream position afterwards
+static bool ReadIndexHeader(wxInputStream& stream,
+                            const wxTarEntry& entry,
+                            std::vector<char>& header)
+{
+    if (!stream.IsSeekable())
+        return false;
+
+    const wxFileOffset pos = stream.TellI();
+    const wxFileOffset offset = entry.GetOffset() - TAR_BLOCKSIZE;
+
+    header.resize(TAR_BLOCKSIZE);
+    bool ok = offset >= 0 && stream.SeekI(offset) == offset &&
+              stream.ReadAll(header.data(), header.size());
+
+    stream.Reset();
+    if (stream.SeekI(pos) != pos)
+        ok = false;
+
+    if (!ok)
+        header.clear();
+
+    return ok;
+}
+
+void wxTarIndex::Clear()
+{
+    m_entries.clear();
+    m_byName.clear();
+    m_archiveSize = wxInvalidOffset;
+    m_lastHeader.clear();
+}
+
+void wxTarIndex::Add(const wxTarEntry& entry)
+{
+    m_byName[entry.GetInternalName()] = m_entries.size();
+    m_entries.push_back(entry);
+}
+
+const wxTarEntry *wxTarIndex::Find(const wxString& name,
+                                   wxPathFormat format /*=wxPATH_NATIVE*/) const
+{
+    const auto it = m_byName.find(wxTarEntry::GetInternalName(name, format));
+
+    return it != m_byName.end() ? &m_entries[it->second] : nullptr;
+}
+
+bool wxTarIndex::Build(wxInputStream& stream,
+                       wxMBConv& conv /*=wxConvLocal*/)
+{
+    Clear();
+
+    wxTarInputStream tar(stream, conv);
+    wxTarEntry *entry;
+
+    // on seekable streams this only reads the headers, as the data of each
+    // entry is skipped over by seeking
+    while ((entry = tar.GetNextEntry()) != nullptr) {
+        Add(*entry);
+        delete entry;
+    }
+
+    if (tar.GetLastError() != wxSTREAM_EOF) {
+        Clear();
+        return false;
+    }
+
+    m_archiveSize = stream.GetLength();
+
+    // remember the header of the last entry to be able to detect if the
+    // archive was modified later, see IsUpToDate()
+    if (!m_entries.empty())
+        ReadIndexHeader(stream, m_entries.back(), m_lastHeader);
+
+    return true;
+}
+
+bool wxTarIndex::IsUpToDate(wxInputStream& stream) const
+{
+    // an index can't be checked against an archive of unknown size, so it
+    // must not be used for it
+    const wxFileOffset size = stream.GetLength();
+    if (size == wxInvalidOffset || size != m_archiveSize)
+        return false;
+
+    if (m_entries.empty())
+        return true;
+
+    std::vector<char> header;
+    return !m_lastHeader.empty() &&
+           ReadIndexHeader(stream, m_entries.back(), header) &&
+           header == m_lastHeader;
+}
+
+bool wxTarIndex::Save(wxOutputStream& stream) const
+{
+    wxDataOutputStream ds(stream);
+
+    stream.Write(TARINDEX_MAGIC, strlen(TARINDEX_MAGIC));
+    ds.Write32(TARINDEX_VERSION);
+    ds.Write64(wxUint64(m_archiveSize));
+    ds.Write32(wxUint32(m_lastHeader.size()));
+    stream.Write(m_lastHeader.data(), m_lastHeader.size());
+    ds.Write32(wxUint32(m_entries.size()));
+
+    for (const wxTarEntry& entry : m_entries) {
+        ds.WriteString(entry.GetInternalName());
+        ds.Write64(wxUint64(entry.GetOffset()));
+        ds.Write64(wxUint64(entry.GetSize()));
+        ds.Write32(entry.m_Mode);
+        ds.Write8(entry.m_IsModeSet);
+        ds.Write32(entry.GetUserId());
+        ds.Write32(entry.GetGroupId());
+        ds.Write8(entry.GetTypeFlag());
+        WriteIndexDate(ds, entry.GetDateTime());
+        WriteIndexDate(ds, entry.GetAccessTime());
+        WriteIndexDate(ds, entry.GetCreateTime());
+        ds.WriteString(entry.GetLinkName());
+        ds.WriteString(entry.GetUserName());
+        ds.WriteString(entry.GetGroupName());
+        ds.Write32(entry.GetDevMajor());
+        ds.Write32(entry.GetDevMinor());
+    }
+
+    stream.Write(TARINDEX_MAGIC, strlen(TARINDEX_MAGIC));
+
+    return stream.IsOk();
+}
+
+bool wxTarIndex::Load(wxInputStream& stream,
+                      wxFileOffset archiveSize /*=wxInvalidOffset*/)
+{
+    Clear();
+
+    char magic[sizeof(TARINDEX_MAGIC) - 1];
+    if (!stream.ReadAll(magic, sizeof(magic)) ||
+            memcmp(magic, TARINDEX_MAGIC, sizeof(magic)) != 0) {
+        wxLogError(_("invalid tar index"));
+        return false;
+    }
+
+    wxDataInputStream ds(stream);
+
+    if (ds.Read32() != TARINDEX_VERSION) {
+        wxLogError(_("unsupported tar index version"));
+        return false;
+    }
+
+    wxFileOffset indexedSize = wxFileOffset(ds.Read64());
+    if (archiveSize != wxInvalidOffset && indexedSize != wxInvalidOffset &&
+            archiveSize != indexedSize)
+        return false;
+
+    wxUint32 headerSize = ds.Read32();
+    if (headerSize != 0 && headerSize != TAR_BLOCKSIZE) {
+        wxLogError(_("invalid tar index"));
+        return false;
+    }
+
+    std::vector<char> lastHeader(headerSize);
+    if (headerSize && !stream.ReadAll(lastHeader.data(), headerSize)) {
+        wxLogError(_("incomplete tar index"));
+        return false;
+    }
+
+    wxUint32 count = ds.Read32();
+
+    for (wxUint32 n = 0; n < count && stream.IsOk(); n++) {
+        wxTarEntry entry;
+
+        entry.m_Name = ds.ReadString();
+        entry.SetOffset(wxFileOffset(ds.Read64()));
+        entry.SetSize(wxFileOffset(ds.Read64()));
+        entry.m_Mode = ds.Read32();
+        entry.m_IsModeSet = ds.Read8() != 0;
+        entry.SetUserId(ds.Read32());
+        entry.SetGroupId(ds.Read32());
+        entry.SetTypeFlag(ds.Read8());
+        entry.SetDateTime(ReadIndexDate(ds));
+        entry.SetAccessTime(ReadIndexDate(ds));
+        entry.SetCreateTime(ReadIndexDate(ds));
+        entry.SetLinkName(ds.ReadString());
+        entry.SetUserName(ds.ReadString());
+        entry.SetGroupName(ds.ReadString());
+        entry.SetDevMajor(ds.Read32());
+        entry.SetDevMinor(ds.Read32());
+
+        Add(entry);
+    }
+
+    if (!stream.ReadAll(magic, sizeof(magic)) ||
+            memcmp(magic, TARINDEX_MAGIC, sizeof(magic)) != 0) {
+        wxLogError(_("incomplete tar index"));
+        Clear();
+        return false;
+    }
+
+    m_archiveSize = indexedSize;
+    m_lastHeader.swap(lastHeader);
+
+    return true;
+}
+
+
 /////////////////////////////////////////////////////////////////////////////
 // Output stream
 
@@ -0,0 +1,208 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        src/common/tilecache.cpp
+// Purpose:     wxTileCache implementation
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ============================================================================
+// declarations
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+// for compilers that support precompilation, includes "wx/wx.h".
+#include "wx/wxprec.h"
+
+#ifndef WX_PRECOMP
+    #include "wx/dcmemory.h"
+    #include "wx/region.h"
+    #include "wx/window.h"
+#endif
+
+#include "wx/tilecache.h"
+
+#include <algorithm>
+#include <vector>
+
+// ============================================================================
+// implementation
+// ============================================================================
+
+namespace
+{
+
+// Division rounding towards negative infinity, as logical coordinates may be
+// negative.
+inline int FloorDiv(int a, int b)
+{
+    return a >= 0 ? a / b : -((b - 1 - a) / b);
+}
+
+} // anonymous namespace
+
+wxTileCache::wxTileCache(const wxSize& tileSize, size_t maxTiles)
+    : m_tileSize(tileSize),
+      m_maxTiles(maxTiles),
+      m_scale(0.0),
+      m_paintCounter(0)
+{
+    wxASSERT_MSG( tileSize.x > 0 && tileSize.y > 0, "Invalid tile size" );
+}
+
+wxTileCache::~wxTileCache() = default;
+
+void wxTileCache::SetTileSize(const wxSize& tileSize)
+{
+    wxCHECK_RET( tileSize.x > 0 && tileSize.y > 0, "Invalid tile size" );
+
+    if ( tileSize != m_tileSize )
+    {
+        m_tileSize = tileSize;
+
+        Clear();
+    }
+}
+
+void wxTileCache::SetMaxTiles(size_t maxTiles)
+{
+    m_maxTiles = maxTiles;
+
+    DiscardUnusedTiles();
+}
+
+wxRect wxTileCache::GetTileRect(TileKey key) const
+{
+    const int col = static_cast<wxInt32>(key >> 32);
+    const int row = static_cast<wxInt32>(key & 0xffffffff);
+
+    return wxRect(wxPoint(col*m_tileSize.x, row*m_tileSize.y), m_tileSize);
+}
+
+void wxTileCache::Invalidate(const wxRect& rect)
+{
+    for ( auto& kv : m_tiles )
+    {
+        const wxRect r = GetTileRect(kv.first).Intersect(rect);
+        if ( !r.IsEmpty() )
+            kv.second.dirty.Union(r);
+    }
+}
+
+void wxTileCache::InvalidateAll()
+{
+    for ( auto& kv : m_tiles )
+        kv.second.dirty = GetTileRect(kv.first);
+}
+
+void wxTileCache::Clear()
+{
+    m_tiles.clear();
+}
+
+void wxTileCache::Paint(wxDC& dc, const wxRect& rect)
+{
+    if ( rect.IsEmpty() )
+        return;
+
+    // The existing tiles can't be used any more if the DC scale has changed,
+    // e.g. because the window was moved to another display.
+    const double scale = dc.GetContentScaleFactor();
+    if ( scale != m_scale )
+    {
+        Clear();
+
+        m_scale = scale;
+    }
+
+    m_paintCounter++;
+
+    const int colFirst = FloorDiv(rect.x, m_tileSize.x),
+              colLast = FloorDiv(rect.GetRight(), m_tileSize.x),
+              rowFirst = FloorDiv(rect.y, m_tileSize.y),
+              rowLast = FloorDiv(rect.GetBottom(), m_tileSize.y);
+
+    for ( int row = rowFirst; row <= rowLast; row++ )
+    {
+        for ( int col = colFirst; col <= colLast; col++ )
+        {
+            const TileKey key = MakeKey(col, row);
+            const wxRect tileRect = GetTileRect(key);
+
+            Tile& tile = m_tiles[key];
+            if ( !tile.bitmap.IsOk() )
+            {
+                if ( !tile.bitmap.CreateWithLogicalSize(m_tileSize, scale) )
+                {
+                    m_tiles.erase(key);
+                    continue;
+                }
+
+                tile.dirty = tileRect;
+            }
+
+            tile.lastUsed = m_paintCounter;
+
+            wxMemoryDC memDC(tile.bitmap);
+            memDC.SetLogicalOrigin(tileRect.x, tileRect.y);
+
+            if ( !tile.dirty.IsEmpty() )
+            {
+                memDC.CopyAttributes(dc);
+
+                {
+                    wxDCClipper clip(memDC, tile.dirty);
+                    DrawTile(memDC, tile.dirty);
+                }
+
+                tile.dirty = wxRect();
+
+                // Reset the origin in case DrawTile() changed it.
+                memDC.SetLogicalOrigin(tileRect.x, tileRect.y);
+            }
+
+            const wxRect r = tileRect.Intersect(rect);
+            dc.Blit(r.GetPosition(), r.GetSize(), &memDC, r.GetPosition());
+        }
+    }
+
+    DiscardUnusedTiles();
+}
+
+void wxTileCache::PaintUpdateRegion(wxDC& dc, const wxWindow* window)
+{
+    wxCHECK_RET( window, "must have a window" );
+
+    for ( wxRegionIterator it(window->GetUpdateRegion()); it; ++it )
+    {
+        const wxRect r = it.GetRect();
+        Paint(dc, wxRect(dc.DeviceToLogical(r.GetTopLeft()),
+                         dc.DeviceToLogical(r.GetBottomRight())));
+    }
+}
+
+void wxTileCache::DiscardUnusedTiles()
+{
+    if ( m_tiles.size() <= m_maxTiles )
+        return;
+
+    // Find the tiles used least recently, but never discard the tiles used by
+    // the current paint operation.
+    std::vector< std::pair<unsigned long, TileKey> > tiles;
+    tiles.reserve(m_tiles.size());
+    for ( const auto& kv : m_tiles )
+    {
+        if ( kv.second.lastUsed != m_paintCounter )
+            tiles.push_back(std::make_pair(kv.second.lastUsed, kv.first));
+    }
+
+    const size_t numToDiscard = wxMin(m_tiles.size() - m_maxTiles, tiles.size());
+    std::nth_element(tiles.begin(), tiles.begin() + numToDiscard, tiles.end());
+
+    for ( size_t n = 0; n < numToDiscard; n++ )
+        m_tiles.erase(tiles[n].second);
+}
@@ -679,6 +679,28 @@ long wxExecute(const wxString& command,
     return wxDoExecuteWithCapture(command, output, &error, flags, env);
 }
 
+#ifndef __UNIX__
+
+// Unix version is more efficient and is implemented in utilsunx.cpp.
+std::vector<long>
+wxExecuteBatch(const wxArrayString& commands,
+               int flags,
+               const wxExecuteEnv *env)
+{
+    wxCHECK_MSG( !(flags & wxEXEC_SYNC), std::vector<long>(),
+                 wxS("wxExecuteBatch() only supports asynchronous execution") );
+
+    std::vector<long> pids;
+    pids.reserve(commands.size());
+
+    for ( const wxString& command : commands )
+        pids.push_back(wxExecute(command, flags, nullptr, env));
+
+    return pids;
+}
+
+#endif // !__UNIX__
+
 // ----------------------------------------------------------------------------
 // Id functions
 // ----------------------------------------------------------------------------
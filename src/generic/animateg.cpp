@@ -387,6 +387,7 @@ bool wxGenericAnimationCtrl::RebuildBackingStoreUpToFrame(unsigned int frame)
     }
 
     // finally draw this frame
+    SaveAreaUnderFrame(dc, frame);
     DrawFrame(dc, frame);
 
     return true;
@@ -428,6 +429,13 @@ void wxGenericAnimationCtrl::IncrementalUpdateBackingStore()
                 // the best we can do is to restore to background
                 DisposeToBackground(dc);
             }
+            else if (m_bmpUnderFrame.IsOk())
+            {
+                // we saved the area covered by the previous frame before
+                // drawing it, so just restore it
+                dc.DrawBitmap(m_bmpUnderFrame,
+                              AnimationImplGetFramePosition(m_currentFrame-1));
+            }
             else
                 if (!RebuildBackingStoreUpToFrame(m_currentFrame-2))
                     Stop();
@@ -440,6 +448,7 @@ void wxGenericAnimationCtrl::IncrementalUpdateBackingStore()
     }
 
     // now just draw the current frame on the top of the backing store
+    SaveAreaUnderFrame(dc, m_currentFrame);
     DrawFrame(dc, m_currentFrame);
 }
 
@@ -492,6 +501,23 @@ void wxGenericAnimationCtrl::DrawFrame(wxDC &dc, unsigned int frame)
                   true /* use mask */);
 }
 
+void wxGenericAnimationCtrl::SaveAreaUnderFrame(wxDC& dc, unsigned int frame)
+{
+    const wxSize sz = AnimationImplGetFrameSize(frame);
+    if ( AnimationImplGetDisposalMethod(frame) != wxANIM_TOPREVIOUS ||
+            sz.x <= 0 || sz.y <= 0 )
+    {
+        m_bmpUnderFrame = wxNullBitmap;
+        return;
+    }
+
+    if ( !m_bmpUnderFrame.IsOk() || m_bmpUnderFrame.GetSize() != sz )
+        m_bmpUnderFrame.Create(sz);
+
+    wxMemoryDC dcSave(m_bmpUnderFrame);
+    dcSave.Blit(wxPoint(0, 0), sz, &dc, AnimationImplGetFramePosition(frame));
+}
+
 void wxGenericAnimationCtrl::DrawCurrentFrame(wxDC& dc)
 {
     wxASSERT( m_backingStore.IsOk() );
@@ -77,6 +77,7 @@ wxGCC_WARNING_RESTORE(cast-qual)
 
 #ifndef WX_PRECOMP
     #include "wx/utils.h"                   // Only for wxMin()
+    #include "wx/module.h"
 #endif // WX_PRECOMP
 
 #include "wx/bmpbndl.h"
@@ -88,9 +89,30 @@ wxGCC_WARNING_RESTORE(cast-qual)
     #define wxNO_SVG_FILE
 #endif
 #include "wx/rawbmp.h"
+#if wxUSE_THREADS
+    #include "wx/thread.h"
+#endif
 
 #include "wx/private/bmpbndl.h"
 
+#include <algorithm>
+#include <atomic>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+// constants
+// ----------------------------------------------------------------------------
+
+// Number of the most recently used bitmaps of different sizes kept by each
+// bundle.
+static const size_t wxSVG_BUNDLE_CACHE_SIZE = 4;
+
+// Default maximal size of the global cache.
+static const size_t wxSVG_DEFAULT_CACHE_LIMIT = 16*1024*1024;
+
 // ----------------------------------------------------------------------------
 // private helpers
 // ----------------------------------------------------------------------------
@@ -98,13 +120,203 @@ wxGCC_WARNING_RESTORE(cast-qual)
 namespace
 {
 
+// Identifies the bitmap rasterized from the given document at the given size.
+struct wxSVGCacheKey
+{
+    wxUint64 docHash;
+
+    // The document itself: different documents may have the same hash, so it
+    // is compared too if the hashes are equal.
+    wxCharBuffer doc;
+
+    wxSize size;
+
+    bool operator==(const wxSVGCacheKey& other) const
+    {
+        if ( docHash != other.docHash || size != other.size )
+            return false;
+
+        // Bitmaps of the same bundle share the same buffer, so avoid comparing
+        // the contents in this common case.
+        return doc.data() == other.doc.data() ||
+                (doc.length() == other.doc.length() &&
+                    memcmp(doc.data(), other.doc.data(), doc.length()) == 0);
+    }
+};
+
+struct wxSVGCacheKeyHash
+{
+    size_t operator()(const wxSVGCacheKey& key) const
+    {
+        wxUint64 h = key.docHash;
+        h ^= (static_cast<wxUint64>(key.size.x) << 32) ^ key.size.y;
+        h *= 0x9e3779b97f4a7c15ULL;
+        return static_cast<size_t>(h ^ (h >> 32));
+    }
+};
+
+// Global cache of the rasterized bitmaps, shared by all SVG bundles, which
+// keeps the most recently used bitmaps up to the given total size.
+//
+// Note that it is only used from the main thread, as bitmaps are anyhow not
+// supposed to be used from the other ones.
+class wxSVGRasterCache
+{
+public:
+    static wxSVGRasterCache& Get()
+    {
+        if ( !ms_instance )
+            ms_instance = new wxSVGRasterCache();
+
+        return *ms_instance;
+    }
+
+    static void Destroy()
+    {
+        delete ms_instance;
+        ms_instance = nullptr;
+    }
+
+    // Return the cached bitmap or invalid bitmap if not found.
+    wxBitmap Find(const wxSVGCacheKey& key)
+    {
+        const auto it = m_index.find(key);
+        if ( it == m_index.end() )
+        {
+            m_stats.misses++;
+            return wxBitmap();
+        }
+
+        m_stats.hits++;
+
+        // Move the entry to the front of the list as it's now the most
+        // recently used one.
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+
+        return it->second->second;
+    }
+
+    void Add(const wxSVGCacheKey& key, const wxBitmap& bitmap)
+    {
+        // Rasterizing may fail, e.g. if the bitmap is too big.
+        if ( !bitmap.IsOk() )
+            return;
+
+        const size_t bytes = GetBitmapBytes(bitmap);
+        if ( bytes > m_limit )
+            return;
+
+        m_entries.emplace_front(key, bitmap);
+        m_index[key] = m_entries.begin();
+        m_stats.count++;
+        m_stats.bytes += bytes;
+
+        Trim();
+    }
+
+    // Check if the bitmap is in the cache without affecting anything.
+    bool Contains(const wxSVGCacheKey& key) const
+    {
+        return m_index.count(key) != 0;
+    }
+
+    // Used by the bundles to record finding the bitmap in their own cache.
+    void AddHit()
+    {
+        m_stats.hits++;
+    }
+
+    void SetLimit(size_t bytes)
+    {
+        m_limit = bytes;
+
+        Trim();
+    }
+
+    void Clear()
+    {
+        m_entries.clear();
+        m_index.clear();
+        m_stats = wxBitmapBundle::SVGCacheStats();
+    }
+
+    const wxBitmapBundle::SVGCacheStats& GetStats() const
+    {
+        return m_stats;
+    }
+
+private:
+    wxSVGRasterCache()
+        : m_limit(wxSVG_DEFAULT_CACHE_LIMIT)
+    {
+    }
+
+    static size_t GetBitmapBytes(const wxBitmap& bitmap)
+    {
+        return static_cast<size_t>(bitmap.GetWidth())*bitmap.GetHeight()*4;
+    }
+
+    // Remove the least recently used bitmaps until we're under the limit.
+    void Trim()
+    {
+        while ( m_stats.bytes > m_limit )
+        {
+            const Entry& entry = m_entries.back();
+
+            m_stats.bytes -= GetBitmapBytes(entry.second);
+            m_stats.count--;
+
+            m_index.erase(entry.first);
+            m_entries.pop_back();
+        }
+    }
+
+    using Entry = std::pair<wxSVGCacheKey, wxBitmap>;
+    using Entries = std::list<Entry>;
+
+    // The entries in the most recently used first order.
+    Entries m_entries;
+
+    std::unordered_map<wxSVGCacheKey, Entries::iterator, wxSVGCacheKeyHash>
+        m_index;
+
+    size_t m_limit;
+
+    wxBitmapBundle::SVGCacheStats m_stats;
+
+    static wxSVGRasterCache* ms_instance;
+
+    wxDECLARE_NO_COPY_CLASS(wxSVGRasterCache);
+};
+
+wxSVGRasterCache* wxSVGRasterCache::ms_instance = nullptr;
+
+// Compute the hash identifying the SVG document contents.
+wxUint64 wxHashSVGDocument(const char* data, size_t len)
+{
+    // Use 64-bit FNV-1a hash, which is good enough for our purposes.
+    wxUint64 h = 0xcbf29ce484222325ULL ^ len;
+    for ( size_t n = 0; n < len; n++ )
+    {
+        h ^= static_cast<unsigned char>(data[n]);
+        h *= 0x100000001b3ULL;
+    }
+
+    return h;
+}
+
 class wxBitmapBundleImplSVG : public wxBitmapBundleImpl
 {
 public:
     // Ctor must be passed a valid NSVGimage and takes ownership of it.
-    wxBitmapBundleImplSVG(NSVGimage* svgImage, const wxSize& sizeDef)
+    wxBitmapBundleImplSVG(NSVGimage* svgImage,
+                          wxUint64 docHash,
+                          const wxCharBuffer& doc,
+                          const wxSize& sizeDef)
         : m_svgImage(svgImage),
           m_svgRasterizer(nsvgCreateRasterizer()),
+          m_docHash(docHash),
+          m_doc(doc),
           m_sizeDef(sizeDef)
     {
     }
@@ -119,22 +331,53 @@ public:
     virtual wxSize GetPreferredBitmapSizeAtScale(double scale) const override;
     virtual wxBitmap GetBitmap(const wxSize& size) override;
 
+    // Return the key of the bitmap of the given size in the global cache.
+    wxSVGCacheKey GetCacheKey(const wxSize& size) const
+    {
+        return wxSVGCacheKey{m_docHash, m_doc, size};
+    }
+
+    // Check if the bitmap of this size is in this bundle own cache.
+    bool HasCachedBitmap(const wxSize& size) const;
+
+    // Add the bitmap to this bundle own cache as the most recently used one.
+    void AddCachedBitmap(const wxBitmap& bitmap);
+
+    // Rasterize the image at the given size into the provided buffer of
+    // size.x*size.y RGBA pixels using the given rasterizer.
+    //
+    // This function may be called from any thread, as long as each thread
+    // uses its own rasterizer.
+    void RasterizeInto(NSVGrasterizer* rasterizer,
+                       const wxSize& size,
+                       unsigned char* buffer) const;
+
+    // Create the bitmap from the buffer filled by RasterizeInto(), this can
+    // only be done from the main thread.
+    static wxBitmap BitmapFromRGBA(const unsigned char* buffer,
+                                   const wxSize& size);
+
 private:
     wxBitmap DoRasterize(const wxSize& size);
 
     NSVGimage* const m_svgImage;
     NSVGrasterizer* const m_svgRasterizer;
 
+    // Hash and contents of the SVG document used as key in the global cache.
+    const wxUint64 m_docHash;
+    const wxCharBuffer m_doc;
+
     const wxSize m_sizeDef;
 
-    // Cache the last used bitmap (may be invalid if not used yet).
+    // Cache the last few used bitmaps, most recently used first.
     //
-    // Note that we cache only the last bitmap and not all the bitmaps ever
+    // Note that we cache only a few bitmaps and not all the bitmaps ever
     // requested from GetBitmap() for the different sizes because there would
     // be no way to clear such cache and its growth could be unbounded,
     // resulting in too many bitmap objects being used in an application using
-    // SVG for all of its icons.
-    wxBitmap m_cachedBitmap;
+    // SVG for all of its icons. The global cache, which is bounded, is used
+    // for all the other ones.
+    std::vector<wxBitmap> m_cachedBitmaps;
 
     wxDECLARE_NO_COPY_CLASS(wxBitmapBundleImplSVG);
 };
@@ -158,20 +401,70 @@ wxSize wxBitmapBundleImplSVG::GetPreferredBitmapSizeAtScale(double scale) const
 
 wxBitmap wxBitmapBundleImplSVG::GetBitmap(const wxSize& size)
 {
-    if ( !m_cachedBitmap.IsOk() || m_cachedBitmap.GetSize() != size )
+    wxSVGRasterCache& cache = wxSVGRasterCache::Get();
+
+    for ( size_t n = 0; n < m_cachedBitmaps.size(); n++ )
     {
-        m_cachedBitmap = DoRasterize(size);
+        if ( m_cachedBitmaps[n].GetSize() == size )
+        {
+            // Make it the most recently used one.
+            std::rotate(m_cachedBitmaps.begin(),
+                        m_cachedBitmaps.begin() + n,
+                        m_cachedBitmaps.begin() + n + 1);
+
+            cache.AddHit();
+
+            return m_cachedBitmaps[0];
+        }
+    }
+
+    const wxSVGCacheKey key = GetCacheKey(size);
+
+    wxBitmap bitmap = cache.Find(key);
+    if ( !bitmap.IsOk() )
+    {
+        bitmap = DoRasterize(size);
+        cache.Add(key, bitmap);
     }
 
-    return m_cachedBitmap;
+    AddCachedBitmap(bitmap);
+
+    return bitmap;
+}
+
+bool wxBitmapBundleImplSVG::HasCachedBitmap(const wxSize& size) const
+{
+    for ( const wxBitmap& bitmap : m_cachedBitmaps )
+    {
+        if ( bitmap.GetSize() == size )
+            return true;
+    }
+
+    return false;
+}
+
+void wxBitmapBundleImplSVG::AddCachedBitmap(const wxBitmap& bitmap)
+{
+    if ( m_cachedBitmaps.size() == wxSVG_BUNDLE_CACHE_SIZE )
+        m_cachedBitmaps.pop_back();
+    m_cachedBitmaps.insert(m_cachedBitmaps.begin(), bitmap);
 }
 
 wxBitmap wxBitmapBundleImplSVG::DoRasterize(const wxSize& size)
 {
     wxVector<unsigned char> buffer(size.x*size.y*4);
+    RasterizeInto(m_svgRasterizer, size, &buffer[0]);
+
+    return BitmapFromRGBA(&buffer[0], size);
+}
+
+void wxBitmapBundleImplSVG::RasterizeInto(NSVGrasterizer* rasterizer,
+                                          const wxSize& size,
+                                          unsigned char* buffer) const
+{
     nsvgRasterize
     (
-        m_svgRasterizer,
+        rasterizer,
         m_svgImage,
         0.0, 0.0,           // no offset
         wxMin
@@ -179,16 +472,22 @@ wxBitmap wxBitmapBundleImplSVG::DoRasterize(const wxSize& size)
             size.x/m_svgImage->width,
             size.y/m_svgImage->height
         ),                  // scale
-        &buffer[0],
+        buffer,
         size.x, size.y,
         size.x*4            // stride -- we have no gaps between lines
     );
+}
 
+/* static */
+wxBitmap
+wxBitmapBundleImplSVG::BitmapFromRGBA(const unsigned char* buffer,
+                                      const wxSize& size)
+{
     wxBitmap bitmap(size, 32);
     wxAlphaPixelData bmpdata(bitmap);
     wxAlphaPixelData::Iterator dst(bmpdata);
 
-    const unsigned char* src = &buffer[0];
+    const unsigned char* src = buffer;
     for ( int y = 0; y < size.y; ++y )
     {
         dst.MoveTo(bmpdata, 0, y);
@@ -222,9 +521,207 @@ wxBitmap wxBitmapBundleImplSVG::DoRasterize(const wxSize& size)
     return bitmap;
 }
 
+// ----------------------------------------------------------------------------
+// Parallel rasterization
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// A single bitmap to rasterize in wxBitmapBundle::PrerasterizeSVG().
+struct wxSVGRasterTask
+{
+    const wxBitmapBundleImplSVG* impl;
+    wxSize size;
+    std::vector<unsigned char> buffer;
+};
+
+// Perform the tasks not taken by anybody else yet: this is called from all
+// the threads at once, with each of them using its own rasterizer.
+void wxRasterizeSVGTasks(std::vector<wxSVGRasterTask>& tasks,
+                         std::atomic<size_t>& next)
+{
+    NSVGrasterizer* const rasterizer = nsvgCreateRasterizer();
+    if ( !rasterizer )
+        return;
+
+    for ( ;; )
+    {
+        const size_t n = next++;
+        if ( n >= tasks.size() )
+            break;
+
+        wxSVGRasterTask& task = tasks[n];
+        task.buffer.resize(task.size.x*task.size.y*4);
+        task.impl->RasterizeInto(rasterizer, task.size, task.buffer.data());
+    }
+
+    nsvgDeleteRasterizer(rasterizer);
+}
+
+#if wxUSE_THREADS
+
+class wxSVGRasterThread : public wxThread
+{
+public:
+    wxSVGRasterThread(std::vector<wxSVGRasterTask>& tasks,
+                      std::atomic<size_t>& next)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_tasks(tasks),
+          m_next(next)
+    {
+    }
+
+    virtual ExitCode Entry() override
+    {
+        wxRasterizeSVGTasks(m_tasks, m_next);
+
+        return nullptr;
+    }
+
+private:
+    std::vector<wxSVGRasterTask>& m_tasks;
+    std::atomic<size_t>& m_next;
+};
+
+#endif // wxUSE_THREADS
+
+} // anonymous namespace
+
+/* static */
+size_t
+wxBitmapBundle::PrerasterizeSVG(const wxVector<wxBitmapBundle>& bundles,
+                                const wxVector<wxSize>& sizes,
+                                int numThreads)
+{
+    wxSVGRasterCache& cache = wxSVGRasterCache::Get();
+
+    // Find all the bitmaps which are not available yet, taking care to
+    // rasterize the bitmaps for the bundles using the same SVG document only
+    // once.
+    std::vector<wxSVGRasterTask> tasks;
+    std::unordered_map<wxSVGCacheKey, size_t, wxSVGCacheKeyHash> taskIndices;
+
+    // The bundles which need the bitmap created by the task with the given
+    // index.
+    std::vector<std::pair<wxBitmapBundleImplSVG*, size_t>> targets;
+
+    for ( const wxBitmapBundle& bundle : bundles )
+    {
+        // Just ignore all the non-SVG bundles.
+        wxBitmapBundleImplSVG* const
+            impl = dynamic_cast<wxBitmapBundleImplSVG*>(bundle.GetImpl());
+        if ( !impl )
+            continue;
+
+        for ( const wxSize& size : sizes )
+        {
+            if ( impl->HasCachedBitmap(size) )
+                continue;
+
+            // If the bitmap is already in the global cache, GetBitmap() will
+            // find it there.
+            const wxSVGCacheKey key = impl->GetCacheKey(size);
+            if ( cache.Contains(key) )
+                continue;
+
+            const auto res = taskIndices.emplace(key, tasks.size());
+            if ( res.second )
+                tasks.push_back(wxSVGRasterTask{impl, size, {}});
+
+            targets.emplace_back(impl, res.first->second);
+        }
+    }
+
+    // The same bundle could have been given more than once or the same size
+    // could be repeated, but each bitmap must be added to the bundle only
+    // once, as otherwise it could replace the other bitmaps in its cache.
+    std::sort(targets.begin(), targets.end());
+    targets.erase(std::unique(targets.begin(), targets.end()), targets.end());
+
+    if ( tasks.empty() )
+        return 0;
+
+    std::atomic<size_t> next(0);
+
+#if wxUSE_THREADS
+    if ( numThreads <= 0 )
+        numThreads = wxThread::GetCPUCount();
+    if ( static_cast<size_t>(numThreads) > tasks.size() )
+        numThreads = static_cast<int>(tasks.size());
+
+    // The current thread works too, so we need one less extra thread.
+    std::vector<std::unique_ptr<wxSVGRasterThread>> threads;
+    for ( int n = 1; n < numThreads; n++ )
+    {
+        std::unique_ptr<wxSVGRasterThread>
+            thread(new wxSVGRasterThread(tasks, next));
+        if ( thread->Run() != wxTHREAD_NO_ERROR )
+        {
+            // Not fatal, we'll just use fewer threads.
+            break;
+        }
+
+        threads.push_back(std::move(thread));
+    }
+#else // !wxUSE_THREADS
+    wxUnusedVar(numThreads);
+#endif // wxUSE_THREADS/!wxUSE_THREADS
+
+    wxRasterizeSVGTasks(tasks, next);
+
+#if wxUSE_THREADS
+    for ( const auto& thread : threads )
+        thread->Wait();
+#endif // wxUSE_THREADS
+
+    // Now create the bitmaps, which can only be done in the main thread.
+    std::vector<wxBitmap> bitmaps;
+    bitmaps.reserve(tasks.size());
+    for ( wxSVGRasterTask& task : tasks )
+    {
+        // Creating the rasterizer could have failed.
+        if ( task.buffer.empty() )
+        {
+            bitmaps.push_back(wxBitmap());
+            continue;
+        }
+
+        const wxBitmap
+            bitmap = wxBitmapBundleImplSVG::BitmapFromRGBA(task.buffer.data(),
+                                                           task.size);
+        bitmaps.push_back(bitmap);
+
+        cache.Add(task.impl->GetCacheKey(task.size), bitmap);
+
+        // Free the memory as soon as possible.
+        std::vector<unsigned char>().swap(task.buffer);
+    }
+
+    // And also keep them in the bundles themselves, in case the global cache
+    // is too small to keep all of them.
+    for ( const auto& target : targets )
+    {
+        const wxBitmap& bitmap = bitmaps[target.second];
+        if ( bitmap.IsOk() )
+            target.first->AddCachedBitmap(bitmap);
+    }
+
+    return tasks.size();
+}
+
+// ----------------------------------------------------------------------------
+// wxBitmapBundle SVG functions
+// ----------------------------------------------------------------------------
+
 /* static */
 wxBitmapBundle wxBitmapBundle::FromSVG(char* data, const wxSize& sizeDef)
 {
+    // Compute the hash and copy the document before parsing, which modifies
+    // the data.
+    const wxCharBuffer doc(data);
+    const wxUint64 docHash = wxHashSVGDocument(doc.data(), doc.length());
+
     NSVGimage* const svgImage = nsvgParse(data, "px", 96);
     if ( !svgImage )
         return wxBitmapBundle();
@@ -238,7 +735,7 @@ wxBitmapBundle wxBitmapBundle::FromSVG(char* data, const wxSize& sizeDef)
         return wxBitmapBundle();
     }
 
-    return wxBitmapBundle(new wxBitmapBundleImplSVG(svgImage, sizeDef));
+    return wxBitmapBundle(new wxBitmapBundleImplSVG(svgImage, docHash, doc, sizeDef));
 }
 
 /* static */
@@ -288,4 +785,41 @@ wxBitmapBundle wxBitmapBundle::FromSVGFile(const wxString& path, const wxSize& s
     return wxBitmapBundle();
 }
 
+/* static */
+wxBitmapBundle::SVGCacheStats wxBitmapBundle::GetSVGCacheStats()
+{
+    return wxSVGRasterCache::Get().GetStats();
+}
+
+/* static */
+void wxBitmapBundle::SetSVGCacheLimit(size_t bytes)
+{
+    wxSVGRasterCache::Get().SetLimit(bytes);
+}
+
+/* static */
+void wxBitmapBundle::ClearSVGCache()
+{
+    wxSVGRasterCache::Get().Clear();
+}
+
+// ----------------------------------------------------------------------------
+// Module destroying the global cache
+// ----------------------------------------------------------------------------
+
+// The cached bitmaps must be destroyed before the GUI toolkit shuts down.
+class wxSVGRasterCacheModule : public wxModule
+{
+public:
+    wxSVGRasterCacheModule() = default;
+
+    virtual bool OnInit() override { return true; }
+    virtual void OnExit() override { wxSVGRasterCache::Destroy(); }
+
+private:
+    wxDECLARE_DYNAMIC_CLASS(wxSVGRasterCacheModule);
+};
+
+wxIMPLEMENT_DYNAMIC_CLASS(wxSVGRasterCacheModule, wxModule);
+
 #endif // wxHAS_SVG
@@ -13,6 +13,7 @@
 #if wxUSE_PRINTING_ARCHITECTURE && wxUSE_POSTSCRIPT
 
 #include "wx/generic/dcpsg.h"
+#include "wx/generic/private/dcpsg.h"
 
 #ifndef WX_PRECOMP
     #include "wx/intl.h"
@@ -30,6 +31,14 @@
 #include "wx/filename.h"
 #include "wx/stdpaths.h"
 
+#if wxUSE_ZLIB && wxUSE_STREAMS
+    #include "wx/mstream.h"
+    #include "wx/zstream.h"
+#endif
+
+#include <cmath>
+#include <vector>
+
 #ifdef __WXMSW__
 
 #ifdef DrawText
@@ -50,6 +59,169 @@
 
 #endif
 
+//-----------------------------------------------------------------------------
+// helpers
+//-----------------------------------------------------------------------------
+
+namespace
+{
+
+// Size of the output buffer: it's written to the file when it becomes bigger.
+const size_t PS_BUFFER_SIZE = 64*1024;
+
+} // anonymous namespace
+
+namespace wxPrivate
+{
+
+// Append the same representation of the number as produced by "%f" printf()
+// format in C locale, but without any memory allocations (in the common case).
+void AppendPSNumber(std::string& s, double f)
+{
+    // Use the slow but general version for the values which can't be handled
+    // below, including NaN.
+    const double a = fabs(f);
+    if ( !(a < 1e9) )
+    {
+        s += wxString::FromCDouble(f, 6).utf8_string();
+        return;
+    }
+
+    // Round the number to 6 decimal digits in the same way as printf() does
+    // it, i.e. using its exact binary value and rounding the ties to even:
+    // compare the exact value of 2000000*a, computed as x + e, with the
+    // midpoint between the two candidates, which is an exactly representable
+    // integer.
+    const double lo = floor(a * 1e6);
+    const double mid = 2*lo + 1;
+    const double x = a * 2e6;
+    const double e = fma(a, 2e6, -x);
+    const bool roundUp = x > mid ||
+                         (x == mid && (e > 0 || (e == 0 && fmod(lo, 2) != 0)));
+
+    unsigned long long u = static_cast<unsigned long long>(lo) + roundUp;
+
+    char buf[32];
+    char* const end = buf + sizeof(buf);
+    char* p = end;
+
+    for ( int n = 0; n < 6; n++ )
+    {
+        *--p = static_cast<char>('0' + u % 10);
+        u /= 10;
+    }
+    *--p = '.';
+    do
+    {
+        *--p = static_cast<char>('0' + u % 10);
+        u /= 10;
+    } while ( u );
+
+    // Note that printf() outputs "-0.000000" for small negative numbers and
+    // negative zero, so do the same thing.
+    if ( std::signbit(f) )
+        *--p = '-';
+
+    s.append(p, end - p);
+}
+
+// Compress the data using the format understood by RunLengthDecode filter.
+void RunLengthEncode(const unsigned char* data, size_t len,
+                     std::vector<unsigned char>& out)
+{
+    size_t i = 0;
+    while ( i < len )
+    {
+        // Check for a run of identical bytes first.
+        size_t run = 1;
+        while ( i + run < len && run < 128 && data[i + run] == data[i] )
+            run++;
+
+        if ( run > 1 )
+        {
+            out.push_back(static_cast<unsigned char>(257 - run));
+            out.push_back(data[i]);
+            i += run;
+            continue;
+        }
+
+        // Otherwise copy the bytes literally until the next run.
+        const size_t start = i;
+        while ( i < len && i - start < 128 )
+        {
+            if ( i + 2 < len && data[i] == data[i + 1] && data[i] == data[i + 2] )
+                break;
+
+            i++;
+        }
+
+        out.push_back(static_cast<unsigned char>(i - start - 1));
+        out.insert(out.end(), data + start, data + i);
+    }
+
+    // End of data marker.
+    out.push_back(128);
+}
+
+// Append the data encoded in ASCII85 format followed by its end marker.
+void AppendASCII85(std::string& s, const unsigned char* data, size_t len)
+{
+    // Break the output into lines of reasonable length and avoid starting
+    // any of them with "%" to ensure they can't be mistaken for DSC comments.
+    size_t column = 0;
+    const auto putChar = [&s, &column](char c)
+    {
+        if ( column == 0 && c == '%' )
+        {
+            s += ' ';
+            column++;
+        }
+
+        s += c;
+
+        if ( ++column == 76 )
+        {
+            s += '\n';
+            column = 0;
+        }
+    };
+
+    for ( size_t i = 0; i < len; i += 4 )
+    {
+        const size_t n = wxMin(len - i, size_t(4));
+
+        wxUint32 word = 0;
+        for ( size_t j = 0; j < 4; j++ )
+        {
+            word <<= 8;
+            if ( j < n )
+                word |= data[i + j];
+        }
+
+        // A full group of zeroes is abbreviated as "z".
+        if ( word == 0 && n == 4 )
+        {
+            putChar('z');
+            continue;
+        }
+
+        char digits[5];
+        for ( int j = 4; j >= 0; j-- )
+        {
+            digits[j] = static_cast<char>('!' + word % 85);
+            word /= 85;
+        }
+
+        // A final partial group of n bytes is output as n + 1 characters.
+        for ( size_t j = 0; j <= n; j++ )
+            putChar(digits[j]);
+    }
+
+    s += "~>\n";
+}
+
+} // namespace wxPrivate
+
 //-----------------------------------------------------------------------------
 // start and end of document/page
 //-----------------------------------------------------------------------------
@@ -227,6 +399,11 @@ wxPostScriptDC::wxPostScriptDC(const wxPrintData& printData)
 {
 }
 
+void wxPostScriptDC::SetImageEncoding(wxPostScriptImageEncoding encoding)
+{
+    static_cast<wxPostScriptDCImpl*>(GetImpl())->SetImageEncoding(encoding);
+}
+
 // we don't want to use only 72 dpi from PS print
 static const int DPI = 600;
 static const double PS2DEV = 600.0 / 72.0;
@@ -303,12 +480,16 @@ void wxPostScriptDCImpl::Init()
     m_underlineThickness = 0.0;
 
     m_isFontChanged = false;
+
+    // Use the encoding understood by all PostScript interpreters by default.
+    m_imageEncoding = wxPS_IMAGE_ENCODING_HEX;
 }
 
 wxPostScriptDCImpl::~wxPostScriptDCImpl ()
 {
     if (m_pstream)
     {
+        PsFlush();
         fclose( m_pstream );
         m_pstream = nullptr;
     }
@@ -346,20 +527,13 @@ void wxPostScriptDCImpl::DoSetClippingRegion (wxCoord x, wxCoord y, wxCoord w, w
 
     m_clipping = true;
 
-    wxString buffer;
-    buffer.Printf( "gsave\n"
-                   "newpath\n"
-                   "%f %f moveto\n"
-                   "%f %f lineto\n"
-                   "%f %f lineto\n"
-                   "%f %f lineto\n"
-                   "closepath clip newpath\n",
-            XLOG2DEV(x),   YLOG2DEV(y),
-            XLOG2DEV(x+w), YLOG2DEV(y),
-            XLOG2DEV(x+w), YLOG2DEV(y+h),
-            XLOG2DEV(x),   YLOG2DEV(y+h) );
-    buffer.Replace( ",", "." );
-    PsPrint( buffer );
+    PsAppend( "gsave\n"
+              "newpath\n" );
+    PsAppendPoint( XLOG2DEV(x),   YLOG2DEV(y),   "moveto" );
+    PsAppendPoint( XLOG2DEV(x+w), YLOG2DEV(y),   "lineto" );
+    PsAppendPoint( XLOG2DEV(x+w), YLOG2DEV(y+h), "lineto" );
+    PsAppendPoint( XLOG2DEV(x),   YLOG2DEV(y+h), "lineto" );
+    PsPrint( "closepath clip newpath\n" );
 }
 
 
@@ -409,15 +583,10 @@ void wxPostScriptDCImpl::DoDrawLine (wxCoord x1, wxCoord y1, wxCoord x2, wxCoord
 
     SetPen( m_pen );
 
-    wxString buffer;
-    buffer.Printf( "newpath\n"
-                   "%f %f moveto\n"
-                   "%f %f lineto\n"
-                   "stroke\n",
-            XLOG2DEV(x1), YLOG2DEV(y1),
-            XLOG2DEV(x2), YLOG2DEV(y2) );
-    buffer.Replace( ",", "." );
-    PsPrint( buffer );
+    PsAppend( "newpath\n" );
+    PsAppendPoint( XLOG2DEV(x1), YLOG2DEV(y1), "moveto" );
+    PsAppendPoint( XLOG2DEV(x2), YLOG2DEV(y2), "lineto" );
+    PsPrint( "stroke\n" );
 
     if ( AreAutomaticBoundingBoxUpdatesEnabled() )
         CalcBoundingBox( x1, y1, x2, y2 );
@@ -566,15 +735,10 @@ void wxPostScriptDCImpl::DoDrawPoint (wxCoord x, wxCoord y)
 
     SetPen (m_pen);
 
-    wxString buffer;
-    buffer.Printf( "newpath\n"
-                   "%f %f moveto\n"
-                   "%f %f lineto\n"
-                   "stroke\n",
-            XLOG2DEV(x),   YLOG2DEV(y),
-            XLOG2DEV(x+1), YLOG2DEV(y) );
-    buffer.Replace( ",", "." );
-    PsPrint( buffer );
+    PsAppend( "newpath\n" );
+    PsAppendPoint( XLOG2DEV(x),   YLOG2DEV(y), "moveto" );
+    PsAppendPoint( XLOG2DEV(x+1), YLOG2DEV(y), "lineto" );
+    PsPrint( "stroke\n" );
 
     if ( AreAutomaticBoundingBoxUpdatesEnabled() )
         CalcBoundingBox( x, y );
@@ -592,25 +756,16 @@ void wxPostScriptDCImpl::DoDrawPolygon (int n, const wxPoint points[], wxCoord x
 
         PsPrint( "newpath\n" );
 
-        double xx = XLOG2DEV(points[0].x + xoffset);
-        double yy = YLOG2DEV(points[0].y + yoffset);
-
-        wxString buffer;
-        buffer.Printf( "%f %f moveto\n", xx, yy );
-        buffer.Replace( ",", "." );
-        PsPrint( buffer );
+        PsAppendPoint( XLOG2DEV(points[0].x + xoffset),
+                       YLOG2DEV(points[0].y + yoffset), "moveto" );
 
         if ( AreAutomaticBoundingBoxUpdatesEnabled() )
             CalcBoundingBox( points[0].x + xoffset, points[0].y + yoffset );
 
         for (int i = 1; i < n; i++)
         {
-            xx = XLOG2DEV(points[i].x + xoffset);
-            yy = YLOG2DEV(points[i].y + yoffset);
-
-            buffer.Printf( "%f %f lineto\n", xx, yy );
-            buffer.Replace( ",", "." );
-            PsPrint( buffer );
+            PsAppendPoint( XLOG2DEV(points[i].x + xoffset),
+                           YLOG2DEV(points[i].y + yoffset), "lineto" );
 
             if ( AreAutomaticBoundingBoxUpdatesEnabled() )
                 CalcBoundingBox( points[i].x + xoffset, points[i].y + yoffset);
@@ -625,25 +780,16 @@ void wxPostScriptDCImpl::DoDrawPolygon (int n, const wxPoint points[], wxCoord x
 
         PsPrint( "newpath\n" );
 
-        double xx = XLOG2DEV(points[0].x + xoffset);
-        double yy = YLOG2DEV(points[0].y + yoffset);
-
-        wxString buffer;
-        buffer.Printf( "%f %f moveto\n", xx, yy );
-        buffer.Replace( ",", "." );
-        PsPrint( buffer );
+        PsAppendPoint( XLOG2DEV(points[0].x + xoffset),
+                       YLOG2DEV(points[0].y + yoffset), "moveto" );
 
         if ( AreAutomaticBoundingBoxUpdatesEnabled() )
             CalcBoundingBox( points[0].x + xoffset, points[0].y + yoffset );
 
         for (int i = 1; i < n; i++)
         {
-            xx = XLOG2DEV(points[i].x + xoffset);
-            yy = YLOG2DEV(points[i].y + yoffset);
-
-            buffer.Printf( "%f %f lineto\n", xx, yy );
-            buffer.Replace( ",", "." );
-            PsPrint( buffer );
+            PsAppendPoint( XLOG2DEV(points[i].x + xoffset),
+                           YLOG2DEV(points[i].y + yoffset), "lineto" );
 
             if ( AreAutomaticBoundingBoxUpdatesEnabled() )
                 CalcBoundingBox( points[i].x + xoffset, points[i].y + yoffset);
@@ -669,25 +815,16 @@ void wxPostScriptDCImpl::DoDrawPolyPolygon (int n, const int count[], const wxPo
         int ofs = 0;
         for (int i = 0; i < n; ofs += count[i++])
         {
-            double xx = XLOG2DEV(points[ofs].x + xoffset);
-            double yy = YLOG2DEV(points[ofs].y + yoffset);
-
-            wxString buffer;
-            buffer.Printf( "%f %f moveto\n", xx, yy );
-            buffer.Replace( ",", "." );
-            PsPrint( buffer );
+            PsAppendPoint( XLOG2DEV(points[ofs].x + xoffset),
+                           YLOG2DEV(points[ofs].y + yoffset), "moveto" );
 
             if ( AreAutomaticBoundingBoxUpdatesEnabled() )
                 CalcBoundingBox( points[ofs].x + xoffset, points[ofs].y + yoffset );
 
             for (int j = 1; j < count[i]; j++)
             {
-                xx = XLOG2DEV(points[ofs+j].x + xoffset);
-                yy = YLOG2DEV(points[ofs+j].y + yoffset);
-
-                buffer.Printf( "%f %f lineto\n", xx, yy );
-                buffer.Replace( ",", "." );
-                PsPrint( buffer );
+                PsAppendPoint( XLOG2DEV(points[ofs+j].x + xoffset),
+                               YLOG2DEV(points[ofs+j].y + yoffset), "lineto" );
 
                 if ( AreAutomaticBoundingBoxUpdatesEnabled() )
                     CalcBoundingBox( points[ofs+j].x + xoffset, points[ofs+j].y + yoffset);
@@ -705,25 +842,16 @@ void wxPostScriptDCImpl::DoDrawPolyPolygon (int n, const int count[], const wxPo
         int ofs = 0;
         for (int i = 0; i < n; ofs += count[i++])
         {
-            double xx = XLOG2DEV(points[ofs].x + xoffset);
-            double yy = YLOG2DEV(points[ofs].y + yoffset);
-
-            wxString buffer;
-            buffer.Printf( "%f %f moveto\n", xx, yy );
-            buffer.Replace( ",", "." );
-            PsPrint( buffer );
+            PsAppendPoint( XLOG2DEV(points[ofs].x + xoffset),
+                           YLOG2DEV(points[ofs].y + yoffset), "moveto" );
 
             if ( AreAutomaticBoundingBoxUpdatesEnabled() )
                 CalcBoundingBox( points[ofs].x + xoffset, points[ofs].y + yoffset );
 
             for (int j = 1; j < count[i]; j++)
             {
-                xx = XLOG2DEV(points[ofs+j].x + xoffset);
-                yy = YLOG2DEV(points[ofs+j].y + yoffset);
-
-                buffer.Printf( "%f %f lineto\n", xx, yy );
-                buffer.Replace( ",", "." );
-                PsPrint( buffer );
+                PsAppendPoint( XLOG2DEV(points[ofs+j].x + xoffset),
+                               YLOG2DEV(points[ofs+j].y + yoffset), "lineto" );
 
                 if ( AreAutomaticBoundingBoxUpdatesEnabled() )
                     CalcBoundingBox( points[ofs+j].x + xoffset, points[ofs+j].y + yoffset);
@@ -752,21 +880,14 @@ void wxPostScriptDCImpl::DoDrawLines (int n, const wxPoint points[], wxCoord xof
             CalcBoundingBox( points[i].x+xoffset, points[i].y+yoffset );
     }
 
-    wxString buffer;
-    buffer.Printf( "newpath\n"
-                   "%f %f moveto\n",
-              XLOG2DEV(points[0].x+xoffset),
-              YLOG2DEV(points[0].y+yoffset) );
-    buffer.Replace( ",", "." );
-    PsPrint( buffer );
+    PsAppend( "newpath\n" );
+    PsAppendPoint( XLOG2DEV(points[0].x+xoffset),
+                   YLOG2DEV(points[0].y+yoffset), "moveto" );
 
     for (i = 1; i < n; i++)
     {
-        buffer.Printf( "%f %f lineto\n",
-                  XLOG2DEV(points[i].x+xoffset),
-                  YLOG2DEV(points[i].y+yoffset) );
-        buffer.Replace( ",", "." );
-        PsPrint( buffer );
+        PsAppendPoint( XLOG2DEV(points[i].x+xoffset),
+                       YLOG2DEV(points[i].y+yoffset), "lineto" );
     }
 
     PsPrint( "stroke\n" );
@@ -783,20 +904,13 @@ void wxPostScriptDCImpl::DoDrawRectangle (wxCoord x, wxCoord y, wxCoord width, w
     {
         SetBrush( m_brush );
 
-        wxString buffer;
-        buffer.Printf( "newpath\n"
-                       "%f %f moveto\n"
-                       "%f %f lineto\n"
-                       "%f %f lineto\n"
-                       "%f %f lineto\n"
-                       "closepath\n"
-                       "fill\n",
-                XLOG2DEV(x),         YLOG2DEV(y),
-                XLOG2DEV(x + width), YLOG2DEV(y),
-                XLOG2DEV(x + width), YLOG2DEV(y + height),
-                XLOG2DEV(x),         YLOG2DEV(y + height) );
-        buffer.Replace( ",", "." );
-        PsPrint( buffer );
+        PsAppend( "newpath\n" );
+        PsAppendPoint( XLOG2DEV(x),         YLOG2DEV(y),          "moveto" );
+        PsAppendPoint( XLOG2DEV(x + width), YLOG2DEV(y),          "lineto" );
+        PsAppendPoint( XLOG2DEV(x + width), YLOG2DEV(y + height), "lineto" );
+        PsAppendPoint( XLOG2DEV(x),         YLOG2DEV(y + height), "lineto" );
+        PsPrint( "closepath\n"
+                 "fill\n" );
 
         if ( AreAutomaticBoundingBoxUpdatesEnabled() )
             CalcBoundingBox( wxPoint(x, y), wxSize(width, height) );
@@ -806,20 +920,13 @@ void wxPostScriptDCImpl::DoDrawRectangle (wxCoord x, wxCoord y, wxCoord width, w
     {
         SetPen (m_pen);
 
-        wxString buffer;
-        buffer.Printf( "newpath\n"
-                       "%f %f moveto\n"
-                       "%f %f lineto\n"
-                       "%f %f lineto\n"
-                       "%f %f lineto\n"
-                       "closepath\n"
-                       "stroke\n",
-                XLOG2DEV(x),         YLOG2DEV(y),
-                XLOG2DEV(x + width), YLOG2DEV(y),
-                XLOG2DEV(x + width), YLOG2DEV(y + height),
-                XLOG2DEV(x),         YLOG2DEV(y + height) );
-        buffer.Replace( ",", "." );
-        PsPrint( buffer );
+        PsAppend( "newpath\n" );
+        PsAppendPoint( XLOG2DEV(x),         YLOG2DEV(y),          "moveto" );
+        PsAppendPoint( XLOG2DEV(x + width), YLOG2DEV(y),          "lineto" );
+        PsAppendPoint( XLOG2DEV(x + width), YLOG2DEV(y + height), "lineto" );
+        PsAppendPoint( XLOG2DEV(x),         YLOG2DEV(y + height), "lineto" );
+        PsPrint( "closepath\n"
+                 "stroke\n" );
 
         if ( AreAutomaticBoundingBoxUpdatesEnabled() )
             CalcBoundingBox( wxPoint(x, y), wxSize(width, height) );
@@ -919,14 +1026,14 @@ void wxPostScriptDCImpl::DoDrawEllipse (wxCoord x, wxCoord y, wxCoord width, wxC
     {
         SetBrush (m_brush);
 
-        wxString buffer;
-        buffer.Printf( "newpath\n"
-                       "%f %f %f %f 0 360 ellipse\n"
-                       "fill\n",
-                XLOG2DEV(x + width / 2), YLOG2DEV(y + height / 2),
-                XLOG2DEVREL(width / 2), YLOG2DEVREL(height / 2) );
-        buffer.Replace( ",", "." );
-        PsPrint( buffer );
+        PsAppend( "newpath\n" );
+        PsAppendNumber( XLOG2DEV(x + width / 2) );
+        PsAppend( " " );
+        PsAppendNumber( YLOG2DEV(y + height / 2) );
+        PsAppend( " " );
+        PsAppendPoint( XLOG2DEVREL(width / 2), YLOG2DEVREL(height / 2),
+                       "0 360 ellipse" );
+        PsPrint( "fill\n" );
 
         if ( AreAutomaticBoundingBoxUpdatesEnabled() )
             CalcBoundingBox( x - width, y - height, x + width, y + height );
@@ -936,14 +1043,14 @@ void wxPostScriptDCImpl::DoDrawEllipse (wxCoord x, wxCoord y, wxCoord width, wxC
     {
         SetPen (m_pen);
 
-        wxString buffer;
-        buffer.Printf( "newpath\n"
-                       "%f %f %f %f 0 360 ellipse\n"
-                       "stroke\n",
-                XLOG2DEV(x + width / 2), YLOG2DEV(y + height / 2),
-                XLOG2DEVREL(width / 2), YLOG2DEVREL(height / 2) );
-        buffer.Replace( ",", "." );
-        PsPrint( buffer );
+        PsAppend( "newpath\n" );
+        PsAppendNumber( XLOG2DEV(x + width / 2) );
+        PsAppend( " " );
+        PsAppendNumber( YLOG2DEV(y + height / 2) );
+        PsAppend( " " );
+        PsAppendPoint( XLOG2DEVREL(width / 2), YLOG2DEVREL(height / 2),
+                       "0 360 ellipse" );
+        PsPrint( "stroke\n" );
 
         if ( AreAutomaticBoundingBoxUpdatesEnabled() )
             CalcBoundingBox( x - width, y - height, x + width, y + height );
@@ -974,52 +1081,54 @@ void wxPostScriptDCImpl::DoDrawBitmap( const wxBitmap& bitmap, wxCoord x, wxCoor
     double xx = XLOG2DEV(x);
     double yy = YLOG2DEV(y + bitmap.GetHeight());
 
-    wxString buffer;
-    buffer.Printf( "/origstate save def\n"
-                   "20 dict begin\n"
-                   "/pix %d string def\n"
-                   "/grays %d string def\n"
-                   "/npixels 0 def\n"
-                   "/rgbindx 0 def\n"
-                   "%f %f translate\n"
-                   "%f %f scale\n"
-                   "%d %d 8\n"
-                   "[%d 0 0 %d 0 %d]\n"
-                   "{currentfile pix readhexstring pop}\n"
-                   "false 3 colorimage\n",
-            w, w, xx, yy, ww, hh, w, h, w, -h, h );
-    buffer.Replace( ",", "." );
-    PsPrint( buffer );
-
-    unsigned char* data = image.GetData();
-
-    // size of the buffer = width*rgb(3)*hexa(2)+'\n'
-    wxCharBuffer charbuffer(w*6 + 1);
+    PsAppend( "/origstate save def\n"
+              "20 dict begin\n" );
 
-    //rows
-    for (int j = 0; j < h; j++)
+    if ( m_imageEncoding == wxPS_IMAGE_ENCODING_HEX )
     {
-        char* bufferindex = charbuffer.data();
-
-        //cols
-        for (int i = 0; i < w*3; i++)
-        {
-            char c1, c2;
-            wxDecToHex(*data, &c1, &c2);
-            *(bufferindex++) = c1;
-            *(bufferindex++) = c2;
-
-            data++;
-        }
-        *(bufferindex++) = '\n';
-        *bufferindex = 0;
+        wxString buffer;
+        buffer.Printf( "/pix %d string def\n"
+                       "/grays %d string def\n"
+                       "/npixels 0 def\n"
+                       "/rgbindx 0 def\n"
+                       "%f %f translate\n"
+                       "%f %f scale\n"
+                       "%d %d 8\n"
+                       "[%d 0 0 %d 0 %d]\n"
+                       "{currentfile pix readhexstring pop}\n"
+                       "false 3 colorimage\n",
+                w, w, xx, yy, ww, hh, w, h, w, -h, h );
+        buffer.Replace( ",", "." );
+        PsPrint( buffer );
+    }
+    else // Use Level 2 image dictionary with filtered data source.
+    {
+        PsAppendPoint( xx, yy, "translate" );
+        PsAppendPoint( ww, hh, "scale" );
 
-        if (m_pstream)
-            fwrite( charbuffer, 1, strlen( charbuffer ), m_pstream );
-        else
-            PsPrint( charbuffer );
+        wxString buffer;
+        buffer.Printf( "/DeviceRGB setcolorspace\n"
+                       "<<\n"
+                       "/ImageType 1\n"
+                       "/Width %d\n"
+                       "/Height %d\n"
+                       "/BitsPerComponent 8\n"
+                       "/Decode [0 1 0 1 0 1]\n"
+                       "/ImageMatrix [%d 0 0 %d 0 %d]\n"
+                       "/DataSource currentfile /ASCII85Decode filter %s filter\n"
+                       ">>\n"
+                       "image\n",
+                w, h, w, -h, h,
+#if wxUSE_ZLIB && wxUSE_STREAMS
+                m_imageEncoding == wxPS_IMAGE_ENCODING_FLATE ? "/FlateDecode"
+                                                             :
+#endif // wxUSE_ZLIB && wxUSE_STREAMS
+                                                               "/RunLengthDecode" );
+        PsPrint( buffer );
     }
 
+    PsAppendImageData( image.GetData(), w, h );
+
     PsPrint( "end\n" );
     PsPrint( "origstate restore\n" );
 }
@@ -1049,10 +1158,10 @@ void wxPostScriptDCImpl::SetPSColour(const wxColor& col)
         double bluePS = (double)blue / 255.0;
         double greenPS = (double)green / 255.0;
 
-        wxString buffer;
-        buffer.Printf( "%f %f %f setrgbcolor\n", redPS, greenPS, bluePS );
-        buffer.Replace( ",", "." );
-        PsPrint( buffer );
+        PsAppendNumber( redPS );
+        PsAppend( " " );
+        PsAppendPoint( greenPS, bluePS, "setrgbcolor" );
+        PsFlushIfNeeded();
 
         m_currentRed = red;
         m_currentBlue = blue;
@@ -1190,10 +1299,10 @@ void wxPostScriptDCImpl::SetPen( const wxPen& pen )
     else
         width = (double) m_pen.GetWidth();
 
+    PsAppendNumber( width * DEV2PS * m_scaleX );
+    PsPrint( " setlinewidth\n" );
+
     wxString buffer;
-    buffer.Printf( "%f setlinewidth\n", width * DEV2PS * m_scaleX );
-    buffer.Replace( ",", "." );
-    PsPrint( buffer );
 
 /*
      Line style - WRONG: 2nd arg is OFFSET
@@ -1665,12 +1774,29 @@ bool wxPostScriptDCImpl::StartDoc( const wxString& WXUNUSED(message) )
 
     m_ok = true;
 
+    // Discard anything output before the start of the document.
+    m_psBuffer.clear();
+
     wxString buffer;
 
     PsPrint( "%!PS-Adobe-2.0\n" );
 
     PsPrint( "%%Creator: wxWidgets PostScript renderer\n" );
 
+    switch ( m_imageEncoding )
+    {
+        case wxPS_IMAGE_ENCODING_HEX:
+            break;
+
+        case wxPS_IMAGE_ENCODING_RUNLENGTH:
+            PsPrint( "%%LanguageLevel: 2\n" );
+            break;
+
+        case wxPS_IMAGE_ENCODING_FLATE:
+            PsPrint( "%%LanguageLevel: 3\n" );
+            break;
+    }
+
     buffer.Printf( "%%%%CreationDate: %s\n", wxNow() );
     PsPrint( buffer );
 
@@ -1739,6 +1865,8 @@ void wxPostScriptDCImpl::EndDoc ()
         PsPrint( "grestore\n" );
     }
 
+    PsFlush();
+
     if ( m_pstream ) {
         fclose( m_pstream );
         m_pstream = nullptr;
@@ -1914,7 +2042,109 @@ wxCoord wxPostScriptDCImpl::GetCharHeight() const
 
 void wxPostScriptDCImpl::PsPrint( const wxString& str )
 {
-    const wxCharBuffer psdata(str.utf8_str());
+    m_psBuffer += str.utf8_string();
+    PsFlushIfNeeded();
+}
+
+void wxPostScriptDCImpl::PsPrint( const char* psdata )
+{
+    m_psBuffer += psdata;
+    PsFlushIfNeeded();
+}
+
+void wxPostScriptDCImpl::PsAppendNumber( double value )
+{
+    wxPrivate::AppendPSNumber( m_psBuffer, value );
+}
+
+void wxPostScriptDCImpl::PsAppendPoint( double x, double y, const char* op )
+{
+    wxPrivate::AppendPSNumber( m_psBuffer, x );
+    m_psBuffer += ' ';
+    wxPrivate::AppendPSNumber( m_psBuffer, y );
+    m_psBuffer += ' ';
+    m_psBuffer += op;
+    m_psBuffer += '\n';
+}
+
+void wxPostScriptDCImpl::PsAppendImageData( const unsigned char* data,
+                                            int width, int height )
+{
+    const size_t len = 3*static_cast<size_t>(width)*height;
+
+    switch ( m_imageEncoding )
+    {
+        case wxPS_IMAGE_ENCODING_HEX:
+            {
+                // size of the buffer = width*rgb(3)*hexa(2)+'\n'
+                char* const line = new char[width*6 + 1];
+
+                //rows
+                for (int j = 0; j < height; j++)
+                {
+                    char* bufferindex = line;
+
+                    //cols
+                    for (int i = 0; i < width*3; i++)
+                    {
+                        wxDecToHex(*data, bufferindex, bufferindex + 1);
+                        bufferindex += 2;
+
+                        data++;
+                    }
+                    *(bufferindex++) = '\n';
+
+                    m_psBuffer.append( line, bufferindex - line );
+                    PsFlushIfNeeded();
+                }
+
+                delete [] line;
+            }
+            return;
+
+        case wxPS_IMAGE_ENCODING_FLATE:
+#if wxUSE_ZLIB && wxUSE_STREAMS
+            {
+                wxMemoryOutputStream mos;
+                {
+                    wxZlibOutputStream zos(mos, -1, wxZLIB_ZLIB);
+                    zos.Write( data, len );
+                }
+
+                const wxStreamBuffer* const sb = mos.GetOutputStreamBuffer();
+                wxPrivate::AppendASCII85( m_psBuffer,
+                               static_cast<unsigned char*>(sb->GetBufferStart()),
+                               mos.GetLength() );
+                PsFlushIfNeeded();
+            }
+            return;
+#endif // wxUSE_ZLIB && wxUSE_STREAMS
+
+            // Without zlib we can't compress the data, but the header
+            // specified /RunLengthDecode in this case, so fall through.
+            wxFALLTHROUGH;
+
+        case wxPS_IMAGE_ENCODING_RUNLENGTH:
+            {
+                std::vector<unsigned char> encoded;
+                wxPrivate::RunLengthEncode( data, len, encoded );
+                wxPrivate::AppendASCII85( m_psBuffer, encoded.data(), encoded.size() );
+                PsFlushIfNeeded();
+            }
+            return;
+    }
+}
+
+void wxPostScriptDCImpl::PsFlushIfNeeded()
+{
+    if ( m_psBuffer.size() >= PS_BUFFER_SIZE )
+        PsFlush();
+}
+
+void wxPostScriptDCImpl::PsFlush()
+{
+    if ( m_psBuffer.empty() )
+        return;
 
     switch (m_printData.GetPrintMode())
     {
@@ -1927,19 +2157,26 @@ void wxPostScriptDCImpl::PsPrint( const wxString& str )
                 // wxPostScriptPrintNativeData methods on it crashes.
                 wxPostScriptPrintNativeData *data =
                     wxDynamicCast(m_printData.GetNativeData(), wxPostScriptPrintNativeData);
-                wxCHECK_RET( data, wxS("Cannot obtain output stream") );
-                wxOutputStream* outputstream = data->GetOutputStream();
-                wxCHECK_RET( outputstream, wxT("invalid outputstream") );
-                outputstream->Write( psdata, strlen( psdata ) );
+                wxOutputStream* outputstream = data ? data->GetOutputStream() : nullptr;
+                if ( outputstream )
+                    outputstream->Write( m_psBuffer.data(), m_psBuffer.size() );
+                else
+                    wxFAIL_MSG( wxS("Cannot obtain output stream") );
             }
             break;
 #endif // wxUSE_STREAMS
 
         // save data into file
         default:
-            wxCHECK_RET( m_pstream, wxT("invalid postscript dc") );
-            fwrite( psdata, 1, strlen( psdata ), m_pstream );
+            if ( m_pstream )
+                fwrite( m_psBuffer.data(), 1, m_psBuffer.size(), m_pstream );
+            else
+                wxFAIL_MSG( wxS("invalid postscript dc") );
     }
+
+    // Don't keep the data even if we failed to write it, as it would be
+    // useless and just accumulate.
+    m_psBuffer.clear();
 }
 
 void wxPostScriptDCImpl::DoGetTextExtent(const wxString& string,
@@ -38,9 +38,13 @@ bool wxCairoInit();
 #endif
 
 #include "wx/private/graphics.h"
+#if wxUSE_IMAGE
+    #include "wx/private/image.h"
+#endif
 #include "wx/rawbmp.h"
 #include "wx/vector.h"
 #include "wx/display.h"
+#include "wx/module.h"
 #ifdef __WXMSW__
     #include "wx/msw/enhmeta.h"
 #endif
@@ -88,7 +92,6 @@ using namespace std;
 #ifndef __WXGTK3__
 #include "wx/gtk/dc.h"
 #endif
-#include "wx/gtk/private/object.h"
 #endif
 
 #ifdef __WXQT__
@@ -256,6 +259,12 @@ public:
 
     virtual void Apply( wxGraphicsContext* context );
 
+    // Return true if just a plain colour, and not a pattern, is used.
+    bool UsesPlainColour() const
+    {
+        return !m_pattern && m_hatchStyle == wxHATCHSTYLE_INVALID;
+    }
+
     void CreateLinearGradientPattern(wxDouble x1, wxDouble y1,
                                      wxDouble x2, wxDouble y2,
                                      const wxGraphicsGradientStops& stops,
@@ -394,6 +403,10 @@ public:
 
 #if wxUSE_IMAGE
     wxImage ConvertToImage() const;
+
+    // Return true if the surface uses the data of this image directly, which
+    // is only possible if it uses packed storage.
+    bool UsesImageData(const wxImage& image) const;
 #endif // wxUSE_IMAGE
 
 private :
@@ -414,6 +427,186 @@ private :
     unsigned char* m_buffer;
 };
 
+#ifdef __WXGTK__
+// ----------------------------------------------------------------------------
+// wxCairoTextLayoutCache: recently used Pango layouts of wxCairoContexts
+// ----------------------------------------------------------------------------
+
+// Creating a Pango layout and shaping the text in it is relatively expensive,
+// so keep the layouts for the strings drawn or measured recently, as the same
+// labels are typically used many times, and reuse them when possible.
+//
+// The layouts are identified by their font description, text and attributes,
+// as they can be used with any cairo_t after calling pango_cairo_update_layout()
+// for it, so a single cache is shared by all the contexts, which is important
+// as a new context is usually created for every repaint. But the layouts can't
+// be used by several threads at once, so there is one cache per thread, see
+// GetTextLayoutCache() below.
+class wxCairoTextLayoutCache
+{
+public:
+    // Pango attributes which can be set for the layouts, combination of these
+    // flags is passed to the functions below.
+    enum
+    {
+        Attr_Underlined    = 1,
+        Attr_Strikethrough = 2
+    };
+
+    wxCairoTextLayoutCache() = default;
+    ~wxCairoTextLayoutCache() { Clear(); }
+
+    // Return the existing layout using the given font, text and attributes or
+    // nullptr.
+    PangoLayout* Find(const PangoFontDescription* desc,
+                      const char* text, size_t len,
+                      int attrs)
+    {
+        const size_t hash = GetHash(desc, text, len, attrs);
+        for ( Entry& e : m_entries )
+        {
+            if ( e.hash == hash &&
+                    e.attrs == attrs &&
+                        e.text.compare(0, e.text.length(), text, len) == 0 &&
+                            pango_font_description_equal
+                            (
+                                pango_layout_get_font_description(e.layout),
+                                desc
+                            ) )
+            {
+                e.lastUsed = ++m_lastUsed;
+                return e.layout;
+            }
+        }
+
+        return nullptr;
+    }
+
+    // Take ownership of the layout which must have been created for the given
+    // font, text and attributes. It remains valid at least until the next
+    // call to Add().
+    void Add(PangoLayout* layout,
+             const PangoFontDescription* desc,
+             const char* text, size_t len,
+             int attrs)
+    {
+        if ( len > MAX_TEXT_LENGTH )
+        {
+            // Don't waste memory on long strings which are unlikely to be
+            // reused, just keep this layout alive until the next call.
+            if ( m_uncached )
+                g_object_unref(m_uncached);
+            m_uncached = layout;
+            return;
+        }
+
+        Entry* entry;
+        if ( m_entries.size() < MAX_ENTRIES )
+        {
+            m_entries.push_back(Entry());
+            entry = &m_entries.back();
+        }
+        else // Replace the least recently used entry.
+        {
+            entry = &m_entries[0];
+            for ( Entry& e : m_entries )
+            {
+                if ( e.lastUsed < entry->lastUsed )
+                    entry = &e;
+            }
+
+            g_object_unref(entry->layout);
+        }
+
+        entry->hash = GetHash(desc, text, len, attrs);
+        entry->text.assign(text, len);
+        entry->attrs = attrs;
+        entry->layout = layout;
+        entry->lastUsed = ++m_lastUsed;
+    }
+
+    void Clear()
+    {
+        for ( const Entry& e : m_entries )
+            g_object_unref(e.layout);
+        m_entries.clear();
+
+        if ( m_uncached )
+        {
+            g_object_unref(m_uncached);
+            m_uncached = nullptr;
+        }
+    }
+
+private:
+    // The maximal number of layouts and the length of the text in them.
+    enum
+    {
+        MAX_ENTRIES = 64,
+        MAX_TEXT_LENGTH = 256
+    };
+
+    static size_t GetHash(const PangoFontDescription* desc,
+                          const char* text, size_t len,
+                          int attrs)
+    {
+        // Use FNV-1a for the text.
+        size_t hash = 2166136261u;
+        for ( size_t n = 0; n < len; n++ )
+        {
+            hash ^= static_cast<unsigned char>(text[n]);
+            hash *= 16777619u;
+        }
+
+        return hash ^ pango_font_description_hash(desc) ^ attrs;
+    }
+
+    struct Entry
+    {
+        size_t hash;
+        std::string text;
+        int attrs;
+        PangoLayout* layout;
+        unsigned long lastUsed;
+    };
+
+    wxVector<Entry> m_entries;
+    unsigned long m_lastUsed = 0;
+
+    PangoLayout* m_uncached = nullptr;
+
+    wxDECLARE_NO_COPY_CLASS(wxCairoTextLayoutCache);
+};
+
+namespace
+{
+
+// Return the cache used by all the contexts in the current thread.
+wxCairoTextLayoutCache& GetTextLayoutCache()
+{
+    thread_local wxCairoTextLayoutCache s_textLayouts;
+    return s_textLayouts;
+}
+
+// Module releasing the layouts cached by the main thread before Pango is shut
+// down, the other threads release theirs when they exit.
+class wxCairoTextLayoutCacheModule : public wxModule
+{
+public:
+    wxCairoTextLayoutCacheModule() { }
+
+    virtual bool OnInit() override { return true; }
+    virtual void OnExit() override { GetTextLayoutCache().Clear(); }
+
+private:
+    wxDECLARE_DYNAMIC_CLASS(wxCairoTextLayoutCacheModule);
+};
+
+} // anonymous namespace
+
+wxIMPLEMENT_DYNAMIC_CLASS(wxCairoTextLayoutCacheModule, wxModule);
+#endif // __WXGTK__
+
 class WXDLLIMPEXP_CORE wxCairoContext : public wxGraphicsContext
 {
 public:
@@ -483,6 +676,9 @@ public:
     virtual void FillPath( const wxGraphicsPath& p , wxPolygonFillMode fillStyle = wxWINDING_RULE ) override;
     virtual void ClearRectangle( wxDouble x, wxDouble y, wxDouble w, wxDouble h ) override;
     virtual void DrawRectangle( wxDouble x, wxDouble y, wxDouble w, wxDouble h) override;
+    virtual void DrawRectangles( size_t n, const wxRect2DDouble *rects, const wxColour *colours = nullptr ) override;
+    virtual void StrokeSegments( size_t n, const wxPoint2DDouble *beginPoints, const wxPoint2DDouble *endPoints,
+                                 const wxGraphicsPenInfo& pen, const wxColour *colours = nullptr ) override;
 
     virtual void Translate( wxDouble dx , wxDouble dy ) override;
     virtual void Scale( wxDouble xScale , wxDouble yScale ) override;
@@ -539,43 +735,50 @@ protected:
     int m_mswStateSavedDC;
 #endif
 #ifdef __WXGTK__
-    // Tiny helper actually applying the font. It's convenient because it can
-    // be called with a temporary wxFont, as we're going to make a copy of its
-    // Pango font description inside this function before the font object is
-    // destroyed.
-    //
-    // It's also all we need for GTK < 3.
-    static void DoApplyFont(PangoLayout* layout, const wxFont& font)
-    {
-        pango_layout_set_font_description
-        (
-            layout,
-            font.GetNativeFontInfo()->description
-        );
-    }
-
 #if defined(__WXGTK3__) && !defined(__WIN32__)
     // This factor must be applied to the font before actually using it, for
     // consistency with the text drawn by GTK itself.
     float m_fontScalingFactor;
 
-    // Function applying the Pango font description for the given font scaled by
-    // the font scaling factor if necessary to the specified layout.
-    void ApplyFont(PangoLayout* layout, const wxFont& font) const
+    // The last font passed to GetPangoFontDescription() and its scaled
+    // version, cached to avoid creating a new font every time.
+    mutable wxFont m_lastFont,
+                   m_lastScaledFont;
+
+    // Return the Pango font description for the given font scaled by the font
+    // scaling factor if necessary.
+    const PangoFontDescription* GetPangoFontDescription(const wxFont& font) const
     {
         // Only scale the font if we really need to do it.
-        DoApplyFont(layout, m_fontScalingFactor == 1.0f
-                                ? font
-                                : font.Scaled(m_fontScalingFactor));
+        if ( m_fontScalingFactor == 1.0f )
+            return font.GetNativeFontInfo()->description;
+
+        if ( !m_lastFont.IsSameAs(font) )
+        {
+            m_lastFont = font;
+            m_lastScaledFont = font.Scaled(m_fontScalingFactor);
+        }
+
+        return m_lastScaledFont.GetNativeFontInfo()->description;
     }
 #else // GTK < 3
-    // Provide the same function even if it does nothing in this case to keep
-    // the same code for all GTK versions.
-    void ApplyFont(PangoLayout* layout, const wxFont& font) const
+    // Provide the same function even if it does nothing special in this case
+    // to keep the same code for all GTK versions.
+    const PangoFontDescription* GetPangoFontDescription(const wxFont& font) const
     {
-        DoApplyFont(layout, font);
+        return font.GetNativeFontInfo()->description;
     }
 #endif // __WXGTK3__
+
+    // Return the layout with the given text and font, possibly reusing an
+    // existing one. The returned pointer is owned by the per-thread cache and
+    // remains valid until the next call to this function in the same thread.
+    //
+    // If withAttrs is true, Pango attributes needed for underlined or struck
+    // through fonts are also set for the layout.
+    PangoLayout* GetTextLayout(const wxFont& font,
+                               const wxCharBuffer& data,
+                               bool withAttrs) const;
 #endif // __WXGTK__
 
 #ifdef __WXMAC__
@@ -608,7 +811,7 @@ public:
     wxCairoImageContext(wxGraphicsRenderer* renderer, wxImage& image) :
         wxCairoContext(renderer),
         m_image(image),
-        m_data(renderer, image)
+        m_data(renderer, PrepareImage(image))
     {
         Init(cairo_create(m_data.GetCairoSurface()));
         m_width = image.GetWidth();
@@ -622,10 +825,27 @@ public:
 
     virtual void Flush() override
     {
-        m_image = m_data.ConvertToImage();
+        // There is nothing to copy if we draw directly on the image data, but
+        // check whether it's still the case every time, as the image could
+        // have been converted to the default storage or its data could have
+        // been copied since the context creation.
+        if ( m_data.UsesImageData(m_image) )
+            cairo_surface_flush(m_data.GetCairoSurface());
+        else
+            m_image = m_data.ConvertToImage();
     }
 
 private:
+    // Ensure that the image data is not shared with anything else if it uses
+    // packed storage, as we're going to draw on it directly in this case.
+    static const wxImage& PrepareImage(wxImage& image)
+    {
+        if ( image.IsPacked() && !image.HasMask() )
+            image.GetPackedData();
+
+        return image;
+    }
+
     wxImage& m_image;
     wxCairoBitmapData m_data;
 
@@ -1755,10 +1975,39 @@ wxCairoBitmapData::wxCairoBitmapData( wxGraphicsRenderer* renderer, const wxBitm
 
 #if wxUSE_IMAGE
 
+// Key used for associating wxImagePackedBuffer with the surfaces using it.
+static cairo_user_data_key_t gs_imageBufferKey;
+
 wxCairoBitmapData::wxCairoBitmapData(wxGraphicsRenderer* renderer,
                                      const wxImage& image)
     : wxGraphicsBitmapData(renderer)
 {
+    // If the image uses packed storage, its data is already in the format used
+    // by Cairo, so we can just share it instead of copying.
+    wxImagePackedBuffer* const buffer = image.GetPackedBuffer();
+    if ( buffer && !image.HasMask() )
+    {
+        m_width = image.GetWidth();
+        m_height = image.GetHeight();
+        m_buffer = nullptr;
+        m_surface = cairo_image_surface_create_for_data(
+                        reinterpret_cast<unsigned char*>(buffer->GetData()),
+                        CAIRO_FORMAT_ARGB32, m_width, m_height, 4*m_width);
+
+        buffer->IncRef();
+        if ( cairo_surface_set_user_data(m_surface, &gs_imageBufferKey,
+                                         buffer, wxImagePackedBuffer::Release)
+                == CAIRO_STATUS_SUCCESS )
+        {
+            m_pattern = cairo_pattern_create_for_surface(m_surface);
+            return;
+        }
+
+        // Fall back to copying the data if we failed to share it.
+        buffer->DecRef();
+        cairo_surface_destroy(m_surface);
+    }
+
     const cairo_format_t bufferFormat = image.HasAlpha() || image.HasMask()
                                             ? CAIRO_FORMAT_ARGB32
                                             : CAIRO_FORMAT_RGB24;
@@ -1848,6 +2097,14 @@ wxCairoBitmapData::wxCairoBitmapData(wxGraphicsRenderer* renderer,
     InitSurface(bufferFormat, stride);
 }
 
+bool wxCairoBitmapData::UsesImageData(const wxImage& image) const
+{
+    const wxImagePackedBuffer* const buffer = image.GetPackedBuffer();
+
+    return buffer && cairo_image_surface_get_data(m_surface)
+                        == reinterpret_cast<unsigned char*>(buffer->GetData());
+}
+
 wxImage wxCairoBitmapData::ConvertToImage() const
 {
     wxImage image(m_width, m_height, false /* don't clear */);
@@ -2546,6 +2803,7 @@ void wxCairoContext::Init(cairo_t *context, bool storeInitClip)
     // GDK_DPI_SCALE environment variable).
     GdkScreen* screen = gdk_screen_get_default();
     m_fontScalingFactor = screen ? float(gdk_screen_get_resolution(screen) / 96.0) : 1.0f;
+    m_lastFont = wxNullFont;
 #endif
 
     m_context = context;
@@ -2808,6 +3066,107 @@ void wxCairoContext::DrawRectangle( wxDouble x, wxDouble y, wxDouble w, wxDouble
     }
 }
 
+// Set the source of the given context to the (solid) colour.
+static void wxCairoSetSourceColour(cairo_t* cr, const wxColour& colour)
+{
+    cairo_set_source_rgba(cr,
+                          colour.Red()/255.0,
+                          colour.Green()/255.0,
+                          colour.Blue()/255.0,
+                          colour.Alpha()/255.0);
+}
+
+void wxCairoContext::DrawRectangles( size_t n, const wxRect2DDouble *rects, const wxColour *colours )
+{
+    // All rectangles are added to the same path, so make sure the overlapping
+    // ones are filled correctly.
+    cairo_set_fill_rule(m_context, CAIRO_FILL_RULE_WINDING);
+
+    if ( colours )
+    {
+        // Change the source colour only when it really changes, all the
+        // consecutive rectangles of the same colour are filled together.
+        for ( size_t i = 0; i < n; )
+        {
+            const wxColour& colour = colours[i];
+            for ( ; i < n && colours[i] == colour; ++i )
+            {
+                const wxRect2DDouble r = wxGetNormalizedRect2D(rects[i]);
+                cairo_rectangle(m_context, r.m_x, r.m_y, r.m_width, r.m_height);
+            }
+
+            wxCairoSetSourceColour(m_context, colour);
+            cairo_fill(m_context);
+        }
+    }
+    else if ( !m_brush.IsNull() )
+    {
+        ((wxCairoBrushData*)m_brush.GetRefData())->Apply(this);
+        for ( size_t i = 0; i < n; ++i )
+        {
+            const wxRect2DDouble r = wxGetNormalizedRect2D(rects[i]);
+            cairo_rectangle(m_context, r.m_x, r.m_y, r.m_width, r.m_height);
+        }
+        cairo_fill(m_context);
+    }
+
+    if ( !m_pen.IsNull() )
+    {
+        OffsetHelper helper(ShouldOffset(), m_context, m_pen);
+        ((wxCairoPenData*)m_pen.GetRefData())->Apply(this);
+        for ( size_t i = 0; i < n; ++i )
+        {
+            const wxRect2DDouble& r = rects[i];
+            cairo_rectangle(m_context, r.m_x, r.m_y, r.m_width, r.m_height);
+        }
+        cairo_stroke(m_context);
+    }
+}
+
+void wxCairoContext::StrokeSegments( size_t n, const wxPoint2DDouble *beginPoints, const wxPoint2DDouble *endPoints,
+                                     const wxGraphicsPenInfo& pen, const wxColour *colours )
+{
+    const wxGraphicsPen graphicsPen = CreatePen(pen);
+    if ( graphicsPen.IsNull() )
+        return;
+
+    wxCairoPenData* const
+        penData = static_cast<wxCairoPenData*>(graphicsPen.GetRefData());
+
+    // We can't change the colour of the pen using a pattern, so let the
+    // generic implementation create a new pen for each colour in this case.
+    if ( colours && !penData->UsesPlainColour() )
+    {
+        wxGraphicsContext::StrokeSegments(n, beginPoints, endPoints, pen, colours);
+        return;
+    }
+
+    // ShouldOffset() uses the current pen, so make it the pen used here.
+    const wxGraphicsPen formerPen = m_pen;
+    m_pen = graphicsPen;
+
+    {
+        OffsetHelper helper(ShouldOffset(), m_context, m_pen);
+        penData->Apply(this);
+
+        for ( size_t i = 0; i < n; )
+        {
+            const size_t first = i;
+            for ( ; i < n && (!colours || colours[i] == colours[first]); ++i )
+            {
+                cairo_move_to(m_context, beginPoints[i].m_x, beginPoints[i].m_y);
+                cairo_line_to(m_context, endPoints[i].m_x, endPoints[i].m_y);
+            }
+
+            if ( colours )
+                wxCairoSetSourceColour(m_context, colours[first]);
+            cairo_stroke(m_context);
+        }
+    }
+
+    m_pen = formerPen;
+}
+
 void wxCairoContext::Rotate( wxDouble angle )
 {
     cairo_rotate(m_context,angle);
@@ -2956,13 +3315,7 @@ void wxCairoContext::DoDrawText(const wxString& str, wxDouble x, wxDouble y)
     const wxFont& font = fontData->GetFont();
     if ( font.IsOk() )
     {
-        wxGtkObject<PangoLayout> layout(pango_cairo_create_layout (m_context));
-        ApplyFont(layout, font);
-        pango_layout_set_text(layout, data, data.length());
-
-        // Note that Pango attributes don't depend on font size, so we don't
-        // need to use the scaled font here.
-        font.GTKSetPangoAttrs(layout);
+        PangoLayout* const layout = GetTextLayout(font, data, true);
 
         cairo_move_to(m_context, x, y);
         pango_cairo_show_layout (m_context, layout);
@@ -2981,6 +3334,55 @@ void wxCairoContext::DoDrawText(const wxString& str, wxDouble x, wxDouble y)
     cairo_show_text(m_context, data);
 }
 
+#ifdef __WXGTK__
+PangoLayout*
+wxCairoContext::GetTextLayout(const wxFont& font,
+                              const wxCharBuffer& data,
+                              bool withAttrs) const
+{
+    const PangoFontDescription* const desc = GetPangoFontDescription(font);
+
+    // Underline and strikethrough are not part of the font description, so
+    // they must be taken into account separately to avoid reusing a layout
+    // with different attributes.
+    int attrs = 0;
+    if ( withAttrs )
+    {
+        if ( font.GetUnderlined() )
+            attrs |= wxCairoTextLayoutCache::Attr_Underlined;
+        if ( font.GetStrikethrough() )
+            attrs |= wxCairoTextLayoutCache::Attr_Strikethrough;
+    }
+
+    wxCairoTextLayoutCache& textLayouts = GetTextLayoutCache();
+
+    // Note that the scaling factor used by this context, if any, is part of
+    // the font description, so the layouts created by the other contexts are
+    // only reused if it's the same.
+    PangoLayout* layout = textLayouts.Find(desc, data, data.length(), attrs);
+    if ( layout )
+    {
+        // The transformation or the font options could have changed since the
+        // layout was created, this does nothing if they didn't.
+        pango_cairo_update_layout(m_context, layout);
+        return layout;
+    }
+
+    layout = pango_cairo_create_layout(m_context);
+    pango_layout_set_font_description(layout, desc);
+    pango_layout_set_text(layout, data, data.length());
+
+    // Note that Pango attributes don't depend on font size, so we don't
+    // need to use the scaled font here.
+    if ( attrs )
+        font.GTKSetPangoAttrs(layout);
+
+    textLayouts.Add(layout, desc, data, data.length(), attrs);
+
+    return layout;
+}
+#endif // __WXGTK__
+
 void wxCairoContext::GetTextExtent( const wxString &str, wxDouble *width, wxDouble *height,
                                     wxDouble *descent, wxDouble *externalLeading ) const
 {
@@ -3014,14 +3416,12 @@ void wxCairoContext::GetTextExtent( const wxString &str, wxDouble *width, wxDoub
         // measuring its extent.
         int w, h;
 
-        wxGtkObject<PangoLayout> layout(pango_cairo_create_layout (m_context));
-        ApplyFont(layout, font);
         const wxCharBuffer data = str.utf8_str();
         if ( !data )
         {
             return;
         }
-        pango_layout_set_text(layout, data, data.length());
+        PangoLayout* const layout = GetTextLayout(font, data, false);
         pango_layout_get_pixel_size (layout, &w, &h);
         if ( width )
             *width = w;
@@ -3082,11 +3482,9 @@ void wxCairoContext::GetPartialTextExtents(const wxString& text, wxArrayDouble&
     int w = 0;
     if (data.length())
     {
-        wxGtkObject<PangoLayout> layout(pango_cairo_create_layout(m_context));
         const wxFont& font = static_cast<wxCairoFontData*>(m_font.GetRefData())->GetFont();
 
-        ApplyFont(layout, font);
-        pango_layout_set_text(layout, data, data.length());
+        PangoLayout* const layout = GetTextLayout(font, data, false);
 
         // Check if we have any Unicode characters in the text.
         if (const gint num_chars = pango_layout_get_character_count(layout))
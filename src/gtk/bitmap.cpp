@@ -25,6 +25,13 @@
 #include "wx/gtk/private/object.h"
 #include "wx/gtk/private.h"
 
+#if defined(__WXGTK3__) && wxUSE_IMAGE
+    #include "wx/private/image.h"
+
+// Key used for associating wxImagePackedBuffer with the surfaces using it.
+static cairo_user_data_key_t gs_imageBufferKey;
+#endif
+
 GdkWindow* wxGetTopLevelGDK();
 
 #ifndef __WXGTK3__
@@ -586,12 +593,50 @@ static void CopyImageData(
 
 #if wxUSE_IMAGE
 #ifdef __WXGTK3__
+// Create the surface using the data of an image in packed storage mode, which
+// has the same layout as Cairo surfaces, directly.
+static cairo_surface_t*
+CreateSurfaceFromImageBuffer(wxImagePackedBuffer* buffer, bool useAlpha, int w, int h)
+{
+    cairo_surface_t* surface = cairo_image_surface_create_for_data(
+        reinterpret_cast<guchar*>(buffer->GetData()),
+        useAlpha ? CAIRO_FORMAT_ARGB32 : CAIRO_FORMAT_RGB24, w, h, 4 * w);
+
+    buffer->IncRef();
+    if (cairo_surface_set_user_data(surface, &gs_imageBufferKey,
+                                    buffer, wxImagePackedBuffer::Release) != CAIRO_STATUS_SUCCESS)
+    {
+        buffer->DecRef();
+        cairo_surface_destroy(surface);
+        return nullptr;
+    }
+
+    return surface;
+}
+
 void wxBitmap::InitFromImage(const wxImage& image, int depth, double scale)
 {
     wxCHECK_RET(image.IsOk(), "invalid image");
 
     const int w = image.GetWidth();
     const int h = image.GetHeight();
+
+    wxImagePackedBuffer* const buffer = image.GetPackedBuffer();
+    if (buffer && depth != 1 && !image.HasMask())
+    {
+        if (depth < 0)
+            depth = image.HasAlpha() ? 32 : 24;
+        wxBitmapRefData* bmpData = new wxBitmapRefData(w, h, depth);
+        bmpData->m_scaleFactor = scale;
+        bmpData->m_surface = CreateSurfaceFromImageBuffer(buffer, bmpData->m_bpp == 32, w, h);
+        m_refData = bmpData;
+        if (bmpData->m_surface)
+            return;
+
+        // Fall back to copying the data below if sharing it failed.
+        UnRef();
+    }
+
     const guchar* alpha = image.GetAlpha();
     if (depth < 0)
         depth = alpha ? 32 : 24;
@@ -1366,7 +1411,20 @@ cairo_t* wxBitmap::CairoCreate() const
     wxBitmapRefData* bmpData = M_BMPDATA;
     cairo_t* cr;
     if (bmpData->m_surface)
+    {
+#if wxUSE_IMAGE
+        // Don't draw on the data shared with the image this bitmap was
+        // created from, make a copy of it first.
+        if (cairo_surface_get_user_data(bmpData->m_surface, &gs_imageBufferKey))
+        {
+            cairo_surface_t* surface = GetSubSurface(bmpData->m_surface,
+                wxRect(0, 0, bmpData->m_width, bmpData->m_height));
+            cairo_surface_destroy(bmpData->m_surface);
+            bmpData->m_surface = surface;
+        }
+#endif // wxUSE_IMAGE
         cr = cairo_create(bmpData->m_surface);
+    }
     else
     {
         GdkPixbuf* pixbuf = bmpData->m_pixbufNoMask;
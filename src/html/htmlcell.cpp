@@ -24,6 +24,7 @@
 #include "wx/html/htmlcell.h"
 #include "wx/html/htmlwin.h"
 
+#include <limits.h>
 #include <stdlib.h>
 
 //-----------------------------------------------------------------------------
@@ -692,11 +693,20 @@ wxHtmlContainerCell::~wxHtmlContainerCell()
 void wxHtmlContainerCell::SetIndent(int i, int what, int units)
 {
     int val = (units == wxHTML_UNITS_PIXELS) ? i : -i;
-    if (what & wxHTML_INDENT_LEFT) m_IndentLeft = val;
-    if (what & wxHTML_INDENT_RIGHT) m_IndentRight = val;
-    if (what & wxHTML_INDENT_TOP) m_IndentTop = val;
-    if (what & wxHTML_INDENT_BOTTOM) m_IndentBottom = val;
-    m_LastLayout = -1;
+    bool changed = false;
+    if ((what & wxHTML_INDENT_LEFT) && m_IndentLeft != val)
+        { m_IndentLeft = val; changed = true; }
+    if ((what & wxHTML_INDENT_RIGHT) && m_IndentRight != val)
+        { m_IndentRight = val; changed = true; }
+    if ((what & wxHTML_INDENT_TOP) && m_IndentTop != val)
+        { m_IndentTop = val; changed = true; }
+    if ((what & wxHTML_INDENT_BOTTOM) && m_IndentBottom != val)
+        { m_IndentBottom = val; changed = true; }
+
+    // Don't invalidate the layout needlessly, this function is called from
+    // Layout() itself by some derived classes.
+    if (changed)
+        m_LastLayout = -1;
 }
 
 
@@ -749,9 +759,11 @@ void wxHtmlContainerCell::Layout(int w)
 {
     wxHtmlCell::Layout(w);
 
-    if (m_LastLayout == w)
-        return;
+    // Nothing changed since the last layout if m_LastLayout is set, except
+    // for the cells which could have been appended or changed since then.
+    const bool wasLaidOut = m_LastLayout != -1;
     m_LastLayout = w;
+    m_LayoutNotifiedParent = false;
 
     // VS: Any attempt to layout with negative or zero width leads to hell,
     // but we can't ignore such attempts completely, since it sometimes
@@ -767,7 +779,6 @@ void wxHtmlContainerCell::Layout(int w)
     int ysizeup = 0, ysizedown = 0;
     int MaxLineWidth = 0;
     int curLineWidth = 0;
-    m_MaxTotalWidth = 0;
 
 
     /*
@@ -776,23 +787,71 @@ void wxHtmlContainerCell::Layout(int w)
 
     */
 
+    int width;
     if (m_WidthFloatUnits == wxHTML_UNITS_PERCENT)
     {
-        if (m_WidthFloat < 0) m_Width = (100 + m_WidthFloat) * w / 100;
-        else m_Width = m_WidthFloat * w / 100;
+        if (m_WidthFloat < 0) width = (100 + m_WidthFloat) * w / 100;
+        else width = m_WidthFloat * w / 100;
     }
     else
     {
-        if (m_WidthFloat < 0) m_Width = w + m_WidthFloat;
-        else m_Width = m_WidthFloat;
+        if (m_WidthFloat < 0) width = w + m_WidthFloat;
+        else width = m_WidthFloat;
     }
 
-    if (m_Cells)
+    // Laying out big containers is relatively expensive, so avoid doing it if
+    // our width didn't change, e.g. because it is fixed, or if it did change
+    // but not in a way affecting the layout of our contents, and only lay out
+    // the last lines if the cells were just appended to them.
+    LayoutLine resume;
+    if (wasLaidOut && ReuseLayout(width, &resume) && !resume.cell)
+        return;
+
+    m_Width = width;
+    m_LayoutWidth = width;
+    m_LayoutCellsAppended = false;
+
+    wxHtmlCell *first = m_Cells;
+    if (resume.cell)
+    {
+        // the cells before this line remain where they are:
+        first = resume.cell;
+        ypos = resume.ypos;
+        MaxLineWidth = resume.maxLineWidth;
+        curLineWidth = resume.curLineWidth;
+        m_MaxTotalWidth = resume.maxTotalWidth;
+        m_LayoutLineWidthMin = resume.lineWidthMin;
+        m_LayoutLineWidthMax = resume.lineWidthMax;
+
+        // the line before the last one remains valid if we resume from it
+        if (resume.cell == m_LayoutLastLine.cell)
+            m_LayoutLastLine = m_LayoutPrevLine;
+        else
+            m_LayoutLastLine = LayoutLine();
+    }
+    else
+    {
+        m_LayoutHasWidthDependentCells = false;
+        m_LayoutLineWidthMin = INT_MIN;
+        m_LayoutLineWidthMax = INT_MAX;
+        m_MaxTotalWidth = 0;
+        m_LayoutLastLine = LayoutLine();
+    }
+
+    if (first)
     {
         int l = (m_IndentLeft < 0) ? (-m_IndentLeft * m_Width / 100) : m_IndentLeft;
         int r = (m_IndentRight < 0) ? (-m_IndentRight * m_Width / 100) : m_IndentRight;
-        for (wxHtmlCell *cell = m_Cells; cell; cell = cell->GetNext())
+        for (wxHtmlCell *cell = first; cell; cell = cell->GetNext())
+        {
             cell->Layout(m_Width - (l + r));
+
+            if (cell->IsLayoutWidthDependent())
+                m_LayoutHasWidthDependentCells = true;
+
+            if (!cell->IsTerminalCell())
+                ((wxHtmlContainerCell*)cell)->m_LayoutNotifiedParent = false;
+        }
     }
 
     /*
@@ -806,10 +865,24 @@ void wxHtmlContainerCell::Layout(int w)
     s_width = m_Width - s_indent - ((m_IndentRight < 0) ? (-m_IndentRight * m_Width / 100) : m_IndentRight);
 
     // my own layout:
-    wxHtmlCell *cell = m_Cells,
-               *line = m_Cells;
+    wxHtmlCell *cell = first,
+               *line = first;
     while (cell != nullptr)
     {
+        if (cell == line)
+        {
+            // remember the state at the beginning of the line to be able to
+            // resume the layout from it if more cells are appended later:
+            m_LayoutPrevLine = m_LayoutLastLine;
+            m_LayoutLastLine.cell = cell;
+            m_LayoutLastLine.ypos = ypos;
+            m_LayoutLastLine.maxLineWidth = MaxLineWidth;
+            m_LayoutLastLine.maxTotalWidth = m_MaxTotalWidth;
+            m_LayoutLastLine.curLineWidth = curLineWidth;
+            m_LayoutLastLine.lineWidthMin = m_LayoutLineWidthMin;
+            m_LayoutLastLine.lineWidthMax = m_LayoutLineWidthMax;
+        }
+
         switch (m_AlignVer)
         {
             case wxHTML_ALIGN_TOP :      ybasicpos = 0; break;
@@ -855,6 +928,22 @@ void wxHtmlContainerCell::Layout(int w)
             } while (nextCell && !nextCell->IsLinebreakAllowed());
         }
 
+        // remember the range of the line widths for which the decision below
+        // would remain the same:
+        if (cell && cell->IsLinebreakAllowed())
+        {
+            if (xpos + nextWordWidth > s_width)
+            {
+                if (xpos + nextWordWidth < m_LayoutLineWidthMax)
+                    m_LayoutLineWidthMax = xpos + nextWordWidth;
+            }
+            else
+            {
+                if (xpos + nextWordWidth > m_LayoutLineWidthMin)
+                    m_LayoutLineWidthMin = xpos + nextWordWidth;
+            }
+        }
+
         // force new line if occurred:
         if ((cell == nullptr) ||
             (xpos + nextWordWidth > s_width && cell->IsLinebreakAllowed()))
@@ -979,30 +1068,171 @@ void wxHtmlContainerCell::Layout(int w)
     }
 
     // setup height & width, depending on container layout:
-    m_Height = ypos + (ysizedown + ysizeup) + m_IndentBottom;
+    m_LayoutHeight = ypos + (ysizedown + ysizeup) + m_IndentBottom;
+    m_LayoutMinHeightOffset = 0;
+    ApplyMinHeight();
 
-    if (m_Height < m_MinHeight)
+    if (curLineWidth > m_MaxTotalWidth)
+        m_MaxTotalWidth = curLineWidth;
+
+    m_MaxTotalWidth += s_indent + ((m_IndentRight < 0) ? (-m_IndentRight * m_Width / 100) : m_IndentRight);
+    MaxLineWidth += s_indent + ((m_IndentRight < 0) ? (-m_IndentRight * m_Width / 100) : m_IndentRight);
+    m_LayoutUsedWidth = MaxLineWidth;
+    if (m_Width < MaxLineWidth) m_Width = MaxLineWidth;
+
+    m_LayoutChangedChildren = 0;
+}
+
+bool wxHtmlContainerCell::ReuseLayout(int width, LayoutLine *resume)
+{
+    const int l = (m_IndentLeft < 0) ? (-m_IndentLeft * width / 100) : m_IndentLeft;
+    const int r = (m_IndentRight < 0) ? (-m_IndentRight * width / 100) : m_IndentRight;
+
+    if (width != m_LayoutWidth)
     {
-        if (m_MinHeightAlign != wxHTML_ALIGN_TOP)
+        // The cells added or changed since the last layout can't be taken
+        // into account by the checks below.
+        if (m_LayoutCellsAppended || m_LayoutChangedChildren)
+            return false;
+
+        // The horizontal positions of the cells depend on the width unless
+        // they're left-aligned and the indents are fixed.
+        if (m_AlignHor != wxHTML_ALIGN_LEFT ||
+                m_IndentLeft < 0 || m_IndentRight < 0)
+            return false;
+
+        // And the lines must be broken in the same places.
+        const int s_width = width - l - r;
+        if (s_width < m_LayoutLineWidthMin || s_width >= m_LayoutLineWidthMax)
+            return false;
+
+        // The cells whose layout depends on our width must be laid out again,
+        // but we can only keep our own layout if their size remains the same.
+        if (m_LayoutHasWidthDependentCells)
         {
-            int diff = m_MinHeight - m_Height;
-            if (m_MinHeightAlign == wxHTML_ALIGN_CENTER) diff /= 2;
-            cell = m_Cells;
-            while (cell)
+            for (wxHtmlCell *cell = m_Cells; cell; cell = cell->GetNext())
             {
-                cell->SetPos(cell->GetPosX(), cell->GetPosY() + diff);
-                cell = cell->GetNext();
+                if (!cell->IsLayoutWidthDependent())
+                    continue;
+
+                const int x = cell->GetPosX(),
+                          y = cell->GetPosY(),
+                          cellWidth = cell->GetWidth(),
+                          cellHeight = cell->GetHeight(),
+                          cellDescent = cell->GetDescent(),
+                          cellMaxWidth = cell->GetMaxTotalWidth();
+
+                cell->Layout(width - (l + r));
+                cell->SetPos(x, y);
+
+                if (cell->GetWidth() != cellWidth ||
+                        cell->GetHeight() != cellHeight ||
+                            cell->GetDescent() != cellDescent ||
+                                cell->GetMaxTotalWidth() != cellMaxWidth)
+                    return false;
             }
         }
-        m_Height = m_MinHeight;
     }
+    else if (m_LayoutCellsAppended || m_LayoutChangedChildren)
+    {
+        // Only the child containers which changed since the last layout and
+        // the appended cells need to be laid out. As the document is normally
+        // modified at its end, e.g. by wxHtmlWindow::AppendToPage(), look for
+        // them only in the last two lines and give up if they're not there.
+        if (m_LayoutMinHeightOffset)
+            return false;
 
-    if (curLineWidth > m_MaxTotalWidth)
-        m_MaxTotalWidth = curLineWidth;
+        const LayoutLine *line = m_LayoutPrevLine.cell ? &m_LayoutPrevLine
+                                                       : &m_LayoutLastLine;
+        if (!line->cell)
+            return false;
 
-    m_MaxTotalWidth += s_indent + ((m_IndentRight < 0) ? (-m_IndentRight * m_Width / 100) : m_IndentRight);
-    MaxLineWidth += s_indent + ((m_IndentRight < 0) ? (-m_IndentRight * m_Width / 100) : m_IndentRight);
-    if (m_Width < MaxLineWidth) m_Width = MaxLineWidth;
+        const LayoutLine *resumeLine = nullptr;
+        int changed = 0;
+        for (wxHtmlCell *cell = line->cell; cell; cell = cell->GetNext())
+        {
+            if (cell == m_LayoutLastLine.cell)
+                line = &m_LayoutLastLine;
+
+            if (cell->IsTerminalCell())
+                continue;
+
+            wxHtmlContainerCell* const cont = (wxHtmlContainerCell*)cell;
+            if (!cont->m_LayoutNotifiedParent)
+                continue;
+
+            changed++;
+
+            const int x = cont->GetPosX(),
+                      y = cont->GetPosY(),
+                      cellWidth = cont->GetWidth(),
+                      cellHeight = cont->GetHeight(),
+                      cellDescent = cont->GetDescent(),
+                      cellMaxWidth = cont->GetMaxTotalWidth();
+
+            cont->Layout(width - (l + r));
+            cont->SetPos(x, y);
+            cont->m_LayoutNotifiedParent = false;
+
+            if (resumeLine)
+                continue;
+
+            if (cont->GetWidth() != cellWidth ||
+                    cont->GetHeight() != cellHeight ||
+                        cont->GetDescent() != cellDescent ||
+                            cont->GetMaxTotalWidth() != cellMaxWidth)
+            {
+                // The line break before this cell could disappear if it
+                // became narrower, so the previous line must be laid out
+                // again too in this case.
+                if (cell == line->cell && cell != m_Cells &&
+                        cont->GetWidth() < cellWidth)
+                    return false;
+
+                resumeLine = line;
+            }
+        }
+
+        if (changed != m_LayoutChangedChildren)
+            return false;
+
+        if (m_LayoutCellsAppended && !resumeLine)
+            resumeLine = &m_LayoutLastLine;
+
+        if (resumeLine)
+        {
+            *resume = *resumeLine;
+            return true;
+        }
+    }
+
+    m_LayoutChangedChildren = 0;
+    m_LayoutWidth = width;
+    m_Width = wxMax(width, m_LayoutUsedWidth);
+    ApplyMinHeight();
+
+    return true;
+}
+
+void wxHtmlContainerCell::ApplyMinHeight()
+{
+    int offset = 0;
+    if (m_LayoutHeight < m_MinHeight && m_MinHeightAlign != wxHTML_ALIGN_TOP)
+    {
+        offset = m_MinHeight - m_LayoutHeight;
+        if (m_MinHeightAlign == wxHTML_ALIGN_CENTER) offset /= 2;
+    }
+
+    if (offset != m_LayoutMinHeightOffset)
+    {
+        const int diff = offset - m_LayoutMinHeightOffset;
+        for (wxHtmlCell *cell = m_Cells; cell; cell = cell->GetNext())
+            cell->SetPos(cell->GetPosX(), cell->GetPosY() + diff);
+
+        m_LayoutMinHeightOffset = offset;
+    }
+
+    m_Height = wxMax(m_LayoutHeight, m_MinHeight);
 }
 
 void wxHtmlContainerCell::UpdateRenderingStatePre(wxHtmlRenderingInfo& info,
@@ -1189,7 +1419,13 @@ void wxHtmlContainerCell::InsertCell(wxHtmlCell *f)
         if (m_LastCell) while (m_LastCell->GetNext()) m_LastCell = m_LastCell->GetNext();
     }
     f->SetParent(this);
-    m_LastLayout = -1;
+
+    // if we had been already laid out, it's enough to lay out the last line
+    // containing the new cell, otherwise we must be laid out anyhow
+    if (m_LastLayout != -1)
+        m_LayoutCellsAppended = true;
+
+    NotifyLayoutChange();
 }
 
 
@@ -1227,6 +1463,22 @@ void wxHtmlContainerCell::Detach(wxHtmlCell *cell)
 
     cell->SetParent(nullptr);
     cell->SetNext(nullptr);
+
+    m_LastLayout = -1;
+    NotifyLayoutChange();
+}
+
+void wxHtmlContainerCell::NotifyLayoutChange()
+{
+    // Parent containers count the children which must be laid out again to
+    // avoid iterating over all of them when laying themselves out.
+    for (wxHtmlContainerCell *cont = this;
+         !cont->m_LayoutNotifiedParent && cont->GetParent();
+         cont = cont->GetParent())
+    {
+        cont->m_LayoutNotifiedParent = true;
+        cont->GetParent()->m_LayoutChangedChildren++;
+    }
 }
 
 
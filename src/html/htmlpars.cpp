@@ -99,6 +99,24 @@ wxObject* wxHtmlParser::Parse(const wxString& source)
     return result;
 }
 
+wxObject* wxHtmlParser::ParseAppended(const wxString& source)
+{
+    // Take the ownership of the previous source to avoid copying it.
+    wxString* const prev = const_cast<wxString*>(m_Source);
+    m_Source = nullptr;
+
+    wxObject *result = Parse(source);
+
+    if ( prev )
+    {
+        prev->append(*m_Source);
+        delete m_Source;
+        m_Source = prev;
+    }
+
+    return result;
+}
+
 void wxHtmlParser::InitParser(const wxString& source)
 {
     SetSource(source);
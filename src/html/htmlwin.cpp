@@ -350,6 +350,7 @@ void wxHtmlWindow::Init()
     m_lastDoubleClick = 0;
 #endif // wxUSE_CLIPBOARD
     m_tmpSelFromCell = nullptr;
+    m_tmpAppendCell = nullptr;
 }
 
 bool wxHtmlWindow::Create(wxWindow *parent, wxWindowID id,
@@ -460,14 +461,52 @@ bool wxHtmlWindow::SetPage(const wxString& source)
 
 bool wxHtmlWindow::DoSetPage(const wxString& source)
 {
-    wxString newsrc(source);
-
     wxDELETE(m_selection);
 
     // we will soon delete all the cells, so clear pointers to them:
     m_tmpSelFromCell = nullptr;
+    m_tmpAppendCell = nullptr;
 
     // pass HTML through registered processors:
+    const wxString newsrc = ApplyProcessors(source);
+
+    // ...and run the parser on it:
+    wxClientDC dc(this);
+    dc.SetMapMode(wxMM_TEXT);
+    SetBackgroundColour(wxSystemSettings::GetColour(wxSYS_COLOUR_WINDOW));
+    SetBackgroundImage(wxNullBitmap);
+
+    double pixelScale = 1.0;
+#ifndef wxHAS_DPI_INDEPENDENT_PIXELS
+    pixelScale = GetDPIScaleFactor();
+#endif
+
+    m_Parser->SetDC(&dc, pixelScale, 1.0);
+
+    // notice that it's important to set m_Cell to nullptr here before calling
+    // Parse() below, even if it will be overwritten by its return value as
+    // without this we may crash if it's used from inside Parse(), so use
+    // wxDELETE() and not just delete here
+    wxDELETE(m_Cell);
+
+    m_Cell = (wxHtmlContainerCell*) m_Parser->Parse(newsrc);
+
+    // The parser doesn't need the DC any more, so ensure it's not left with a
+    // dangling pointer after the DC object goes out of scope.
+    m_Parser->SetDC(nullptr);
+
+    m_Cell->SetIndent(m_Borders, wxHTML_INDENT_ALL, wxHTML_UNITS_PIXELS);
+    m_Cell->SetAlignHor(wxHTML_ALIGN_CENTER);
+    CreateLayout();
+    if (m_tmpCanDrawLocks == 0)
+        Refresh();
+    return true;
+}
+
+wxString wxHtmlWindow::ApplyProcessors(const wxString& source) const
+{
+    wxString newsrc(source);
+
     if (m_Processors || m_GlobalProcessors)
     {
         wxHtmlProcessorList::iterator nodeL, nodeG;
@@ -512,11 +551,39 @@ bool wxHtmlWindow::DoSetPage(const wxString& source)
         }
     }
 
-    // ...and run the parser on it:
+    return newsrc;
+}
+
+bool wxHtmlWindow::AppendToPage(const wxString& source)
+{
+    if ( !m_Cell )
+        return DoSetPage(source);
+
+    // Find the container in which the parsing of the page ended: this is the
+    // last container before the empty one always added to the end by the
+    // parser.
+    if ( !m_tmpAppendCell )
+    {
+        for ( wxHtmlCell* cell = m_Cell->GetFirstChild(); cell; )
+        {
+            wxHtmlCell* const next = cell->GetNext();
+            if ( next && !next->GetNext() && !cell->IsTerminalCell() )
+                m_tmpAppendCell = static_cast<wxHtmlContainerCell*>(cell);
+
+            cell = next;
+        }
+
+        // We can't append to the page if it wasn't created by the parser.
+        if ( !m_tmpAppendCell )
+            return DoSetPage(*(m_Parser->GetSource()) + source);
+    }
+
+    // Parse only the new fragment, continuing in this container as if the
+    // fragment were parsed together with the existing page, so that e.g. the
+    // text at its beginning continues the last paragraph and a paragraph
+    // opened at its beginning reuses the empty container after <br>.
     wxClientDC dc(this);
     dc.SetMapMode(wxMM_TEXT);
-    SetBackgroundColour(wxSystemSettings::GetColour(wxSYS_COLOUR_WINDOW));
-    SetBackgroundImage(wxNullBitmap);
 
     double pixelScale = 1.0;
 #ifndef wxHAS_DPI_INDEPENDENT_PIXELS
@@ -525,31 +592,19 @@ bool wxHtmlWindow::DoSetPage(const wxString& source)
 
     m_Parser->SetDC(&dc, pixelScale, 1.0);
 
-    // notice that it's important to set m_Cell to nullptr here before calling
-    // Parse() below, even if it will be overwritten by its return value as
-    // without this we may crash if it's used from inside Parse(), so use
-    // wxDELETE() and not just delete here
-    wxDELETE(m_Cell);
-
-    m_Cell = (wxHtmlContainerCell*) m_Parser->Parse(newsrc);
+    m_tmpAppendCell = m_Parser->ParseAppendedTo(m_tmpAppendCell,
+                                                ApplyProcessors(source));
 
-    // The parser doesn't need the DC any more, so ensure it's not left with a
-    // dangling pointer after the DC object goes out of scope.
     m_Parser->SetDC(nullptr);
 
-    m_Cell->SetIndent(m_Borders, wxHTML_INDENT_ALL, wxHTML_UNITS_PIXELS);
-    m_Cell->SetAlignHor(wxHTML_ALIGN_CENTER);
+    // Thanks to the layout of the existing cells being preserved, only the
+    // appended ones are laid out here.
     CreateLayout();
     if (m_tmpCanDrawLocks == 0)
         Refresh();
     return true;
 }
 
-bool wxHtmlWindow::AppendToPage(const wxString& source)
-{
-    return DoSetPage(*(GetParser()->GetSource()) + source);
-}
-
 bool wxHtmlWindow::LoadPage(const wxString& location)
 {
     wxCHECK_MSG( !location.empty(), false, "location must be non-empty" );
@@ -69,6 +69,8 @@ public:
               int WXUNUSED(view_y1), int WXUNUSED(view_y2),
               wxHtmlRenderingInfo& WXUNUSED(info)) override {}
 
+    bool IsLayoutWidthDependent() const override { return false; }
+
 private:
     wxDECLARE_NO_COPY_CLASS(wxHtmlPageBreakCell);
 };
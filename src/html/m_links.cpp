@@ -35,6 +35,8 @@ public:
               int WXUNUSED(view_y1), int WXUNUSED(view_y2),
               wxHtmlRenderingInfo& WXUNUSED(info)) override {}
 
+    bool IsLayoutWidthDependent() const override { return false; }
+
     virtual const wxHtmlCell* Find(int condition, const void* param) const override
     {
         if (CheckIsAnchor(condition, param, m_AnchorName) ||
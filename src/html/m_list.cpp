@@ -36,6 +36,7 @@ class wxHtmlListmarkCell : public wxHtmlCell
         wxHtmlListmarkCell(wxDC *dc, const wxColour& clr);
         void Draw(wxDC& dc, int x, int y, int view_y1, int view_y2,
                   wxHtmlRenderingInfo& info) override;
+        bool IsLayoutWidthDependent() const override { return false; }
 
     wxDECLARE_NO_COPY_CLASS(wxHtmlListmarkCell);
 };
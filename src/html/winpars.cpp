@@ -39,6 +39,8 @@ wxHtmlWinParser::wxHtmlWinParser(wxHtmlWindowInterface *wndIface)
 {
     m_windowInterface = wndIface;
     m_Container = nullptr;
+    m_appendContainer = nullptr;
+    m_appendFormatting = nullptr;
     m_DC = nullptr;
     m_CharHeight = m_CharWidth = 0;
     m_UseLink = false;
@@ -216,16 +218,56 @@ void wxHtmlWinParser::InitParser(const wxString& source)
     m_tmpLastWasSpace = false;
     m_lastWordCell = nullptr;
 
-    // open the toplevel container that contains everything else and that
-    // is never closed (this makes parser's life easier):
-    OpenContainer();
+    wxHtmlContainerCell *formatting;
+    if (m_appendContainer)
+    {
+        // continue adding the cells to the existing container:
+        SetContainer(m_appendContainer);
 
-    // then open the first container into which page's content will go:
-    OpenContainer();
+        // the tag handlers reuse the current container if it's empty, so
+        // don't add anything to it before parsing in this case and insert the
+        // formatting cells at its beginning in GetProduct() instead:
+        if (m_appendContainer->GetFirstChild())
+        {
+            formatting = m_Container;
+
+            // the new text continues the last word of the container, if any:
+            for (wxHtmlCell *cell = m_appendContainer->GetFirstChild();
+                 cell;
+                 cell = cell->GetNext())
+            {
+                wxHtmlWordCell * const word = wxDynamicCast(cell, wxHtmlWordCell);
+                if (word)
+                    m_lastWordCell = word;
+            }
+
+            if (m_lastWordCell)
+            {
+                const wxString text = m_lastWordCell->ConvertToText(nullptr);
+                m_tmpLastWasSpace = !text.empty() && wxIsspace(text.Last());
+            }
+        }
+        else
+        {
+            m_appendFormatting = new wxHtmlContainerCell(nullptr);
+            formatting = m_appendFormatting;
+        }
+    }
+    else
+    {
+        // open the toplevel container that contains everything else and that
+        // is never closed (this makes parser's life easier):
+        OpenContainer();
+
+        // then open the first container into which page's content will go:
+        OpenContainer();
+
+        formatting = m_Container;
+    }
 
-    m_Container->InsertCell(new wxHtmlColourCell(m_ActualColor));
+    formatting->InsertCell(new wxHtmlColourCell(m_ActualColor));
 
-    m_Container->InsertCell
+    formatting->InsertCell
                  (
                    new wxHtmlColourCell
                        (
@@ -234,7 +276,7 @@ void wxHtmlWinParser::InitParser(const wxString& source)
                        )
                   );
 
-    m_Container->InsertCell(new wxHtmlFontCell(CreateCurrentFont()));
+    formatting->InsertCell(new wxHtmlFontCell(CreateCurrentFont()));
 }
 
 void wxHtmlWinParser::DoneParser()
@@ -247,6 +289,38 @@ wxObject* wxHtmlWinParser::GetProduct()
 {
     wxHtmlContainerCell *top;
 
+    if (m_appendContainer)
+    {
+        if (m_appendFormatting)
+        {
+            wxHtmlCell *cell;
+            while ((cell = m_appendContainer->GetFirstChild()) != nullptr)
+            {
+                m_appendContainer->Detach(cell);
+                m_appendFormatting->InsertCell(cell);
+            }
+
+            while ((cell = m_appendFormatting->GetFirstChild()) != nullptr)
+            {
+                m_appendFormatting->Detach(cell);
+                m_appendContainer->InsertCell(cell);
+            }
+
+            wxDELETE(m_appendFormatting);
+        }
+
+        // remember where the parsing ended for ParseAppendedTo() and leave
+        // the rest of the document as is: unlike for a complete document,
+        // don't add an empty container at its end and don't remove the
+        // spacing at its top and bottom
+        m_appendContainer = m_Container;
+
+        top = m_Container;
+        while (top->GetParent()) top = top->GetParent();
+
+        return top;
+    }
+
     CloseContainer();
     OpenContainer();
 
@@ -257,6 +331,20 @@ wxObject* wxHtmlWinParser::GetProduct()
     return top;
 }
 
+wxHtmlContainerCell *
+wxHtmlWinParser::ParseAppendedTo(wxHtmlContainerCell *container,
+                                 const wxString& source)
+{
+    m_appendContainer = container;
+
+    ParseAppended(source);
+
+    wxHtmlContainerCell * const last = m_appendContainer;
+    m_appendContainer = nullptr;
+
+    return last;
+}
+
 wxFSFile *wxHtmlWinParser::OpenURL(wxHtmlURLType type,
                                    const wxString& url) const
 {
@@ -21,7 +21,13 @@
 #include <unistd.h>
 #include "wx/private/fswatcher.h"
 
+#if wxUSE_TIMER
+    #include "wx/timer.h"
+#endif
+
+#include <memory>
 #include <unordered_map>
+#include <vector>
 
 // ============================================================================
 // wxFSWatcherImpl implementation & helper wxFSWSourceHandler implementation
@@ -33,6 +39,31 @@ using wxFSWatchEntryDescriptors = std::unordered_map<int, wxFSWatchEntry*>;
 // inotify event cookie => inotify_event* map
 using wxInotifyCookies = std::unordered_map<int, inotify_event*>;
 
+// maximal number of events waiting to be coalesced, when it is reached they
+// are all sent immediately
+static const size_t wxFSW_MAX_COALESCED_EVENTS = 4096;
+
+class wxFSWatcherImplUnix;
+
+#if wxUSE_TIMER
+
+// Timer used to send the coalesced events when the coalescing interval ends.
+class wxFSWCoalescingTimer : public wxTimer
+{
+public:
+    explicit wxFSWCoalescingTimer(wxFSWatcherImplUnix* service)
+        : m_service(service)
+    {
+    }
+
+    virtual void Notify() override;
+
+private:
+    wxFSWatcherImplUnix* const m_service;
+};
+
+#endif // wxUSE_TIMER
+
 /**
  * Helper class encapsulating inotify mechanism
  */
@@ -49,6 +80,9 @@ public:
 
     ~wxFSWatcherImplUnix()
     {
+        // it's too late to send any events now
+        DiscardCoalescedEvents();
+
         // we close inotify only if initialized before
         if (IsOk())
         {
@@ -205,6 +239,27 @@ public:
         return m_source != nullptr;
     }
 
+    // send all the events which were being coalesced
+    void SendCoalescedEvents()
+    {
+#if wxUSE_TIMER
+        if ( m_coalescingTimer )
+            m_coalescingTimer->Stop();
+#endif // wxUSE_TIMER
+
+        if ( m_coalescedEvents.empty() )
+            return;
+
+        // the handlers could generate more events, so don't iterate over the
+        // vector itself
+        std::vector<wxFileSystemWatcherEvent> events;
+        events.swap(m_coalescedEvents);
+        m_coalescedIndex.clear();
+
+        for ( wxFileSystemWatcherEvent& event : events )
+            DoSendEvent(event);
+    }
+
 protected:
     int DoAddInotify(wxFSWatchEntry* watch)
     {
@@ -536,11 +591,103 @@ protected:
     }
 
     void SendEvent(wxFileSystemWatcherEvent& evt)
+    {
+#if wxUSE_TIMER
+        const int interval = m_watcher->GetCoalescingInterval();
+        if ( interval > 0 && CanCoalesce(evt) )
+        {
+            CoalesceEvent(evt, interval);
+            return;
+        }
+#endif // wxUSE_TIMER
+
+        // don't change the order of events: send any coalesced events, which
+        // had happened before this one, first
+        SendCoalescedEvents();
+
+        DoSendEvent(evt);
+    }
+
+    void DoSendEvent(wxFileSystemWatcherEvent& evt)
     {
         wxLogTrace(wxTRACE_FSWATCHER, evt.ToString());
         m_watcher->GetOwner()->ProcessEvent(evt);
     }
 
+    static bool CanCoalesce(const wxFileSystemWatcherEvent& evt)
+    {
+        switch ( evt.GetChangeType() )
+        {
+            case wxFSW_EVENT_MODIFY:
+            case wxFSW_EVENT_ACCESS:
+            case wxFSW_EVENT_ATTRIB:
+            case wxFSW_EVENT_RENAME:
+                return true;
+        }
+
+        return false;
+    }
+
+#if wxUSE_TIMER
+    void CoalesceEvent(const wxFileSystemWatcherEvent& evt, int interval)
+    {
+        if ( evt.GetChangeType() == wxFSW_EVENT_RENAME )
+        {
+            // renames can't be reordered with respect to the other events, so
+            // only merge the identical consecutive ones
+            if ( !m_coalescedEvents.empty() )
+            {
+                const wxFileSystemWatcherEvent& last = m_coalescedEvents.back();
+                if ( last.GetChangeType() == wxFSW_EVENT_RENAME &&
+                        last.GetPath() == evt.GetPath() &&
+                            last.GetNewPath() == evt.GetNewPath() )
+                {
+                    return;
+                }
+            }
+
+            // and don't let modifications of the renamed path be merged with
+            // those before the rename
+            m_coalescedIndex.clear();
+        }
+        else // modification, access or attributes change
+        {
+            wxString key;
+            key << evt.GetChangeType() << ':' << evt.GetPath().GetFullPath();
+
+            if ( !m_coalescedIndex.insert({key, m_coalescedEvents.size()}).second )
+            {
+                // there is already a pending event of this kind for this path
+                return;
+            }
+        }
+
+        m_coalescedEvents.push_back(evt);
+
+        if ( m_coalescedEvents.size() >= wxFSW_MAX_COALESCED_EVENTS )
+        {
+            SendCoalescedEvents();
+            return;
+        }
+
+        if ( !m_coalescingTimer )
+            m_coalescingTimer.reset(new wxFSWCoalescingTimer(this));
+
+        if ( !m_coalescingTimer->IsRunning() )
+            m_coalescingTimer->StartOnce(interval);
+    }
+#endif // wxUSE_TIMER
+
+    void DiscardCoalescedEvents()
+    {
+#if wxUSE_TIMER
+        m_coalescingTimer.reset();
+#endif // wxUSE_TIMER
+
+        m_coalescedEvents.clear();
+        m_coalescedIndex.clear();
+    }
+
     int ReadEventsToBuf(char* buf, int size)
     {
         wxCHECK_MSG( IsOk(), false,
@@ -657,11 +804,30 @@ protected:
     wxInotifyCookies m_cookies;           // map to track renames
     wxEventLoopSource* m_source;          // our event loop source
 
+    // the events waiting to be sent, in the order in which they happened, and
+    // the index of the event in this vector for each of the paths
+    std::vector<wxFileSystemWatcherEvent> m_coalescedEvents;
+    std::unordered_map<wxString, size_t> m_coalescedIndex;
+
+#if wxUSE_TIMER
+    // the timer sending the coalesced events, only created if needed
+    std::unique_ptr<wxFSWCoalescingTimer> m_coalescingTimer;
+#endif // wxUSE_TIMER
+
     // file descriptor created by inotify_init()
     int m_ifd;
 };
 
 
+#if wxUSE_TIMER
+
+void wxFSWCoalescingTimer::Notify()
+{
+    m_service->SendCoalescedEvents();
+}
+
+#endif // wxUSE_TIMER
+
 // ============================================================================
 // wxFSWSourceHandler implementation
 // ============================================================================
@@ -146,6 +146,18 @@
     #include <sys/resource.h>   // for setpriority()
 #endif
 
+// We can only use posix_spawnp() instead of fork() if we can make it close all
+// the inherited descriptors in the child, as we do after fork() ourselves.
+#if defined(HAVE_POSIX_SPAWNP) && \
+    defined(HAVE_POSIX_SPAWN_FILE_ACTIONS_ADDCLOSEFROM_NP)
+    #define wxHAS_POSIX_SPAWN
+
+    #include <spawn.h>
+
+    // This is not always declared in the system headers, see wxGetEnvMap().
+    extern char **environ;
+#endif
+
 #if defined(__DARWIN__)
     #include <sys/sysctl.h>
     #include <AvailabilityMacros.h>
@@ -517,6 +529,208 @@ long wxExecute(const wchar_t* const* wargv, int flags, wxProcess* process,
 namespace
 {
 
+// Close all descriptors except for the standard ones in the child process.
+void CloseInheritedDescriptors()
+{
+#ifdef HAVE_CLOSE_RANGE
+    // This is much faster than the loop below, as it doesn't need to make a
+    // system call per descriptor, but it may be not supported by the kernel
+    // we're running under, so fall back to the loop if it fails.
+    if ( close_range(STDERR_FILENO + 1, ~0U, 0) == 0 )
+        return;
+#endif // HAVE_CLOSE_RANGE
+
+    // TODO: Iterating up to FD_SETSIZE is both inefficient (because it may
+    //       be quite big) and incorrect (because in principle we could
+    //       have more opened descriptions than this number). Unfortunately
+    //       there is no good portable solution for closing all descriptors
+    //       above a certain threshold but non-portable solutions exist for
+    //       most platforms, see [https://stackoverflow.com/questions/899038/
+    //          getting-the-highest-allocated-file-descriptor]
+    for ( int fd = 0; fd < (int)FD_SETSIZE; ++fd )
+    {
+        if ( fd != STDIN_FILENO  &&
+             fd != STDOUT_FILENO &&
+             fd != STDERR_FILENO )
+        {
+            close(fd);
+        }
+    }
+}
+
+#ifdef wxHAS_POSIX_SPAWN
+
+// Helper class launching child processes using posix_spawnp(), which is much
+// faster than fork() for the processes with big address spaces, as it doesn't
+// need to duplicate them.
+//
+// It can't be used with all the options supported by wxExecute(), so IsOk()
+// must be checked before using it. If it returns false, or if Spawn() fails,
+// fork() must be used instead.
+//
+// The same object can be reused to launch several processes with the same
+// options, which is what wxExecuteBatch() does.
+class wxPosixSpawner
+{
+public:
+    wxPosixSpawner(int flags, const wxExecuteEnv* env, int prio = 0)
+    {
+        m_ok = false;
+        m_pathChanged = false;
+
+        // There is no way to change the priority of the child process.
+        if ( prio )
+            return;
+
+        if ( posix_spawnattr_init(&m_attr) != 0 )
+            return;
+
+        short attrFlags = 0;
+        if ( flags & wxEXEC_MAKE_GROUP_LEADER )
+        {
+#ifdef POSIX_SPAWN_SETSID
+            attrFlags |= POSIX_SPAWN_SETSID;
+#else
+            posix_spawnattr_destroy(&m_attr);
+            return;
+#endif
+        }
+
+        if ( attrFlags && posix_spawnattr_setflags(&m_attr, attrFlags) != 0 )
+        {
+            posix_spawnattr_destroy(&m_attr);
+            return;
+        }
+
+        if ( env )
+        {
+            // We don't want to fail to launch the process just because the
+            // directory doesn't exist, as fork() code just ignores this, so
+            // let it deal with this case too.
+            if ( !env->cwd.empty() )
+            {
+#ifdef HAVE_POSIX_SPAWN_FILE_ACTIONS_ADDCHDIR_NP
+                if ( !wxDirExists(env->cwd) )
+#endif
+                {
+                    posix_spawnattr_destroy(&m_attr);
+                    return;
+                }
+
+                m_cwd = env->cwd.fn_str();
+            }
+
+            if ( !env->env.empty() )
+            {
+                m_envStrings.reserve(env->env.size());
+                for ( const auto& kv : env->env )
+                {
+                    m_envStrings.push_back((kv.first + '=' + kv.second).mb_str());
+                    m_envp.push_back(m_envStrings.back().data());
+                }
+
+                m_envp.push_back(nullptr);
+
+                // posix_spawnp() searches for the program using our own PATH,
+                // unlike execvp() called after changing the environment.
+                wxString pathOld,
+                         pathNew;
+                wxGetEnv("PATH", &pathOld);
+
+                const auto it = env->env.find("PATH");
+                if ( it != env->env.end() )
+                    pathNew = it->second;
+
+                m_pathChanged = pathOld != pathNew;
+            }
+        }
+
+        m_ok = true;
+    }
+
+    ~wxPosixSpawner()
+    {
+        if ( m_ok )
+            posix_spawnattr_destroy(&m_attr);
+    }
+
+    bool IsOk() const { return m_ok; }
+
+    // Launch the process, redirecting its standard streams to the given
+    // descriptors if they're specified.
+    //
+    // Returns false if the process couldn't be launched, notably if the
+    // program couldn't be executed.
+    bool Spawn(const char* const* argv,
+               pid_t& pid,
+               int fdIn = -1,
+               int fdOut = -1,
+               int fdErr = -1) const
+    {
+        if ( !m_ok || !*argv )
+            return false;
+
+        // Don't search for the program in a different PATH.
+        if ( m_pathChanged && !strchr(*argv, '/') )
+            return false;
+
+        posix_spawn_file_actions_t actions;
+        if ( posix_spawn_file_actions_init(&actions) != 0 )
+            return false;
+
+        bool ok = true;
+        if ( fdIn != -1 )
+        {
+            ok = posix_spawn_file_actions_adddup2(&actions, fdIn, STDIN_FILENO) == 0 &&
+                 posix_spawn_file_actions_adddup2(&actions, fdOut, STDOUT_FILENO) == 0 &&
+                 posix_spawn_file_actions_adddup2(&actions, fdErr, STDERR_FILENO) == 0;
+        }
+
+#ifdef HAVE_POSIX_SPAWN_FILE_ACTIONS_ADDCHDIR_NP
+        if ( ok && m_cwd )
+            ok = posix_spawn_file_actions_addchdir_np(&actions, m_cwd.data()) == 0;
+#endif
+
+        // Close all the other descriptors, see the comment in wxExecute().
+        if ( ok )
+        {
+            ok = posix_spawn_file_actions_addclosefrom_np(&actions,
+                                                          STDERR_FILENO + 1) == 0;
+        }
+
+        if ( ok )
+        {
+            ok = posix_spawnp(&pid, *argv, &actions, &m_attr,
+                              const_cast<char**>(argv),
+                              m_envp.empty() ? environ
+                                             : const_cast<char**>(&m_envp[0])) == 0;
+        }
+
+        posix_spawn_file_actions_destroy(&actions);
+
+        return ok;
+    }
+
+private:
+    posix_spawnattr_t m_attr;
+
+    // Working directory of the child, if it must be changed.
+    wxCharBuffer m_cwd;
+
+    // Environment of the child, empty if it is inherited.
+    std::vector<wxCharBuffer> m_envStrings;
+    std::vector<const char*> m_envp;
+
+    // True if the environment of the child uses a different PATH.
+    bool m_pathChanged;
+
+    bool m_ok;
+
+    wxDECLARE_NO_COPY_CLASS(wxPosixSpawner);
+};
+
+#endif // wxHAS_POSIX_SPAWN
+
 // Helper function of wxExecute(): wait for the process termination without
 // dispatching any events.
 //
@@ -662,17 +876,41 @@ long wxExecute(const char* const* argv, int flags, wxProcess* process,
     else
         prio = (2*prio)/5 - 21;
 
+    bool spawned = false;
+
+#ifdef wxHAS_POSIX_SPAWN
+    // Try launching the child without forking first, if this fails for
+    // whatever reason, we still fall back on fork() below, which reports the
+    // errors in the usual way.
+    const wxPosixSpawner spawner(flags, env, prio);
+    if ( pipeIn.IsOk() )
+    {
+        spawned = spawner.Spawn(argv, pid,
+                                pipeIn[wxPipe::Read],
+                                pipeOut[wxPipe::Write],
+                                pipeErr[wxPipe::Write]);
+    }
+    else
+    {
+        spawned = spawner.Spawn(argv, pid);
+    }
+#endif // wxHAS_POSIX_SPAWN
+
     // fork the process
     //
     // NB: do *not* use vfork() here, it completely breaks this code for some
     //     reason under Solaris (and maybe others, although not under Linux)
     //     But on OpenVMS we do not have fork so we have to use vfork and
     //     cross our fingers that it works.
+   if ( !spawned )
+   {
 #ifdef __VMS
-   pid = vfork();
+       pid = vfork();
 #else
-   pid = fork();
+       pid = fork();
 #endif
+   }
+
    if ( pid == -1 )     // error?
     {
         wxLogSysError( _("Fork failed") );
@@ -723,24 +961,7 @@ long wxExecute(const char* const* argv, int flags, wxProcess* process,
         // Ideally we'd provide some flag to indicate that none (or some?) of
         // the descriptors do not need to be closed but for now this is better
         // than never closing them at all as wx code never used FD_CLOEXEC.
-
-        // TODO: Iterating up to FD_SETSIZE is both inefficient (because it may
-        //       be quite big) and incorrect (because in principle we could
-        //       have more opened descriptions than this number). Unfortunately
-        //       there is no good portable solution for closing all descriptors
-        //       above a certain threshold but non-portable solutions exist for
-        //       most platforms, see [https://stackoverflow.com/questions/899038/
-        //          getting-the-highest-allocated-file-descriptor]
-        for ( int fd = 0; fd < (int)FD_SETSIZE; ++fd )
-        {
-            if ( fd != STDIN_FILENO  &&
-                 fd != STDOUT_FILENO &&
-                 fd != STDERR_FILENO )
-            {
-                close(fd);
-            }
-        }
-
+        CloseInheritedDescriptors();
 
         // Process additional options if we have any
         if ( env )
@@ -891,6 +1112,53 @@ long wxExecute(const char* const* argv, int flags, wxProcess* process,
 
 #undef ERROR_RETURN_CODE
 
+std::vector<long>
+wxExecuteBatch(const wxArrayString& commands,
+               int flags,
+               const wxExecuteEnv *env)
+{
+    wxCHECK_MSG( !(flags & wxEXEC_SYNC), std::vector<long>(),
+                 wxS("wxExecuteBatch() only supports asynchronous execution") );
+
+    std::vector<long> pids;
+    pids.reserve(commands.size());
+
+#ifdef wxHAS_POSIX_SPAWN
+    // Prepare everything depending on the options only once for all commands.
+    const wxPosixSpawner spawner(flags, env);
+#endif // wxHAS_POSIX_SPAWN
+
+    for ( const wxString& command : commands )
+    {
+        ArgsArray argv(wxCmdLineParser::ConvertStringToArgs(command,
+                                                            wxCMD_LINE_SPLIT_UNIX));
+
+        long pid = 0;
+
+#ifdef wxHAS_POSIX_SPAWN
+        pid_t childPid;
+        if ( spawner.Spawn(argv, childPid) )
+        {
+            // As in wxExecute(), this object deletes itself when the child
+            // terminates.
+            wxExecuteData* const execData = new wxExecuteData;
+            execData->m_flags = flags;
+            execData->OnStart(childPid);
+
+            pid = childPid;
+        }
+        else
+#endif // wxHAS_POSIX_SPAWN
+        {
+            pid = wxExecute(argv, flags, nullptr, env);
+        }
+
+        pids.push_back(pid);
+    }
+
+    return pids;
+}
+
 // ----------------------------------------------------------------------------
 // file and directory functions
 // ----------------------------------------------------------------------------
@@ -359,6 +359,7 @@
 #include <wx/textwrapper.h>
 #include <wx/tglbtn.h>
 #include <wx/thread.h>
+#include <wx/tilecache.h>
 #include <wx/timectrl.h>
 #include <wx/time.h>
 #include <wx/timer.h>
@@ -15,6 +15,7 @@
 #if wxUSE_STREAMS
 
 #include "archivetest.h"
+#include "wx/mstream.h"
 #include "wx/tarstrm.h"
 
 using std::string;
@@ -69,4 +70,113 @@ CppUnit::Test *tartest::makeTest(
 CPPUNIT_TEST_SUITE_REGISTRATION(tartest);
 CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(tartest, "archive/tar");
 
+
+///////////////////////////////////////////////////////////////////////////////
+// wxTarIndex
+
+TEST_CASE("wxTarIndex", "[archive][tar]")
+{
+    const int count = 50;
+
+    wxMemoryOutputStream mout;
+    {
+        wxTarOutputStream tar(mout);
+        for (int n = 0; n < count; n++) {
+            const wxString name = wxString::Format("dir/file%d.txt", n);
+            REQUIRE( tar.PutNextEntry(name) );
+            const wxString data = wxString::Format("This is file %d", n);
+            tar.Write(data.utf8_str(), data.utf8_str().length());
+        }
+        REQUIRE( tar.Close() );
+    }
+
+    wxStreamBuffer* const buf = mout.GetOutputStreamBuffer();
+    wxMemoryInputStream min(buf->GetBufferStart(), buf->GetBufferSize());
+
+    wxTarIndex index;
+    REQUIRE( index.Build(min) );
+    CHECK( index.GetCount() == count );
+    CHECK( index.GetArchiveSize() == min.GetLength() );
+    CHECK( index.GetEntry(3).GetName(wxPATH_UNIX) == "dir/file3.txt" );
+
+    wxMemoryOutputStream indexOut;
+    REQUIRE( index.Save(indexOut) );
+
+    wxStreamBuffer* const indexBuf = indexOut.GetOutputStreamBuffer();
+
+    SECTION("Load")
+    {
+        wxMemoryInputStream indexIn(indexBuf->GetBufferStart(),
+                                    indexBuf->GetBufferSize());
+        wxTarIndex loaded;
+        REQUIRE( loaded.Load(indexIn, min.GetLength()) );
+        REQUIRE( loaded.GetCount() == count );
+
+        const wxTarEntry* const entry = loaded.Find("dir/file42.txt", wxPATH_UNIX);
+        REQUIRE( entry );
+        CHECK( entry->GetSize() == index.GetEntry(42).GetSize() );
+        CHECK( entry->GetOffset() == index.GetEntry(42).GetOffset() );
+        CHECK( entry->GetDateTime() == index.GetEntry(42).GetDateTime() );
+        CHECK( !loaded.Find("dir/nonexistent", wxPATH_UNIX) );
+
+        // Open the entries out of order to check that seeking works.
+        wxTarInputStream tar(min);
+        for (int n : { 42, 7, 49, 0 }) {
+            INFO( "Entry " << n );
+            REQUIRE( tar.OpenEntry(loaded,
+                                   wxString::Format("dir/file%d.txt", n),
+                                   wxPATH_UNIX) );
+
+            char data[64];
+            const size_t len = tar.Read(data, sizeof(data)).LastRead();
+            CHECK( wxString::FromUTF8(data, len) ==
+                    wxString::Format("This is file %d", n) );
+        }
+
+        CHECK( !tar.OpenEntry(loaded, "dir/nonexistent", wxPATH_UNIX) );
+    }
+
+    SECTION("Stale")
+    {
+        // An index for an archive of a different size must not be loaded.
+        wxMemoryInputStream indexIn(indexBuf->GetBufferStart(),
+                                    indexBuf->GetBufferSize());
+        wxTarIndex loaded;
+        CHECK( !loaded.Load(indexIn, min.GetLength() + 512) );
+        CHECK( loaded.IsEmpty() );
+    }
+
+    SECTION("UpToDate")
+    {
+        wxMemoryInputStream indexIn(indexBuf->GetBufferStart(),
+                                    indexBuf->GetBufferSize());
+        wxTarIndex loaded;
+        REQUIRE( loaded.Load(indexIn, min.GetLength()) );
+        CHECK( loaded.IsUpToDate(min) );
+
+        // Modify the name of the last entry without changing the size of the
+        // archive: the index must be detected as stale.
+        std::vector<char> modified(static_cast<char*>(buf->GetBufferStart()),
+                                   static_cast<char*>(buf->GetBufferEnd()));
+        modified[index.GetEntry(count - 1).GetOffset() - 512 + 4] = 'X';
+
+        wxMemoryInputStream minModified(modified.data(), modified.size());
+        CHECK( !loaded.IsUpToDate(minModified) );
+
+        // Checking the archive must not change its current position.
+        CHECK( minModified.TellI() == 0 );
+    }
+
+    SECTION("Truncated")
+    {
+        wxLogNull noLog;
+
+        wxMemoryInputStream indexIn(indexBuf->GetBufferStart(),
+                                    indexBuf->GetBufferSize() - 1);
+        wxTarIndex loaded;
+        CHECK( !loaded.Load(indexIn) );
+        CHECK( loaded.IsEmpty() );
+    }
+}
+
 #endif // wxUSE_STREAMS
@@ -15,11 +15,12 @@
 // headers
 // ----------------------------------------------------------------------------
 
-#include <float.h>
-
 #include "wx/app.h"
 #include "wx/cmdline.h"
+#include "wx/ffile.h"
+#include "wx/filefn.h"
 #include "wx/stopwatch.h"
+#include "wx/tokenzr.h"
 #include "wx/uilocale.h"
 
 #if wxUSE_GUI
@@ -28,6 +29,12 @@
 
 #include "bench.h"
 
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <utility>
+#include <vector>
+
 // ----------------------------------------------------------------------------
 // constants
 // ----------------------------------------------------------------------------
@@ -39,6 +46,35 @@ static const char OPTION_RUN_TIME = 't';
 static const char OPTION_NUM_RUNS = 'n';
 static const char OPTION_NUMERIC_PARAM = 'p';
 static const char OPTION_STRING_PARAM = 's';
+static const char OPTION_WARMUP = 'w';
+
+static const char* const OPTION_SWEEP = "sweep";
+static const char* const OPTION_JSON = "json";
+static const char* const OPTION_CSV = "csv";
+static const char* const OPTION_BASELINE = "baseline";
+static const char* const OPTION_THRESHOLD = "threshold";
+
+// ----------------------------------------------------------------------------
+// helper classes
+// ----------------------------------------------------------------------------
+
+// Statistics of the run times of a single benchmark, all times are in us.
+struct BenchResult
+{
+    wxString name;
+    long param = 0;
+    long runs = 0;
+    double min = 0,
+           median = 0,
+           p95 = 0,
+           p99 = 0,
+           max = 0,
+           mean = 0,
+           stddev = 0;
+
+    // Compute all the statistics from the given samples, which get sorted.
+    void Compute(std::vector<double>& samples);
+};
 
 // ----------------------------------------------------------------------------
 // BenchApp declaration
@@ -67,19 +103,44 @@ public:
     const wxString& GetStringParameter() const { return m_strParam; }
 
 private:
-    // output the results of a single benchmark if successful or just return
-    // false if anything went wrong
+    // output the results of a single benchmark and store them in m_results
+    // if successful or just return false if anything went wrong
     bool RunSingleBenchmark(Bench::Function* func);
 
+    // return true if the benchmark is selected by the command line
+    bool ShouldRun(const Bench::Function* func) const;
+
     // list all registered benchmarks
     void ListBenchmarks();
 
+    // write the results in the machine-readable formats
+    bool WriteJSON(const wxString& filename) const;
+    bool WriteCSV(const wxString& filename) const;
+
+    // load the baseline results from the file created by WriteCSV()
+    bool LoadBaseline(const wxString& filename);
+
+    // compare the result with the baseline, if any, and return false if it
+    // is worse than the baseline by more than the threshold
+    bool CheckBaseline(const BenchResult& result) const;
+
     // command lines options/parameters
-    wxSortedArrayString m_toRun;
+    wxArrayString m_toRun;      // names or masks of the benchmarks to run
     long m_numRuns, // number of times to run a single benchmark or 0
          m_runTime, // minimum time to run a single benchmark if m_numRuns == 0
+         m_numWarmup, // number of runs to perform before measuring
          m_numParam;
+    std::vector<long> m_sweep;  // values of m_numParam to use, if not empty
     wxString m_strParam;
+    wxString m_jsonFile,
+             m_csvFile;
+    double m_threshold;         // maximal allowed slowdown, in percents
+
+    // the results of all benchmarks which were run
+    std::vector<BenchResult> m_results;
+
+    // the baseline median times indexed by the benchmark name and parameter
+    std::map<std::pair<wxString, long>, double> m_baseline;
 };
 
 wxIMPLEMENT_APP_CONSOLE(BenchApp);
@@ -102,6 +163,42 @@ wxString Bench::GetStringParameter(const wxString& defVal)
     return !val.empty() ? val : defVal;
 }
 
+// ============================================================================
+// BenchResult implementation
+// ============================================================================
+
+void BenchResult::Compute(std::vector<double>& samples)
+{
+    runs = static_cast<long>(samples.size());
+    if ( !runs )
+        return;
+
+    std::sort(samples.begin(), samples.end());
+
+    // Use the nearest-rank definition of the percentile.
+    const auto percentile = [&samples](double p)
+    {
+        size_t rank = static_cast<size_t>(std::ceil(p * samples.size() / 100));
+        return samples[rank ? rank - 1 : 0];
+    };
+
+    min = samples.front();
+    max = samples.back();
+    median = percentile(50);
+    p95 = percentile(95);
+    p99 = percentile(99);
+
+    double sum = 0;
+    for ( double t : samples )
+        sum += t;
+    mean = sum / runs;
+
+    double sumSq = 0;
+    for ( double t : samples )
+        sumSq += (t - mean)*(t - mean);
+    stddev = runs > 1 ? std::sqrt(sumSq / (runs - 1)) : 0;
+}
+
 // ============================================================================
 // BenchApp implementation
 // ============================================================================
@@ -110,7 +207,9 @@ BenchApp::BenchApp()
 {
     m_numRuns = 0; // this means to use m_runTime
     m_runTime = 500; // default minimum
+    m_numWarmup = 0;
     m_numParam = 0;
+    m_threshold = 10;
 }
 
 bool BenchApp::OnInit()
@@ -176,8 +275,44 @@ void BenchApp::OnInitCmdLine(wxCmdLineParser& parser)
                      "string parameter used by some benchmark functions "
                      "(default: empty)",
                      wxCMD_LINE_VAL_STRING);
+    parser.AddOption(OPTION_WARMUP,
+                     "warmup",
+                     wxString::Format
+                     (
+                         "number of times to run each benchmark before "
+                         "measuring it (default: %ld)",
+                         m_numWarmup
+                     ),
+                     wxCMD_LINE_VAL_NUMBER);
+    parser.AddOption(wxString(),
+                     OPTION_SWEEP,
+                     "comma-separated list of the values of the numeric "
+                     "parameter to run each benchmark with",
+                     wxCMD_LINE_VAL_STRING);
+    parser.AddOption(wxString(),
+                     OPTION_JSON,
+                     "also write the results to the given file in JSON format",
+                     wxCMD_LINE_VAL_STRING);
+    parser.AddOption(wxString(),
+                     OPTION_CSV,
+                     "also write the results to the given file in CSV format",
+                     wxCMD_LINE_VAL_STRING);
+    parser.AddOption(wxString(),
+                     OPTION_BASELINE,
+                     "compare the results with the ones in the given file "
+                     "previously created with --csv",
+                     wxCMD_LINE_VAL_STRING);
+    parser.AddOption(wxString(),
+                     OPTION_THRESHOLD,
+                     wxString::Format
+                     (
+                         "maximal allowed increase of the median time "
+                         "compared to the baseline in percents (default: %g)",
+                         m_threshold
+                     ),
+                     wxCMD_LINE_VAL_DOUBLE);
 
-    parser.AddParam("benchmark name",
+    parser.AddParam("benchmark name or mask",
                     wxCMD_LINE_VAL_STRING,
                     wxCMD_LINE_PARAM_OPTIONAL | wxCMD_LINE_PARAM_MULTIPLE);
 }
@@ -205,6 +340,35 @@ bool BenchApp::OnCmdLineParsed(wxCmdLineParser& parser)
     const bool numRunsSpecified = parser.Found(OPTION_NUM_RUNS, &m_numRuns);
     parser.Found(OPTION_NUMERIC_PARAM, &m_numParam);
     parser.Found(OPTION_STRING_PARAM, &m_strParam);
+    parser.Found(OPTION_WARMUP, &m_numWarmup);
+    parser.Found(OPTION_JSON, &m_jsonFile);
+    parser.Found(OPTION_CSV, &m_csvFile);
+    parser.Found(OPTION_THRESHOLD, &m_threshold);
+
+    wxString sweep;
+    if ( parser.Found(OPTION_SWEEP, &sweep) )
+    {
+        wxStringTokenizer tk(sweep, ",");
+        while ( tk.HasMoreTokens() )
+        {
+            long value;
+            if ( !tk.GetNextToken().Trim().Trim(false).ToLong(&value) )
+            {
+                wxFprintf(stderr, "Invalid parameter sweep \"%s\".\n", sweep);
+                return false;
+            }
+
+            m_sweep.push_back(value);
+        }
+    }
+
+    wxString baseline;
+    if ( parser.Found(OPTION_BASELINE, &baseline) )
+    {
+        if ( !LoadBaseline(baseline) )
+            return false;
+    }
+
     if ( parser.Found(OPTION_SINGLE) )
     {
         if ( runTimeSpecified || numRunsSpecified )
@@ -222,21 +386,26 @@ bool BenchApp::OnCmdLineParsed(wxCmdLineParser& parser)
         m_runTime = 0;
     }
 
-    // construct sorted array for quick verification of benchmark names
-    wxSortedArrayString benchmarks;
-    for ( Bench::Function *func = Bench::Function::GetFirst();
-          func;
-          func = func->GetNext() )
-    {
-        benchmarks.push_back(func->GetName());
-    }
-
+    // check that each of the names or masks selects at least one benchmark
     for ( size_t n = 0; n < count; n++ )
     {
         const wxString name = parser.GetParam(n);
-        if ( benchmarks.Index(name) == wxNOT_FOUND )
+
+        bool found = false;
+        for ( Bench::Function *func = Bench::Function::GetFirst();
+              func;
+              func = func->GetNext() )
         {
-            wxFprintf(stderr, "No benchmark named \"%s\".\n", name);
+            if ( wxMatchWild(name, func->GetName()) )
+            {
+                found = true;
+                break;
+            }
+        }
+
+        if ( !found )
+        {
+            wxFprintf(stderr, "No benchmark matching \"%s\".\n", name);
             return false;
         }
 
@@ -251,7 +420,9 @@ int BenchApp::OnRun()
     int rc = EXIT_SUCCESS;
 
     wxString params;
-    if ( m_numParam )
+    if ( !m_sweep.empty() )
+        params += "multiple values of N";
+    else if ( m_numParam )
         params += wxString::Format("N=%ld", m_numParam);
     if ( !m_strParam.empty() )
     {
@@ -263,62 +434,87 @@ int BenchApp::OnRun()
     if ( !params.empty() )
         wxPrintf("Benchmarks are running with non-default %s\n", params);
 
+    // When not sweeping, just run everything once with the single value.
+    std::vector<long> paramValues(m_sweep);
+    if ( paramValues.empty() )
+        paramValues.push_back(m_numParam);
+
+    int regressions = 0;
     for ( Bench::Function *func = Bench::Function::GetFirst();
           func;
           func = func->GetNext() )
     {
-        if ( m_toRun.Index(func->GetName()) == wxNOT_FOUND )
+        if ( !ShouldRun(func) )
             continue;
 
-        if ( !RunSingleBenchmark(func) )
+        for ( long param : paramValues )
         {
-            wxFprintf(stderr, "ERROR running %s\n", func->GetName());
-            rc = EXIT_FAILURE;
+            m_numParam = param;
+
+            if ( !RunSingleBenchmark(func) )
+            {
+                wxFprintf(stderr, "ERROR running %s\n", func->GetName());
+                rc = EXIT_FAILURE;
+                continue;
+            }
+
+            if ( !CheckBaseline(m_results.back()) )
+                regressions++;
         }
     }
 
+    if ( regressions )
+    {
+        wxPrintf("%d benchmark(s) regressed by more than %g%%\n",
+                 regressions, m_threshold);
+        rc = EXIT_FAILURE;
+    }
+
+    if ( !m_jsonFile.empty() && !WriteJSON(m_jsonFile) )
+        rc = EXIT_FAILURE;
+
+    if ( !m_csvFile.empty() && !WriteCSV(m_csvFile) )
+        rc = EXIT_FAILURE;
+
     return rc;
 }
 
+bool BenchApp::ShouldRun(const Bench::Function* func) const
+{
+    for ( const wxString& mask : m_toRun )
+    {
+        if ( wxMatchWild(mask, func->GetName()) )
+            return true;
+    }
+
+    return false;
+}
+
 bool BenchApp::RunSingleBenchmark(Bench::Function* func)
 {
     if ( !func->Init() )
         return false;
 
-    wxPrintf("%-30s", wxString(func->GetName()) + ':');
-    fflush(stdout);
-
-    // We use the algorithm for iteratively computing the mean and the
-    // standard deviation of the sequence of values described in Knuth's
-    // "The Art of Computer Programming, Volume 2: Seminumerical
-    // Algorithms", section 4.2.2.
-    //
-    // The algorithm defines the sequences M(k) and S(k) as follows:
-    //
-    //  M(1) = x(1), M(k) = M(k-1) + (x(k) - M(k-1)) / k
-    //  S(1) = 0,    S(k) = S(k-1) + (x(k) - M(k-1))*(x(k) - M(k))
-    //
-    // where x(k) is the k-th value. Then the mean is simply the last value
-    // of the first sequence M(N) and the standard deviation is
-    // sqrt(S(N)/(N-1)).
+    wxString name = func->GetName();
+    if ( !m_sweep.empty() )
+        name += wxString::Format("[N=%ld]", m_numParam);
 
-    wxStopWatch swTotal;
-    if ( !func->Run() )
-        return false;
+    wxPrintf("%-30s", name + ':');
+    fflush(stdout);
 
-    double timeMin = DBL_MAX,
-           timeMax = 0;
+    // The warm-up runs are not taken into account at all.
+    for ( long n = 0; n < m_numWarmup; n++ )
+    {
+        if ( !func->Run() )
+            return false;
+    }
 
-    double m = swTotal.TimeInMicro().ToDouble();
-    double s = 0;
+    // Collect the time of each run, so that we can compute the percentiles.
+    std::vector<double> samples;
 
-    long n = 0;
+    wxStopWatch swTotal;
     for ( ;; )
     {
-        // One termination condition is reaching the maximum number of runs.
-        if ( ++n == m_numRuns )
-            break;
-
         double t;
         {
             wxStopWatch swThis;
@@ -328,14 +524,11 @@ bool BenchApp::RunSingleBenchmark(Bench::Function* func)
             t = swThis.TimeInMicro().ToDouble();
         }
 
-        if ( t < timeMin )
-            timeMin = t;
-        if ( t > timeMax )
-            timeMax = t;
+        samples.push_back(t);
 
-        const double lastM = m;
-        m += (t - lastM) / n;
-        s += (t - lastM)*(t - m);
+        // One termination condition is reaching the maximum number of runs.
+        if ( m_numRuns && static_cast<long>(samples.size()) >= m_numRuns )
+            break;
 
         // The other termination condition is that we are running for at least
         // m_runTime milliseconds.
@@ -345,25 +538,189 @@ bool BenchApp::RunSingleBenchmark(Bench::Function* func)
 
     func->Done();
 
+    BenchResult result;
+    result.name = func->GetName();
+    result.param = m_numParam;
+    result.Compute(samples);
+
     // For a single run there is no standard deviation and min/max don't make
     // much sense.
-    if ( n == 1 )
+    if ( result.runs == 1 )
     {
-        wxPrintf("single run took %.0fus\n", m);
+        wxPrintf("single run took %.0fus\n", result.mean);
     }
     else
     {
-        s = sqrt(s / (n - 1));
-
         wxPrintf
         (
-            "%12ld runs, %.0fus avg, %.0f std dev (%.0f/%.0f min/max)\n",
-            n, m, s, timeMin, timeMax
+            "%12ld runs, %.0fus avg, %.0f std dev (%.0f/%.0f min/max, "
+            "%.0f/%.0f/%.0f median/p95/p99)\n",
+            result.runs, result.mean, result.stddev, result.min, result.max,
+            result.median, result.p95, result.p99
         );
     }
 
     fflush(stdout);
 
+    m_results.push_back(result);
+
+    return true;
+}
+
+bool BenchApp::CheckBaseline(const BenchResult& result) const
+{
+    const auto it = m_baseline.find(std::make_pair(result.name, result.param));
+    if ( it == m_baseline.end() || it->second <= 0 )
+        return true;
+
+    const double change = (result.median - it->second) / it->second * 100;
+    const bool ok = change <= m_threshold;
+
+    wxPrintf("%-30s%+.1f%% compared to the baseline median of %.0fus%s\n",
+             "", change, it->second, ok ? "" : " (REGRESSION)");
+
+    return ok;
+}
+
+// Helper for writing both the JSON and CSV numbers: notice that we can't use
+// wxPrintf() with them because they must not depend on the current locale.
+static wxString FormatTime(double t)
+{
+    return wxString::FromCDouble(t, 3);
+}
+
+// Quote a string for inclusion into JSON.
+static wxString QuoteJSON(const wxString& s)
+{
+    wxString quoted('"');
+    for ( wxUniChar ch : s )
+    {
+        if ( ch < 0x20 )
+        {
+            // Control characters can't appear in JSON strings unescaped.
+            quoted += wxString::Format("\\u%04x", static_cast<unsigned>(ch.GetValue()));
+            continue;
+        }
+
+        if ( ch == '"' || ch == '\\' )
+            quoted += '\\';
+        quoted += ch;
+    }
+    quoted += '"';
+
+    return quoted;
+}
+
+bool BenchApp::WriteJSON(const wxString& filename) const
+{
+    wxString json;
+    json << "{\n"
+         << "  \"build\": " << QuoteJSON(WX_BUILD_OPTIONS_SIGNATURE) << ",\n"
+         << "  \"benchmarks\": [";
+
+    for ( size_t n = 0; n < m_results.size(); n++ )
+    {
+        const BenchResult& r = m_results[n];
+
+        json << (n ? "," : "") << "\n"
+             << "    {"
+             << "\"name\": " << QuoteJSON(r.name) << ", "
+             << "\"param\": " << r.param << ", "
+             << "\"runs\": " << r.runs << ", "
+             << "\"min\": " << FormatTime(r.min) << ", "
+             << "\"median\": " << FormatTime(r.median) << ", "
+             << "\"p95\": " << FormatTime(r.p95) << ", "
+             << "\"p99\": " << FormatTime(r.p99) << ", "
+             << "\"max\": " << FormatTime(r.max) << ", "
+             << "\"mean\": " << FormatTime(r.mean) << ", "
+             << "\"stddev\": " << FormatTime(r.stddev)
+             << "}";
+    }
+
+    json << "\n  ]\n}\n";
+
+    wxFFile file(filename, "w");
+    return file.IsOpened() && file.Write(json) && file.Close();
+}
+
+// The columns of the CSV file, the baseline file must have at least the name,
+// param and median ones.
+static const char* const CSV_HEADER =
+    "name,param,runs,min,median,p95,p99,max,mean,stddev";
+
+bool BenchApp::WriteCSV(const wxString& filename) const
+{
+    wxString csv;
+    csv << CSV_HEADER << "\n";
+
+    for ( const BenchResult& r : m_results )
+    {
+        csv << r.name << ','
+            << r.param << ','
+            << r.runs << ','
+            << FormatTime(r.min) << ','
+            << FormatTime(r.median) << ','
+            << FormatTime(r.p95) << ','
+            << FormatTime(r.p99) << ','
+            << FormatTime(r.max) << ','
+            << FormatTime(r.mean) << ','
+            << FormatTime(r.stddev) << "\n";
+    }
+
+    wxFFile file(filename, "w");
+    return file.IsOpened() && file.Write(csv) && file.Close();
+}
+
+bool BenchApp::LoadBaseline(const wxString& filename)
+{
+    wxString contents;
+    wxFFile file(filename);
+    if ( !file.IsOpened() || !file.ReadAll(&contents) )
+        return false;
+
+    const wxArrayString lines = wxSplit(contents, '\n', '\0');
+    if ( lines.empty() )
+    {
+        wxFprintf(stderr, "Baseline file \"%s\" is empty.\n", filename);
+        return false;
+    }
+
+    // Find the columns we need in the header.
+    const wxArrayString header = wxSplit(lines[0], ',', '\0');
+    const int colName = header.Index("name"),
+              colParam = header.Index("param"),
+              colMedian = header.Index("median");
+    if ( colName == wxNOT_FOUND ||
+            colParam == wxNOT_FOUND ||
+                colMedian == wxNOT_FOUND )
+    {
+        wxFprintf(stderr, "Baseline file \"%s\" is not in CSV format.\n",
+                  filename);
+        return false;
+    }
+
+    const size_t numCols = header.size();
+    for ( size_t n = 1; n < lines.size(); n++ )
+    {
+        if ( lines[n].empty() )
+            continue;
+
+        const wxArrayString fields = wxSplit(lines[n], ',', '\0');
+
+        long param;
+        double median;
+        if ( fields.size() != numCols ||
+                !fields[colParam].ToLong(&param) ||
+                    !fields[colMedian].ToCDouble(&median) )
+        {
+            wxFprintf(stderr, "Invalid line %d in baseline file \"%s\".\n",
+                      static_cast<int>(n + 1), filename);
+            return false;
+        }
+
+        m_baseline[std::make_pair(fields[colName], param)] = median;
+    }
+
     return true;
 }
 
@@ -0,0 +1,120 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/config.cpp
+// Purpose:     wxFileConfig benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/defs.h"
+
+#if wxUSE_CONFIG && wxUSE_STREAMS
+
+#include "wx/fileconf.h"
+#include "wx/sstream.h"
+
+#include "bench.h"
+
+#include <memory>
+
+// Number of entries in each group of the test config.
+static const int ENTRIES_PER_GROUP = 100;
+
+// The total number of the entries is given by the numeric parameter.
+static int GetNumEntries()
+{
+    return Bench::GetNumericParameter(30000);
+}
+
+static wxString GetKey(int n)
+{
+    return wxString::Format("/group%d/sub%d/entry%d",
+                            n / ENTRIES_PER_GROUP / 10,
+                            n / ENTRIES_PER_GROUP % 10,
+                            n);
+}
+
+// Contents of the config file and the config object created from it.
+static wxString gs_configText;
+static std::unique_ptr<wxFileConfig> gs_config;
+
+static void WriteAll(wxFileConfig& fc)
+{
+    const int count = GetNumEntries();
+    for ( int n = 0; n < count; n++ )
+        fc.Write(GetKey(n), n);
+}
+
+static bool InitConfig()
+{
+    wxFileConfig fc(wxString(), wxString(), wxString(), wxString(), 0);
+    fc.SetBatchMode();
+    WriteAll(fc);
+
+    wxStringOutputStream sos;
+    if ( !fc.Save(sos) )
+        return false;
+
+    gs_configText = sos.GetString();
+
+    wxStringInputStream sis(gs_configText);
+    gs_config.reset(new wxFileConfig(sis));
+
+    return true;
+}
+
+static void DoneConfig()
+{
+    gs_config.reset();
+    gs_configText.clear();
+}
+
+BENCHMARK_FUNC_WITH_INIT(FileConfigLoad, InitConfig, DoneConfig)
+{
+    wxStringInputStream sis(gs_configText);
+    wxFileConfig fc(sis);
+
+    return fc.GetNumberOfGroups() != 0;
+}
+
+BENCHMARK_FUNC_WITH_INIT(FileConfigRead, InitConfig, DoneConfig)
+{
+    const int count = GetNumEntries();
+    for ( int n = 0; n < count; n++ )
+    {
+        if ( gs_config->ReadLong(GetKey(n), -1) != n )
+            return false;
+    }
+
+    return true;
+}
+
+BENCHMARK_FUNC_WITH_INIT(FileConfigEnum, InitConfig, DoneConfig)
+{
+    return gs_config->GetNumberOfEntries(true) == size_t(GetNumEntries());
+}
+
+// Both of the write benchmarks also serialize the config, as this is when the
+// lines are updated in batch mode.
+static bool WriteAndSave(bool batch)
+{
+    wxFileConfig fc(wxString(), wxString(), wxString(), wxString(), 0);
+    fc.SetBatchMode(batch);
+    WriteAll(fc);
+
+    wxStringOutputStream sos;
+    return fc.Save(sos) && sos.GetString().length() == gs_configText.length();
+}
+
+BENCHMARK_FUNC_WITH_INIT(FileConfigWrite, InitConfig, DoneConfig)
+{
+    return WriteAndSave(false);
+}
+
+BENCHMARK_FUNC_WITH_INIT(FileConfigWriteBatch, InitConfig, DoneConfig)
+{
+    return WriteAndSave(true);
+}
+
+#endif // wxUSE_CONFIG && wxUSE_STREAMS
@@ -0,0 +1,81 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/exec.cpp
+// Purpose:     wxExecute() benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/arrstr.h"
+#include "wx/utils.h"
+
+#include "bench.h"
+
+#include <memory>
+
+#ifdef __UNIX__
+    #define COMMAND "true"
+#elif defined(__WINDOWS__)
+    #define COMMAND "cmd.exe /c rem"
+#else
+    #error "no command to exec"
+#endif
+
+// Allocate a big chunk of memory to check how launching a child process
+// depends on the size of the parent process, this is the case when using
+// fork() but shouldn't be when using posix_spawn().
+//
+// The size of the memory in MiB is given by the numeric parameter.
+static std::unique_ptr<char[]> gs_ballast;
+
+static bool AllocateBallast()
+{
+    const long sizeMiB = Bench::GetNumericParameter(0);
+    if ( sizeMiB > 0 )
+    {
+        const size_t size = static_cast<size_t>(sizeMiB) * 1024 * 1024;
+        gs_ballast.reset(new char[size]);
+
+        // Touch all the pages to ensure they're really mapped.
+        for ( size_t n = 0; n < size; n += 4096 )
+            gs_ballast[n] = static_cast<char>(n);
+    }
+
+    return true;
+}
+
+static void FreeBallast()
+{
+    gs_ballast.reset();
+}
+
+// Launch the process synchronously, each run corresponds to one spawn.
+BENCHMARK_FUNC_WITH_INIT(ExecBlock, AllocateBallast, FreeBallast)
+{
+    return wxExecute(COMMAND, wxEXEC_BLOCK) == 0;
+}
+
+// Launch 10 processes at once using a single wxExecuteBatch() call.
+//
+// Notice that the terminated processes are only reaped during the next run.
+BENCHMARK_FUNC_WITH_INIT(ExecBatch, AllocateBallast, FreeBallast)
+{
+    wxArrayString commands;
+    for ( int n = 0; n < 10; n++ )
+        commands.push_back(COMMAND);
+
+    bool ok = true;
+    for ( long pid : wxExecuteBatch(commands) )
+    {
+        if ( !pid )
+            ok = false;
+    }
+
+    // Waiting for this process also reaps all the previously launched ones
+    // which have already terminated.
+    if ( wxExecute(COMMAND, wxEXEC_BLOCK) != 0 )
+        ok = false;
+
+    return ok;
+}
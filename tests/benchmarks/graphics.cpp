@@ -68,11 +68,15 @@ struct GraphicsBenchmarkOptions
         testEllipses =
         testTextExtent =
         testMultiLineTextExtent =
-        testPartialTextExtents = false;
+        testPartialTextExtents =
+        testLabels =
+        testBatches =
+        testReport = false;
 
         usePaint =
         useClient =
-        useMemory = false;
+        useMemory =
+        useImage = false;
 
         useDC =
         useGC =
@@ -99,11 +103,15 @@ struct GraphicsBenchmarkOptions
          testEllipses,
          testTextExtent,
          testMultiLineTextExtent,
-         testPartialTextExtents;
+         testPartialTextExtents,
+         testLabels,
+         testBatches,
+         testReport;
 
     bool usePaint,
          useClient,
-         useMemory;
+         useMemory,
+         useImage;
 
     bool useDC,
          useGC,
@@ -378,6 +386,22 @@ private:
 
         }
 
+        if ( opts.useImage && opts.useGC )
+        {
+            // There is no wxDC for drawing on wxImage, so only graphics
+            // context can be used here.
+            wxImage image(opts.width, opts.height);
+            wxGraphicsRenderer* const renderer = m_renderer
+                ? m_renderer
+                : wxGraphicsRenderer::GetDefaultRenderer();
+            wxGCDC gcdc(renderer->CreateContextFromImage(image));
+            BenchmarkAll(wxString::Format("%6s GC (%s)", "image",
+                                          renderer->GetName()), gcdc);
+
+            BenchmarkReport(wxString::Format("%6s GC (%s)", "image",
+                                             renderer->GetName()), renderer);
+        }
+
         wxTheApp->ExitMainLoop();
     }
 
@@ -406,6 +430,8 @@ private:
         BenchmarkEllipses(msg, dc);
         BenchmarkTextExtent(msg, dc);
         BenchmarkPartialTextExtents(msg, dc);
+        BenchmarkLabels(msg, dc);
+        BenchmarkBatches(msg, dc);
     }
 
     void SetupDC(wxDC& dc)
@@ -692,6 +718,217 @@ private:
                  opts.numIters, t, (1000. * t)/opts.numIters);
     }
 
+    void BenchmarkLabels(const wxString& msg, wxDC& dc)
+    {
+        if ( !opts.testLabels )
+            return;
+
+        SetupDC(dc);
+
+        wxPrintf("Benchmarking %s: ", msg);
+        fflush(stdout);
+
+        // Use a small vocabulary, as most labels in real programs are drawn
+        // many times, and center them at random positions, which requires
+        // measuring them first.
+        const wxString labels[] =
+        {
+            "OK", "Cancel", "Apply", "Help", "Name", "Size", "Type",
+            "Date modified", "Open", "Save", "Close", "Properties",
+        };
+
+        wxStopWatch sw;
+        for ( long n = 0; n < opts.numIters; n++ )
+        {
+            const wxString& label = labels[n % WXSIZEOF(labels)];
+            const wxSize size = dc.GetTextExtent(label);
+
+            dc.DrawText(label,
+                        rand() % opts.width - size.x / 2,
+                        rand() % opts.height - size.y / 2);
+        }
+
+        const long t = sw.Time();
+
+        wxPrintf("%ld labels done in %ldms = %gus/label\n",
+                 opts.numIters, t, (1000. * t)/opts.numIters);
+    }
+
+    // Compare drawing many primitives one by one and all at once.
+    void BenchmarkBatches(const wxString& msg, wxDC& dc)
+    {
+        if ( !opts.testBatches )
+            return;
+
+        // Batch drawing functions are only available in wxGraphicsContext.
+        wxGraphicsContext* const gc = dc.GetGraphicsContext();
+        if ( !gc )
+            return;
+
+        // Use a few colours, with all items of the same colour going one
+        // after another, as is typical for heat maps and scatter plots.
+        static const wxColour palette[] =
+        {
+            *wxRED, *wxGREEN, *wxBLUE, *wxYELLOW, *wxCYAN, *wxWHITE,
+        };
+
+        const size_t count = opts.numIters;
+        wxVector<wxRect2DDouble> rects(count);
+        wxVector<wxPoint2DDouble> points(count),
+                                  ends(count);
+        wxVector<wxColour> colours(count);
+        for ( size_t n = 0; n < count; n++ )
+        {
+            rects[n] = wxRect2DDouble(rand() % opts.width,
+                                      rand() % opts.height,
+                                      8, 8);
+            points[n] = wxPoint2DDouble(rand() % opts.width,
+                                        rand() % opts.height);
+            ends[n] = points[n] + wxPoint2DDouble(rand() % 32, rand() % 32);
+            colours[n] = palette[n*WXSIZEOF(palette)/count];
+        }
+
+        const wxGraphicsPenInfo penInfo(*wxWHITE);
+
+        gc->SetPen(wxNullGraphicsPen);
+
+        wxPrintf("Benchmarking %s: ", msg);
+        fflush(stdout);
+
+        wxStopWatch sw;
+        for ( size_t n = 0; n < count; n++ )
+        {
+            gc->SetBrush(wxBrush(colours[n]));
+            gc->DrawRectangle(rects[n]);
+        }
+        long t = sw.Time();
+
+        wxPrintf("%ld coloured rects done one by one in %ldms = %gus/rect\n",
+                 opts.numIters, t, (1000. * t)/opts.numIters);
+
+        wxPrintf("Benchmarking %s: ", msg);
+        fflush(stdout);
+
+        sw.Start();
+        gc->DrawRectangles(count, &rects[0], &colours[0]);
+        t = sw.Time();
+
+        wxPrintf("%ld coloured rects done at once in %ldms = %gus/rect\n",
+                 opts.numIters, t, (1000. * t)/opts.numIters);
+
+        wxPrintf("Benchmarking %s: ", msg);
+        fflush(stdout);
+
+        sw.Start();
+        for ( size_t n = 0; n < count; n++ )
+        {
+            gc->SetBrush(wxBrush(colours[n]));
+            gc->DrawRectangle(points[n].m_x, points[n].m_y, 1, 1);
+        }
+        t = sw.Time();
+
+        wxPrintf("%ld coloured points done one by one in %ldms = %gus/point\n",
+                 opts.numIters, t, (1000. * t)/opts.numIters);
+
+        wxPrintf("Benchmarking %s: ", msg);
+        fflush(stdout);
+
+        sw.Start();
+        gc->DrawPoints(count, &points[0], &colours[0]);
+        t = sw.Time();
+
+        wxPrintf("%ld coloured points done at once in %ldms = %gus/point\n",
+                 opts.numIters, t, (1000. * t)/opts.numIters);
+
+        wxPrintf("Benchmarking %s: ", msg);
+        fflush(stdout);
+
+        sw.Start();
+        for ( size_t n = 0; n < count; n++ )
+        {
+            gc->SetPen(gc->CreatePen(wxGraphicsPenInfo(colours[n])));
+            gc->StrokeLine(points[n], ends[n]);
+        }
+        t = sw.Time();
+
+        wxPrintf("%ld coloured lines done one by one in %ldms = %gus/line\n",
+                 opts.numIters, t, (1000. * t)/opts.numIters);
+
+        wxPrintf("Benchmarking %s: ", msg);
+        fflush(stdout);
+
+        sw.Start();
+        gc->StrokeSegments(count, &points[0], &ends[0], penInfo, &colours[0]);
+        t = sw.Time();
+
+        wxPrintf("%ld coloured lines done at once in %ldms = %gus/line\n",
+                 opts.numIters, t, (1000. * t)/opts.numIters);
+    }
+
+    // Draw a page of a "report" consisting of many shapes and some text.
+    static void DrawReportPage(wxGraphicsContext& gc)
+    {
+        // Note that all objects must be created here as this function is
+        // called from multiple threads when drawing in parallel.
+        gc.SetBrush(gc.CreateBrush(wxBrush(wxColour(255, 255, 255))));
+        gc.DrawRectangle(0, 0, opts.width, opts.height);
+
+        gc.SetFont(gc.CreateFont(12, wxString(), wxFONTFLAG_DEFAULT,
+                                 wxColour(0, 0, 0)));
+
+        const int rowHeight = 20;
+        for ( int y = 0; y < opts.height; y += rowHeight )
+        {
+            const int n = y / rowHeight;
+
+            gc.SetPen(gc.CreatePen(wxGraphicsPenInfo(wxColour(0, 0, 128)).Width(1.5)));
+            gc.StrokeLine(0, y + 0.5, opts.width, y + 0.5);
+
+            gc.SetPen(wxNullGraphicsPen);
+            gc.SetBrush(gc.CreateBrush(wxBrush(wxColour(n*37 % 256, 128, 200))));
+            gc.DrawRoundedRectangle(opts.width / 2, y + 3,
+                                    (n*53) % (opts.width / 2), rowHeight - 6, 3);
+            gc.DrawEllipse(5.3, y + 4.7, rowHeight - 8, rowHeight - 8);
+
+            gc.DrawText(wxString::Format("Row %d of the report", n), 30, y + 2);
+        }
+    }
+
+    void BenchmarkReport(const wxString& msg, wxGraphicsRenderer* renderer)
+    {
+        if ( !opts.testReport )
+            return;
+
+        // Each iteration draws a whole page, so use fewer of them.
+        const long numPages = wxMax(opts.numIters / 100, 1);
+
+        wxPrintf("Benchmarking %s: ", msg);
+        fflush(stdout);
+
+        wxImage imageSerial(opts.width, opts.height);
+
+        wxStopWatch sw;
+        for ( long n = 0; n < numPages; n++ )
+            renderer->RenderImageInBands(imageSerial, DrawReportPage, 1);
+        long t = sw.Time();
+
+        wxPrintf("%ld report pages drawn serially in %ldms = %gms/page\n",
+                 numPages, t, double(t)/numPages);
+
+        wxPrintf("Benchmarking %s: ", msg);
+        fflush(stdout);
+
+        wxImage imageParallel(opts.width, opts.height);
+
+        sw.Start();
+        for ( long n = 0; n < numPages; n++ )
+            renderer->RenderImageInBands(imageParallel, DrawReportPage);
+        t = sw.Time();
+
+        wxPrintf("%ld report pages drawn in parallel in %ldms = %gms/page\n",
+                 numPages, t, double(t)/numPages);
+    }
+
     void BenchmarkBitmaps(const wxString& msg, wxDC& dc)
     {
         if ( !opts.testBitmaps )
@@ -869,9 +1106,13 @@ public:
             { wxCMD_LINE_SWITCH, "",  "textextent" },
             { wxCMD_LINE_SWITCH, "",  "multilinetextextent" },
             { wxCMD_LINE_SWITCH, "",  "partialtextextents" },
+            { wxCMD_LINE_SWITCH, "",  "labels" },
+            { wxCMD_LINE_SWITCH, "",  "batches" },
+            { wxCMD_LINE_SWITCH, "",  "report" },
             { wxCMD_LINE_SWITCH, "",  "paint" },
             { wxCMD_LINE_SWITCH, "",  "client" },
             { wxCMD_LINE_SWITCH, "",  "memory" },
+            { wxCMD_LINE_SWITCH, "",  "wximage" },
             { wxCMD_LINE_SWITCH, "",  "dc" },
             { wxCMD_LINE_SWITCH, "",  "gc" },
 #if wxUSE_GLCANVAS
@@ -959,10 +1200,15 @@ public:
         opts.testTextExtent = parser.Found("textextent");
         opts.testMultiLineTextExtent = parser.Found("multilinetextextent");
         opts.testPartialTextExtents = parser.Found("partialtextextents");
+        opts.testLabels = parser.Found("labels");
+        opts.testBatches = parser.Found("batches");
+        opts.testReport = parser.Found("report");
         if ( !(opts.testBitmaps || opts.testImages || opts.testLines
                     || opts.testRawBitmaps || opts.testRectangles
                     || opts.testCircles || opts.testEllipses
-                    || opts.testTextExtent || opts.testPartialTextExtents) )
+                    || opts.testTextExtent || opts.testPartialTextExtents
+                    || opts.testLabels || opts.testBatches
+                    || opts.testReport) )
         {
             // Do everything by default.
             opts.testBitmaps =
@@ -973,17 +1219,23 @@ public:
             opts.testCircles =
             opts.testEllipses =
             opts.testTextExtent =
-            opts.testPartialTextExtents = true;
+            opts.testPartialTextExtents =
+            opts.testLabels =
+            opts.testBatches =
+            opts.testReport = true;
         }
 
         opts.usePaint = parser.Found("paint");
         opts.useClient = parser.Found("client");
         opts.useMemory = parser.Found("memory");
-        if ( !(opts.usePaint || opts.useClient || opts.useMemory) )
+        opts.useImage = parser.Found("wximage");
+        if ( !(opts.usePaint || opts.useClient || opts.useMemory
+                    || opts.useImage) )
         {
             opts.usePaint =
             opts.useClient =
-            opts.useMemory = true;
+            opts.useMemory =
+            opts.useImage = true;
         }
 
         opts.useDC = parser.Found("dc");
@@ -0,0 +1,104 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/htmlparser/htmlresize.cpp
+// Purpose:     wxHtmlContainerCell layout benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/bitmap.h"
+#include "wx/dcmemory.h"
+#include "wx/html/htmlcell.h"
+#include "wx/html/winpars.h"
+
+#include "../bench.h"
+
+#if wxUSE_HTML
+
+namespace
+{
+
+wxBitmap gs_bitmap;
+wxMemoryDC* gs_dc = nullptr;
+wxHtmlContainerCell* gs_cell = nullptr;
+
+// Create a document similar to the one shown by a log viewer, with the given
+// number of lines (50000 by default) and a paragraph of long text, which is
+// wrapped at any reasonable width, every 1000 lines.
+bool CreateLogDocument()
+{
+    const long count = Bench::GetNumericParameter(50000);
+
+    wxString html("<html><body>");
+    for ( long n = 0; n < count; n++ )
+    {
+        if ( n % 1000 == 0 )
+        {
+            html += "<p>";
+            for ( int i = 0; i < 20; i++ )
+                html += "This paragraph is long enough to be wrapped. ";
+            html += "</p>";
+        }
+
+        html += wxString::Format
+                (
+                    "<font color=\"#808080\">12:34:%02ld.%03ld</font> "
+                    "<b>%s</b> message %ld processed<br>",
+                    (n / 1000) % 60, n % 1000,
+                    n % 10 ? "info" : "warning",
+                    n
+                );
+    }
+    html += "</body></html>";
+
+    gs_bitmap.Create(1, 1);
+    gs_dc = new wxMemoryDC(gs_bitmap);
+
+    wxHtmlWinParser parser;
+    parser.SetDC(gs_dc);
+
+    gs_cell = static_cast<wxHtmlContainerCell*>(parser.Parse(html));
+    if ( !gs_cell )
+        return false;
+
+    gs_cell->Layout(800);
+
+    return true;
+}
+
+void DeleteLogDocument()
+{
+    delete gs_cell;
+    gs_cell = nullptr;
+
+    delete gs_dc;
+    gs_dc = nullptr;
+
+    gs_bitmap = wxNullBitmap;
+}
+
+} // anonymous namespace
+
+// Simulate dragging the window border: the width changes by a few pixels
+// every time, which doesn't change the position of any lines in the log.
+BENCHMARK_FUNC_WITH_INIT(HTMLResize, CreateLogDocument, DeleteLogDocument)
+{
+    static int s_step = 0;
+
+    gs_cell->Layout(750 + s_step++ % 100);
+
+    return gs_cell->GetHeight() > 0;
+}
+
+// Resize the window between the widths at which the lines must be wrapped.
+BENCHMARK_FUNC_WITH_INIT(HTMLResizeWrap, CreateLogDocument, DeleteLogDocument)
+{
+    static int s_step = 0;
+
+    gs_cell->Layout(s_step++ % 2 ? 150 : 250);
+
+    return gs_cell->GetHeight() > 0;
+}
+
+#endif // wxUSE_HTML
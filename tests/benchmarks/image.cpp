@@ -7,10 +7,17 @@
 // Licence:     wxWindows licence
 /////////////////////////////////////////////////////////////////////////////
 
+#include "wx/crt.h"
 #include "wx/image.h"
+#include "wx/math.h"
+#include "wx/mstream.h"
+#include "wx/quantize.h"
+#include "wx/utils.h"
 
 #include "bench.h"
 
+#include <vector>
+
 BENCHMARK_FUNC(LoadBMP)
 {
     wxImage image;
@@ -30,7 +37,52 @@ BENCHMARK_FUNC(LoadJPEG)
     return image.LoadFile("horse.jpg");
 }
 
-BENCHMARK_FUNC(LoadPNG)
+// Create a thumbnail of the JPEG image given by the string parameter with
+// the maximal size given by the numeric one.
+static wxImage LoadJPEGThumbnail(bool scaleOnLoad)
+{
+    static bool s_handlerAdded = false;
+    if ( !s_handlerAdded )
+    {
+        s_handlerAdded = true;
+        wxImage::AddHandler(new wxJPEGHandler);
+    }
+
+    const int size = Bench::GetNumericParameter(64);
+
+    wxImage image;
+    if ( scaleOnLoad )
+    {
+        image.SetOption(wxIMAGE_OPTION_MAX_WIDTH, size);
+        image.SetOption(wxIMAGE_OPTION_MAX_HEIGHT, size);
+    }
+
+    if ( !image.LoadFile(Bench::GetStringParameter("horse.jpg")) )
+        return wxImage();
+
+    if ( !scaleOnLoad )
+    {
+        const double scale = wxMin(double(size) / image.GetWidth(),
+                                   double(size) / image.GetHeight());
+        if ( scale < 1 )
+            image.Rescale(wxRound(scale*image.GetWidth()),
+                          wxRound(scale*image.GetHeight()));
+    }
+
+    return image;
+}
+
+BENCHMARK_FUNC(LoadJPEGThumbnail)
+{
+    return LoadJPEGThumbnail(true).IsOk();
+}
+
+BENCHMARK_FUNC(LoadJPEGThenRescale)
+{
+    return LoadJPEGThumbnail(false).IsOk();
+}
+
+static void AddPNGHandlerIfNeeded()
 {
     static bool s_handlerAdded = false;
     if ( !s_handlerAdded )
@@ -38,11 +90,225 @@ BENCHMARK_FUNC(LoadPNG)
         s_handlerAdded = true;
         wxImage::AddHandler(new wxPNGHandler);
     }
+}
+
+BENCHMARK_FUNC(LoadPNG)
+{
+    AddPNGHandlerIfNeeded();
 
     wxImage image;
     return image.LoadFile("horse.png");
 }
 
+// Synthetic full HD image looking vaguely like a screenshot, i.e. with big
+// uniform areas, gradients and some busier parts, used by PNG saving
+// benchmarks.
+static wxImage& GetScreenshotImage()
+{
+    static wxImage s_image;
+    if ( !s_image.IsOk() )
+    {
+        const int w = 1920;
+        const int h = 1080;
+        s_image.Create(w, h, false);
+
+        unsigned char* p = s_image.GetData();
+        for ( int y = 0; y < h; y++ )
+        {
+            for ( int x = 0; x < w; x++ )
+            {
+                unsigned char r, g, b;
+                if ( y < 40 )
+                {
+                    // Title bar gradient.
+                    r = g = static_cast<unsigned char>(64 + x*128/w);
+                    b = 200;
+                }
+                else if ( x < 300 )
+                {
+                    // Side bar with "text" lines.
+                    const bool ink = (y / 4) % 5 == 0 && ((x * 7 + y) % 11) < 6;
+                    r = g = b = ink ? 30 : 240;
+                }
+                else
+                {
+                    // Content area with a noisy picture in it.
+                    r = static_cast<unsigned char>((x ^ y) & 0xff);
+                    g = static_cast<unsigned char>((x * y) >> 6);
+                    b = static_cast<unsigned char>(x + y);
+                }
+
+                *p++ = r;
+                *p++ = g;
+                *p++ = b;
+            }
+        }
+    }
+
+    return s_image;
+}
+
+static bool SavePNG(bool fast, int threads)
+{
+    AddPNGHandlerIfNeeded();
+
+    wxImage& image = GetScreenshotImage();
+    image.SetOption(wxIMAGE_OPTION_PNG_FAST, fast);
+    image.SetOption(wxIMAGE_OPTION_PNG_COMPRESSION_THREADS, threads);
+
+    wxMemoryOutputStream mos;
+    return image.SaveFile(mos, wxBITMAP_TYPE_PNG);
+}
+
+BENCHMARK_FUNC(SavePNG)
+{
+    return SavePNG(false, 1);
+}
+
+BENCHMARK_FUNC(SavePNGFast)
+{
+    return SavePNG(true, 1);
+}
+
+// The number of threads to use is given by the numeric parameter, all CPUs
+// are used by default.
+BENCHMARK_FUNC(SavePNGParallel)
+{
+    return SavePNG(false, Bench::GetNumericParameter(0));
+}
+
+BENCHMARK_FUNC(SavePNGFastParallel)
+{
+    return SavePNG(true, Bench::GetNumericParameter(0));
+}
+
+// Quantization benchmarks use the same image as PNG ones, reducing it to the
+// default number of colours.
+static wxImage QuantizeScreenshot(int flags)
+{
+    const wxImage& image = GetScreenshotImage();
+
+    wxImage dest(image.GetWidth(), image.GetHeight(), false);
+    wxQuantize::Quantize(image, dest, nullptr, 236, nullptr,
+                         wxQUANTIZE_FILL_DESTINATION_IMAGE | flags);
+    return dest;
+}
+
+// Print the quality of the result, as PSNR, before running the benchmark, to
+// allow comparing the different quantization engines.
+template <int flags>
+static bool PrintQuantizeQuality()
+{
+    const wxImage& image = GetScreenshotImage();
+    const wxImage dest = QuantizeScreenshot(flags);
+
+    const size_t len = 3*image.GetWidth()*image.GetHeight();
+    const unsigned char* p1 = image.GetData();
+    const unsigned char* p2 = dest.GetData();
+
+    double sum = 0;
+    for ( size_t n = 0; n < len; n++ )
+    {
+        const double d = p1[n] - p2[n];
+        sum += d*d;
+    }
+
+    wxPrintf("PSNR: %.2fdB\n", 10*log10(255.*255.*len/sum));
+
+    return true;
+}
+
+BENCHMARK_FUNC_WITH_INIT(Quantize, PrintQuantizeQuality<0>, nullptr)
+{
+    return QuantizeScreenshot(0).IsOk();
+}
+
+BENCHMARK_FUNC_WITH_INIT(QuantizeNoDither,
+                         PrintQuantizeQuality<wxQUANTIZE_NO_DITHERING>,
+                         nullptr)
+{
+    return QuantizeScreenshot(wxQUANTIZE_NO_DITHERING).IsOk();
+}
+
+BENCHMARK_FUNC_WITH_INIT(QuantizeFast,
+                         PrintQuantizeQuality<wxQUANTIZE_FAST>,
+                         nullptr)
+{
+    return QuantizeScreenshot(wxQUANTIZE_FAST).IsOk();
+}
+
+BENCHMARK_FUNC_WITH_INIT(QuantizeFastNoDither,
+                         PrintQuantizeQuality<wxQUANTIZE_FAST | wxQUANTIZE_NO_DITHERING>,
+                         nullptr)
+{
+    return QuantizeScreenshot(wxQUANTIZE_FAST | wxQUANTIZE_NO_DITHERING).IsOk();
+}
+
+// Small images in all formats which can be saved, used to check how fast the
+// format of an image is detected when loading it.
+static std::vector<wxMemoryBuffer> gs_mixedImages;
+
+static bool InitMixedImages()
+{
+    wxInitAllImageHandlers();
+
+    const wxImage image = GetScreenshotImage().GetSubImage(wxRect(280, 20, 32, 32));
+
+    static const wxBitmapType types[] =
+    {
+        wxBITMAP_TYPE_BMP,
+        wxBITMAP_TYPE_PNG,
+        wxBITMAP_TYPE_JPEG,
+        wxBITMAP_TYPE_GIF,
+        wxBITMAP_TYPE_TIFF,
+        wxBITMAP_TYPE_PCX,
+        wxBITMAP_TYPE_PNM,
+        wxBITMAP_TYPE_TGA,
+        wxBITMAP_TYPE_XPM,
+        wxBITMAP_TYPE_ICO,
+    };
+
+    for ( wxBitmapType type : types )
+    {
+        if ( !wxImage::FindHandler(type) )
+            continue;
+
+        wxMemoryOutputStream mos;
+        if ( !image.SaveFile(mos, type) )
+            return false;
+
+        wxMemoryBuffer buf;
+        mos.CopyTo(buf.GetWriteBuf(mos.GetLength()), mos.GetLength());
+        buf.UngetWriteBuf(mos.GetLength());
+        gs_mixedImages.push_back(buf);
+    }
+
+    return !gs_mixedImages.empty();
+}
+
+static void DoneMixedImages()
+{
+    gs_mixedImages.clear();
+}
+
+// Load the given number of images (10000 by default) in different formats
+// without specifying their type.
+BENCHMARK_FUNC_WITH_INIT(LoadMixedImages, InitMixedImages, DoneMixedImages)
+{
+    const long count = Bench::GetNumericParameter(10000);
+    for ( long n = 0; n < count; n++ )
+    {
+        const wxMemoryBuffer& buf = gs_mixedImages[n % gs_mixedImages.size()];
+
+        wxMemoryInputStream mis(buf.GetData(), buf.GetDataLen());
+        wxImage image;
+        if ( !image.LoadFile(mis) )
+            return false;
+    }
+
+    return true;
+}
+
 #if wxUSE_LIBTIFF
 BENCHMARK_FUNC(LoadTIFF)
 {
@@ -0,0 +1,104 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/lzma.cpp
+// Purpose:     LZMA streams benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/defs.h"
+
+#if wxUSE_LIBLZMA && wxUSE_STREAMS
+
+#include "wx/lzmastream.h"
+#include "wx/mstream.h"
+
+#include "bench.h"
+
+// Uncompressed data and the same data compressed using single-threaded and
+// multi-threaded compressors (the latter being split in independent blocks).
+static wxMemoryBuffer gs_data;
+static wxMemoryBuffer gs_compressed;
+static wxMemoryBuffer gs_compressedMT;
+
+static bool Compress(wxMemoryBuffer& out, int threads)
+{
+    wxMemoryOutputStream mout;
+    {
+        wxLZMAOutputStream zout(mout, 0, threads);
+        if ( !zout.WriteAll(gs_data.GetData(), gs_data.GetDataLen()) )
+            return false;
+
+        if ( !zout.Close() )
+            return false;
+    }
+
+    const size_t len = mout.GetSize();
+    mout.CopyTo(out.GetWriteBuf(len), len);
+    out.UngetWriteBuf(len);
+
+    return true;
+}
+
+static bool Decompress(const wxMemoryBuffer& in, int threads)
+{
+    wxMemoryInputStream min(in.GetData(), in.GetDataLen());
+    wxLZMAInputStream zin(min, threads);
+
+    char buf[65536];
+    size_t total = 0;
+    while ( zin.Read(buf, sizeof(buf)).LastRead() )
+        total += zin.LastRead();
+
+    return zin.GetLastError() == wxSTREAM_EOF && total == gs_data.GetDataLen();
+}
+
+// The size of the data in MiB is given by the numeric parameter.
+static bool InitData()
+{
+    const size_t len = Bench::GetNumericParameter(16) * 1024 * 1024;
+
+    // Generate something compressible, but not too much so.
+    unsigned char* const p = static_cast<unsigned char*>(gs_data.GetWriteBuf(len));
+    unsigned seed = 1;
+    for ( size_t n = 0; n < len; n++ )
+    {
+        seed = seed * 1103515245 + 12345;
+        p[n] = static_cast<unsigned char>("abcdefgh"[(seed >> 16) % 8]);
+    }
+    gs_data.UngetWriteBuf(len);
+
+    return Compress(gs_compressed, 1) && Compress(gs_compressedMT, 0);
+}
+
+static void DoneData()
+{
+    gs_data.Clear();
+    gs_compressed.Clear();
+    gs_compressedMT.Clear();
+}
+
+BENCHMARK_FUNC_WITH_INIT(LZMACompress, InitData, DoneData)
+{
+    wxMemoryBuffer out;
+    return Compress(out, 1);
+}
+
+BENCHMARK_FUNC_WITH_INIT(LZMACompressMT, InitData, DoneData)
+{
+    wxMemoryBuffer out;
+    return Compress(out, 0);
+}
+
+BENCHMARK_FUNC_WITH_INIT(LZMADecompress, InitData, DoneData)
+{
+    return Decompress(gs_compressed, 1);
+}
+
+BENCHMARK_FUNC_WITH_INIT(LZMADecompressMT, InitData, DoneData)
+{
+    return Decompress(gs_compressedMT, 0);
+}
+
+#endif // wxUSE_LIBLZMA && wxUSE_STREAMS
@@ -0,0 +1,182 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/postscript.cpp
+// Purpose:     wxPostScriptDC benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/bitmap.h"
+#include "wx/dcps.h"
+#include "wx/filefn.h"
+#include "wx/filename.h"
+#include "wx/image.h"
+
+#include "bench.h"
+
+#if wxUSE_POSTSCRIPT && wxUSE_PRINTING_ARCHITECTURE
+
+namespace
+{
+
+// Size of the last file created by one of the functions below.
+wxFileOffset gs_lastSize = 0;
+
+// Call the given function to draw on a PostScript DC writing to a temporary
+// file and remember the size of the generated file.
+template <typename F>
+bool ExportPS(wxPostScriptImageEncoding encoding, F draw)
+{
+    const wxString filename = wxFileName::CreateTempFileName("bench");
+
+    wxPrintData printData;
+    printData.SetFilename(filename);
+    printData.SetPrintMode(wxPRINT_MODE_FILE);
+
+    bool ok;
+    {
+        wxPostScriptDC dc(printData);
+        dc.SetImageEncoding(encoding);
+
+        if ( !dc.StartDoc("bench") )
+            return false;
+
+        dc.StartPage();
+        draw(dc);
+        dc.EndPage();
+        dc.EndDoc();
+
+        ok = dc.IsOk();
+    }
+
+    gs_lastSize = wxFileName::GetSize(filename).GetValue();
+
+    wxRemoveFile(filename);
+
+    return ok;
+}
+
+// Export the given number of primitives (100000 by default) drawn using a few
+// different pens and brushes.
+void DrawPrimitives(wxDC& dc)
+{
+    const long count = Bench::GetNumericParameter(100000);
+
+    static const wxColour colours[] =
+    {
+        *wxBLACK, *wxRED, *wxGREEN, *wxBLUE, wxColour(255, 128, 0),
+    };
+    const int numColours = WXSIZEOF(colours);
+
+    for ( long n = 0; n < count; n++ )
+    {
+        dc.SetPen(wxPen(colours[n % numColours], 1 + n % 3));
+        dc.SetBrush(wxBrush(colours[(n + 1) % numColours]));
+
+        const int x = (n * 37) % 500;
+        const int y = (n * 91) % 700;
+
+        switch ( n % 4 )
+        {
+            case 0:
+                dc.DrawLine(x, y, x + 10, y + 7);
+                break;
+
+            case 1:
+                dc.DrawRectangle(x, y, 10, 7);
+                break;
+
+            case 2:
+                dc.DrawEllipse(x, y, 9, 9);
+                break;
+
+            case 3:
+                {
+                    const wxPoint points[] =
+                    {
+                        wxPoint(x, y), wxPoint(x + 5, y + 9), wxPoint(x + 9, y),
+                    };
+                    dc.DrawPolygon(WXSIZEOF(points), points);
+                }
+                break;
+        }
+    }
+}
+
+// Draw a synthetic image resembling a chart, i.e. with big areas of the same
+// colour and some gradients, the given number of times (10 by default).
+bool ExportImages(wxPostScriptImageEncoding encoding)
+{
+    wxImage image(400, 300);
+    unsigned char* p = image.GetData();
+    for ( int y = 0; y < image.GetHeight(); y++ )
+    {
+        for ( int x = 0; x < image.GetWidth(); x++ )
+        {
+            if ( x < 50 )
+            {
+                // Gradient legend.
+                *p++ = static_cast<unsigned char>(y * 255 / image.GetHeight());
+                *p++ = 128;
+                *p++ = static_cast<unsigned char>(255 - x * 5);
+            }
+            else if ( (x / 40) % 2 && y > 300 - x / 2 )
+            {
+                // Bars.
+                *p++ = 0x20;
+                *p++ = 0x60;
+                *p++ = 0xc0;
+            }
+            else
+            {
+                // Background with grid lines.
+                const unsigned char c = x % 50 && y % 50 ? 0xff : 0xc0;
+                *p++ = c;
+                *p++ = c;
+                *p++ = c;
+            }
+        }
+    }
+
+    const wxBitmap bmp(image);
+    const long count = Bench::GetNumericParameter(10);
+
+    return ExportPS(encoding, [&bmp, count](wxDC& dc)
+        {
+            for ( long n = 0; n < count; n++ )
+                dc.DrawBitmap(bmp, 10 * (n % 10), 10 * (n % 40));
+        });
+}
+
+void ShowSize()
+{
+    wxPrintf("Generated file size: %lld bytes\n",
+             static_cast<long long>(gs_lastSize));
+}
+
+} // anonymous namespace
+
+BENCHMARK_FUNC_WITH_INIT(PSExport, nullptr, ShowSize)
+{
+    return ExportPS(wxPS_IMAGE_ENCODING_HEX, DrawPrimitives);
+}
+
+BENCHMARK_FUNC_WITH_INIT(PSExportImagesHex, nullptr, ShowSize)
+{
+    return ExportImages(wxPS_IMAGE_ENCODING_HEX);
+}
+
+BENCHMARK_FUNC_WITH_INIT(PSExportImagesRunLength, nullptr, ShowSize)
+{
+    return ExportImages(wxPS_IMAGE_ENCODING_RUNLENGTH);
+}
+
+#if wxUSE_ZLIB
+BENCHMARK_FUNC_WITH_INIT(PSExportImagesFlate, nullptr, ShowSize)
+{
+    return ExportImages(wxPS_IMAGE_ENCODING_FLATE);
+}
+#endif // wxUSE_ZLIB
+
+#endif // wxUSE_POSTSCRIPT && wxUSE_PRINTING_ARCHITECTURE
@@ -0,0 +1,101 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/svg.cpp
+// Purpose:     wxSVGFileDC benchmarks
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/dcsvg.h"
+#include "wx/filefn.h"
+#include "wx/filename.h"
+
+#include "bench.h"
+
+#if wxUSE_SVG
+
+// Export the given number of primitives (100000 by default) drawn using a few
+// different pens and brushes, as typically done when exporting a chart.
+static bool ExportSVG(const wxString& ext, bool useStyleClasses)
+{
+    // Note that the file created by CreateTempFileName() must be removed too.
+    const wxString tempname = wxFileName::CreateTempFileName("bench");
+    const wxString filename = tempname + ext;
+
+    const long count = Bench::GetNumericParameter(100000);
+
+    static const wxColour colours[] =
+    {
+        *wxBLACK, *wxRED, *wxGREEN, *wxBLUE, wxColour(255, 128, 0, 128),
+    };
+    const int numColours = WXSIZEOF(colours);
+
+    bool ok;
+    {
+        wxSVGFileDC dc(filename, 1000, 1000);
+        if ( useStyleClasses )
+            dc.EnableStyleClasses();
+
+        for ( long n = 0; n < count; n++ )
+        {
+            const wxColour& col = colours[n % numColours];
+            dc.SetPen(wxPen(col, 1 + n % 3));
+            dc.SetBrush(wxBrush(colours[(n + 1) % numColours]));
+
+            const int x = (n * 37) % 990;
+            const int y = (n * 91) % 990;
+
+            switch ( n % 4 )
+            {
+                case 0:
+                    dc.DrawLine(x, y, x + 10, y + 7);
+                    break;
+
+                case 1:
+                    dc.DrawRectangle(x, y, 10, 7);
+                    break;
+
+                case 2:
+                    dc.DrawEllipse(x, y, 9, 9);
+                    break;
+
+                case 3:
+                    {
+                        const wxPoint points[] =
+                        {
+                            wxPoint(x, y), wxPoint(x + 5, y + 9), wxPoint(x + 9, y),
+                        };
+                        dc.DrawPolygon(WXSIZEOF(points), points);
+                    }
+                    break;
+            }
+        }
+
+        ok = dc.IsOk();
+    }
+
+    wxRemoveFile(filename);
+    wxRemoveFile(tempname);
+
+    return ok;
+}
+
+BENCHMARK_FUNC(SVGExport)
+{
+    return ExportSVG(".svg", false);
+}
+
+BENCHMARK_FUNC(SVGExportClasses)
+{
+    return ExportSVG(".svg", true);
+}
+
+#if wxUSE_ZLIB
+BENCHMARK_FUNC(SVGExportCompressed)
+{
+    return ExportSVG(".svgz", true);
+}
+#endif // wxUSE_ZLIB
+
+#endif // wxUSE_SVG
@@ -641,6 +641,97 @@ TEST_CASE("wxFileConfig::LongLong", "[fileconfig][config][longlong]")
     CHECK( ll == val );
 }
 
+TEST_CASE("wxFileConfig::CaseInsensitive", "[fileconfig][config]")
+{
+    wxStringInputStream sis(testconfig);
+    wxFileConfig fc(sis);
+
+    CHECK( fc.Read("/ROOT/Entry", "") == "value" );
+    CHECK( fc.HasGroup("/Root/Group1/SubGroup") );
+    CHECK( fc.Read("/root/GROUP1/subgroup/SUBENTRY2", "") == "subvalue2" );
+
+    fc.Write("/Root/ENTRY", "newvalue");
+    wxVERIFY_FILECONFIG( "[root]\n"
+                         "entry=newvalue\n"
+                         "[root/group1]\n"
+                         "[root/group1/subgroup]\n"
+                         "subentry=subvalue\n"
+                         "subentry2=subvalue2\n"
+                         "[root/group2]\n",
+                         fc );
+}
+
+TEST_CASE("wxFileConfig::PathCache", "[fileconfig][config]")
+{
+    wxStringInputStream sis(testconfig);
+    wxFileConfig fc(sis);
+
+    // Use the paths once to cache them.
+    CHECK( fc.Read("/root/group1/subgroup/subentry", "") == "subvalue" );
+    CHECK( ChangePath(fc, "/root/group1/subgroup") == "/root/group1/subgroup" );
+    CHECK( ChangePath(fc, "..") == "/root/group1" );
+    fc.SetPath("/");
+
+    // Check that the cached paths are not used after the group is deleted.
+    CHECK( fc.DeleteGroup("/root/group1") );
+    CHECK( !fc.HasGroup("/root/group1/subgroup") );
+    CHECK( fc.Read("/root/group1/subgroup/subentry", "") == "" );
+
+    // Or renamed.
+    fc.SetPath("/root");
+    CHECK( fc.RenameGroup("group2", "group3") );
+    fc.SetPath("/");
+    CHECK( !fc.HasGroup("/root/group2") );
+    CHECK( fc.HasGroup("/root/group3") );
+
+    fc.Write("/root/group1/subgroup/subentry", "recreated");
+    CHECK( fc.Read("/root/group1/subgroup/subentry", "") == "recreated" );
+}
+
+TEST_CASE("wxFileConfig::BatchMode", "[fileconfig][config]")
+{
+    const auto fill = [](wxFileConfig& fc)
+    {
+        fc.Write("entry", "changed");
+        fc.Write("newentry", "1");
+        fc.Write("/root/group1/newentry", "2");
+        fc.Write("/root/newgroup/entry", "3");
+        fc.Write("/root/group1/subgroup/subentry", "4");
+        fc.Write("/root/newgroup/entry", "5");
+        fc.Write("/newroot/entry", "6");
+        fc.Write("/root/group1/subgroup/subentry", "7");
+        fc.DeleteEntry("/root/newgroup/entry", false);
+        fc.Write("/root/newgroup/entry2", "8");
+        fc.Write("/root/group2/", "");
+        fc.Write("/root/group2/entry", "9");
+        fc.RenameEntry("newentry", "renamed");
+        fc.Write("/root/entry3", "10");
+    };
+
+    wxStringInputStream sis1(testconfig);
+    wxFileConfig fc1(sis1);
+    fill(fc1);
+
+    wxStringInputStream sis2(testconfig);
+    wxFileConfig fc2(sis2);
+    fc2.SetBatchMode();
+    CHECK( fc2.IsBatchMode() );
+    fill(fc2);
+
+    // Values must be available immediately, even in batch mode.
+    CHECK( fc2.Read("/root/group1/subgroup/subentry", "") == "7" );
+
+    fc2.SetBatchMode(false);
+    CHECK( Dump(fc2) == Dump(fc1) );
+
+    // Saving while in batch mode must produce the same result too.
+    wxStringInputStream sis3(testconfig);
+    wxFileConfig fc3(sis3);
+    fc3.SetBatchMode();
+    fill(fc3);
+    CHECK( Dump(fc3) == Dump(fc1) );
+}
+
 TEST_CASE_METHOD(LogTestCase, "wxFileConfig::Error", "[fileconfig][error]")
 {
     const auto checkWarning = [this](const char* contents, const char* expected)
@@ -372,6 +372,50 @@ TEST_CASE_METHOD(ExecTestCase, "wxExecute::AsyncRedirect", "[exec]")
     DoTestAsyncRedirect(COMMAND_STDERR, Check_Stderr, "file");
 }
 
+#ifdef __UNIX__
+
+TEST_CASE("wxExecute::Env", "[exec]")
+{
+    wxExecuteEnv env;
+    env.cwd = "/";
+    REQUIRE( wxGetEnvMap(&env.env) );
+    env.env["WX_EXEC_TEST"] = "ok";
+
+    wxArrayString output;
+    REQUIRE( wxExecute("/bin/sh -c 'pwd; echo $WX_EXEC_TEST'",
+                       output, 0, &env) == 0 );
+    REQUIRE( output.size() == 2 );
+    CHECK( output[0] == "/" );
+    CHECK( output[1] == "ok" );
+
+    // Check that the environment is also changed when using a different PATH,
+    // which is a special case for some implementations.
+    env.env["PATH"] = "/bin:/usr/bin";
+
+    output.clear();
+    REQUIRE( wxExecute("sh -c 'echo $PATH'", output, 0, &env) == 0 );
+    REQUIRE( output.size() == 1 );
+    CHECK( output[0] == "/bin:/usr/bin" );
+}
+
+TEST_CASE("wxExecuteBatch", "[exec]")
+{
+    wxArrayString commands;
+    for ( int n = 0; n < 3; n++ )
+        commands.push_back(ASYNC_COMMAND);
+
+    const std::vector<long> pids = wxExecuteBatch(commands);
+    REQUIRE( pids.size() == commands.size() );
+
+    for ( long pid : pids )
+    {
+        REQUIRE( pid != 0 );
+        CHECK( wxKill(pid, wxSIGKILL) == 0 );
+    }
+}
+
+#endif // __UNIX__
+
 // static
 wxString ExecTestCase::CreateSleepFile(const wxString& basename, int seconds)
 {
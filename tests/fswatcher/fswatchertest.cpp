@@ -627,6 +627,50 @@ TEST_CASE_METHOD(FileSystemWatcherTestCase,
     EventTester tester;
     tester.Run();
 }
+
+// ----------------------------------------------------------------------------
+// TestCoalescing: several modifications result in a single event
+// ----------------------------------------------------------------------------
+
+TEST_CASE_METHOD(FileSystemWatcherTestCase,
+                 "wxFileSystemWatcher::Coalescing", "[fsw]")
+{
+    class EventTester : public FSWTesterBase
+    {
+    public:
+        virtual bool Init() override
+        {
+            if ( !FSWTesterBase::Init() )
+                return false;
+
+            m_watcher->SetCoalescingInterval(100);
+            CHECK( m_watcher->GetCoalescingInterval() == 100 );
+
+            return true;
+        }
+
+        virtual void GenerateEvent() override
+        {
+            CHECK(eg.ModifyFile());
+            CHECK(eg.ModifyFile());
+            CHECK(eg.ModifyFile());
+        }
+
+        virtual wxFileSystemWatcherEvent ExpectedEvent() override
+        {
+            wxFileSystemWatcherEvent event(wxFSW_EVENT_MODIFY);
+            event.SetPath(eg.m_file);
+            event.SetNewPath(eg.m_file);
+            return event;
+        }
+    };
+
+    // we need to create a file to modify
+    EventGenerator::Get().CreateFile();
+
+    EventTester tester;
+    tester.Run();
+}
 #endif // wxHAS_INOTIFY
 
 // ----------------------------------------------------------------------------
@@ -873,6 +917,100 @@ TEST_CASE_METHOD(FileSystemWatcherTestCase,
 }
 
 
+#ifdef wxHAS_INOTIFY
+
+// ----------------------------------------------------------------------------
+// TestTreeAsync
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+class TreeAsyncTester : public FSWTesterBase,
+                        public wxTimer
+{
+public:
+    TreeAsyncTester() : m_treedir(EventGenerator::GetWatchDir())
+    {
+        m_treedir.AppendDir("asynctree");
+    }
+
+    virtual void GenerateEvent() override
+    {
+        // Create a tree with 1 + 10 + 100 directories.
+        REQUIRE(m_treedir.Mkdir());
+        for ( int i = 0; i < 10; i++ )
+        {
+            for ( int j = 0; j < 10; j++ )
+            {
+                wxFileName dir(m_treedir);
+                dir.AppendDir(wxString::Format("dir%d", i));
+                dir.AppendDir(wxString::Format("sub%d", j));
+                REQUIRE(dir.Mkdir(wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL));
+            }
+        }
+
+        m_initial = m_watcher->GetWatchedPathsCount();
+
+        // Check that cancelling adding the tree works.
+        CHECK( m_watcher->AddTreeAsync(m_treedir) );
+        CHECK( m_watcher->IsAddingTree() );
+        CHECK( m_watcher->RemoveTree(m_treedir) );
+        CHECK( !m_watcher->IsAddingTree() );
+        CHECK( m_watcher->GetWatchedPathsCount() == m_initial );
+
+        // The root of the tree is added immediately, the rest of it later.
+        CHECK( m_watcher->AddTreeAsync(m_treedir) );
+        CHECK( m_watcher->GetWatchedPathsCount() >= m_initial + 1 );
+
+        Start(10);
+    }
+
+    virtual void Notify() override
+    {
+        if ( m_watcher->IsAddingTree() )
+            return;
+
+        Stop();
+
+        CHECK( m_watcher->GetWatchedPathsCount() == m_initial + 111 );
+
+        CHECK( m_watcher->RemoveTree(m_treedir) );
+        CHECK( m_watcher->GetWatchedPathsCount() == m_initial );
+
+        CHECK( m_treedir.Rmdir(wxPATH_RMDIR_RECURSIVE) );
+
+        Exit();
+    }
+
+    virtual void CheckResult() override
+    {
+        // Do nothing, we don't check for events here.
+    }
+
+    virtual wxFileSystemWatcherEvent ExpectedEvent() override
+    {
+        FAIL( "Shouldn't be called" );
+
+        return wxFileSystemWatcherEvent(wxFSW_EVENT_ERROR);
+    }
+
+private:
+    wxFileName m_treedir;
+    int m_initial = 0;
+};
+
+} // anonymous namespace
+
+TEST_CASE_METHOD(FileSystemWatcherTestCase,
+                 "wxFileSystemWatcher::TreeAsync", "[fsw]")
+{
+    TreeAsyncTester tester;
+    tester.Run();
+}
+
+#endif // wxHAS_INOTIFY
+
 namespace
 {
 
@@ -0,0 +1,210 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        tests/graphics/batchdraw.cpp
+// Purpose:     Tests for wxGraphicsContext functions drawing many primitives
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets team
+///////////////////////////////////////////////////////////////////////////////
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+#include "testprec.h"
+
+#if wxUSE_GRAPHICS_CONTEXT
+
+#include "wx/brush.h"
+#include "wx/graphics.h"
+#include "wx/image.h"
+#include "wx/pen.h"
+
+#include "testimage.h"
+
+#include <functional>
+#include <memory>
+
+namespace
+{
+
+const int IMAGE_SIZE = 64;
+
+// The primitives are placed on a grid with cells big enough for them to never
+// overlap, so that drawing them one by one or all at once gives the same result.
+const int GRID_STEP = 8;
+const int GRID_COUNT = IMAGE_SIZE / GRID_STEP;
+const size_t ITEMS_COUNT = GRID_COUNT*GRID_COUNT;
+
+// Draw on a white image using the given renderer and return the result.
+wxImage
+DrawImage(wxGraphicsRenderer* renderer,
+          const std::function<void (wxGraphicsContext&)>& draw)
+{
+    wxImage image(IMAGE_SIZE, IMAGE_SIZE);
+    image.SetRGB(wxRect(0, 0, IMAGE_SIZE, IMAGE_SIZE), 0xff, 0xff, 0xff);
+
+    {
+        std::unique_ptr<wxGraphicsContext> gc(renderer->CreateContextFromImage(image));
+        REQUIRE( gc );
+
+        gc->SetAntialiasMode(wxANTIALIAS_NONE);
+        draw(*gc);
+    }
+
+    return image;
+}
+
+wxColour GetItemColour(size_t n)
+{
+    // Use runs of the same colour of different lengths.
+    static const wxColour colours[] = { *wxRED, *wxRED, *wxGREEN, *wxBLUE, *wxBLUE, *wxBLUE };
+
+    return colours[n % WXSIZEOF(colours)];
+}
+
+void CheckBatches(wxGraphicsRenderer* renderer)
+{
+    wxVector<wxRect2DDouble> rects;
+    wxVector<wxPoint2DDouble> points, beginPoints, endPoints;
+    wxVector<wxColour> colours;
+    for ( int y = 0; y < GRID_COUNT; y++ )
+    {
+        for ( int x = 0; x < GRID_COUNT; x++ )
+        {
+            const int left = x*GRID_STEP + 1;
+            const int top = y*GRID_STEP + 1;
+
+            rects.push_back(wxRect2DDouble(left, top, 5, 5));
+            points.push_back(wxPoint2DDouble(left + 2, top + 2));
+            beginPoints.push_back(wxPoint2DDouble(left, top + 2.5));
+            endPoints.push_back(wxPoint2DDouble(left + 5, top + 2.5));
+            colours.push_back(GetItemColour(colours.size()));
+        }
+    }
+
+    SECTION("DrawRectangles")
+    {
+        const wxImage single = DrawImage(renderer, [&](wxGraphicsContext& gc)
+        {
+            gc.SetPen(*wxBLACK_PEN);
+            gc.SetBrush(*wxRED_BRUSH);
+            for ( size_t n = 0; n < ITEMS_COUNT; n++ )
+                gc.DrawRectangle(rects[n].m_x, rects[n].m_y,
+                                 rects[n].m_width, rects[n].m_height);
+        });
+
+        const wxImage batch = DrawImage(renderer, [&](wxGraphicsContext& gc)
+        {
+            gc.SetPen(*wxBLACK_PEN);
+            gc.SetBrush(*wxRED_BRUSH);
+            gc.DrawRectangles(ITEMS_COUNT, &rects[0]);
+        });
+
+        CHECK_THAT( batch, RGBSameAs(single) );
+    }
+
+    SECTION("DrawRectangles with colours")
+    {
+        const wxImage single = DrawImage(renderer, [&](wxGraphicsContext& gc)
+        {
+            gc.SetPen(*wxBLACK_PEN);
+            for ( size_t n = 0; n < ITEMS_COUNT; n++ )
+            {
+                gc.SetBrush(wxBrush(colours[n]));
+                gc.DrawRectangle(rects[n].m_x, rects[n].m_y,
+                                 rects[n].m_width, rects[n].m_height);
+            }
+        });
+
+        const wxImage batch = DrawImage(renderer, [&](wxGraphicsContext& gc)
+        {
+            gc.SetPen(*wxBLACK_PEN);
+            gc.DrawRectangles(ITEMS_COUNT, &rects[0], &colours[0]);
+        });
+
+        CHECK_THAT( batch, RGBSameAs(single) );
+    }
+
+    SECTION("DrawPoints")
+    {
+        const wxImage single = DrawImage(renderer, [&](wxGraphicsContext& gc)
+        {
+            gc.SetPen(*wxTRANSPARENT_PEN);
+            for ( size_t n = 0; n < ITEMS_COUNT; n++ )
+            {
+                gc.SetBrush(wxBrush(colours[n]));
+                gc.DrawRectangle(points[n].m_x, points[n].m_y, 1, 1);
+            }
+        });
+
+        const wxImage batch = DrawImage(renderer, [&](wxGraphicsContext& gc)
+        {
+            // The pen must not be used for drawing the points.
+            gc.SetPen(*wxBLACK_PEN);
+            gc.DrawPoints(ITEMS_COUNT, &points[0], &colours[0]);
+        });
+
+        CHECK_THAT( batch, RGBSameAs(single) );
+    }
+
+    SECTION("StrokeSegments")
+    {
+        const wxImage single = DrawImage(renderer, [&](wxGraphicsContext& gc)
+        {
+            gc.SetPen(gc.CreatePen(wxGraphicsPenInfo(*wxBLUE)));
+            for ( size_t n = 0; n < ITEMS_COUNT; n++ )
+                gc.StrokeLine(beginPoints[n].m_x, beginPoints[n].m_y,
+                              endPoints[n].m_x, endPoints[n].m_y);
+        });
+
+        const wxImage batch = DrawImage(renderer, [&](wxGraphicsContext& gc)
+        {
+            gc.StrokeSegments(ITEMS_COUNT, &beginPoints[0], &endPoints[0],
+                              wxGraphicsPenInfo(*wxBLUE));
+        });
+
+        CHECK_THAT( batch, RGBSameAs(single) );
+    }
+
+    SECTION("StrokeSegments with colours")
+    {
+        const wxImage single = DrawImage(renderer, [&](wxGraphicsContext& gc)
+        {
+            for ( size_t n = 0; n < ITEMS_COUNT; n++ )
+            {
+                gc.SetPen(gc.CreatePen(wxGraphicsPenInfo(colours[n], 2)));
+                gc.StrokeLine(beginPoints[n].m_x, beginPoints[n].m_y,
+                              endPoints[n].m_x, endPoints[n].m_y);
+            }
+        });
+
+        const wxImage batch = DrawImage(renderer, [&](wxGraphicsContext& gc)
+        {
+            gc.StrokeSegments(ITEMS_COUNT, &beginPoints[0], &endPoints[0],
+                              wxGraphicsPenInfo(*wxBLACK, 2), &colours[0]);
+        });
+
+        CHECK_THAT( batch, RGBSameAs(single) );
+    }
+}
+
+} // anonymous namespace
+
+TEST_CASE("wxGraphicsContext::Batches", "[graphcontext][batch]")
+{
+    SECTION("Default GC")
+    {
+        CheckBatches(wxGraphicsRenderer::GetDefaultRenderer());
+    }
+
+#if wxUSE_CAIRO
+    SECTION("Cairo GC")
+    {
+        wxGraphicsRenderer* gr = wxGraphicsRenderer::GetCairoRenderer();
+        REQUIRE( gr != nullptr );
+        CheckBatches(gr);
+    }
+#endif // wxUSE_CAIRO
+}
+
+#endif // wxUSE_GRAPHICS_CONTEXT
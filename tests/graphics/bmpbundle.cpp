@@ -23,6 +23,7 @@
 #endif // __WINDOWS__
 
 #include "asserthelper.h"
+#include "testimage.h"
 
 // ----------------------------------------------------------------------------
 // tests
@@ -462,6 +463,121 @@ TEST_CASE("BitmapBundle::FromSVG", "[bmpbundle][svg]")
     CHECK( b.GetBitmap(wxSize(16, 16)).GetSize() == wxSize(16, 16) );
 }
 
+TEST_CASE("BitmapBundle::SVGCache", "[bmpbundle][svg]")
+{
+    static const char svg_data[] =
+        "<svg viewBox=\"0 0 100 100\">"
+        "<rect x=\"10\" y=\"10\" width=\"80\" height=\"80\" fill=\"red\"/>"
+        "</svg>"
+        ;
+
+    wxBitmapBundle::ClearSVGCache();
+
+    wxBitmapBundle b1 = wxBitmapBundle::FromSVG(svg_data, wxSize(16, 16));
+    REQUIRE( b1.IsOk() );
+
+    // The first request for each size must rasterize the bitmap.
+    CHECK( b1.GetBitmap(wxSize(16, 16)).GetSize() == wxSize(16, 16) );
+    CHECK( b1.GetBitmap(wxSize(24, 24)).GetSize() == wxSize(24, 24) );
+
+    wxBitmapBundle::SVGCacheStats stats = wxBitmapBundle::GetSVGCacheStats();
+    CHECK( stats.hits == 0 );
+    CHECK( stats.misses == 2 );
+    CHECK( stats.count == 2 );
+    CHECK( stats.bytes == (16*16 + 24*24)*4 );
+
+    // But alternating between them shouldn't.
+    CHECK( b1.GetBitmap(wxSize(16, 16)).GetSize() == wxSize(16, 16) );
+    CHECK( b1.GetBitmap(wxSize(24, 24)).GetSize() == wxSize(24, 24) );
+    CHECK( wxBitmapBundle::GetSVGCacheStats().hits == 2 );
+
+    // Another bundle created from the same data reuses the same bitmaps.
+    wxBitmapBundle b2 = wxBitmapBundle::FromSVG(svg_data, wxSize(16, 16));
+    CHECK( b2.GetBitmap(wxSize(24, 24)).GetSize() == wxSize(24, 24) );
+
+    stats = wxBitmapBundle::GetSVGCacheStats();
+    CHECK( stats.hits == 3 );
+    CHECK( stats.misses == 2 );
+
+    // Reducing the limit evicts the least recently used bitmap.
+    wxBitmapBundle::SetSVGCacheLimit(24*24*4);
+    stats = wxBitmapBundle::GetSVGCacheStats();
+    CHECK( stats.count == 1 );
+    CHECK( stats.bytes == 24*24*4 );
+
+    wxBitmapBundle b3 = wxBitmapBundle::FromSVG(svg_data, wxSize(16, 16));
+    CHECK( b3.GetBitmap(wxSize(24, 24)).GetSize() == wxSize(24, 24) );
+    CHECK( b3.GetBitmap(wxSize(16, 16)).GetSize() == wxSize(16, 16) );
+
+    stats = wxBitmapBundle::GetSVGCacheStats();
+    CHECK( stats.hits == 4 );
+    CHECK( stats.misses == 3 );
+    CHECK( stats.count == 1 );
+
+    wxBitmapBundle::SetSVGCacheLimit(16*1024*1024);
+    wxBitmapBundle::ClearSVGCache();
+    CHECK( wxBitmapBundle::GetSVGCacheStats().count == 0 );
+}
+
+TEST_CASE("BitmapBundle::PrerasterizeSVG", "[bmpbundle][svg]")
+{
+    static const char svg_data[] =
+        "<svg viewBox=\"0 0 100 100\">"
+        "<circle cx=\"50\" cy=\"50\" r=\"40\" fill=\"green\"/>"
+        "</svg>"
+        ;
+
+    wxBitmapBundle::ClearSVGCache();
+
+    wxVector<wxBitmapBundle> bundles;
+    bundles.push_back(wxBitmapBundle::FromSVG(svg_data, wxSize(16, 16)));
+    bundles.push_back(wxBitmapBundle::FromSVG(svg_data, wxSize(16, 16)));
+    bundles.push_back(wxBitmap(8, 8));
+
+    wxVector<wxSize> sizes;
+    sizes.push_back(wxSize(16, 16));
+    sizes.push_back(wxSize(32, 32));
+
+    // The two SVG bundles use the same data, so only 2 bitmaps are needed.
+    CHECK( wxBitmapBundle::PrerasterizeSVG(bundles, sizes, 2) == 2 );
+    CHECK( wxBitmapBundle::PrerasterizeSVG(bundles, sizes, 2) == 0 );
+
+    const wxBitmapBundle::SVGCacheStats stats = wxBitmapBundle::GetSVGCacheStats();
+    CHECK( stats.count == 2 );
+    CHECK( stats.misses == 0 );
+
+    // Check that the result is the same as when rasterizing on demand.
+    const wxBitmap bmp = bundles[1].GetBitmap(wxSize(32, 32));
+    REQUIRE( bmp.GetSize() == wxSize(32, 32) );
+    CHECK( wxBitmapBundle::GetSVGCacheStats().misses == 0 );
+
+    wxBitmapBundle::ClearSVGCache();
+    wxBitmapBundle other = wxBitmapBundle::FromSVG(svg_data, wxSize(16, 16));
+    CHECK_THAT( other.GetBitmap(wxSize(32, 32)).ConvertToImage(),
+                RGBASameAs(bmp.ConvertToImage()) );
+    CHECK( wxBitmapBundle::GetSVGCacheStats().misses == 1 );
+
+    // Check that duplicate bundles and sizes don't result in the same bitmap
+    // being cached by the bundle several times, which would evict the other
+    // bitmaps cached by it.
+    other.GetBitmap(wxSize(48, 48));
+    wxBitmapBundle::ClearSVGCache();
+
+    wxVector<wxBitmapBundle> dups;
+    dups.push_back(other);
+    dups.push_back(other);
+
+    sizes.push_back(wxSize(16, 16));
+    sizes.push_back(wxSize(64, 64));
+    CHECK( wxBitmapBundle::PrerasterizeSVG(dups, sizes, 2) == 2 );
+
+    const wxBitmap bmp48 = other.GetBitmap(wxSize(48, 48));
+    CHECK( bmp48.GetSize() == wxSize(48, 48) );
+    CHECK( wxBitmapBundle::GetSVGCacheStats().misses == 0 );
+
+    wxBitmapBundle::ClearSVGCache();
+}
+
 TEST_CASE("BitmapBundle::FromSVG-alpha", "[bmpbundle][svg][alpha]")
 {
     static const char svg_data[] =
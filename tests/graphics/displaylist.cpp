@@ -0,0 +1,242 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        tests/graphics/displaylist.cpp
+// Purpose:     wxRecordingDC and wxDisplayList unit tests
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets team
+///////////////////////////////////////////////////////////////////////////////
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+#include "testprec.h"
+
+#include "wx/bitmap.h"
+#include "wx/dcmemory.h"
+#include "wx/datstrm.h"
+#include "wx/dcrecord.h"
+#include "wx/image.h"
+#include "wx/mstream.h"
+
+#include <type_traits>
+
+static const wxSize s_size(200, 150);
+
+// Draw some shapes using different attributes.
+static void DrawShapes(wxDC& dc)
+{
+    dc.SetPen(wxPen(*wxRED, 3));
+    dc.SetBrush(*wxBLUE_BRUSH);
+    dc.DrawRectangle(10, 10, 50, 40);
+
+    dc.SetPen(*wxGREEN_PEN);
+    dc.DrawLine(0, 100, 199, 60);
+
+    const wxPoint points[] = { wxPoint(120, 20), wxPoint(180, 40), wxPoint(140, 90) };
+    dc.SetBrush(*wxYELLOW_BRUSH);
+    dc.DrawPolygon(WXSIZEOF(points), points);
+
+    dc.SetClippingRegion(100, 100, 50, 30);
+    dc.SetBrush(*wxBLACK_BRUSH);
+    dc.DrawEllipse(90, 90, 100, 60);
+    dc.DestroyClippingRegion();
+
+    dc.SetPen(*wxRED_PEN);
+    dc.DrawPoint(5, 140);
+}
+
+static wxImage DrawOnImage(void (*draw)(wxDC&))
+{
+    wxBitmap bmp(s_size);
+    {
+        wxMemoryDC dc(bmp);
+        dc.SetBackground(*wxWHITE_BRUSH);
+        dc.Clear();
+        draw(dc);
+    }
+
+    return bmp.ConvertToImage();
+}
+
+static wxImage ReplayOnImage(const wxDisplayList& list)
+{
+    wxBitmap bmp(s_size);
+    {
+        wxMemoryDC dc(bmp);
+        dc.SetBackground(*wxWHITE_BRUSH);
+        dc.Clear();
+        list.Replay(dc);
+    }
+
+    return bmp.ConvertToImage();
+}
+
+static bool AreImagesEqual(const wxImage& image1, const wxImage& image2)
+{
+    return image1.GetSize() == image2.GetSize() &&
+           memcmp(image1.GetData(), image2.GetData(),
+                  3*image1.GetWidth()*image1.GetHeight()) == 0;
+}
+
+TEST_CASE("DisplayList::Replay", "[dc][displaylist]")
+{
+    wxDisplayList list;
+    CHECK( list.IsEmpty() );
+
+    {
+        wxRecordingDC dc(list, s_size);
+        DrawShapes(dc);
+    }
+
+    CHECK( list.GetCount() == 5 );
+    CHECK( list.GetBoundingBox().Contains(wxRect(10, 10, 50, 40)) );
+
+    CHECK( AreImagesEqual(ReplayOnImage(list), DrawOnImage(DrawShapes)) );
+
+    list.Clear();
+    CHECK( list.IsEmpty() );
+}
+
+TEST_CASE("DisplayList::ReplayRect", "[dc][displaylist]")
+{
+    wxDisplayList list;
+    {
+        wxRecordingDC dc(list, wxSize(2000, 2000));
+        dc.SetPen(*wxTRANSPARENT_PEN);
+        dc.SetBrush(*wxBLACK_BRUSH);
+        dc.DrawRectangle(10, 10, 20, 20);
+        dc.DrawRectangle(1500, 1500, 20, 20);
+    }
+
+    wxBitmap bmp(s_size);
+    wxMemoryDC dc(bmp);
+    dc.SetBackground(*wxWHITE_BRUSH);
+    dc.Clear();
+
+    // Only the second rectangle intersects this area, so the first one must
+    // not be drawn.
+    dc.SetDeviceOrigin(-1450, -1450);
+    list.Replay(dc, wxRect(1450, 1450, 100, 100));
+    dc.SetDeviceOrigin(0, 0);
+
+    dc.SelectObject(wxNullBitmap);
+    const wxImage image = bmp.ConvertToImage();
+    CHECK( image.GetRed(20, 20) == 0xff );
+    CHECK( image.GetRed(60, 60) == 0 );
+}
+
+#if wxUSE_STREAMS
+
+TEST_CASE("DisplayList::SaveLoad", "[dc][displaylist]")
+{
+    wxDisplayList list;
+    {
+        wxRecordingDC dc(list, s_size);
+        DrawShapes(dc);
+    }
+
+    wxMemoryOutputStream mos;
+    REQUIRE( list.Save(mos) );
+
+    wxDisplayList loaded;
+    wxMemoryInputStream mis(mos);
+    REQUIRE( loaded.Load(mis) );
+    CHECK( loaded.GetCount() == list.GetCount() );
+
+    CHECK( AreImagesEqual(ReplayOnImage(loaded), DrawOnImage(DrawShapes)) );
+
+    // Loading invalid data must fail and leave the list unchanged.
+    const char garbage[] = "wxDL garbage";
+    wxMemoryInputStream misBad(garbage, sizeof(garbage));
+    CHECK( !loaded.Load(misBad) );
+    CHECK( loaded.GetCount() == list.GetCount() );
+
+    // Huge counts in a short file must just make loading fail too.
+    for ( int n = 0; n <= 6; n++ )
+    {
+        INFO( "Huge count #" << n );
+
+        wxMemoryOutputStream mosHuge;
+        mosHuge.Write("wxDL", 4);
+
+        wxDataOutputStream ds(mosHuge);
+        ds.Write32(2);
+        for ( int i = 0; i < n; i++ )
+            ds.Write64(wxUint64(0));
+        ds.Write64(wxUint64(0x0fffffff));
+
+        wxMemoryInputStream misHuge(mosHuge);
+        CHECK( !loaded.Load(misHuge) );
+    }
+
+    // As must unknown operations.
+    wxDisplayList listClear;
+    {
+        wxRecordingDC dc(listClear, s_size);
+        dc.Clear();
+    }
+
+    wxMemoryOutputStream mosClear;
+    REQUIRE( listClear.Save(mosClear) );
+
+    // The data of the only operation is at the very end.
+    std::vector<char> data(mosClear.GetLength());
+    mosClear.CopyTo(data.data(), data.size());
+    {
+        wxMemoryInputStream misClear(data.data(), data.size());
+        CHECK( loaded.Load(misClear) );
+    }
+
+    data.back() = '\x7f';
+    {
+        wxMemoryInputStream misClear(data.data(), data.size());
+        CHECK( !loaded.Load(misClear) );
+    }
+}
+
+// Draw lines using a pen with user-defined dashes.
+static void DrawDashes(wxDC& dc)
+{
+    static const wxDash dashes[] = { 2, 5, 100, 1 };
+
+    wxPen pen(*wxBLUE, 2, wxPENSTYLE_USER_DASH);
+    pen.SetDashes(WXSIZEOF(dashes), dashes);
+    dc.SetPen(pen);
+
+    for ( int y = 10; y < s_size.y; y += 20 )
+        dc.DrawLine(0, y, s_size.x, y + 5);
+}
+
+TEST_CASE("DisplayList::Dashes", "[dc][displaylist]")
+{
+    static_assert(!std::is_copy_constructible<wxDisplayList>::value,
+                  "wxDisplayList must not be copyable");
+
+    wxDisplayList list;
+    {
+        wxRecordingDC dc(list, s_size);
+        DrawDashes(dc);
+    }
+
+    wxMemoryOutputStream mos;
+    REQUIRE( list.Save(mos) );
+
+    wxDisplayList loaded;
+    {
+        wxMemoryInputStream mis(mos);
+        REQUIRE( loaded.Load(mis) );
+    }
+
+    const wxImage expected = DrawOnImage(DrawDashes);
+    CHECK( AreImagesEqual(ReplayOnImage(loaded), expected) );
+
+    // The pens created when loading must remain valid after moving the list.
+    wxDisplayList moved(std::move(loaded));
+    CHECK( AreImagesEqual(ReplayOnImage(moved), expected) );
+
+    list = std::move(moved);
+    CHECK( AreImagesEqual(ReplayOnImage(list), expected) );
+}
+
+#endif // wxUSE_STREAMS
@@ -0,0 +1,129 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        tests/graphics/glyphcache.cpp
+// Purpose:     wxGCDC glyph cache unit tests
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets team
+///////////////////////////////////////////////////////////////////////////////
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+#include "testprec.h"
+
+// wxCairoRenderer::CreateMeasuringContext(), used by the glyph cache, is not
+// implemented for wxX11.
+#if wxUSE_GRAPHICS_CONTEXT && !defined(__WXX11__)
+
+#include "wx/bitmap.h"
+#include "wx/dcgraph.h"
+#include "wx/dcmemory.h"
+#include "wx/image.h"
+
+// Return the number of non-white pixels in the given area of the image.
+static int CountInkPixels(const wxImage& image, const wxRect& rect)
+{
+    int count = 0;
+    for ( int y = rect.y; y < rect.GetBottom(); y++ )
+    {
+        for ( int x = rect.x; x < rect.GetRight(); x++ )
+        {
+            if ( image.GetRed(x, y) != 0xff ||
+                    image.GetGreen(x, y) != 0xff ||
+                        image.GetBlue(x, y) != 0xff )
+                count++;
+        }
+    }
+
+    return count;
+}
+
+TEST_CASE("wxGCDC::GlyphCache", "[dc][gcdc][text]")
+{
+    wxGCDC::ClearGlyphCache();
+    wxGCDC::ResetGlyphCacheStats();
+
+    wxBitmap bmp(200, 100);
+    wxImage image;
+    wxSize extent;
+    {
+        wxMemoryDC memdc(bmp);
+        memdc.SetBackground(*wxWHITE_BRUSH);
+        memdc.Clear();
+
+        wxGCDC dc(memdc);
+        dc.EnableGlyphCache();
+        dc.SetFont(*wxNORMAL_FONT);
+        dc.SetTextForeground(*wxBLACK);
+
+        extent = dc.GetTextExtent("Hello");
+
+        dc.DrawText("Hello", 10, 10);
+
+        // All ASCII characters are rasterized when the cache is created, but
+        // they're not counted as misses.
+        wxGCDCGlyphCacheStats stats = wxGCDC::GetGlyphCacheStats();
+        CHECK( stats.prerasterized == 0x7f - 0x20 );
+        CHECK( stats.misses == 0 );
+        CHECK( stats.hits == 5 );
+        CHECK( stats.fallbacks == 0 );
+
+        dc.DrawText("Hello", 10, 50);
+
+        stats = wxGCDC::GetGlyphCacheStats();
+        CHECK( stats.misses == 0 );
+        CHECK( stats.hits == 10 );
+
+        // Non-ASCII characters are rasterized when they're used.
+        dc.DrawText(wxString::FromUTF8("\xc3\xa9t\xc3\xa9"), 100, 50);
+
+        stats = wxGCDC::GetGlyphCacheStats();
+        CHECK( stats.misses == 1 );
+        CHECK( stats.hits == 11 );
+
+        // Text requiring shaping must be drawn without using the cache.
+        dc.DrawText(wxString::FromUTF8("\xd8\xb3\xd9\x84\xd8\xa7\xd9\x85"), 100, 10);
+
+        stats = wxGCDC::GetGlyphCacheStats();
+        CHECK( stats.fallbacks == 1 );
+        CHECK( stats.hits == 11 );
+
+        // Including the text with combining marks, e.g. KA followed by the
+        // combining voiced sound mark here.
+        dc.DrawText(wxString::FromUTF8("\xe3\x81\x8b\xe3\x82\x99"), 150, 10);
+
+        stats = wxGCDC::GetGlyphCacheStats();
+        CHECK( stats.fallbacks == 2 );
+        CHECK( stats.hits == 11 );
+
+        // As must the text with too many glyphs to fit in the cache, and the
+        // already cached characters in it must not count as hits then.
+        wxString tooMany("Hello");
+        for ( wxUint32 ch = 0x4e00; ch < 0x4e00 + 4096; ch++ )
+            tooMany += wxUniChar(ch);
+        dc.DrawText(tooMany, 10, 80);
+
+        stats = wxGCDC::GetGlyphCacheStats();
+        CHECK( stats.fallbacks == 3 );
+        CHECK( stats.hits == 11 );
+
+        // And so must the scaled text.
+        dc.SetUserScale(2, 2);
+        dc.DrawText("Hello", 50, 25);
+        CHECK( wxGCDC::GetGlyphCacheStats().fallbacks == 4 );
+    }
+
+    image = bmp.ConvertToImage();
+
+    // Check that something was drawn where the text is.
+    CHECK( CountInkPixels(image, wxRect(wxPoint(10, 10), extent)) > 0 );
+    CHECK( CountInkPixels(image, wxRect(wxPoint(10, 50), extent)) > 0 );
+
+    // But not outside of it.
+    CHECK( CountInkPixels(image, wxRect(0, 0, 200, 8)) == 0 );
+
+    wxGCDC::ClearGlyphCache();
+}
+
+#endif // wxUSE_GRAPHICS_CONTEXT && !__WXX11__
@@ -1167,6 +1167,94 @@ TEST_CASE("GraphicsBitmapTestCase::CreateFromImage", "[graphbitmap][create][from
 #endif // wxUSE_GRAPHICS_CAIRO
     }
 }
+
+#if wxUSE_CAIRO
+// Cairo uses the data of the images with packed storage directly, check that
+// this doesn't result in any unexpected sharing.
+TEST_CASE("GraphicsBitmapTestCase::PackedImage", "[graphbitmap][image][packed]")
+{
+    wxGraphicsRenderer* gr = wxGraphicsRenderer::GetCairoRenderer();
+    REQUIRE(gr != nullptr);
+
+    wxImage image;
+    REQUIRE( image.CreatePacked(8, 8) );
+
+    wxUint32* const data = image.GetPackedData();
+    REQUIRE( data != nullptr );
+
+    SECTION("Context")
+    {
+        {
+            std::unique_ptr<wxGraphicsContext> gc(gr->CreateContextFromImage(image));
+            REQUIRE( gc );
+
+            gc->SetPen(*wxTRANSPARENT_PEN);
+            gc->SetBrush(*wxRED_BRUSH);
+            gc->DrawRectangle(0, 0, 8, 8);
+        }
+
+        // The drawing must have been done directly on the image data.
+        CHECK( image.IsPacked() );
+        CHECK( image.GetPackedData() == data );
+        CHECK( data[0] == 0xffff0000 );
+    }
+
+    SECTION("Context with unpacked image")
+    {
+        {
+            std::unique_ptr<wxGraphicsContext> gc(gr->CreateContextFromImage(image));
+            REQUIRE( gc );
+
+            gc->SetPen(*wxTRANSPARENT_PEN);
+            gc->SetBrush(*wxRED_BRUSH);
+            gc->DrawRectangle(0, 0, 8, 8);
+
+            // Accessing the RGB data switches the image to the default
+            // storage, the context must notice it when it's flushed.
+            image.GetData();
+            REQUIRE( !image.IsPacked() );
+        }
+
+        CHECK( image.GetRed(0, 0) == 0xff );
+        CHECK( image.GetGreen(0, 0) == 0 );
+        CHECK( image.GetBlue(0, 0) == 0 );
+        CHECK( image.GetAlpha(0, 0) == wxALPHA_OPAQUE );
+    }
+
+    SECTION("Bitmap")
+    {
+        const wxGraphicsBitmap bmp = gr->CreateBitmapFromImage(image);
+        REQUIRE( !bmp.IsNull() );
+
+        // The data is shared with the bitmap, so it must be copied before
+        // being modified and the bitmap must not be affected by the change.
+        wxUint32* const dataNew = image.GetPackedData();
+        CHECK( dataNew != data );
+
+        dataNew[0] = 0xffff0000;
+
+        const wxImage imageBmp = bmp.ConvertToImage();
+        CHECK( imageBmp.GetRed(0, 0) == 0 );
+        CHECK( imageBmp.GetAlpha(0, 0) == wxALPHA_TRANSPARENT );
+    }
+
+#ifdef __WXGTK3__
+    SECTION("wxBitmap")
+    {
+        const wxBitmap bmp(image);
+        REQUIRE( bmp.IsOk() );
+
+        wxUint32* const dataNew = image.GetPackedData();
+        CHECK( dataNew != data );
+
+        dataNew[0] = 0xffff0000;
+
+        const wxImage imageBmp = bmp.ConvertToImage();
+        CHECK( imageBmp.GetRed(0, 0) == 0 );
+    }
+#endif // __WXGTK3__
+}
+#endif // wxUSE_CAIRO
 #endif // wxUSE_GRAPHICS_CONTEXT
 
 #endif // wxHAS_RAW_BITMAP
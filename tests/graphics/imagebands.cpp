@@ -0,0 +1,108 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        tests/graphics/imagebands.cpp
+// Purpose:     wxGraphicsRenderer::RenderImageInBands() unit tests
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets team
+///////////////////////////////////////////////////////////////////////////////
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+#include "testprec.h"
+
+#if wxUSE_GRAPHICS_CONTEXT
+
+#include "wx/brush.h"
+#include "wx/graphics.h"
+#include "wx/image.h"
+#include "wx/pen.h"
+
+#include "testimage.h"
+
+namespace
+{
+
+const int IMAGE_WIDTH = 200;
+const int IMAGE_HEIGHT = 500;
+
+// Draw many shapes crossing the band boundaries, using fractional coordinates
+// to check that anti-aliasing gives the same results in all bands.
+void DrawShapes(wxGraphicsContext& gc)
+{
+    // All objects must be created here as this function is called from
+    // multiple threads concurrently, so even the stock objects can't be used.
+    gc.SetBrush(gc.CreateBrush(wxBrush(wxColour(255, 255, 255))));
+    gc.DrawRectangle(0, 0, IMAGE_WIDTH, IMAGE_HEIGHT);
+
+    gc.SetFont(gc.CreateFont(12, wxString(), wxFONTFLAG_DEFAULT,
+                             wxColour(0, 0, 0)));
+
+    const int rowHeight = 23;
+    for ( int y = 0; y < IMAGE_HEIGHT; y += rowHeight )
+    {
+        const int n = y / rowHeight;
+
+        gc.SetPen(gc.CreatePen(wxGraphicsPenInfo(wxColour(0, 0, 128)).Width(1.5)));
+        gc.StrokeLine(0, y + 0.5, IMAGE_WIDTH, y + 0.5);
+        gc.StrokeLine(n*7.3, 0, IMAGE_WIDTH - n*7.3, IMAGE_HEIGHT);
+
+        gc.SetPen(wxGraphicsPen());
+        gc.SetBrush(gc.CreateBrush(wxBrush(wxColour(n*37 % 256, 128, 200))));
+        gc.DrawRoundedRectangle(IMAGE_WIDTH / 2, y + 3.3,
+                                (n*53) % (IMAGE_WIDTH / 2), rowHeight + 10, 3);
+        gc.DrawEllipse(5.3, y + 4.7, rowHeight, rowHeight + 7.5);
+
+        gc.DrawText(wxString::Format("Row %d", n), 30, y + 2);
+    }
+}
+
+void CheckBands(wxGraphicsRenderer* renderer, bool packed)
+{
+    wxImage imageSingle, imageBands;
+    if ( packed )
+    {
+        REQUIRE( imageSingle.CreatePacked(IMAGE_WIDTH, IMAGE_HEIGHT) );
+        REQUIRE( imageBands.CreatePacked(IMAGE_WIDTH, IMAGE_HEIGHT) );
+    }
+    else
+    {
+        REQUIRE( imageSingle.Create(IMAGE_WIDTH, IMAGE_HEIGHT) );
+        REQUIRE( imageBands.Create(IMAGE_WIDTH, IMAGE_HEIGHT) );
+    }
+
+    // Drawing with a single thread uses a single context for the whole image.
+    REQUIRE( renderer->RenderImageInBands(imageSingle, DrawShapes, 1) );
+
+    // And this one must split the image in several bands.
+    REQUIRE( renderer->RenderImageInBands(imageBands, DrawShapes, 4) );
+
+    CHECK( imageBands.IsPacked() == imageSingle.IsPacked() );
+    CHECK( imageBands.HasAlpha() == imageSingle.HasAlpha() );
+    CHECK_THAT( imageBands, RGBASameAs(imageSingle) );
+}
+
+} // anonymous namespace
+
+TEST_CASE("wxGraphicsRenderer::RenderImageInBands", "[graphcontext][image][bands]")
+{
+    const bool packed = GENERATE(false, true);
+    INFO( (packed ? "Packed image" : "Image") );
+
+    SECTION("Default GC")
+    {
+        CheckBands(wxGraphicsRenderer::GetDefaultRenderer(), packed);
+    }
+
+#if wxUSE_CAIRO
+    SECTION("Cairo GC")
+    {
+        wxGraphicsRenderer* gr = wxGraphicsRenderer::GetCairoRenderer();
+        REQUIRE( gr != nullptr );
+        CheckBands(gr, packed);
+    }
+#endif // wxUSE_CAIRO
+}
+
+#endif // wxUSE_GRAPHICS_CONTEXT
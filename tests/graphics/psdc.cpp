@@ -0,0 +1,193 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        tests/graphics/psdc.cpp
+// Purpose:     Tests for the helpers used by wxPostScriptDC
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets team
+///////////////////////////////////////////////////////////////////////////////
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+#include "testprec.h"
+
+#if wxUSE_PRINTING_ARCHITECTURE && wxUSE_POSTSCRIPT
+
+#include "wx/generic/private/dcpsg.h"
+
+#include <cmath>
+#include <limits>
+
+namespace
+{
+
+std::string FormatPSNumber(double f)
+{
+    std::string s;
+    wxPrivate::AppendPSNumber(s, f);
+    return s;
+}
+
+std::string EncodeASCII85(const std::string& data)
+{
+    std::string s;
+    wxPrivate::AppendASCII85(s,
+                             reinterpret_cast<const unsigned char*>(data.data()),
+                             data.size());
+    return s;
+}
+
+std::vector<unsigned char> EncodeRunLength(const std::string& data)
+{
+    std::vector<unsigned char> out;
+    wxPrivate::RunLengthEncode(reinterpret_cast<const unsigned char*>(data.data()),
+                               data.size(),
+                               out);
+    return out;
+}
+
+void CheckPSNumber(double f)
+{
+    INFO( "Value: " << wxString::FromCDouble(f) );
+    CHECK( FormatPSNumber(f) == wxString::FromCDouble(f, 6).utf8_string() );
+}
+
+} // anonymous namespace
+
+TEST_CASE("wxPostScriptDC::Number", "[dc][psdc]")
+{
+    SECTION("Simple")
+    {
+        CHECK( FormatPSNumber(0) == "0.000000" );
+        CHECK( FormatPSNumber(1) == "1.000000" );
+        CHECK( FormatPSNumber(-12.5) == "-12.500000" );
+        CHECK( FormatPSNumber(0.1) == "0.100000" );
+        CHECK( FormatPSNumber(123456.789) == "123456.789000" );
+    }
+
+    SECTION("Ties")
+    {
+        // These values are exactly representable, so they're rounded to even.
+        CHECK( FormatPSNumber(0.0078125) == "0.007812" );
+        CHECK( FormatPSNumber(0.0234375) == "0.023438" );
+        CHECK( FormatPSNumber(-0.0078125) == "-0.007812" );
+        CHECK( FormatPSNumber(123456.0078125) == "123456.007812" );
+
+        CheckPSNumber(0.0078125);
+        CheckPSNumber(0.0234375);
+        CheckPSNumber(-0.0390625);
+        CheckPSNumber(1024.0078125);
+
+        // And these ones are not, so they're rounded depending on their
+        // actual binary value.
+        CheckPSNumber(0.0000005);
+        CheckPSNumber(0.0000015);
+        CheckPSNumber(2.0000005);
+        CheckPSNumber(-1.2345675);
+        CheckPSNumber(999999.9999995);
+    }
+
+    SECTION("Negative")
+    {
+        CheckPSNumber(-1);
+        CheckPSNumber(-0.000001);
+        CheckPSNumber(-123.456789123);
+
+        // Small negative values are output with the sign, as printf() does.
+        CHECK( FormatPSNumber(-1e-9) == "-0.000000" );
+        CheckPSNumber(-1e-9);
+        CheckPSNumber(-0.0000004);
+    }
+
+    SECTION("Negative zero")
+    {
+        CHECK( FormatPSNumber(-0.0) == "-0.000000" );
+        CheckPSNumber(-0.0);
+    }
+
+    SECTION("Big")
+    {
+        CheckPSNumber(999999999.9999994);
+        CheckPSNumber(999999999.9999996);
+        CheckPSNumber(1e9);
+        CheckPSNumber(-1e9);
+        CheckPSNumber(1e9 + 0.5);
+        CheckPSNumber(123456789012.345);
+        CheckPSNumber(1e20);
+        CheckPSNumber(-1e300);
+        CheckPSNumber(std::numeric_limits<double>::max());
+        CheckPSNumber(std::numeric_limits<double>::infinity());
+    }
+
+    SECTION("Many")
+    {
+        // Check many values with different magnitudes and fractional parts.
+        for ( int e = -30; e < 34; e++ )
+        {
+            for ( int n = 1; n < 1000; n += 7 )
+            {
+                const double f = std::ldexp(n * 1.0001, e);
+                CheckPSNumber(f);
+                CheckPSNumber(-f);
+            }
+        }
+    }
+}
+
+TEST_CASE("wxPostScriptDC::ASCII85", "[dc][psdc]")
+{
+    CHECK( EncodeASCII85("") == "~>\n" );
+    CHECK( EncodeASCII85("Man is distinguished") == "9jqo^BlbD-BleB1DJ+*+F(f,q~>\n" );
+
+    // Partial groups are output using fewer characters.
+    CHECK( EncodeASCII85(".") == "/c~>\n" );
+    CHECK( EncodeASCII85("Man") == "9jqo~>\n" );
+
+    // Complete groups of zeroes are abbreviated, but not partial ones.
+    CHECK( EncodeASCII85(std::string(4, '\0')) == "z~>\n" );
+    CHECK( EncodeASCII85(std::string(3, '\0')) == "!!!!~>\n" );
+    CHECK( EncodeASCII85(std::string(6, '\0')) == "z!!!~>\n" );
+
+    // The lines must be wrapped.
+    CHECK( EncodeASCII85(std::string(80, '\xff')) ==
+           "s8W-!s8W-!s8W-!s8W-!s8W-!s8W-!s8W-!s8W-!s8W-!s8W-!s8W-!s8W-!s8W-!s8W-!s8W-!s\n"
+           "8W-!s8W-!s8W-!s8W-!s8W-!~>\n" );
+
+    // And never start with "%".
+    CHECK( EncodeASCII85(std::string("\x0c\x72\x12\xc4", 4)) == " %!!!!~>\n" );
+}
+
+TEST_CASE("wxPostScriptDC::RunLength", "[dc][psdc]")
+{
+    using Bytes = std::vector<unsigned char>;
+
+    CHECK( EncodeRunLength("") == Bytes{128} );
+    CHECK( EncodeRunLength("ABC") == (Bytes{2, 'A', 'B', 'C', 128}) );
+    CHECK( EncodeRunLength("AAAB") == (Bytes{254, 'A', 0, 'B', 128}) );
+
+    // Pairs of identical bytes are not worth encoding as runs.
+    CHECK( EncodeRunLength("ABBC") == (Bytes{3, 'A', 'B', 'B', 'C', 128}) );
+
+    // Runs are limited to 128 bytes.
+    CHECK( EncodeRunLength(std::string(130, 'x')) ==
+           (Bytes{129, 'x', 255, 'x', 128}) );
+
+    // And so are the literal sequences.
+    std::string data;
+    Bytes expected{127};
+    for ( int n = 0; n < 200; n++ )
+    {
+        data += static_cast<char>(n);
+
+        if ( n == 128 )
+            expected.push_back(71);
+
+        expected.push_back(static_cast<unsigned char>(n));
+    }
+    expected.push_back(128);
+
+    CHECK( EncodeRunLength(data) == expected );
+}
+
+#endif // wxUSE_PRINTING_ARCHITECTURE && wxUSE_POSTSCRIPT
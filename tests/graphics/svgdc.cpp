@@ -0,0 +1,141 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        tests/graphics/svgdc.cpp
+// Purpose:     wxSVGFileDC output unit tests
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets team
+///////////////////////////////////////////////////////////////////////////////
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+#include "testprec.h"
+
+#if wxUSE_SVG
+
+#include "wx/dcsvg.h"
+#include "wx/ffile.h"
+#include "wx/pen.h"
+#include "wx/sstream.h"
+#include "wx/wfstream.h"
+#include "wx/zstream.h"
+
+#include "testfile.h"
+
+// Return the number of occurrences of the given substring in the string.
+static int CountOccurrences(const wxString& s, const wxString& sub)
+{
+    int count = 0;
+    for ( size_t pos = s.find(sub); pos != wxString::npos; pos = s.find(sub, pos + 1) )
+        count++;
+
+    return count;
+}
+
+// Draw the lines using a few pens, some of them used more than once.
+static void DrawLines(wxSVGFileDC& dc)
+{
+    dc.SetPen(*wxRED_PEN);
+    dc.DrawLine(0, 0, 10, 10);
+
+    dc.SetPen(*wxBLUE_PEN);
+    dc.DrawLine(10, 10, 20, 20);
+
+    dc.SetPen(*wxRED_PEN);
+    dc.DrawLine(20, 20, 30, 30);
+}
+
+static wxString ReadAll(wxInputStream& stream)
+{
+    wxStringOutputStream out(nullptr, wxConvUTF8);
+    stream.Read(out);
+
+    return out.GetString();
+}
+
+TEST_CASE("wxSVGFileDC::StyleClasses", "[dc][svgdc]")
+{
+    TempFile tf("test_classes.svg");
+
+    {
+        wxSVGFileDC dc(tf.GetName(), 100, 100);
+        dc.EnableStyleClasses();
+        DrawLines(dc);
+        REQUIRE( dc.IsOk() );
+    }
+
+    wxFileInputStream fis(tf.GetName());
+    REQUIRE( fis.IsOk() );
+
+    const wxString svg = ReadAll(fis);
+
+    // Each distinct style must be defined only once.
+    CHECK( CountOccurrences(svg, "<style>") == 2 );
+    CHECK( CountOccurrences(svg, "<style>.wxs0 {") == 1 );
+    CHECK( CountOccurrences(svg, "<style>.wxs1 {") == 1 );
+
+    // And referenced by all the groups using it.
+    CHECK( CountOccurrences(svg, "<g class=\"wxs0\"") == 2 );
+    CHECK( CountOccurrences(svg, "<g class=\"wxs1\"") == 1 );
+
+    // The only group using inline style is the top level one.
+    CHECK( CountOccurrences(svg, "<g style=") == 1 );
+}
+
+TEST_CASE("wxSVGFileDC::NoStyleClasses", "[dc][svgdc]")
+{
+    TempFile tf("test_noclasses.svg");
+
+    {
+        wxSVGFileDC dc(tf.GetName(), 100, 100);
+        DrawLines(dc);
+        REQUIRE( dc.IsOk() );
+    }
+
+    wxFileInputStream fis(tf.GetName());
+    REQUIRE( fis.IsOk() );
+
+    const wxString svg = ReadAll(fis);
+
+    CHECK( CountOccurrences(svg, "<style>") == 0 );
+    CHECK( CountOccurrences(svg, "class=") == 0 );
+    CHECK( CountOccurrences(svg, "<g style=") == 4 );
+}
+
+#if wxUSE_ZLIB
+TEST_CASE("wxSVGFileDC::Compressed", "[dc][svgdc]")
+{
+    TempFile tf("test_compressed.svgz");
+
+    {
+        wxSVGFileDC dc(tf.GetName(), 100, 100);
+        DrawLines(dc);
+        REQUIRE( dc.IsOk() );
+    }
+
+    // Check for the gzip magic bytes.
+    {
+        wxFFile file(tf.GetName(), "rb");
+        REQUIRE( file.IsOpened() );
+
+        unsigned char header[2] = { 0, 0 };
+        REQUIRE( file.Read(header, sizeof(header)) == sizeof(header) );
+        CHECK( header[0] == 0x1f );
+        CHECK( header[1] == 0x8b );
+    }
+
+    // And that the compressed contents is the complete SVG document.
+    wxFileInputStream fis(tf.GetName());
+    REQUIRE( fis.IsOk() );
+
+    wxZlibInputStream zis(fis, wxZLIB_GZIP);
+    const wxString svg = ReadAll(zis);
+
+    CHECK( svg.StartsWith("<?xml ") );
+    CHECK( svg.EndsWith("</svg>\n") );
+    CHECK( CountOccurrences(svg, "<path ") == 3 );
+}
+#endif // wxUSE_ZLIB
+
+#endif // wxUSE_SVG
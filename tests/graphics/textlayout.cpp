@@ -0,0 +1,75 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        tests/graphics/textlayout.cpp
+// Purpose:     Tests for reusing text layouts in wxGraphicsContext
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets team
+///////////////////////////////////////////////////////////////////////////////
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+#include "testprec.h"
+
+#if wxUSE_GRAPHICS_CONTEXT && wxUSE_CAIRO
+
+#include "wx/font.h"
+#include "wx/graphics.h"
+#include "wx/image.h"
+
+#include <memory>
+
+// Draw the given text using the plain and underlined versions of the font in
+// the left and right halves of the image, in the specified order, using the
+// same context.
+static wxImage
+DrawPlainAndUnderlined(const wxString& text, bool underlinedFirst)
+{
+    wxImage image(200, 40);
+    image.SetRGB(wxRect(0, 0, 200, 40), 0xff, 0xff, 0xff);
+
+    {
+        std::unique_ptr<wxGraphicsContext>
+            gc(wxGraphicsRenderer::GetCairoRenderer()->CreateContextFromImage(image));
+        REQUIRE( gc );
+
+        const wxFont font = wxFontInfo(12);
+        const wxFont fontUnderlined = wxFontInfo(12).Underlined();
+
+        if ( underlinedFirst )
+        {
+            gc->SetFont(fontUnderlined, *wxBLACK);
+            gc->DrawText(text, 100, 5);
+        }
+
+        gc->SetFont(font, *wxBLACK);
+        gc->DrawText(text, 0, 5);
+
+        if ( !underlinedFirst )
+        {
+            gc->SetFont(fontUnderlined, *wxBLACK);
+            gc->DrawText(text, 100, 5);
+        }
+    }
+
+    return image;
+}
+
+TEST_CASE("wxGraphicsContext::TextLayoutAttributes", "[graphcontext][text]")
+{
+    // The layout used for the plain text must not be reused for the text
+    // drawn with the underlined font and vice versa.
+    const wxImage image1 = DrawPlainAndUnderlined("Hello", false);
+    const wxImage image2 = DrawPlainAndUnderlined("Hello", true);
+
+    // Check that the underline is actually drawn, otherwise this test is
+    // meaningless.
+    const wxImage plain = image1.GetSubImage(wxRect(0, 0, 100, 40));
+    const wxImage underlined = image1.GetSubImage(wxRect(100, 0, 100, 40));
+    REQUIRE( memcmp(plain.GetData(), underlined.GetData(), 100*40*3) != 0 );
+
+    CHECK( memcmp(image1.GetData(), image2.GetData(), 200*40*3) == 0 );
+}
+
+#endif // wxUSE_GRAPHICS_CONTEXT && wxUSE_CAIRO
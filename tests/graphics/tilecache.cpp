@@ -0,0 +1,210 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        tests/graphics/tilecache.cpp
+// Purpose:     wxTileCache unit tests
+// Author:      wxWidgets team
+// Created:     2026-10-19
+// Copyright:   (c) 2026 wxWidgets team
+///////////////////////////////////////////////////////////////////////////////
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+#include "testprec.h"
+
+#ifndef WX_PRECOMP
+    #include "wx/bitmap.h"
+    #include "wx/brush.h"
+    #include "wx/dcmemory.h"
+    #include "wx/image.h"
+    #include "wx/pen.h"
+#endif // WX_PRECOMP
+
+#include "wx/tilecache.h"
+
+#include "asserthelper.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+
+// Cache using small tiles and remembering all the rectangles drawn by it.
+class TestTileCache : public wxTileCache
+{
+public:
+    TestTileCache() : wxTileCache(wxSize(16, 16), 4), m_colour(*wxRED) { }
+
+    void SetColour(const wxColour& colour) { m_colour = colour; }
+
+    // Return the rectangles drawn since the last call to this function.
+    std::vector<wxRect> TakeDrawn()
+    {
+        std::vector<wxRect> drawn;
+        drawn.swap(m_drawn);
+        return drawn;
+    }
+
+protected:
+    void DrawTile(wxDC& dc, const wxRect& rect) override
+    {
+        m_drawn.push_back(rect);
+
+        dc.SetPen(*wxTRANSPARENT_PEN);
+        dc.SetBrush(wxBrush(m_colour));
+        dc.DrawRectangle(rect);
+    }
+
+private:
+    wxColour m_colour;
+    std::vector<wxRect> m_drawn;
+};
+
+// Paint the given rectangle of the cache on a 64*64 bitmap and return it.
+wxImage Paint(TestTileCache& cache, const wxRect& rect)
+{
+    wxBitmap bmp(64, 64);
+    {
+        wxMemoryDC dc(bmp);
+        dc.SetBackground(*wxWHITE_BRUSH);
+        dc.Clear();
+
+        cache.Paint(dc, rect);
+    }
+
+    return bmp.ConvertToImage();
+}
+
+wxColour GetPixel(const wxImage& image, int x, int y)
+{
+    return wxColour(image.GetRed(x, y), image.GetGreen(x, y), image.GetBlue(x, y));
+}
+
+} // anonymous namespace
+
+TEST_CASE("wxTileCache", "[tilecache][dc]")
+{
+    TestTileCache cache;
+
+    const wxRect rectAll(0, 0, 32, 32);
+
+    // Initially all the tiles intersecting the rectangle are drawn.
+    wxImage image = Paint(cache, rectAll);
+    std::vector<wxRect> drawn = cache.TakeDrawn();
+    REQUIRE( drawn.size() == 4 );
+    for ( const wxRect& r : drawn )
+        CHECK( r.GetSize() == wxSize(16, 16) );
+
+    CHECK( GetPixel(image, 0, 0) == *wxRED );
+    CHECK( GetPixel(image, 31, 31) == *wxRED );
+    CHECK( GetPixel(image, 32, 32) == *wxWHITE );
+
+    SECTION("Reuse")
+    {
+        // Painting the same area again must just reuse the existing tiles.
+        image = Paint(cache, rectAll);
+        CHECK( cache.TakeDrawn().empty() );
+        CHECK( GetPixel(image, 0, 0) == *wxRED );
+        CHECK( GetPixel(image, 31, 31) == *wxRED );
+
+        // And so must painting only a part of it.
+        image = Paint(cache, wxRect(8, 8, 16, 16));
+        CHECK( cache.TakeDrawn().empty() );
+        CHECK( GetPixel(image, 8, 8) == *wxRED );
+        CHECK( GetPixel(image, 0, 0) == *wxWHITE );
+    }
+
+    SECTION("Invalidate")
+    {
+        cache.SetColour(*wxBLUE);
+
+        // Only the invalidated part of the tile must be redrawn.
+        cache.Invalidate(wxRect(4, 4, 2, 2));
+        image = Paint(cache, rectAll);
+        drawn = cache.TakeDrawn();
+        REQUIRE( drawn.size() == 1 );
+        CHECK( drawn[0] == wxRect(4, 4, 2, 2) );
+
+        CHECK( GetPixel(image, 4, 4) == *wxBLUE );
+        CHECK( GetPixel(image, 5, 5) == *wxBLUE );
+        CHECK( GetPixel(image, 3, 3) == *wxRED );
+        CHECK( GetPixel(image, 6, 6) == *wxRED );
+
+        // A rectangle spanning several tiles must be split between them.
+        cache.Invalidate(wxRect(14, 0, 4, 1));
+        Paint(cache, rectAll);
+        drawn = cache.TakeDrawn();
+        REQUIRE( drawn.size() == 2 );
+        CHECK( (drawn[0].Union(drawn[1])) == wxRect(14, 0, 4, 1) );
+
+        // Invalidating the areas without any tiles doesn't do anything.
+        cache.Invalidate(wxRect(100, 100, 10, 10));
+        Paint(cache, rectAll);
+        CHECK( cache.TakeDrawn().empty() );
+    }
+
+    SECTION("InvalidateAll")
+    {
+        cache.SetColour(*wxBLUE);
+        cache.InvalidateAll();
+
+        image = Paint(cache, rectAll);
+        CHECK( cache.TakeDrawn().size() == 4 );
+        CHECK( GetPixel(image, 0, 0) == *wxBLUE );
+        CHECK( GetPixel(image, 31, 31) == *wxBLUE );
+    }
+
+    SECTION("Evict")
+    {
+        // Painting another area must discard the least recently used tiles,
+        // as the cache can only have 4 of them.
+        Paint(cache, wxRect(32, 0, 32, 32));
+        CHECK( cache.TakeDrawn().size() == 4 );
+
+        Paint(cache, wxRect(32, 0, 32, 32));
+        CHECK( cache.TakeDrawn().empty() );
+
+        Paint(cache, rectAll);
+        CHECK( cache.TakeDrawn().size() == 4 );
+
+        // But the tiles needed for the current area are never discarded.
+        Paint(cache, wxRect(0, 0, 48, 48));
+        CHECK( cache.TakeDrawn().size() == 5 );
+
+        // They are discarded by the next paint.
+        Paint(cache, rectAll);
+        CHECK( cache.TakeDrawn().empty() );
+
+        Paint(cache, wxRect(0, 0, 48, 48));
+        CHECK( cache.TakeDrawn().size() == 5 );
+
+        // Increasing the maximal number of tiles allows keeping all of them.
+        cache.SetMaxTiles(9);
+        Paint(cache, rectAll);
+        Paint(cache, wxRect(0, 0, 48, 48));
+        CHECK( cache.TakeDrawn().empty() );
+    }
+
+    SECTION("Clear")
+    {
+        cache.Clear();
+        Paint(cache, rectAll);
+        CHECK( cache.TakeDrawn().size() == 4 );
+
+        // Changing the tile size must discard all tiles too.
+        cache.SetTileSize(wxSize(32, 32));
+        Paint(cache, rectAll);
+        drawn = cache.TakeDrawn();
+        REQUIRE( drawn.size() == 1 );
+        CHECK( drawn[0] == rectAll );
+    }
+
+    SECTION("Negative")
+    {
+        image = Paint(cache, wxRect(-20, -20, 8, 8));
+        drawn = cache.TakeDrawn();
+        CHECK( drawn.size() == 4 );
+        CHECK( std::find(drawn.begin(), drawn.end(), wxRect(-32, -32, 16, 16)) != drawn.end() );
+    }
+}
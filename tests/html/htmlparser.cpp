@@ -16,6 +16,7 @@
 
 
 #ifndef WX_PRECOMP
+    #include "wx/bitmap.h"
     #include "wx/dcmemory.h"
 #endif // WX_PRECOMP
 
@@ -102,4 +103,119 @@ TEST_CASE("wxHtmlCell::Detach", "[html][cell]")
     }
 }
 
+namespace
+{
+
+// Document using different kinds of cells and alignments, which is long enough
+// to wrap at all the widths used by the test below.
+const char* const RELAYOUT_HTML =
+    "<p>Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do "
+    "eiusmod tempor incididunt ut labore et dolore magna aliqua.</p>"
+    "<p align=center>Ut enim ad minim veniam, quis nostrud exercitation "
+    "ullamco laboris nisi ut aliquip ex ea commodo consequat.</p>"
+    "<div align=right>Duis aute irure dolor in reprehenderit in voluptate "
+    "velit esse cillum dolore eu fugiat nulla pariatur.</div>"
+    "<blockquote>Excepteur sint occaecat <b>cupidatat non proident</b>, "
+    "sunt in culpa qui officia deserunt mollit anim id est laborum.</blockquote>"
+    "<ul><li>First item</li><li>Second item, which is <i>much</i> longer "
+    "than the first one and has to wrap.</li></ul>"
+    "<table border=1 width=80%>"
+    "<tr><td>Table cell with some text in it</td><td width=30%>Narrow</td></tr>"
+    "<tr><td colspan=2 align=center>Wide cell spanning both columns of "
+    "the table</td></tr>"
+    "</table>"
+    "<p>Final paragraph with a line break<br>and more text after it.</p>"
+    "<hr>";
+
+enum RelayoutRoot
+{
+    Root_Default,       // As created by the parser.
+    Root_Window,        // Centered with fixed borders, as in wxHtmlWindow.
+    Root_PercentIndent  // Using indents specified in percents.
+};
+
+wxHtmlContainerCell* ParseForRelayout(wxHtmlWinParser& parser, int root)
+{
+    wxHtmlContainerCell* const
+        top = static_cast<wxHtmlContainerCell*>(parser.Parse(RELAYOUT_HTML));
+
+    switch ( root )
+    {
+        case Root_Default:
+            break;
+
+        case Root_Window:
+            top->SetIndent(10, wxHTML_INDENT_ALL, wxHTML_UNITS_PIXELS);
+            top->SetAlignHor(wxHTML_ALIGN_CENTER);
+            break;
+
+        case Root_PercentIndent:
+            top->SetIndent(10, wxHTML_INDENT_LEFT | wxHTML_INDENT_RIGHT,
+                           wxHTML_UNITS_PERCENT);
+            break;
+    }
+
+    return top;
+}
+
+// Check that the given cell, its siblings and all their children have the
+// same positions and sizes as the expected ones.
+void CheckSameLayout(const wxHtmlCell* cell, const wxHtmlCell* expected)
+{
+    for ( ; expected; expected = expected->GetNext(), cell = cell->GetNext() )
+    {
+        REQUIRE( cell );
+
+        INFO( "Expected " << expected->Dump() );
+        INFO( "Actual " << cell->Dump() );
+        CHECK( cell->GetPosX() == expected->GetPosX() );
+        CHECK( cell->GetPosY() == expected->GetPosY() );
+        CHECK( cell->GetWidth() == expected->GetWidth() );
+        CHECK( cell->GetHeight() == expected->GetHeight() );
+        CHECK( cell->GetDescent() == expected->GetDescent() );
+        CHECK( cell->GetMaxTotalWidth() == expected->GetMaxTotalWidth() );
+
+        CheckSameLayout(cell->GetFirstChild(), expected->GetFirstChild());
+    }
+
+    CHECK( !cell );
+}
+
+} // anonymous namespace
+
+// Test that laying out the cells again after changing the width gives the
+// same results as laying out the new cells with this width.
+TEST_CASE("wxHtmlContainerCell::Relayout", "[html][cell]")
+{
+    wxBitmap bmp(1, 1);
+    wxMemoryDC dc(bmp);
+
+    wxHtmlWinParser parser;
+    parser.SetDC(&dc);
+
+    const int root = GENERATE(Root_Default, Root_Window, Root_PercentIndent);
+    INFO( "Root type " << root );
+
+    // Check both the widths changing the lines breaks and very close ones,
+    // which are likely to break the lines at the same places.
+    const int widthA = 400;
+    const int widthB = GENERATE(200, 399, 401, 700);
+
+    std::unique_ptr<wxHtmlContainerCell> const
+        cell(ParseForRelayout(parser, root));
+
+    for ( int width : { widthA, widthB, widthA } )
+    {
+        INFO( "Width " << width );
+
+        cell->Layout(width);
+
+        std::unique_ptr<wxHtmlContainerCell> const
+            expected(ParseForRelayout(parser, root));
+        expected->Layout(width);
+
+        CheckSameLayout(cell.get(), expected.get());
+    }
+}
+
 #endif //wxUSE_HTML
@@ -44,6 +44,8 @@ private:
         WXUISIM_TEST( LinkClick );
 #endif // wxUSE_UIACTIONSIMULATOR
         CPPUNIT_TEST( AppendToPage );
+        CPPUNIT_TEST( AppendToPageMany );
+        CPPUNIT_TEST( AppendToPageParagraphs );
     CPPUNIT_TEST_SUITE_END();
 
     void SelectionToText();
@@ -51,6 +53,12 @@ private:
     void CellClick();
     void LinkClick();
     void AppendToPage();
+    void AppendToPageMany();
+    void AppendToPageParagraphs();
+
+    // Check that the page shown in m_win after appending to it is the same as
+    // the page created by calling SetPage() with its entire source.
+    void CheckSameAsSetPage();
 
     wxHtmlWindow *m_win;
 
@@ -166,4 +174,85 @@ void HtmlWindowTestCase::AppendToPage()
 #endif // wxUSE_CLIPBOARD
 }
 
+void HtmlWindowTestCase::AppendToPageMany()
+{
+    wxString page = "<html><body>Log:<br>";
+    m_win->SetPage(page);
+
+    for ( int n = 0; n < 100; n++ )
+    {
+        const wxString line = wxString::Format("line %d <b>bold</b><br>", n);
+        m_win->AppendToPage(line);
+        page += line;
+    }
+
+    // This paragraph must reuse the empty container created by the last <br>
+    // and keep its top margin.
+    m_win->AppendToPage("<p>Last paragraph");
+    page += "<p>Last paragraph";
+
+    CPPUNIT_ASSERT_EQUAL( page, *m_win->GetParser()->GetSource() );
+
+    CheckSameAsSetPage();
+}
+
+void HtmlWindowTestCase::AppendToPageParagraphs()
+{
+    m_win->SetPage("<p>First paragraph</p>");
+    m_win->AppendToPage("<p>Second paragraph</p>");
+    m_win->AppendToPage("continued by this text");
+    m_win->AppendToPage("<br><br>Text after an empty line");
+    m_win->AppendToPage("<p align=center>Centered paragraph</p>");
+    m_win->AppendToPage("<h3>Header</h3><ul><li>One<li>Two</ul>");
+    m_win->AppendToPage("<p>Final paragraph");
+
+    CheckSameAsSetPage();
+}
+
+// Return the text, position and size of all the cells shown in the window.
+static wxString DumpVisibleCells(wxHtmlWindow* win)
+{
+    const wxHtmlContainerCell* const root = win->GetInternalRepresentation();
+
+    wxString s;
+    for ( wxHtmlTerminalCellsInterator it(root->GetFirstTerminal(),
+                                          root->GetLastTerminal());
+          it;
+          ++it )
+    {
+        if ( it->IsFormattingCell() )
+            continue;
+
+        const wxPoint pos = it->GetAbsPos();
+        s << wxString::Format("\"%s\" at (%d, %d) %dx%d\n",
+                              it->ConvertToText(nullptr),
+                              pos.x, pos.y, it->GetWidth(), it->GetHeight());
+    }
+
+    return s;
+}
+
+void HtmlWindowTestCase::CheckSameAsSetPage()
+{
+    wxHtmlWindow* const win = new wxHtmlWindow(wxTheApp->GetTopWindow(),
+                                               wxID_ANY,
+                                               wxDefaultPosition,
+                                               wxSize(400, 200));
+    win->SetPage(*m_win->GetParser()->GetSource());
+
+    const wxString cells = DumpVisibleCells(win);
+    const wxSize size = win->GetVirtualSize();
+#if wxUSE_CLIPBOARD
+    const wxString text = win->ToText();
+#endif // wxUSE_CLIPBOARD
+
+    DeleteTestWindow(win);
+
+    CPPUNIT_ASSERT_EQUAL( cells, DumpVisibleCells(m_win) );
+    CPPUNIT_ASSERT_EQUAL( size, m_win->GetVirtualSize() );
+#if wxUSE_CLIPBOARD
+    CPPUNIT_ASSERT_EQUAL( text, m_win->ToText() );
+#endif // wxUSE_CLIPBOARD
+}
+
 #endif //wxUSE_HTML
@@ -20,10 +20,12 @@
 #endif // WX_PRECOMP
 
 #include "wx/anidecod.h" // wxImageArray
+#include "wx/gifdecod.h"
 #include "wx/bitmap.h"
 #include "wx/cursor.h"
 #include "wx/icon.h"
 #include "wx/palette.h"
+#include "wx/quantize.h"
 #include "wx/url.h"
 #include "wx/log.h"
 #include "wx/mstream.h"
@@ -135,6 +137,180 @@ TEST_CASE_METHOD(ImageHandlersInit, "wxImage::LoadFromFile", "[image]")
     CHECK(img.LoadFile("image/bitfields.bmp", wxBITMAP_TYPE_BMP));
 }
 
+TEST_CASE_METHOD(ImageHandlersInit, "wxImage::DetectFormat", "[image]")
+{
+    for ( const auto& testfile : g_testfiles )
+    {
+        INFO("Loading " << testfile.file);
+
+        wxFileInputStream fis(testfile.file);
+        REQUIRE( fis.IsOk() );
+
+        CHECK( wxImage::CanRead(fis) );
+        CHECK( fis.TellI() == 0 );
+
+        wxImage image;
+        REQUIRE( image.LoadFile(fis) );
+        CHECK( image.GetType() == testfile.type );
+    }
+
+    // Data not matching any signature is still checked by all handlers.
+    static const unsigned char garbage[] = "This is not an image";
+    wxMemoryInputStream mis(garbage, sizeof(garbage));
+    CHECK( !wxImage::CanRead(mis) );
+}
+
+TEST_CASE_METHOD(ImageHandlersInit, "wxImage::FindHandler", "[image]")
+{
+    for ( const auto& testfile : g_testfiles )
+    {
+        INFO("Looking for " << testfile.file);
+
+        const wxImageHandler* const handler = wxImage::FindHandler(testfile.type);
+        REQUIRE( handler );
+        CHECK( handler->GetType() == testfile.type );
+
+        CHECK( wxImage::FindHandler(handler->GetName()) == handler );
+        CHECK( wxImage::FindHandlerMime(handler->GetMimeType()) == handler );
+        CHECK( wxImage::FindHandler(handler->GetExtension(), testfile.type)
+                == handler );
+    }
+
+    // Alternative extensions are case-insensitive, but the main one is not.
+    CHECK( wxImage::FindHandler("JPEG", wxBITMAP_TYPE_ANY)
+            == wxImage::FindHandler(wxBITMAP_TYPE_JPEG) );
+    CHECK( !wxImage::FindHandler("PNG", wxBITMAP_TYPE_ANY) );
+    CHECK( !wxImage::FindHandler("png", wxBITMAP_TYPE_JPEG) );
+
+    CHECK( wxImage::FindHandlerMime("IMAGE/PNG")
+            == wxImage::FindHandler(wxBITMAP_TYPE_PNG) );
+    CHECK( !wxImage::FindHandlerMime("image/unknown") );
+
+    // Check that the handlers are still found after modifying the list.
+    REQUIRE( wxImage::RemoveHandler("PNG file") );
+    CHECK( !wxImage::FindHandler(wxBITMAP_TYPE_PNG) );
+    CHECK( !wxImage::FindHandler("png", wxBITMAP_TYPE_ANY) );
+    CHECK( !wxImage::FindHandlerMime("image/png") );
+
+    wxImage::AddHandler(new wxPNGHandler);
+    const wxImageHandler* const handlerPNG = wxImage::FindHandler("png", wxBITMAP_TYPE_ANY);
+    REQUIRE( handlerPNG );
+    CHECK( handlerPNG->GetType() == wxBITMAP_TYPE_PNG );
+    CHECK( wxImage::FindHandler(wxBITMAP_TYPE_PNG) == handlerPNG );
+    CHECK( wxImage::FindHandlerMime("image/png") == handlerPNG );
+
+    // Modifying the list directly must be detected too, even if the number of
+    // handlers doesn't change, as the removed handler is deleted.
+    wxList& handlers = wxImage::GetHandlers();
+    REQUIRE( handlers.DeleteObject(const_cast<wxImageHandler*>(handlerPNG)) );
+    delete handlerPNG;
+
+    wxImageHandler* const handlerNew = new wxPNGHandler;
+    handlers.Append(handlerNew);
+    CHECK( wxImage::FindHandler(wxBITMAP_TYPE_PNG) == handlerNew );
+    CHECK( wxImage::FindHandler("png", wxBITMAP_TYPE_ANY) == handlerNew );
+    CHECK( wxImage::FindHandlerMime("image/png") == handlerNew );
+}
+
+TEST_CASE_METHOD(ImageHandlersInit, "wxImage::LoadJPEGScaled", "[image][jpeg]")
+{
+    // The original image is 200*200, so it's scaled by 2/8 during decoding.
+    wxImage img;
+    img.SetOption(wxIMAGE_OPTION_MAX_WIDTH, 60);
+    REQUIRE( img.LoadFile("horse.jpg") );
+    CHECK( img.GetSize() == wxSize(50, 50) );
+    CHECK( img.GetOptionInt(wxIMAGE_OPTION_ORIGINAL_WIDTH) == 200 );
+    CHECK( img.GetOptionInt(wxIMAGE_OPTION_ORIGINAL_HEIGHT) == 200 );
+
+    // This one uses 3/8 scale, or 1/2 with the old libjpeg versions, in which
+    // case the image is scaled down after loading, but the result must be
+    // the same in any case.
+    img = wxImage();
+    img.SetOption(wxIMAGE_OPTION_MAX_HEIGHT, 75);
+    REQUIRE( img.LoadFile("horse.jpg") );
+    CHECK( img.GetSize() == wxSize(75, 75) );
+}
+
+// Receiver checking that the rows are passed in order and optionally
+// cancelling loading after the given number of calls.
+class TestRowsReceiver : public wxImageRowsReceiver
+{
+public:
+    explicit TestRowsReceiver(int maxCalls = -1)
+        : m_maxCalls(maxCalls)
+    {
+    }
+
+    virtual bool OnRows(const wxImage& image, int firstRow, int numRows) override
+    {
+        CHECK( image.IsOk() );
+        CHECK( firstRow == m_rows );
+        CHECK( numRows > 0 );
+        CHECK( firstRow + numRows <= image.GetHeight() );
+
+        m_rows += numRows;
+        m_calls++;
+
+        return m_calls != m_maxCalls;
+    }
+
+    int GetRows() const { return m_rows; }
+    int GetCalls() const { return m_calls; }
+
+private:
+    const int m_maxCalls;
+    int m_rows = 0;
+    int m_calls = 0;
+};
+
+TEST_CASE_METHOD(ImageHandlersInit, "wxImage::LoadFileRows", "[image]")
+{
+    for ( const auto& testfile : g_testfiles )
+    {
+        const wxString file(testfile.file);
+        INFO("Loading " << file);
+
+        wxImageHandler* const handler = wxImage::FindHandler(testfile.type);
+        REQUIRE( handler );
+
+        wxImage expected;
+        REQUIRE( expected.LoadFile(file, testfile.type) );
+
+        wxFileInputStream fis(file);
+        REQUIRE( fis.IsOk() );
+
+        TestRowsReceiver receiver;
+        wxImage img;
+        REQUIRE( handler->LoadFileRows(&img, fis, receiver) );
+        CHECK( receiver.GetRows() == img.GetHeight() );
+
+        REQUIRE( img.GetSize() == expected.GetSize() );
+        CHECK( memcmp(img.GetData(), expected.GetData(),
+                      3*img.GetWidth()*img.GetHeight()) == 0 );
+        CHECK( img.HasAlpha() == expected.HasAlpha() );
+    }
+
+    // Check that loading is cancelled if the receiver asks for it.
+    static const char* const filesToCancel[] = { "horse.png", "horse.jpg", "horse.bmp" };
+    for ( const auto file : filesToCancel )
+    {
+        INFO("Cancelling loading " << file);
+
+        wxFileInputStream fis(file);
+        REQUIRE( fis.IsOk() );
+
+        wxImageHandler* const handler =
+            wxImage::FindHandler(wxString(file).AfterLast('.'), wxBITMAP_TYPE_ANY);
+        REQUIRE( handler );
+
+        TestRowsReceiver receiver(1);
+        wxImage img;
+        CHECK( !handler->LoadFileRows(&img, fis, receiver, false) );
+        CHECK( receiver.GetCalls() == 1 );
+        CHECK( !img.IsOk() );
+    }
+}
+
 TEST_CASE_METHOD(ImageHandlersInit, "wxImage::LoadFromSocketStream", "[image]")
 {
     // This test doesn't work any more even using the IP address below as the
@@ -1097,6 +1273,63 @@ TEST_CASE_METHOD(ImageHandlersInit, "wxImage::PNGDescription", "[image]")
         + wxString(wxT('c'), 256));
 }
 
+TEST_CASE_METHOD(ImageHandlersInit, "wxImage::SavePNGFast", "[image]")
+{
+    const wxImageHandler& handler = *wxImage::FindHandler(wxBITMAP_TYPE_PNG);
+
+    wxImage expected24("horse.png");
+    REQUIRE( expected24.IsOk() );
+
+    wxImage expected32(expected24.Copy());
+    SetAlpha(&expected32);
+
+    wxImage expected8 = expected24.ConvertToGreyscale();
+    expected8.SetOption(wxIMAGE_OPTION_PNG_FORMAT, wxPNG_TYPE_PALETTE);
+
+    // The test image is big enough to be split in several bands compressed
+    // by different threads.
+    for ( int threads : { 1, 4 } )
+    {
+        for ( int fast : { 0, 1 } )
+        {
+            INFO("Using " << threads << " threads" << (fast ? " in fast mode" : ""));
+
+            for ( wxImage* image : { &expected24, &expected32, &expected8 } )
+            {
+                image->SetOption(wxIMAGE_OPTION_PNG_COMPRESSION_THREADS, threads);
+                image->SetOption(wxIMAGE_OPTION_PNG_FAST, fast);
+            }
+
+            CompareImage(handler, expected24);
+            CompareImage(handler, expected32, wxIMAGE_HAVE_ALPHA);
+            CompareImage(handler, expected8, wxIMAGE_HAVE_PALETTE);
+
+            // Also check using just a single filter (4 is Paeth one).
+            wxImage paeth(expected24);
+            paeth.SetOption(wxIMAGE_OPTION_PNG_FILTER, 4);
+            CompareImage(handler, paeth);
+        }
+    }
+
+    // Check that the compression strategy is used when compressing in
+    // parallel too: Huffman-only compression results in bigger files.
+    wxImage huffman(expected24);
+    huffman.SetOption(wxIMAGE_OPTION_PNG_COMPRESSION_THREADS, 4);
+    huffman.SetOption(wxIMAGE_OPTION_PNG_FAST, 0);
+
+    wxMemoryOutputStream mosDefault;
+    REQUIRE( huffman.SaveFile(mosDefault, wxBITMAP_TYPE_PNG) );
+
+    huffman.SetOption(wxIMAGE_OPTION_PNG_COMPRESSION_STRATEGY, 2);
+    huffman.SetOption(wxIMAGE_OPTION_PNG_COMPRESSION_MEM_LEVEL, 9);
+
+    wxMemoryOutputStream mosHuffman;
+    REQUIRE( huffman.SaveFile(mosHuffman, wxBITMAP_TYPE_PNG) );
+    CHECK( mosHuffman.GetSize() > mosDefault.GetSize() );
+
+    CompareImage(handler, huffman);
+}
+
 #if wxUSE_LIBTIFF
 static void TestTIFFImage(const wxString& option, int value,
     const wxImage *compareImage = nullptr)
@@ -1302,6 +1535,51 @@ TEST_CASE_METHOD(ImageHandlersInit, "wxImage::GIFComment", "[image]")
 #endif //wxUSE_PALETTE
 }
 
+TEST_CASE_METHOD(ImageHandlersInit, "wxGIFDecoder::LazyDecoding", "[image][gif]")
+{
+#if wxUSE_PALETTE
+    wxImage image("horse.gif");
+    REQUIRE( image.IsOk() );
+
+    wxImageArray images;
+    images.push_back(image);
+    for (int i = 0; i < 5; ++i)
+    {
+        images.push_back( images[i].Rotate90() );
+        images[i+1].SetPalette(images[0].GetPalette());
+    }
+
+    wxMemoryOutputStream memOut;
+    REQUIRE( wxGIFHandler().SaveAnimation(images, &memOut) );
+
+    wxMemoryInputStream memIn(memOut);
+    wxGIFDecoder decoder;
+    decoder.EnableLazyDecoding(true, 2);
+    REQUIRE( decoder.LoadGIF(memIn) == wxGIF_OK );
+    REQUIRE( decoder.GetFrameCount() == images.size() );
+
+    // Check that the stream is positioned at the end, as without lazy
+    // decoding.
+    CHECK( memIn.TellI() == memOut.TellO() );
+
+    // Access the frames in different orders to check that the frames evicted
+    // from the cache are decoded again correctly.
+    for ( unsigned frame : { 0, 1, 2, 3, 4, 5, 5, 0, 3, 1, 1, 4 } )
+    {
+        INFO("Frame " << frame);
+
+        wxImage frameImage;
+        REQUIRE( decoder.ConvertToImage(frame, &frameImage) );
+        CHECK_THAT( frameImage, RGBSameAs(images[frame]) );
+    }
+
+    // Clone() should preserve the lazy decoding option.
+    wxAnimationDecoder* const clone = decoder.Clone();
+    CHECK( static_cast<wxGIFDecoder*>(clone)->IsLazyDecodingEnabled() );
+    clone->DecRef();
+#endif // #if wxUSE_PALETTE
+}
+
 TEST_CASE_METHOD(ImageHandlersInit, "wxImage::BadGIF", "[image][gif][error]")
 {
     wxImage image("image/bad_truncated.gif");
@@ -1310,6 +1588,70 @@ TEST_CASE_METHOD(ImageHandlersInit, "wxImage::BadGIF", "[image][gif][error]")
     CHECK( image.GetSize() == wxSize(1200, 800) );
 }
 
+TEST_CASE_METHOD(ImageHandlersInit, "wxImage::CorruptGIF", "[image][gif][error]")
+{
+    // Minimal animated GIF with two 1*1 frames.
+    static const unsigned char gifData[] =
+    {
+        'G', 'I', 'F', '8', '9', 'a',
+        0x01, 0x00, 0x01, 0x00, 0x80, 0x00, 0x00,       // screen descriptor
+        0x00, 0x00, 0x00, 0xff, 0xff, 0xff,             // global palette
+
+        0x2c, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00,
+        0x02, 0x02, 0x44, 0x01, 0x00,                   // first frame
+
+        0x2c, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00,
+        0x02, 0x02, 0x44, 0x01, 0x00,                   // second frame
+
+        0x3b
+    };
+
+    // Offsets of the second frame and of its LZW minimum code size.
+    const size_t secondFrame = 34;
+    const size_t secondFrameCodeSize = secondFrame + 10;
+
+    wxImage image;
+    {
+        wxMemoryInputStream mis(gifData, sizeof(gifData));
+        REQUIRE( image.LoadFile(mis, wxBITMAP_TYPE_GIF) );
+        CHECK( image.GetSize() == wxSize(1, 1) );
+    }
+    {
+        wxMemoryInputStream mis(gifData, sizeof(gifData));
+        REQUIRE( image.LoadFile(mis, wxBITMAP_TYPE_GIF, 1) );
+        CHECK( image.GetSize() == wxSize(1, 1) );
+    }
+    {
+        wxMemoryInputStream mis(gifData, sizeof(gifData));
+        CHECK( wxImage::GetImageCount(mis, wxBITMAP_TYPE_GIF) == 2 );
+    }
+
+    wxLogNull noLog;
+
+    // Errors in the frames other than the one being loaded must still be
+    // detected.
+    std::vector<unsigned char> data(gifData, gifData + sizeof(gifData));
+    data[secondFrameCodeSize] = 0;
+    {
+        wxMemoryInputStream mis(data.data(), data.size());
+        CHECK( !image.LoadFile(mis, wxBITMAP_TYPE_GIF, 0) );
+    }
+    {
+        wxMemoryInputStream mis(data.data(), data.size());
+        CHECK( !image.LoadFile(mis, wxBITMAP_TYPE_GIF, 1) );
+    }
+    {
+        wxMemoryInputStream mis(data.data(), data.size());
+        CHECK( wxImage::GetImageCount(mis, wxBITMAP_TYPE_GIF) == -1 );
+    }
+
+    // And the file truncated in the middle of a frame header is invalid too.
+    {
+        wxMemoryInputStream mis(gifData, secondFrame + 5);
+        CHECK( !image.LoadFile(mis, wxBITMAP_TYPE_GIF, 0) );
+    }
+}
+
 #endif // wxUSE_GIF
 
 TEST_CASE_METHOD(ImageHandlersInit, "wxImage::DibPadding", "[image]")
@@ -2359,6 +2701,135 @@ TEST_CASE("wxImage::InitAlpha", "[image][initalpha]")
     }
 }
 
+TEST_CASE("wxImage::Packed", "[image][packed]")
+{
+    wxImage image(2, 2);
+    image.SetRGB(0, 0, 0x10, 0x20, 0x30);
+    image.SetRGB(1, 0, 0xff, 0x80, 0x00);
+    image.SetRGB(0, 1, 0xff, 0xff, 0xff);
+    image.SetRGB(1, 1, 0x40, 0x50, 0x60);
+    REQUIRE( !image.IsPacked() );
+
+    SECTION("Opaque")
+    {
+        const wxImage orig = image.Copy();
+
+        const wxUint32* const data = image.GetPackedData();
+        REQUIRE( data );
+        CHECK( image.IsPacked() );
+        CHECK( data[0] == 0xff102030 );
+        CHECK( data[1] == 0xffff8000 );
+
+        // Querying the image attributes doesn't change the storage mode.
+        // Note that the image is considered to have alpha as the returned
+        // data could have been modified.
+        CHECK( image.GetWidth() == 2 );
+        CHECK( image.GetHeight() == 2 );
+        CHECK( image.HasAlpha() );
+        CHECK( !image.HasMask() );
+        CHECK( image.IsPacked() );
+
+        // Neither does accessing its data using const functions, as this
+        // could be done by several threads at once, but the conversion is
+        // still lossless.
+        CHECK( image.GetRed(1, 1) == 0x40 );
+        CHECK( image.IsPacked() );
+        CHECK( image.HasAlpha() );
+        CHECK_THAT( image, RGBSameAs(orig) );
+
+        // Modifying the data does switch the image to the default storage.
+        image.SetRGB(0, 0, 0x10, 0x20, 0x30);
+        CHECK( !image.IsPacked() );
+        CHECK_THAT( image, RGBSameAs(orig) );
+    }
+
+    SECTION("Unpack")
+    {
+        REQUIRE( image.GetPackedData() );
+
+        // Modifying the image switches it back to the default storage and
+        // the alpha channel is not used if all pixels are opaque.
+        image.SetRGB(1, 1, 0x40, 0x50, 0x60);
+        CHECK( !image.IsPacked() );
+        CHECK( !image.HasAlpha() );
+        CHECK( image.GetRed(0, 0) == 0x10 );
+    }
+
+    SECTION("GetData")
+    {
+        REQUIRE( image.GetPackedData() );
+
+        const wxImage& constImage = image;
+        const unsigned char* const data = constImage.GetData();
+        REQUIRE( data );
+        CHECK( data[0] == 0x10 );
+        CHECK( image.IsPacked() );
+
+        // Getting the data which can be modified switches the image to the
+        // default storage, but still uses the same data.
+        CHECK( image.GetData() == data );
+        CHECK( !image.IsPacked() );
+        CHECK( image.GetBlue(1, 1) == 0x60 );
+    }
+
+    SECTION("Alpha")
+    {
+        image.InitAlpha();
+        image.SetAlpha(1, 0, 0x80);
+        image.SetAlpha(0, 1, 0);
+
+        const wxUint32* const data = image.GetPackedData();
+        REQUIRE( data );
+        CHECK( image.HasAlpha() );
+        CHECK( data[0] == 0xff102030 );
+        CHECK( data[1] == 0x80804000 );
+        CHECK( data[2] == 0 );
+
+        CHECK( image.GetAlpha(1, 0) == 0x80 );
+        CHECK( image.IsPacked() );
+        CHECK( image.GetRed(1, 0) == 0xff );
+        CHECK( image.GetGreen(1, 0) == 0x7f );
+        CHECK( image.GetAlpha(0, 1) == 0 );
+    }
+
+    SECTION("Modify")
+    {
+        wxImage copy = image;
+
+        wxUint32* const data = image.GetPackedData();
+        REQUIRE( data );
+        data[3] = 0x40200000;
+
+        // The copy must not be affected by the changes to the image.
+        CHECK( !copy.IsPacked() );
+        CHECK( copy.GetRed(1, 1) == 0x40 );
+        CHECK( !copy.HasAlpha() );
+
+        // Alpha channel must be used for the modified data and is kept when
+        // converting the image back as soon as any pixel is not opaque.
+        CHECK( image.HasAlpha() );
+        CHECK( image.GetRed(1, 1) == 0x7f );
+        REQUIRE( image.HasAlpha() );
+        CHECK( image.GetAlpha(1, 1) == 0x40 );
+        CHECK( image.GetAlpha(0, 0) == wxIMAGE_ALPHA_OPAQUE );
+    }
+
+    SECTION("Create")
+    {
+        REQUIRE( image.CreatePacked(3, 2) );
+        CHECK( image.IsPacked() );
+        CHECK( image.HasAlpha() );
+        CHECK( image.GetSize() == wxSize(3, 2) );
+
+        wxImage copy = image.Copy();
+        CHECK( copy.IsPacked() );
+        CHECK( copy.GetPackedData() != image.GetPackedData() );
+
+        CHECK( image.GetAlpha(2, 1) == wxIMAGE_ALPHA_TRANSPARENT );
+        CHECK( image.GetBlue(2, 1) == 0 );
+    }
+}
+
 TEST_CASE("wxImage::XPM", "[image][xpm]")
 {
    static const char * dummy_xpm[] = {
@@ -2672,6 +3143,97 @@ TEST_CASE_METHOD(ImageHandlersInit, "wxImage::Cursor", "[image][cursor]")
 #endif
 }
 
+// Quantize the image to the given number of colours and return the result
+// as RGB image.
+static wxImage QuantizeImage(const wxImage& image, int numColours, int flags)
+{
+    const int w = image.GetWidth(),
+              h = image.GetHeight();
+
+    std::vector<unsigned char*> inRows(h), outRows(h);
+    std::vector<unsigned char> indices(w*h);
+    for ( int y = 0; y < h; y++ )
+    {
+        inRows[y] = image.GetData() + 3*w*y;
+        outRows[y] = &indices[w*y];
+    }
+
+    unsigned char palette[3*256];
+    wxQuantize::DoQuantize(w, h, &inRows[0], &outRows[0],
+                           palette, numColours, flags);
+
+    wxImage result(w, h);
+    unsigned char* p = result.GetData();
+    for ( int n = 0; n < w*h; n++ )
+    {
+        const int index = indices[n];
+        if ( index >= numColours )
+        {
+            FAIL_CHECK("Invalid palette index " << index);
+            break;
+        }
+
+        memcpy(p, palette + 3*index, 3);
+        p += 3;
+    }
+
+    return result;
+}
+
+TEST_CASE_METHOD(ImageHandlersInit, "wxQuantize::Fast", "[image][quantize]")
+{
+    // An image with only a few colours must be reproduced exactly.
+    wxImage simple(32, 32);
+    for ( int y = 0; y < 32; y++ )
+    {
+        for ( int x = 0; x < 32; x++ )
+        {
+            static const unsigned char colours[][3] =
+            {
+                { 0xff, 0x00, 0x00 },
+                { 0x00, 0x80, 0x00 },
+                { 0x00, 0x00, 0xff },
+                { 0xff, 0xff, 0xff },
+            };
+            const unsigned char* const c = colours[(x / 8 + y / 8) % 4];
+            simple.SetRGB(x, y, c[0], c[1], c[2]);
+        }
+    }
+
+    for ( int flags : { wxQUANTIZE_FAST,
+                        wxQUANTIZE_FAST | wxQUANTIZE_NO_DITHERING } )
+    {
+        INFO("Flags " << flags);
+        CHECK_THAT( QuantizeImage(simple, 16, flags), RGBSameAs(simple) );
+    }
+
+    // And a real image should be approximated reasonably well by both
+    // engines, with or without dithering.
+    wxImage horse("horse.png");
+    REQUIRE( horse.IsOk() );
+
+    const int w = horse.GetWidth(),
+              h = horse.GetHeight();
+
+    for ( int flags : { 0,
+                        wxQUANTIZE_NO_DITHERING,
+                        wxQUANTIZE_FAST,
+                        wxQUANTIZE_FAST | wxQUANTIZE_NO_DITHERING } )
+    {
+        INFO("Flags " << flags);
+
+        const wxImage result = QuantizeImage(horse, 64, flags);
+
+        double error = 0;
+        const unsigned char* p1 = horse.GetData();
+        const unsigned char* p2 = result.GetData();
+        for ( int n = 0; n < 3*w*h; n++ )
+            error += std::abs(p1[n] - p2[n]);
+
+        CHECK( error / (3*w*h) < 8 );
+    }
+}
+
 /*
     TODO: add lots of more tests to wxImage functions
 */
@@ -84,4 +84,41 @@ wxLZMAOutputStream *LZMAStream::DoCreateOutStream()
     return new wxLZMAOutputStream(new wxMemoryOutputStream());
 }
 
+TEST_CASE("LZMAStream::MultiThreaded", "[stream][lzma]")
+{
+    // Use the lowest compression level to use small blocks and make enough
+    // data to have several of them, so that they can be processed in
+    // parallel.
+    const size_t len = 3*1024*1024;
+    wxMemoryBuffer data(len);
+    for ( size_t n = 0; n < len; n++ )
+        static_cast<char*>(data.GetData())[n] = static_cast<char>((n / 7) % 251);
+    data.SetDataLen(len);
+
+    wxMemoryOutputStream outmem;
+    wxLZMAOutputStream outz(outmem, 0, 4);
+    outz.Write(data.GetData(), len);
+    REQUIRE( outz.LastWrite() == len );
+    REQUIRE( outz.Close() );
+
+    // Check that the data can be read back both in multithreaded and normal
+    // modes.
+    for ( int threads = 0; threads < 2; threads++ )
+    {
+        INFO("Using " << threads << " threads for decompression");
+
+        wxMemoryInputStream inmem(outmem);
+        wxLZMAInputStream inz(inmem, threads);
+
+        wxMemoryOutputStream result;
+        inz.Read(result);
+        CHECK( inz.GetLastError() == wxSTREAM_EOF );
+        REQUIRE( result.GetSize() == len );
+
+        wxMemoryBuffer buf(len);
+        result.CopyTo(buf.GetData(), len);
+        CHECK( memcmp(buf.GetData(), data.GetData(), len) == 0 );
+    }
+}
+
 #endif // wxUSE_LIBLZMA && wxUSE_STREAMS